@@ -58,6 +58,46 @@ namespace lavoir {
     std::size_t m_count = 0;
   };
 
+  /// Sites on a rectangle, stored row after row: the interval's first
+  /// refinement. Neighbours along a row are adjacent in storage, so a
+  /// stencil that walks a row walks contiguous memory.
+  class lattice {
+  public:
+    struct index_type {
+      std::size_t column = 0;
+      std::size_t row = 0;
+    };
+
+    constexpr lattice () = default;
+
+    constexpr lattice (std::size_t columns, std::size_t rows)
+        : m_columns (columns), m_rows (rows) {}
+
+    constexpr std::size_t size () const {
+      return m_columns * m_rows;
+    }
+
+    constexpr std::size_t columns () const {
+      return m_columns;
+    }
+
+    constexpr std::size_t rows () const {
+      return m_rows;
+    }
+
+    constexpr std::size_t offset (index_type index) const {
+      return index.row * m_columns + index.column;
+    }
+
+    constexpr index_type index (std::size_t offset) const {
+      return { offset % m_columns, offset / m_columns };
+    }
+
+  private:
+    std::size_t m_columns = 0;
+    std::size_t m_rows = 0;
+  };
+
   /// One typed column of values leased over a domain. A field owns
   /// nothing: it pairs a domain with a span borrowed from a column or
   /// any other landlord, and must not outlive its lease.
@@ -88,5 +128,7 @@ namespace lavoir {
   };
 
   static_assert (Domain<interval>);
+  static_assert (Domain<lattice>);
   static_assert (Bundle<field<interval, float>>);
+  static_assert (Bundle<field<lattice, float>>);
 }
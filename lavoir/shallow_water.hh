@@ -0,0 +1,376 @@
+#pragma once
+
+#include "lavoir/buffer.hh"
+#include "lavoir/bundle.hh"
+#include "lavoir/units.hh"
+#include "lavoir/wave.hh"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <span>
+#include <stdexcept>
+
+/// The water line's second dimension: linear shallow water over a
+/// square window of lattice sites that follows a point of interest
+/// across a world too large to simulate whole. Each site keeps the
+/// still depth it was seeded with; waves run at sqrt(g · depth), so
+/// they slow in the shallows and stop at the shore, where a dry
+/// neighbour passes no flux and the wave reflects as from a wall.
+///
+/// The window's edge is not a wall: a sponge of rising damping drinks
+/// waves before they reach it, since the world beyond is water the
+/// window simply is not holding. Moving the window slides the three
+/// leapfrog levels by whole sites and seeds only the uncovered strips.
+///
+/// A step costs the same whatever the water does: every interior site
+/// takes one five-point update over contiguous rows, without branches,
+/// so the side of the window is the budget and replays stay exact.
+/// Rows run in bands, and whoever calls tick decides which threads run
+/// them.
+
+namespace lavoir {
+  using acceleration_q = quantity<si::metre / (si::second * si::second), float>;
+
+  inline constexpr acceleration_q standard_gravity =
+    9.80665f * si::metre / (si::second * si::second);
+
+  /// Runs body (band) for every band in order on the calling thread.
+  /// Anything callable the same way may run the bands concurrently
+  /// instead; `sites` is the work they cover together.
+  struct serial_bands {
+    template <typename Body>
+    void operator() (std::size_t bands, std::size_t, Body&& body) const {
+      for (std::size_t band = 0; band < bands; ++band)
+        body (band);
+    }
+  };
+
+  class water_window {
+  public:
+    /// Rows of sites stepped together by one band.
+    static constexpr std::size_t band_rows = 16;
+
+    /// `depth (column, row)` answers the still depth at a site of the
+    /// world lattice; the window's corner starts at `origin`. Depths
+    /// past `deepest` are held there, and stability is checked for
+    /// it: leapfrog in two dimensions needs c² · pace² / spacing² to
+    /// stay below one half.
+    template <typename Depth>
+    water_window (std::size_t side,
+                  site_spacing_q spacing,
+                  metres_q deepest,
+                  step_pace_t pace,
+                  std::int64_t origin_column,
+                  std::int64_t origin_row,
+                  Depth&& depth)
+        : m_sites (side, side), m_pace (pace), m_deepest (deepest) {
+      if (side < 3)
+        throw std::invalid_argument (
+          "A water window needs an interior: at least three sites a side");
+      const auto tick_time = pace * (1 * step);
+      const auto gap = spacing * (1 * unit);
+      const auto per_metre =
+        standard_gravity * tick_time * tick_time / (gap * gap);
+      m_courant2_per_metre = static_cast<float> (
+        (per_metre * (1.0 * si::metre)).numerical_value_in (one));
+      const double deepest_courant2 =
+        m_courant2_per_metre * deepest.numerical_value_in (si::metre);
+      if (!(deepest_courant2 > 0.0 && deepest_courant2 < 0.5))
+        throw std::invalid_argument (
+          "The water window's deepest Courant number must sit inside "
+          "(0, 1/sqrt 2)");
+
+      const values_t count = m_sites.size () * unit;
+      for (auto& level : m_levels)
+        level = column<metres_q>::with_count (count);
+      m_depth = column<metres_q>::with_count (count);
+      m_east = column<float>::with_count (count);
+      m_south = column<float>::with_count (count);
+      m_keel = column<float>::with_count (count);
+      m_origin_column = origin_column;
+      m_origin_row = origin_row;
+      seed (static_cast<std::int64_t> (side),
+            static_cast<std::int64_t> (side),
+            depth);
+    }
+
+    const lattice& sites () const {
+      return m_sites;
+    }
+
+    steps_t age () const {
+      return m_age;
+    }
+
+    step_pace_t pace () const {
+      return m_pace;
+    }
+
+    std::int64_t origin_column () const {
+      return m_origin_column;
+    }
+
+    std::int64_t origin_row () const {
+      return m_origin_row;
+    }
+
+    /// Site updates in every step: the fixed budget the side buys.
+    std::size_t site_updates () const {
+      return (m_sites.columns () - 2) * (m_sites.rows () - 2);
+    }
+
+    /// The displacement field at the current level.
+    field<lattice, const metres_q> surface () const {
+      return { m_sites, m_levels[m_level].lease () };
+    }
+
+    /// The still depth the window was seeded with; zero on dry sites.
+    field<lattice, const metres_q> still_depth () const {
+      return { m_sites, m_depth.lease () };
+    }
+
+    /// Move the window's corner to a new world site. Water that stays
+    /// inside keeps its motion; uncovered strips are seeded still, and
+    /// a jump past the window's side reseeds all of it.
+    template <typename Depth>
+    void follow (std::int64_t origin_column,
+                 std::int64_t origin_row,
+                 Depth&& depth) {
+      const std::int64_t columns = origin_column - m_origin_column;
+      const std::int64_t rows = origin_row - m_origin_row;
+      if (columns == 0 && rows == 0)
+        return;
+      m_origin_column = origin_column;
+      m_origin_row = origin_row;
+      const auto side = static_cast<std::int64_t> (m_sites.columns ());
+      if (std::abs (columns) >= side || std::abs (rows) >= side) {
+        for (auto& level : m_levels)
+          std::ranges::fill (level.lease (), metres_q::zero ());
+        seed (side, side, depth);
+        return;
+      }
+      for (auto& level : m_levels)
+        slide (level.lease (), columns, rows);
+      slide (m_depth.lease (), columns, rows);
+      seed (columns, rows, depth);
+      settle ();
+    }
+
+    /// Raise (or, negative, press down) the water around a world site
+    /// by a Gaussian of the given radius in sites. The current and
+    /// previous levels move together, so the water is displaced at rest
+    /// and its energy is what the Gaussian holds. Dry sites and the
+    /// window's rim are left alone.
+    void disturb (double column, double row, metres_q height, float radius) {
+      const double x = column - static_cast<double> (m_origin_column);
+      const double y = row - static_cast<double> (m_origin_row);
+      const auto reach = static_cast<std::int64_t> (std::ceil (3.0f * radius));
+      const auto near_column = static_cast<std::int64_t> (std::round (x));
+      const auto near_row = static_cast<std::int64_t> (std::round (y));
+      const auto last = static_cast<std::int64_t> (m_sites.columns ()) - 2;
+      const auto u = m_levels[m_level].lease ();
+      const auto u_prev =
+        m_levels[(m_level + wave_levels - 1) % wave_levels].lease ();
+      const auto keel = m_keel.lease ();
+      const float spread = 2.0f * radius * radius;
+      for (std::int64_t r = std::max<std::int64_t> (1, near_row - reach);
+           r <= std::min (last, near_row + reach);
+           ++r)
+        for (std::int64_t c = std::max<std::int64_t> (1, near_column - reach);
+             c <= std::min (last, near_column + reach);
+             ++c) {
+          const auto dx = static_cast<float> (static_cast<double> (c) - x);
+          const auto dy = static_cast<float> (static_cast<double> (r) - y);
+          const std::size_t site = offset (c, r);
+          const float wet = keel[site] > 0.0f ? 1.0f : 0.0f;
+          const float shape = wet * std::exp (-(dx * dx + dy * dy) / spread);
+          u[site] += shape * height;
+          u_prev[site] += shape * height;
+        }
+    }
+
+    /// The displacement at a world site, bilinear between sites; zero
+    /// outside the window.
+    metres_q displacement_at (double column, double row) const {
+      const double x = column - static_cast<double> (m_origin_column);
+      const double y = row - static_cast<double> (m_origin_row);
+      const auto last = static_cast<double> (m_sites.columns () - 1);
+      if (!(x >= 0.0 && y >= 0.0 && x < last && y < last))
+        return metres_q::zero ();
+      const auto c = static_cast<std::size_t> (x);
+      const auto r = static_cast<std::size_t> (y);
+      const auto fx = static_cast<float> (x - static_cast<double> (c));
+      const auto fy = static_cast<float> (y - static_cast<double> (r));
+      const auto u = m_levels[m_level].lease ();
+      const std::size_t site = r * m_sites.columns () + c;
+      const std::size_t below = site + m_sites.columns ();
+      return (1.0f - fy) * ((1.0f - fx) * u[site] + fx * u[site + 1]) +
+             fy * ((1.0f - fx) * u[below] + fx * u[below + 1]);
+    }
+
+    /// Advance one step: leapfrog from the current and previous levels
+    /// into the eldest, band by band, then make it current. Bands
+    /// write disjoint rows of the eldest level and only read the
+    /// others, so `bands` may run them in any order or all at once.
+    template <typename Bands = serial_bands>
+    void tick (Bands&& bands = Bands {}) {
+      const std::size_t interior = m_sites.rows () - 2;
+      const std::size_t count = (interior + band_rows - 1) / band_rows;
+      bands (count, site_updates (), [&] (std::size_t band) {
+        const std::size_t first = 1 + band * band_rows;
+        const std::size_t end = std::min (first + band_rows, interior + 1);
+        for (std::size_t row = first; row < end; ++row)
+          step_row (row);
+      });
+      m_level = (m_level + 1) % wave_levels;
+      m_age += 1 * step;
+    }
+
+  private:
+    std::size_t offset (std::int64_t column, std::int64_t row) const {
+      return m_sites.offset ({ static_cast<std::size_t> (column),
+                               static_cast<std::size_t> (row) });
+    }
+
+    /// One row of the five-point update. Faces carry c² between their
+    /// two sites, so the sum is the discrete divergence of c² ∇u and
+    /// depth may vary from site to site; a dry site's keel of zero
+    /// keeps it flat.
+    void step_row (std::size_t row) {
+      const std::size_t width = m_sites.columns ();
+      const std::size_t next = (m_level + 1) % wave_levels;
+      const std::size_t previous = (m_level + wave_levels - 1) % wave_levels;
+      const metres_q* u = m_levels[m_level].lease ().data ();
+      const metres_q* u_prev = m_levels[previous].lease ().data ();
+      metres_q* u_next = m_levels[next].lease ().data ();
+      const float* east = m_east.lease ().data ();
+      const float* south = m_south.lease ().data ();
+      const float* keel = m_keel.lease ().data ();
+
+      const std::size_t begin = row * width + 1;
+      const std::size_t end = row * width + width - 1;
+      for (std::size_t i = begin; i < end; ++i) {
+        const metres_q flux = east[i] * (u[i + 1] - u[i]) -
+                              east[i - 1] * (u[i] - u[i - 1]) +
+                              south[i] * (u[i + width] - u[i]) -
+                              south[i - width] * (u[i] - u[i - width]);
+        u_next[i] = keel[i] * (2.0f * u[i] - u_prev[i] + flux);
+      }
+    }
+
+    /// Shift a row-major column so the site that sat at (c + columns,
+    /// r + rows) now sits at (c, r); uncovered sites read zero. Rows
+    /// are visited so no source is overwritten before it is read.
+    template <typename T>
+    void slide (std::span<T> values, std::int64_t columns, std::int64_t rows) {
+      const std::size_t width = m_sites.columns ();
+      const auto side = static_cast<std::int64_t> (width);
+      const auto shift = static_cast<std::size_t> (std::abs (columns));
+      const std::size_t kept = width - shift;
+      for (std::int64_t visit = 0; visit < side; ++visit) {
+        const std::int64_t row = rows >= 0 ? visit : side - 1 - visit;
+        const std::int64_t source = row + rows;
+        const auto target = values.subspan (offset (0, row), width);
+        if (source < 0 || source >= side) {
+          std::ranges::fill (target, T {});
+          continue;
+        }
+        const auto from = values.subspan (offset (0, source), width);
+        if (columns >= 0) {
+          std::copy (from.begin () + shift, from.end (), target.begin ());
+          std::fill (target.begin () + kept, target.end (), T {});
+        } else {
+          std::copy_backward (
+            from.begin (), from.begin () + kept, target.end ());
+          std::fill (target.begin (), target.begin () + shift, T {});
+        }
+      }
+    }
+
+    /// Flatten every level on sites the step leaves alone: the dry
+    /// land and the rim, where a slide may have carried water in.
+    void settle () {
+      const auto keel = m_keel.lease ();
+      for (auto& level : m_levels) {
+        const auto u = level.lease ();
+        for (std::size_t site = 0; site < u.size (); ++site)
+          if (keel[site] == 0.0f)
+            u[site] = metres_q::zero ();
+      }
+    }
+
+    /// Ask for the depth of every site uncovered by a slide of
+    /// (columns, rows), then recompute what depth decides.
+    template <typename Depth>
+    void seed (std::int64_t columns, std::int64_t rows, Depth& depth) {
+      const auto side = static_cast<std::int64_t> (m_sites.columns ());
+      const auto uncovered = [side] (std::int64_t site, std::int64_t moved) {
+        return moved > 0 ? site >= side - moved : site < -moved;
+      };
+      const auto depths = m_depth.lease ();
+      for (std::int64_t row = 0; row < side; ++row)
+        for (std::int64_t column = 0; column < side; ++column)
+          if (uncovered (column, columns) || uncovered (row, rows)) {
+            const metres_q still =
+              depth (m_origin_column + column, m_origin_row + row);
+            depths[offset (column, row)] =
+              std::clamp (still, metres_q::zero (), m_deepest);
+          }
+      prepare ();
+    }
+
+    /// Faces, keel and sponge from the seeded depths. The rim is held
+    /// dry so the stencil never leaves the window, and the sponge's
+    /// damping rises toward it over an eighth of the side.
+    void prepare () {
+      const std::size_t side = m_sites.columns ();
+      const auto depths = m_depth.lease ();
+      const auto east = m_east.lease ();
+      const auto south = m_south.lease ();
+      const auto keel = m_keel.lease ();
+      const std::size_t sponge = std::max<std::size_t> (1, side / 8);
+      const auto courant2 = [&] (std::size_t column, std::size_t row) {
+        if (column == 0 || row == 0 || column == side - 1 || row == side - 1)
+          return 0.0f;
+        return m_courant2_per_metre *
+               depths[row * side + column].numerical_value_in (si::metre);
+      };
+      for (std::size_t row = 0; row < side; ++row)
+        for (std::size_t column = 0; column < side; ++column) {
+          const std::size_t site = row * side + column;
+          const float here = courant2 (column, row);
+          east[site] = column + 1 < side
+                         ? std::min (here, courant2 (column + 1, row))
+                         : 0.0f;
+          south[site] = row + 1 < side
+                          ? std::min (here, courant2 (column, row + 1))
+                          : 0.0f;
+          const std::size_t rim = std::min (
+            { column, row, side - 1 - column, side - 1 - row });
+          const float inset = rim < sponge
+                                ? static_cast<float> (sponge - rim) /
+                                    static_cast<float> (sponge)
+                                : 0.0f;
+          keel[site] = here > 0.0f ? 0.9985f * (1.0f - 0.08f * inset * inset)
+                                   : 0.0f;
+        }
+    }
+
+    lattice m_sites;
+    step_pace_t m_pace;
+    metres_q m_deepest;
+    float m_courant2_per_metre = 0.0f;
+    std::array<column<metres_q>, wave_levels> m_levels;
+    column<metres_q> m_depth;
+    column<float> m_east;
+    column<float> m_south;
+    column<float> m_keel;
+    std::int64_t m_origin_column = 0;
+    std::int64_t m_origin_row = 0;
+    std::size_t m_level = 0;
+    steps_t m_age = steps_t::zero ();
+  };
+}
@@ -3,12 +3,22 @@
 #include <algorithm>
 
 namespace moppe::game {
-  Dust::Dust () = default;
+  // Room for every emission that can be alive, so neither emitting nor
+  // restoring a snapshot allocates during play.
+  Dust::Dust () {
+    m_emissions.reserve (MAX_EMISSIONS);
+  }
 
   Dust::State Dust::state () const {
     return { m_emissions, m_next_id, m_logical_time };
   }
 
+  void Dust::capture (State& state) const {
+    state.emissions.assign (m_emissions.begin (), m_emissions.end ());
+    state.next_id = m_next_id;
+    state.logical_time = m_logical_time;
+  }
+
   void Dust::restore (const State& state) {
     m_emissions = state.emissions;
     m_next_id = state.next_id;
@@ -28,7 +38,8 @@ namespace moppe::game {
     std::size_t live_particles = 0;
     for (const Emission& emission : m_emissions)
       live_particles += emission.particle_count;
-    const int available = std::max (0, 500 - static_cast<int> (live_particles));
+    const int available = std::max (
+      0, static_cast<int> (MAX_PARTICLES) - static_cast<int> (live_particles));
     const int accepted = std::clamp (count, 0, available);
     if (accepted == 0)
       return;
@@ -50,8 +61,7 @@ namespace moppe::game {
   void Dust::update (seconds_t dt) {
     m_logical_time += dt;
     std::erase_if (m_emissions, [this] (const Emission& emission) {
-      return m_logical_time - emission.birth_time >
-             emission.style.lifetime * 0.9f;
+      return expired (emission, m_logical_time);
     });
   }
 
@@ -4,6 +4,7 @@
 #include <moppe/game/world.hh>
 #include <moppe/render/renderer.hh>
 
+#include <cstddef>
 #include <vector>
 
 namespace moppe {
@@ -24,6 +25,11 @@ namespace moppe {
         bool additive = false; // glow (embers) vs. soft dust
       };
 
+      // Live particles across every emission. An emission holds at least
+      // one, so no more emissions than this are ever alive either.
+      static constexpr std::size_t MAX_PARTICLES = 500;
+      static constexpr std::size_t MAX_EMISSIONS = MAX_PARTICLES;
+
       Dust ();
 
       struct Emission {
@@ -36,6 +42,12 @@ namespace moppe {
         uint32_t particle_count = 0;
       };
 
+      // Whether an emission has died out by logical time `now`. An emission
+      // never changes once emitted, and once expired it stays expired.
+      static bool expired (const Emission& emission, seconds_t now) {
+        return now - emission.birth_time > emission.style.lifetime * 0.9f;
+      }
+
       struct State {
         std::vector<Emission> emissions;
         uint64_t next_id = 1;
@@ -52,6 +64,8 @@ namespace moppe {
       void render (render::Renderer& renderer) const;
 
       State state () const;
+      // Fills `state` in place, reusing its storage.
+      void capture (State& state) const;
       void restore (const State& state);
 
     private:
@@ -2,6 +2,7 @@
 
 #include <moppe/profile.hh>
 
+#include <cstddef>
 #include <vector>
 
 namespace moppe::game {
@@ -20,24 +21,31 @@ namespace moppe::game {
       return render::ForestAge::Mature;
     }
 
-    render::ForestInstance present (const ForestSite& site) {
-      const float size = site.size.numerical_value_in (mp_units::one);
-      const float cover = site.cover.numerical_value_in (mp_units::one);
-      const float moisture = site.moisture.numerical_value_in (mp_units::one);
-      const bool conifer = site.form == ForestForm::conifer;
+    render::ForestInstance present (const ForestPlan& plan, std::size_t site) {
+      const float size = spatial::get<tree_size_factor> (plan)[site]
+                           .numerical_value_in (mp_units::one);
+      const float cover = spatial::get<map::forest_cover> (plan)[site]
+                            .numerical_value_in (mp_units::one);
+      const float moisture = spatial::get<map::surface_moisture> (plan)[site]
+                               .numerical_value_in (mp_units::one);
+      const bool conifer =
+        forest_form (spatial::get<tree_form> (plan)[site]) ==
+        ForestForm::conifer;
       const meters_t height = size * (conifer ? 15.0f : 13.4f) *
                               (0.82f + 0.30f * cover + 0.26f * moisture) * u::m;
       return {
-        .root = site.position,
-        .ground_normal = site.normal,
+        .root = spatial::get<mp_units::isq::position_vector> (plan)[site],
+        .ground_normal = spatial::get<terrain::terrain_normal> (plan)[site],
         .height = height,
         .crown_radius = (conifer ? 0.23f : 0.25f) * height,
         .canopy_cover = cover * mp_units::one,
         .moisture = moisture * mp_units::one,
-        .seed = site.seed,
+        .seed = spatial::get<tree_seed> (plan)[site].numerical_value_in (
+          mp_units::one),
         .species = conifer ? render::ForestSpecies::Conifer
                            : render::ForestSpecies::Broadleaf,
-        .age = presented_age (site.age),
+        .age = presented_age (
+          forest_age (spatial::get<tree_age_class> (plan)[site])),
       };
     }
   }
@@ -54,10 +62,10 @@ namespace moppe::game {
                                  const ForestPlan& plan) {
     MOPPE_PROFILE_ZONE ("ForestLandscape::upload_instances");
     std::vector<render::ForestInstance> instances;
-    instances.reserve (plan.sites.size ());
-    for (const ForestSite& site : plan.sites)
-      instances.push_back (present (site));
-    renderer.set_forest ({ .period = plan.period }, instances);
+    instances.reserve (plan.size ());
+    for (std::size_t site = 0; site < plan.size (); ++site)
+      instances.push_back (present (plan, site));
+    renderer.set_forest ({ .period = plan.domain ().period () }, instances);
     m_tree_count = instances.size ();
     m_resident_bytes = instances.size () * sizeof (render::ForestInstance);
   }
@@ -8,9 +8,9 @@
 #include <cstdint>
 
 namespace moppe::game {
-  // Presentation owner for the global population. The game keeps typed sites;
-  // the renderer keeps compact GPU instances and decides projected detail.
-  // No complete tree mesh is retained on the CPU.
+  // Presentation owner for the global population. The game keeps typed
+  // columns; the renderer keeps compact GPU instances and decides projected
+  // detail. No complete tree mesh is retained on the CPU.
   class ForestLandscape {
   public:
     void rebuild (render::Renderer& renderer,
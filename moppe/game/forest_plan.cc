@@ -1,22 +1,58 @@
 #include <moppe/game/forest_plan.hh>
 
 #include <moppe/gfx/signal.hh>
+#include <moppe/parallel.hh>
+#include <moppe/spatial/bundle_storage.hh>
 
 #include <algorithm>
-#include <array>
 #include <cmath>
 #include <cstdint>
-#include <filesystem>
 #include <fstream>
-#include <limits>
+#include <istream>
+#include <numeric>
+#include <optional>
+#include <ostream>
 #include <stdexcept>
-#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace moppe::spatial {
+  // A population is its size, the seed that planted it and the torus it
+  // stands on.
+  template <>
+  struct DomainStorage<game::ForestPopulation> {
+    static void write (std::ostream& out,
+                       const game::ForestPopulation& population) {
+      const Vec3 period = extent_value (population.period ());
+      detail::write_scalar (out,
+                            static_cast<std::uint64_t> (population.size ()));
+      detail::write_scalar (out, population.seed ());
+      detail::write_scalar (out, period[0]);
+      detail::write_scalar (out, period[1]);
+      detail::write_scalar (out, period[2]);
+    }
+
+    static std::optional<game::ForestPopulation> read (std::istream& in) {
+      std::uint64_t size = 0;
+      std::uint32_t seed = 0;
+      float x = 0.0f;
+      float y = 0.0f;
+      float z = 0.0f;
+      if (!detail::read_scalar (in, size) || !detail::read_scalar (in, seed) ||
+          !detail::read_scalar (in, x) || !detail::read_scalar (in, y) ||
+          !detail::read_scalar (in, z))
+        return std::nullopt;
+      if (size > 10'000'000)
+        return std::nullopt;
+      return game::ForestPopulation (static_cast<std::size_t> (size),
+                                     seed,
+                                     spatial_extent_in_metres (Vec3 (x, y, z)));
+    }
+  };
+}
 
 namespace moppe::game {
   namespace {
-    constexpr std::uint64_t forest_plan_magic = 0x4d4f505045465253ULL;
-    constexpr std::uint32_t forest_plan_version = 9;
-
     // Marginal woodland stays close to the old proposal density while the
     // most suitable habitat can form a genuinely closed spruce stand. The
     // hard-core pass remains the physical upper bound. Proposals themselves
@@ -26,30 +62,13 @@ namespace moppe::game {
     constexpr float forest_proposal_scale_max = 0.95f;
     constexpr float forest_exclusion_ratio = 0.40f;
 
-    struct ForestPlanHeader {
-      std::uint64_t magic;
-      std::uint32_t version;
-      std::uint32_t seed;
-      std::array<float, 3> period;
-      std::uint32_t reserved;
-      std::uint64_t site_count;
-    };
-
-    struct ForestSiteRecord {
-      std::array<float, 3> position;
-      std::array<float, 3> normal;
-      float cover;
-      float moisture;
-      float size;
-      std::uint32_t seed;
-      std::uint32_t form;
-      std::uint32_t age;
-    };
-
-    static_assert (std::is_trivially_copyable_v<ForestPlanHeader>);
-    static_assert (std::is_trivially_copyable_v<ForestSiteRecord>);
-    static_assert (sizeof (ForestPlanHeader) == 40);
-    static_assert (sizeof (ForestSiteRecord) == 48);
+    // Proposals are drawn, and sites sampled, in batches this long, which
+    // is work enough to be worth handing to another thread.
+    constexpr std::uint64_t forest_proposals_per_stretch = 65536;
+    constexpr std::size_t forest_sites_per_batch = 4096;
+    // Tiles 64 exclusion bins on a side: at the default spacing about 128 m,
+    // so a border's halo is a small share of each tile.
+    constexpr std::uint32_t forest_tile_bins = 64;
 
     struct ForestCandidate {
       float x;
@@ -59,6 +78,8 @@ namespace moppe::game {
       std::uint32_t identity;
     };
 
+    enum class ThinningState : std::uint8_t { undecided, accepted, rejected };
+
     position_t sample_position (meters_t x, meters_t z) {
       return position (
         Vec3 (x.numerical_value_in (u::m), 0, z.numerical_value_in (u::m)));
@@ -97,20 +118,6 @@ namespace moppe::game {
               z.numerical_value_in (u::m)));
     }
 
-    bool same_extent (const std::array<float, 3>& stored,
-                      const spatial_extent_t& expected) {
-      const Vec3 value = extent_value (expected);
-      return stored[0] == value[0] && stored[1] == value[1] &&
-             stored[2] == value[2];
-    }
-
-    template <typename T>
-    void write_record (std::ofstream& output, const T& value) {
-      output.write (reinterpret_cast<const char*> (&value), sizeof (value));
-      if (!output)
-        throw std::runtime_error ("could not write forest plan");
-    }
-
     ForestAge age_from_identity (std::uint32_t identity) {
       const float draw = hash_lane (identity, 6);
       if (draw < 0.18f)
@@ -142,14 +149,22 @@ namespace moppe::game {
                                  const map::SurfaceReadings& readings,
                                  std::uint32_t seed,
                                  meters_t spacing) {
+    return detail::plan_global_forest (
+      surface, readings, seed, spacing, forest_tile_bins);
+  }
+
+  ForestPlan detail::plan_global_forest (const map::SurfaceGeometry& surface,
+                                         const map::SurfaceReadings& readings,
+                                         std::uint32_t seed,
+                                         meters_t spacing,
+                                         std::uint32_t tile_bins) {
     if (spacing <= 0.0f * u::m)
       throw std::invalid_argument ("Forest spacing must be positive");
+    if (tile_bins == 0)
+      throw std::invalid_argument ("Forest tiles must hold at least one bin");
     const terrain::TerrainDomain& domain = surface.domain ();
-    ForestPlan plan;
     const meters_t width = domain.period_x ();
     const meters_t depth = domain.period_z ();
-    plan.period = spatial_extent_in_metres (Vec3 (
-      width.numerical_value_in (u::m), 0, depth.numerical_value_in (u::m)));
     // Draw a deterministic uniform proposal stream over the whole torus, then
     // use habitat-weighted selection and Matérn-style priority thinning. The
     // count matches the earlier fine proposal density, but positions have no
@@ -161,37 +176,49 @@ namespace moppe::game {
       static_cast<std::uint64_t> (
         std::ceil ((width / proposal_spacing).numerical_value_in (one) *
                    (depth / proposal_spacing).numerical_value_in (one))));
-    std::vector<ForestCandidate> candidates;
-    candidates.reserve (static_cast<std::size_t> (proposal_count / 12));
-
-    for (std::uint64_t proposal = 0; proposal < proposal_count; ++proposal) {
-      const std::uint32_t identity =
-        lattice_hash (static_cast<std::uint32_t> (proposal),
-                      static_cast<std::uint32_t> (proposal >> 32),
-                      seed);
-      const meters_t x = hash_lane (identity, 0) * width;
-      const meters_t z = hash_lane (identity, 1) * depth;
-      const map::ForestCover cover = cover_at (readings, x, z);
-      const proportion_t population = band (
-        0.08f * map::forest_cover[one], 0.62f * map::forest_cover[one], cover);
-      const float population_value = population.numerical_value_in (one);
-      const float proposal_scale = std::lerp (
-        forest_proposal_scale_min, forest_proposal_scale_max, population_value);
-      if (cover < 0.06f * map::forest_cover[one] ||
-          hash_lane (identity, 2) > population_value * proposal_scale)
-        continue;
-      candidates.push_back ({ .x = x.numerical_value_in (u::m),
-                              .z = z.numerical_value_in (u::m),
-                              .cover = cover.numerical_value_in (one),
-                              .priority = hash_lane (identity, 3),
-                              .identity = identity });
-    }
 
-    std::ranges::sort (
-      candidates, [] (const ForestCandidate& a, const ForestCandidate& b) {
-        return a.priority < b.priority ||
-               (a.priority == b.priority && a.identity < b.identity);
+    // Each proposal is a hash of its own counter, so any stretch of the
+    // stream can be drawn without the rest.
+    const std::size_t stretches = static_cast<std::size_t> (
+      (proposal_count + forest_proposals_per_stretch - 1) /
+      forest_proposals_per_stretch);
+    std::vector<std::vector<ForestCandidate>> drawn (stretches);
+    parallel_rows (
+      stretches,
+      static_cast<std::size_t> (proposal_count),
+      [&] (std::size_t stretch) {
+        const std::uint64_t first = stretch * forest_proposals_per_stretch;
+        const std::uint64_t last =
+          std::min (proposal_count, first + forest_proposals_per_stretch);
+        std::vector<ForestCandidate>& candidates = drawn[stretch];
+        candidates.reserve (static_cast<std::size_t> ((last - first) / 12));
+        for (std::uint64_t proposal = first; proposal < last; ++proposal) {
+          const std::uint32_t identity =
+            lattice_hash (static_cast<std::uint32_t> (proposal),
+                          static_cast<std::uint32_t> (proposal >> 32),
+                          seed);
+          const meters_t x = hash_lane (identity, 0) * width;
+          const meters_t z = hash_lane (identity, 1) * depth;
+          const map::ForestCover cover = cover_at (readings, x, z);
+          const proportion_t population =
+            band (0.08f * map::forest_cover[one],
+                  0.62f * map::forest_cover[one],
+                  cover);
+          const float population_value = population.numerical_value_in (one);
+          const float proposal_scale = std::lerp (forest_proposal_scale_min,
+                                                  forest_proposal_scale_max,
+                                                  population_value);
+          if (cover < 0.06f * map::forest_cover[one] ||
+              hash_lane (identity, 2) > population_value * proposal_scale)
+            continue;
+          candidates.push_back ({ .x = x.numerical_value_in (u::m),
+                                  .z = z.numerical_value_in (u::m),
+                                  .cover = cover.numerical_value_in (one),
+                                  .priority = hash_lane (identity, 3),
+                                  .identity = identity });
+        }
       });
+
     const float width_m = width.numerical_value_in (u::m);
     const float depth_m = depth.numerical_value_in (u::m);
     const float exclusion =
@@ -204,12 +231,84 @@ namespace moppe::game {
     const float bin_z = depth_m / static_cast<float> (bins_z);
     const int reach_x = static_cast<int> (std::ceil (exclusion / bin_x));
     const int reach_z = static_cast<int> (std::ceil (exclusion / bin_z));
-    std::vector<std::int32_t> heads (static_cast<std::size_t> (bins_x) * bins_z,
-                                     -1);
-    std::vector<std::int32_t> next;
-    std::vector<ForestCandidate> accepted;
-    next.reserve (candidates.size ());
-    accepted.reserve (candidates.size ());
+    const auto bin_of = [&] (const ForestCandidate& candidate) {
+      const std::uint32_t bx =
+        std::min (static_cast<std::uint32_t> (candidate.x / bin_x), bins_x - 1);
+      const std::uint32_t bz =
+        std::min (static_cast<std::uint32_t> (candidate.z / bin_z), bins_z - 1);
+      return std::pair { bx, bz };
+    };
+
+    // Tiles are square blocks of exclusion bins. Candidates are laid out
+    // tile by tile, and in priority order within each tile.
+    const std::uint32_t tiles_x = (bins_x + tile_bins - 1) / tile_bins;
+    const std::uint32_t tiles_z = (bins_z + tile_bins - 1) / tile_bins;
+    const auto tile_of = [&] (const ForestCandidate& candidate) {
+      const auto [bx, bz] = bin_of (candidate);
+      return static_cast<std::size_t> (bz / tile_bins) * tiles_x +
+             bx / tile_bins;
+    };
+    const std::size_t tile_count = static_cast<std::size_t> (tiles_x) * tiles_z;
+    std::vector<std::uint32_t> tile_start (tile_count + 1, 0);
+    for (const std::vector<ForestCandidate>& stretch : drawn)
+      for (const ForestCandidate& candidate : stretch)
+        ++tile_start[tile_of (candidate) + 1];
+    std::partial_sum (
+      tile_start.begin (), tile_start.end (), tile_start.begin ());
+    const std::size_t candidate_count = tile_start.back ();
+    std::vector<ForestCandidate> candidates (candidate_count);
+    {
+      std::vector<std::uint32_t> cursor (tile_start.begin (),
+                                         tile_start.end () - 1);
+      for (std::vector<ForestCandidate>& stretch : drawn) {
+        for (const ForestCandidate& candidate : stretch)
+          candidates[cursor[tile_of (candidate)]++] = candidate;
+        stretch = {};
+      }
+    }
+    parallel_rows (tiles_z, candidate_count, [&] (std::size_t tile_row) {
+      for (std::size_t tile = tile_row * tiles_x;
+           tile < (tile_row + 1) * tiles_x;
+           ++tile)
+        std::sort (candidates.begin () + tile_start[tile],
+                   candidates.begin () + tile_start[tile + 1],
+                   [] (const ForestCandidate& a, const ForestCandidate& b) {
+                     return a.priority < b.priority ||
+                            (a.priority == b.priority &&
+                             a.identity < b.identity);
+                   });
+    });
+    // Equal priorities fall back on the identity, and a repeated identity
+    // is the same proposal drawn twice, which lands in the same tile; the
+    // layout orders that last tie.
+    const auto precedes = [&] (std::uint32_t a, std::uint32_t b) {
+      const ForestCandidate& first = candidates[a];
+      const ForestCandidate& second = candidates[b];
+      if (first.priority != second.priority)
+        return first.priority < second.priority;
+      if (first.identity != second.identity)
+        return first.identity < second.identity;
+      return a < b;
+    };
+
+    std::vector<std::uint32_t> bin_start (
+      static_cast<std::size_t> (bins_x) * bins_z + 1, 0);
+    for (const ForestCandidate& candidate : candidates) {
+      const auto [bx, bz] = bin_of (candidate);
+      ++bin_start[static_cast<std::size_t> (bz) * bins_x + bx + 1];
+    }
+    std::partial_sum (bin_start.begin (), bin_start.end (), bin_start.begin ());
+    std::vector<std::uint32_t> bin_members (candidate_count);
+    {
+      std::vector<std::uint32_t> cursor (bin_start.begin (),
+                                         bin_start.end () - 1);
+      for (std::uint32_t index = 0; index < candidate_count; ++index) {
+        const auto [bx, bz] = bin_of (candidates[index]);
+        bin_members[cursor[static_cast<std::size_t> (bz) * bins_x + bx]++] =
+          index;
+      }
+    }
+
     const auto wrap = [] (int value, std::uint32_t period) {
       const int extent = static_cast<int> (period);
       value %= extent;
@@ -220,94 +319,132 @@ namespace moppe::game {
     };
     const float exclusion_squared = exclusion * exclusion;
 
-    for (const ForestCandidate& candidate : candidates) {
-      const std::uint32_t bx =
-        std::min (static_cast<std::uint32_t> (candidate.x / bin_x), bins_x - 1);
-      const std::uint32_t bz =
-        std::min (static_cast<std::uint32_t> (candidate.z / bin_z), bins_z - 1);
-      bool separated = true;
-      for (int dz = -reach_z; separated && dz <= reach_z; ++dz)
-        for (int dx = -reach_x; separated && dx <= reach_x; ++dx) {
-          const std::uint32_t nx = wrap (static_cast<int> (bx) + dx, bins_x);
-          const std::uint32_t nz = wrap (static_cast<int> (bz) + dz, bins_z);
-          std::int32_t index =
-            heads[static_cast<std::size_t> (nz) * bins_x + nx];
-          while (index >= 0) {
-            const ForestCandidate& neighbour =
-              accepted[static_cast<std::size_t> (index)];
+    // Priority thinning keeps a candidate exactly when no candidate ahead of
+    // it within the exclusion radius was kept. A candidate is decided once
+    // every such neighbour is, which inside one tile is simply priority
+    // order. Across a border, each round reads the neighbouring tiles as
+    // the previous round left them, and repeats until nothing is left
+    // waiting on its halo. One tile over the whole torus is the serial pass.
+    std::vector<ThinningState> settled (candidate_count,
+                                        ThinningState::undecided);
+    std::vector<ThinningState> current = settled;
+    const auto decide = [&] (std::uint32_t index, std::size_t tile) {
+      const ForestCandidate& candidate = candidates[index];
+      const auto [bx, bz] = bin_of (candidate);
+      bool waiting = false;
+      for (int dz = -reach_z; dz <= reach_z; ++dz)
+        for (int dx = -reach_x; dx <= reach_x; ++dx) {
+          const std::size_t bin =
+            static_cast<std::size_t> (
+              wrap (static_cast<int> (bz) + dz, bins_z)) *
+              bins_x +
+            wrap (static_cast<int> (bx) + dx, bins_x);
+          for (std::uint32_t member = bin_start[bin];
+               member < bin_start[bin + 1];
+               ++member) {
+            const std::uint32_t other = bin_members[member];
+            if (other == index || !precedes (other, index))
+              continue;
+            const ForestCandidate& neighbour = candidates[other];
             const float delta_x =
               periodic_delta (candidate.x - neighbour.x, width_m);
             const float delta_z =
               periodic_delta (candidate.z - neighbour.z, depth_m);
-            if (delta_x * delta_x + delta_z * delta_z < exclusion_squared) {
-              separated = false;
-              break;
-            }
-            index = next[static_cast<std::size_t> (index)];
+            if (delta_x * delta_x + delta_z * delta_z >= exclusion_squared)
+              continue;
+            const bool same_tile =
+              other >= tile_start[tile] && other < tile_start[tile + 1];
+            const ThinningState state =
+              same_tile ? current[other] : settled[other];
+            if (state == ThinningState::accepted)
+              return ThinningState::rejected;
+            waiting |= state == ThinningState::undecided;
           }
         }
-      if (!separated)
-        continue;
-      const std::size_t bin = static_cast<std::size_t> (bz) * bins_x + bx;
-      next.push_back (heads[bin]);
-      heads[bin] = static_cast<std::int32_t> (accepted.size ());
-      accepted.push_back (candidate);
+      return waiting ? ThinningState::undecided : ThinningState::accepted;
+    };
+    std::vector<std::size_t> waiting_by_row (tiles_z);
+    for (;;) {
+      parallel_rows (tiles_z, candidate_count, [&] (std::size_t tile_row) {
+        std::size_t waiting = 0;
+        for (std::size_t tile = tile_row * tiles_x;
+             tile < (tile_row + 1) * tiles_x;
+             ++tile)
+          for (std::uint32_t index = tile_start[tile];
+               index < tile_start[tile + 1];
+               ++index) {
+            if (current[index] != ThinningState::undecided)
+              continue;
+            current[index] = decide (index, tile);
+            waiting += current[index] == ThinningState::undecided;
+          }
+        waiting_by_row[tile_row] = waiting;
+      });
+      settled = current;
+      if (std::ranges::all_of (waiting_by_row,
+                               [] (std::size_t waiting) {
+                                 return waiting == 0;
+                               }))
+        break;
     }
 
-    plan.sites.reserve (accepted.size ());
-    for (const ForestCandidate& candidate : accepted) {
-      const meters_t x = candidate.x * u::m;
-      const meters_t z = candidate.z * u::m;
-      const map::ForestCover cover = candidate.cover * map::forest_cover[one];
-      const terrain::SurfaceElevation elevation = elevation_at (surface, x, z);
-      // A boreal stand: spruce IS the forest. The broadleaf construction
-      // is a placeholder blob that has received none of the conifer's
-      // assembly work, so it stays out of the world until it earns its
-      // place.
-      const ForestAge age = age_from_identity (candidate.identity);
-      plan.sites.push_back ({ .position = forest_position (x, elevation, z),
-                              .normal = normal_at (surface, x, z),
-                              .cover = cover,
-                              .moisture = moisture_at (readings, x, z),
-                              .size = size_for_age (age, candidate.identity),
-                              .seed = candidate.identity,
-                              .form = ForestForm::conifer,
-                              .age = age });
-    }
+    std::vector<std::uint32_t> accepted;
+    for (std::uint32_t index = 0; index < candidate_count; ++index)
+      if (current[index] == ThinningState::accepted)
+        accepted.push_back (index);
+    std::ranges::sort (accepted, precedes);
+
+    ForestPlan plan (ForestPopulation (
+      accepted.size (),
+      seed,
+      spatial_extent_in_metres (Vec3 (width.numerical_value_in (u::m),
+                                      0,
+                                      depth.numerical_value_in (u::m)))));
+    auto& positions = spatial::get<isq::position_vector> (plan);
+    auto& normals = spatial::get<terrain::terrain_normal> (plan);
+    auto& covers = spatial::get<map::forest_cover> (plan);
+    auto& moistures = spatial::get<map::surface_moisture> (plan);
+    auto& sizes = spatial::get<tree_size_factor> (plan);
+    auto& seeds = spatial::get<tree_seed> (plan);
+    auto& forms = spatial::get<tree_form> (plan);
+    auto& ages = spatial::get<tree_age_class> (plan);
+    const std::size_t site_batches =
+      (accepted.size () + forest_sites_per_batch - 1) / forest_sites_per_batch;
+    parallel_rows (site_batches, accepted.size (), [&] (std::size_t batch) {
+      const std::size_t first = batch * forest_sites_per_batch;
+      const std::size_t last =
+        std::min (accepted.size (), first + forest_sites_per_batch);
+      for (std::size_t site = first; site < last; ++site) {
+        const ForestCandidate& candidate = candidates[accepted[site]];
+        const meters_t x = candidate.x * u::m;
+        const meters_t z = candidate.z * u::m;
+        const terrain::SurfaceElevation elevation =
+          elevation_at (surface, x, z);
+        // A boreal stand: spruce IS the forest. The broadleaf construction
+        // is a placeholder blob that has received none of the conifer's
+        // assembly work, so it stays out of the world until it earns its
+        // place.
+        const ForestAge age = age_from_identity (candidate.identity);
+        positions[site] = forest_position (x, elevation, z);
+        normals[site] = normal_at (surface, x, z);
+        covers[site] = candidate.cover * map::forest_cover[one];
+        moistures[site] = moisture_at (readings, x, z);
+        sizes[site] = size_for_age (age, candidate.identity);
+        seeds[site] = candidate.identity * tree_seed[one];
+        forms[site] = forest_form_code (ForestForm::conifer);
+        ages[site] = forest_age_code (age);
+      }
+    });
     return plan;
   }
 
-  void save_forest_plan (const ForestPlan& plan,
-                         std::uint32_t seed,
-                         const std::string& path) {
-    const Vec3 period = extent_value (plan.period);
-    const ForestPlanHeader header {
-      .magic = forest_plan_magic,
-      .version = forest_plan_version,
-      .seed = seed,
-      .period = { period[0], period[1], period[2] },
-      .reserved = 0,
-      .site_count = plan.sites.size (),
-    };
+  void save_forest_plan (const ForestPlan& plan, const std::string& path) {
     std::ofstream output (path, std::ios::binary | std::ios::trunc);
     if (!output)
       throw std::runtime_error ("could not create forest plan: " + path);
-    write_record (output, header);
-    for (const ForestSite& site : plan.sites) {
-      const Vec3 point = position_value (site.position);
-      const Vec3 normal = site.normal.numerical_value_in (one);
-      const ForestSiteRecord record {
-        .position = { point[0], point[1], point[2] },
-        .normal = { normal[0], normal[1], normal[2] },
-        .cover = site.cover.numerical_value_in (one),
-        .moisture = site.moisture.numerical_value_in (one),
-        .size = site.size.numerical_value_in (one),
-        .seed = site.seed,
-        .form = static_cast<std::uint32_t> (site.form),
-        .age = static_cast<std::uint32_t> (site.age),
-      };
-      write_record (output, record);
-    }
+    spatial::write_bundle (output, plan);
+    if (!output)
+      throw std::runtime_error ("could not write forest plan: " + path);
   }
 
   std::optional<ForestPlan>
@@ -315,42 +452,21 @@ namespace moppe::game {
                         std::uint32_t seed,
                         const spatial_extent_t& expected_period) {
     std::ifstream input (path, std::ios::binary);
-    ForestPlanHeader header {};
-    input.read (reinterpret_cast<char*> (&header), sizeof (header));
-    if (!input || header.magic != forest_plan_magic ||
-        header.version != forest_plan_version || header.seed != seed ||
-        !same_extent (header.period, expected_period) ||
-        header.site_count > 10'000'000)
+    if (!input)
       return std::nullopt;
-    const std::uintmax_t expected_bytes =
-      sizeof (header) + header.site_count * sizeof (ForestSiteRecord);
-    std::error_code error;
-    if (std::filesystem::file_size (path, error) != expected_bytes || error)
+    std::optional<ForestPlan> plan = spatial::read_bundle<ForestPlan> (input);
+    if (!plan || plan->domain ().seed () != seed ||
+        !(plan->domain ().period () == expected_period))
+      return std::nullopt;
+    const auto known_form = [] (TreeFormCode code) {
+      return code <= forest_form_code (ForestForm::conifer);
+    };
+    const auto known_age = [] (TreeAgeCode code) {
+      return code <= forest_age_code (ForestAge::ancient);
+    };
+    if (!std::ranges::all_of (spatial::get<tree_form> (*plan), known_form) ||
+        !std::ranges::all_of (spatial::get<tree_age_class> (*plan), known_age))
       return std::nullopt;
-
-    ForestPlan plan;
-    plan.period = expected_period;
-    plan.sites.reserve (static_cast<std::size_t> (header.site_count));
-    for (std::uint64_t i = 0; i < header.site_count; ++i) {
-      ForestSiteRecord record {};
-      input.read (reinterpret_cast<char*> (&record), sizeof (record));
-      if (!input ||
-          record.form > static_cast<std::uint32_t> (ForestForm::conifer) ||
-          record.age > static_cast<std::uint32_t> (ForestAge::ancient))
-        return std::nullopt;
-      plan.sites.push_back (
-        { .position = position (
-            Vec3 (record.position[0], record.position[1], record.position[2])),
-          .normal =
-            Vec3 (record.normal[0], record.normal[1], record.normal[2]) *
-            terrain::terrain_normal[one],
-          .cover = record.cover * map::forest_cover[one],
-          .moisture = record.moisture * map::surface_moisture[one],
-          .size = record.size * tree_size_factor[one],
-          .seed = record.seed,
-          .form = static_cast<ForestForm> (record.form),
-          .age = static_cast<ForestAge> (record.age) });
-    }
     return plan;
   }
 }
@@ -4,10 +4,11 @@
 #include <moppe/game/foliage_kind.hh>
 #include <moppe/map/surface.hh>
 
+#include <cstddef>
 #include <cstdint>
 #include <optional>
+#include <stdexcept>
 #include <string>
-#include <vector>
 
 namespace moppe::game {
   using ForestForm = FoliageKind;
@@ -17,37 +18,125 @@ namespace moppe::game {
 
   enum class ForestAge : std::uint8_t { sapling, young, mature, ancient };
 
-  struct ForestSite {
-    position_t position {};
-    terrain::TerrainNormal normal {};
-    map::ForestCover cover {};
-    map::SurfaceMoisture moisture {};
-    TreeSizeFactor size = 1.0f * tree_size_factor[mp_units::one];
-    std::uint32_t seed = 0;
-    ForestForm form = ForestForm::broadleaf;
-    ForestAge age = ForestAge::mature;
-  };
+  using TreeSeed = mp_units::quantity<tree_seed[mp_units::one], std::uint32_t>;
+  using TreeFormCode =
+    mp_units::quantity<tree_form[mp_units::one], std::uint8_t>;
+  using TreeAgeCode =
+    mp_units::quantity<tree_age_class[mp_units::one], std::uint8_t>;
+
+  struct ForestSiteIdTag;
+  using ForestSiteId = terrain::Identifier<ForestSiteIdTag>;
+
+  // The individuals of one planted world, numbered densely in planting
+  // order. The seed that drew them and the torus they stand on are part of
+  // the population's identity, so a stored plan says which world it is for.
+  class ForestPopulation {
+  public:
+    using index_type = ForestSiteId;
+
+    ForestPopulation () = default;
+    ForestPopulation (std::size_t size,
+                      std::uint32_t seed,
+                      const spatial_extent_t& period) noexcept
+        : m_size (size), m_seed (seed), m_period (period) {}
+
+    std::size_t size () const noexcept {
+      return m_size;
+    }
+
+    std::uint32_t seed () const noexcept {
+      return m_seed;
+    }
+
+    const spatial_extent_t& period () const noexcept {
+      return m_period;
+    }
+
+    bool contains (ForestSiteId id) const noexcept {
+      return id.value < m_size;
+    }
+
+    std::size_t offset (ForestSiteId id) const {
+      if (!contains (id))
+        throw std::out_of_range ("forest site outside population");
+      return id.value;
+    }
 
-  struct ForestPlan {
-    std::vector<ForestSite> sites;
-    spatial_extent_t period {};
+    ForestSiteId index (std::size_t offset) const {
+      if (offset >= m_size)
+        throw std::out_of_range ("forest offset outside population");
+      return ForestSiteId { static_cast<std::uint32_t> (offset) };
+    }
+
+    friend bool operator== (const ForestPopulation&,
+                            const ForestPopulation&) = default;
+
+  private:
+    std::size_t m_size = 0;
+    std::uint32_t m_seed = 0;
+    spatial_extent_t m_period {};
   };
 
+  static_assert (spatial::FiniteDomain<ForestPopulation>);
+
+  // One column per attribute, so a pass over hundreds of thousands of trees
+  // streams only what it reads: culling touches positions alone, and the
+  // identity columns are a byte or four a tree.
+  using ForestPlan = spatial::Bundle<ForestPopulation,
+                                     position_t,
+                                     terrain::TerrainNormal,
+                                     map::ForestCover,
+                                     map::SurfaceMoisture,
+                                     TreeSizeFactor,
+                                     TreeSeed,
+                                     TreeFormCode,
+                                     TreeAgeCode>;
+
+  inline TreeFormCode forest_form_code (ForestForm form) {
+    return static_cast<std::uint8_t> (form) * tree_form[mp_units::one];
+  }
+
+  inline ForestForm forest_form (TreeFormCode code) {
+    return static_cast<ForestForm> (code.numerical_value_in (mp_units::one));
+  }
+
+  inline TreeAgeCode forest_age_code (ForestAge age) {
+    return static_cast<std::uint8_t> (age) * tree_age_class[mp_units::one];
+  }
+
+  inline ForestAge forest_age (TreeAgeCode code) {
+    return static_cast<ForestAge> (code.numerical_value_in (mp_units::one));
+  }
+
   // Convert the continuous canopy field into a deterministic hard-core point
   // process. A uniform habitat-weighted proposal stream is priority-thinned
   // on the world torus, so revisiting an area preserves every identity and no
-  // planting grid exists to leak into the rendered population.
+  // planting grid exists to leak into the rendered population. Proposals,
+  // thinning and sampling all run tile-parallel; the plan is the same on any
+  // number of threads.
   [[nodiscard]] ForestPlan
   plan_global_forest (const map::SurfaceGeometry& surface,
                       const map::SurfaceReadings& readings,
                       std::uint32_t seed,
                       meters_t spacing = 5.0f * u::m);
 
+  namespace detail {
+    // The planner thinning tiles of an explicit side, in exclusion bins. The
+    // plan does not depend on it: one tile over the whole torus is the
+    // serial pass, and every tiling gives that same plan.
+    [[nodiscard]] ForestPlan
+    plan_global_forest (const map::SurfaceGeometry& surface,
+                        const map::SurfaceReadings& readings,
+                        std::uint32_t seed,
+                        meters_t spacing,
+                        std::uint32_t tile_bins);
+  }
+
   // The plan is renderer-independent and expensive to derive over a large
-  // surface, so finished worlds persist it beside their typed fields.
-  void save_forest_plan (const ForestPlan& plan,
-                         std::uint32_t seed,
-                         const std::string& path);
+  // surface, so finished worlds persist it beside their typed fields, as an
+  // Arrow bundle like them. A load answers nothing for a plan drawn with
+  // another seed or over another torus.
+  void save_forest_plan (const ForestPlan& plan, const std::string& path);
   [[nodiscard]] std::optional<ForestPlan>
   try_load_forest_plan (const std::string& path,
                         std::uint32_t seed,
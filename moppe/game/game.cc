@@ -28,6 +28,7 @@
 #include <moppe/game/launch_options.hh>
 #include <moppe/game/moppe_game.hh>
 #include <moppe/game/seed_memory.hh>
+#include <moppe/game/session_replay.hh>
 #include <moppe/game/simulation_clock.hh>
 #include <moppe/game/stars.hh>
 #include <moppe/game/surface_presentation.hh>
@@ -88,7 +89,10 @@ namespace moppe {
       MoppeGame (const LaunchOptions& options, terrain::WorldRecipe recipe)
           : m_params (bind_world_params (options.world, recipe)),
             m_recipe (std::move (recipe)),
-            m_loading (this->recipe (), options.world_cache),
+            m_loading (this->recipe (),
+                       options.world_cache,
+                       options.world_preview &&
+                         !::getenv ("MOPPE_REGENERATE_ONCE")),
             m_graphics (options.graphics), m_spawn_position (position_value (
                                              this->world ().spawn_position ())),
             m_renderer (0), m_screenshot_path (options.screenshot_path),
@@ -103,6 +107,13 @@ namespace moppe {
             m_benchmark->measured_frames,
             m_benchmark->partition,
           });
+        if (!options.input_tape_path.empty ()) {
+          m_input_tape.open (options.input_tape_path);
+          if (!m_input_tape)
+            throw std::runtime_error ("cannot write input tape " +
+                                      options.input_tape_path);
+          write_input_tape_header (m_input_tape);
+        }
       }
 
       // -- lifecycle ---------------------------------------------------
@@ -206,43 +217,6 @@ namespace moppe {
         return generated_world ().trails ();
       }
 
-      Vec3 trail_cell_position (terrain::CellIndex cell) const {
-        if (cell == terrain::no_cell)
-          return {};
-        const terrain::TerrainDomain& grid = trail_network ().domain;
-        const std::size_t width = grid.width ();
-        const float x = (cell.value % width) *
-                        (grid.spacing_x ()).numerical_value_in (moppe::u::m);
-        const float z = (cell.value / width) *
-                        (grid.spacing_z ()).numerical_value_in (moppe::u::m);
-        return Vec3 (x,
-                     terrain::surface_elevation_value (
-                       spatial::sample<terrain::surface_elevation> (
-                         surface (), moppe::position (Vec3 (x, 0.0f, z)))),
-                     z);
-      }
-
-      Vec3 trail_alignment_position (
-        const terrain::TrailAlignmentPoint& point) const {
-        return Vec3 (
-          point.x_m,
-          terrain::surface_elevation_value (
-            spatial::sample<terrain::surface_elevation> (
-              surface (), moppe::position (Vec3 (point.x_m, 0.0f, point.z_m)))),
-          point.z_m);
-      }
-
-      Vec3 trail_direction_from_home () const {
-        if (trail_network ().alignment.points.size () < 2)
-          return Vec3 (0, 0, 1);
-        Vec3 direction =
-          trail_alignment_position (trail_network ().alignment.points[1]) -
-          trail_alignment_position (trail_network ().alignment.points[0]);
-        direction[1] = 0.0f;
-        return length2 (direction) > 1e-5f ? normalized (direction)
-                                           : Vec3 (0, 0, 1);
-      }
-
       void draw_home_base_marker (render::DrawList& dl) const {
         const Vec3 base = m_home_base_position;
         render::DrawState marker_state;
@@ -257,7 +231,7 @@ namespace moppe {
         dl.cube (1.0f);
         dl.pop ();
 
-        const Vec3 along = trail_direction_from_home ();
+        const Vec3 along = m_home_heading;
         Vec3 side = cross (Vec3 (0, 1, 0), along);
         if (length2 (side) < 1e-5f)
           side = Vec3 (1, 0, 0);
@@ -422,6 +396,8 @@ namespace moppe {
         m_params = m_generated_world->params ();
         m_recipe = m_generated_world->recipe ();
         m_session = std::make_unique<GameSession> (world (), surface ());
+        m_session->follow_water (surface (),
+                                 m_generated_world->water_surface ());
         retired_session.reset ();
         retired_world.reset ();
       }
@@ -459,22 +435,21 @@ namespace moppe {
         }
       }
 
+      // Home base sits at the start of the world's own trail, and the spawn
+      // point a few metres back along it.
+      void locate_home_base () {
+        const HomeSpawn home = locate_home_spawn (surface (), trail_network ());
+        m_home_base_position = home.home_base;
+        m_home_heading = home.heading;
+        m_spawn_position = home.position;
+      }
+
       void place_stars_and_player () {
         MOPPE_PROFILE_ZONE ("startup.place_stars_and_player");
         session ().stars ().generate (surface (), world (), 80);
-        m_home_base_position =
-          trail_cell_position (trail_network ().plan.home_base);
-        m_spawn_position =
-          m_home_base_position - trail_direction_from_home () * 8.0f;
-        m_spawn_position[1] =
-          terrain::surface_elevation_value (
-            spatial::sample<terrain::surface_elevation> (
-              surface (),
-              moppe::position (
-                Vec3 (m_spawn_position[0], 0.0f, m_spawn_position[2])))) +
-          1.2f;
+        locate_home_base ();
         session ().bike ().reset (m_spawn_position);
-        session ().bike ().set_heading (trail_direction_from_home ());
+        session ().bike ().set_heading (m_home_heading);
 
         const char* demo = ::getenv ("MOPPE_DEMO");
         if (!demo || std::string_view (demo) != "forest")
@@ -683,6 +658,51 @@ namespace moppe {
         }
       }
 
+      // The ground may change under the rider only where nobody can feel
+      // it: on the ground, in play, and outside the opening journey.
+      bool can_swap_world () {
+        if (m_cinematic.active () || logic ().m_game_over)
+          return false;
+        switch (logic ().m_mode) {
+        case M_FOOT:
+          return session ().walker ().state ().grounded;
+        case M_GLIDER:
+          return false;
+        default:
+          return !session ().active_vehicle ().airborne ();
+        }
+      }
+
+      // The preview being ridden gives way to the full world as soon as it
+      // is finished and the swap is safe. The rider, camera and stars keep
+      // their places and their clearance above the new ground.
+      void upgrade_preview_world (render::Renderer& r) {
+        if (!can_swap_world ())
+          return;
+        std::unique_ptr<GeneratedWorld> completed =
+          m_loading.take_completed_world ();
+        if (!completed)
+          return;
+        MOPPE_PROFILE_ZONE ("MoppeGame::upgrade_preview_world");
+        const GameState carried = reproject_game_state (
+          session ().state (), surface (), completed->surface ());
+        activate_completed_world (std::move (completed));
+        prepare_world_water ();
+        prepare_world_surface ();
+        session ().stars ().generate (surface (), world (), 80);
+        session ().restore (carried);
+        locate_home_base ();
+        grow_global_forest ();
+        r.clear_terrain_overlay ();
+        upload_world_terrain (r);
+        if (m_graphics.terrain_shadows)
+          cast_world_shadows (r);
+        r.reset_temporal_state ();
+        m_riding_preview = false;
+        std::cerr << "moppe: world preview replaced at resolution "
+                  << recipe ().resolution () << std::endl;
+      }
+
       void upload_world_terrain (render::Renderer& r) {
         MOPPE_PROFILE_ZONE ("startup.upload_world_terrain");
         m_terrain.setup (r, surface (), world (), m_graphics);
@@ -839,13 +859,10 @@ namespace moppe {
         // Screenshot autopilot for headless verification: rides in a
         // lazy arc with periodic boost-assisted leaps.
         static const bool demo = ::getenv ("MOPPE_DEMO") != 0;
-        if (demo && !m_water_inspection) {
-          input = {
-            .turn = 0.35f * std::sin (total_time * 0.25f),
-            .drive = 1.0f,
-            .boost = std::fmod (total_time, 11.0f) < 1.35f ? 1.0f : 0.0f,
-          };
-        }
+        if (demo && !m_water_inspection)
+          input = demo_autopilot_input (logic ().m_total_time);
+        if (m_input_tape.is_open ())
+          write_input_frame (m_input_tape, input);
 
         const GameSessionAdvanceResult advance = advance_game_session (
           world (), surface (), m_obstacles, session (), input, seconds (dt));
@@ -1170,6 +1187,8 @@ namespace moppe {
           render_loading (r);
           return;
         }
+        if (m_riding_preview)
+          upgrade_preview_world (r);
         if (logic ().m_game_over) {
           render_game_over (r);
           return;
@@ -1318,9 +1337,15 @@ namespace moppe {
 
         // Take the finished world now, but run the heavy finishing work
         // after this frame is submitted, so the panel first shows what is
-        // about to happen.
+        // about to happen. A preview is taken the same way and ridden until
+        // the full world replaces it.
         std::unique_ptr<GeneratedWorld> completed =
           m_loading.take_completed_world ();
+        const bool preview = !completed;
+        if (preview)
+          completed = m_loading.take_preview_world ();
+        else
+          m_loading.take_preview_world ();
         if (completed)
           m_loading.report ("Finishing the world",
                             "Growing forests and planning the first journey");
@@ -1469,8 +1494,10 @@ namespace moppe {
 
         // The frame announcing the finish is on its way to the display;
         // now do the finishing work.
-        if (completed)
+        if (completed) {
+          m_riding_preview = preview;
           finish_loading (r, std::move (completed));
+        }
       }
       void render_game_over (render::Renderer& r) {
         render::FrameParams fp;
@@ -1540,7 +1567,7 @@ namespace moppe {
           return;
         }
 
-        if (k == Key::N && down && m_ready) {
+        if (k == Key::N && down && m_ready && !m_loading.building ()) {
           regenerate_world ();
           return;
         }
@@ -1800,7 +1827,8 @@ namespace moppe {
           recipe ().evolution ().channel_initiation_area,
           recipe ().evolution ().fluvial_transport.concentration_at_unit_slope,
           recipe ().evolution ().critical_hillslope_gradient,
-          recipe ().evolution ().maximum_hillslope_diffusivity_multiplier);
+          recipe ().evolution ().maximum_hillslope_diffusivity_multiplier,
+          recipe ().evolution ().coarse_to_fine);
         logic ().m_mode = M_BIKE;
         logic ().m_car_exists = false;
         logic ().m_game_over = false;
@@ -1851,6 +1879,7 @@ namespace moppe {
       GraphicsSettings m_graphics;
       Vec3 m_spawn_position;
       Vec3 m_home_base_position;
+      Vec3 m_home_heading { 0, 0, 1 };
       bool m_skip_cinematic_requested = false;
       CinematicFlightPlan m_cinematic_plan;
       CinematicFlight m_cinematic;
@@ -1868,6 +1897,8 @@ namespace moppe {
 
       render::Renderer* m_renderer;
       bool m_automated_regeneration_done = false;
+      // The session rides a preview until the full world replaces it.
+      bool m_riding_preview = false;
       std::string m_screenshot_path;
       bool m_snapshot_requested = false;
       std::string m_snapshot_directory;
@@ -1894,6 +1925,8 @@ namespace moppe {
       bool m_benchmark_epoch_pending = false;
       bool m_benchmark_submitted = false;
       bool m_benchmark_results_written = false;
+      // Every fixed step's input, for game-session-benchmark to replay.
+      std::ofstream m_input_tape;
 
       render::DrawList m_world_dl;
       render::DrawList m_hud_dl;
@@ -1,4 +1,5 @@
 #include <moppe/game/game_session.hh>
+#include <moppe/game/simulation_clock.hh>
 
 #include <algorithm>
 #include <cmath>
@@ -197,6 +198,16 @@ namespace moppe::game {
                900 * u::kg),
         m_glider (surface), m_camera (18 * u::deg, 6.5f * u::m) {}
 
+  void GameSession::follow_water (const map::SurfaceGeometry& surface,
+                                  const terrain::WaterSheets& water) {
+    m_rider_water.reset ();
+    m_rider_water.emplace (
+      water,
+      surface,
+      moppe::position (subject_position ()),
+      seconds (static_cast<float> (FIXED_SIMULATION_STEP_SECONDS)));
+  }
+
   mov::Vehicle& GameSession::active_vehicle () noexcept {
     return m_logic.m_mode == M_CAR ? m_car : m_bike;
   }
@@ -256,6 +267,17 @@ namespace moppe::game {
              m_stars.state (),  m_dust.state () };
   }
 
+  void GameSession::capture (State& state) const {
+    state.logic = m_logic;
+    state.vehicle = m_bike.state ();
+    state.car = m_car.state ();
+    state.glider = m_glider.state ();
+    state.walker = m_walker.state ();
+    state.camera = m_camera.state ();
+    state.stars = m_stars.state ();
+    m_dust.capture (state.dust);
+  }
+
   void GameSession::restore (const State& state) {
     m_logic = state.logic;
     m_bike.restore (state.vehicle);
@@ -267,6 +289,60 @@ namespace moppe::game {
     m_dust.restore (state.dust);
   }
 
+  namespace {
+    class GroundShift {
+    public:
+      GroundShift (const map::SurfaceGeometry& from,
+                   const map::SurfaceGeometry& to)
+          : m_from (from), m_to (to) {}
+
+      float at (const Vec3& point) const {
+        const position_t ground = position (Vec3 (point[0], 0.0f, point[2]));
+        return terrain::surface_elevation_value (
+                 spatial::sample<terrain::surface_elevation> (m_to, ground)) -
+               terrain::surface_elevation_value (
+                 spatial::sample<terrain::surface_elevation> (m_from, ground));
+      }
+
+      void apply (Vec3& point) const {
+        point[1] += at (point);
+      }
+
+      void apply (position_t& point) const {
+        Vec3 value = position_value (point);
+        apply (value);
+        point = position (value);
+      }
+
+      void apply (mov::Vehicle::State& vehicle) const {
+        const float shift = at (position_value (vehicle.position));
+        apply (vehicle.position);
+        vehicle.fall_top += shift * u::m;
+      }
+
+    private:
+      const map::SurfaceGeometry& m_from;
+      const map::SurfaceGeometry& m_to;
+    };
+  }
+
+  GameState reproject_game_state (GameState state,
+                                  const map::SurfaceGeometry& from,
+                                  const map::SurfaceGeometry& to) {
+    const GroundShift shift (from, to);
+    shift.apply (state.logic.m_fp_eye);
+    shift.apply (state.vehicle);
+    shift.apply (state.car);
+    shift.apply (state.glider.position);
+    shift.apply (state.walker.position);
+    shift.apply (state.camera.position);
+    shift.apply (state.camera.target);
+    for (std::size_t star = 0; star < state.stars.count; ++star)
+      shift.apply (state.stars.stars[star].position);
+    shift.apply (state.stars.last_position);
+    return state;
+  }
+
   GameSessionAdvanceResult
   advance_game_session (const WorldParams& world,
                         const map::SurfaceGeometry& surface,
@@ -598,6 +674,17 @@ namespace moppe::game {
     if (driving)
       logic.m_odometer += length (vehicle.velocity ()) * elapsed;
 
+    // The water around the rider takes its wake from the vehicle being
+    // ridden; a rider on foot or in the air only carries the window along.
+    if (RiderWater* water = session.rider_water ()) {
+      mov::Vehicle::State rider = vehicle.state ();
+      if (!driving) {
+        rider.position = moppe::position (vehicle_position);
+        rider.velocity = velocity (Vec3 ());
+      }
+      water->advance (rider);
+    }
+
     session.dust ().update (dt);
     logic.m_shake_time += elapsed;
     logic.m_shake *= decay (7.0f / u::s, elapsed * u::s);
@@ -3,9 +3,11 @@
 
 #include <moppe/game/game_state.hh>
 #include <moppe/game/input_frame.hh>
+#include <moppe/game/rider_water.hh>
 #include <moppe/game/world.hh>
 #include <moppe/map/surface.hh>
 
+#include <optional>
 #include <vector>
 
 namespace moppe::game {
@@ -86,6 +88,19 @@ namespace moppe::game {
       return m_dust;
     }
 
+    // Raises live water around the rider over the world's water sheets,
+    // which must outlive the session as the surface does; a session has none
+    // until then. The waves are not part of State, which stays small enough
+    // to record at every step, so restoring a state leaves them as they are.
+    void follow_water (const map::SurfaceGeometry& surface,
+                       const terrain::WaterSheets& water);
+    RiderWater* rider_water () noexcept {
+      return m_rider_water ? &*m_rider_water : nullptr;
+    }
+    const RiderWater* rider_water () const noexcept {
+      return m_rider_water ? &*m_rider_water : nullptr;
+    }
+
     mov::Vehicle& active_vehicle () noexcept;
     const mov::Vehicle& active_vehicle () const noexcept;
     Vec3 subject_position () const;
@@ -96,6 +111,9 @@ namespace moppe::game {
     void clear_controls ();
 
     State state () const;
+    // Fills `state` in place. A state reused this way allocates only when
+    // the dust outgrows every earlier capture into it.
+    void capture (State& state) const;
     void restore (const State& state);
 
   private:
@@ -107,8 +125,17 @@ namespace moppe::game {
     ChaseCamera m_camera;
     Stars m_stars;
     Dust m_dust;
+    std::optional<RiderWater> m_rider_water;
   };
 
+  // A state carried onto another surface over the same extent, as when a
+  // preview world is replaced by the full one. Every height keeps its
+  // clearance above the ground below it, so a rider on one surface is on the
+  // other at the same place, neither buried nor dropped.
+  GameState reproject_game_state (GameState state,
+                                  const map::SurfaceGeometry& from,
+                                  const map::SurfaceGeometry& to);
+
   GameSessionAdvanceResult
   advance_game_session (const WorldParams& world,
                         const map::SurfaceGeometry& surface,
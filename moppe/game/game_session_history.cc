@@ -0,0 +1,239 @@
+#include <moppe/game/game_session_history.hh>
+
+#include <moppe/memory.hh>
+
+#include <stdexcept>
+
+namespace moppe::game {
+  namespace {
+    // Changes kept per snapshot in ordinary riding: the stars drawn
+    // towards the rider, and the dust born at a step -- drift dirt, roost,
+    // exhaust and embers at once.
+    constexpr std::size_t typical_star_changes = 8;
+    constexpr std::size_t typical_dust_births = 4;
+
+    bool same_star (const Stars::StarState& a, const Stars::StarState& b) {
+      return a.position[0] == b.position[0] && a.position[1] == b.position[1] &&
+             a.position[2] == b.position[2] && a.phase == b.phase &&
+             a.respawn_at == b.respawn_at;
+    }
+  }
+
+  GameSessionHistory::GameSessionHistory (std::size_t snapshots,
+                                          std::size_t keyframe_interval)
+      : m_keyframe_interval (keyframe_interval) {
+    if (snapshots == 0 || keyframe_interval == 0)
+      throw std::invalid_argument (
+        "a session history needs room for a snapshot and a keyframe");
+    // Forgetting the oldest keyframe forgets the snapshots built on it, up
+    // to one interval; the spare slots keep the promised span held.
+    m_slots.resize (snapshots + keyframe_interval);
+    const std::size_t keyframes = m_slots.size () / keyframe_interval + 2;
+    m_star_changes.values.resize (keyframes * Stars::MAX_STARS +
+                                  m_slots.size () * typical_star_changes);
+    // The oldest snapshot's live dust was born before it, and the first
+    // snapshot records all of its dust at once.
+    m_emissions.values.resize (m_slots.size () * typical_dust_births +
+                               Dust::MAX_EMISSIONS);
+    m_scratch.dust.emissions.reserve (Dust::MAX_EMISSIONS);
+  }
+
+  void GameSessionHistory::clear () noexcept {
+    m_oldest = m_next;
+    m_star_changes.begin = m_star_changes.end;
+    m_emissions.begin = m_emissions.end;
+  }
+
+  std::uint64_t
+  GameSessionHistory::sequence_back (std::size_t steps_back) const {
+    if (steps_back >= size ())
+      throw std::out_of_range ("the session history is not that long");
+    return m_next - 1 - steps_back;
+  }
+
+  double GameSessionHistory::total_time (std::size_t steps_back) const {
+    return slot (sequence_back (steps_back)).logic.m_total_time;
+  }
+
+  std::size_t GameSessionHistory::steps_back_for (seconds_t age) const {
+    if (empty ())
+      throw std::out_of_range ("the session history is empty");
+    const double newest = total_time (0);
+    const double wanted = static_cast<double> (seconds_value (age));
+    // The clock only runs forwards through a history, so the first snapshot
+    // old enough is found by bisection.
+    std::size_t young = 0;
+    std::size_t old = size () - 1;
+    if (newest - total_time (old) < wanted)
+      return old;
+    while (old - young > 1) {
+      const std::size_t middle = young + (old - young) / 2;
+      if (newest - total_time (middle) >= wanted)
+        old = middle;
+      else
+        young = middle;
+    }
+    return newest - total_time (young) >= wanted ? young : old;
+  }
+
+  // How many of the live dust emissions, from the first, the ring already
+  // holds from the newest snapshot, with `first` set to where the first of
+  // them is. Any others are newer births. If the dust has moved other than
+  // by emitting and expiring since that snapshot, none are held, and it is
+  // all recorded afresh.
+  std::size_t GameSessionHistory::held_emissions (std::uint64_t& first) const {
+    const Dust::State& dust = m_scratch.dust;
+    const Snapshot& newest = slot (m_next - 1);
+    std::size_t held = 0;
+    for (std::uint64_t position = newest.dust_begin;
+         position < m_emissions.end;
+         ++position) {
+      const Dust::Emission& emission = m_emissions[position];
+      if (Dust::expired (emission, dust.logical_time))
+        continue;
+      if (held == dust.emissions.size () ||
+          emission.id != dust.emissions[held].id)
+        return 0;
+      if (held == 0)
+        first = position;
+      ++held;
+    }
+    if (held < dust.emissions.size () &&
+        dust.emissions[held].id < newest.dust_next_id)
+      return 0;
+    return held;
+  }
+
+  // Forgets the oldest keyframe and every snapshot built on it.
+  void GameSessionHistory::forget_oldest () {
+    ++m_oldest;
+    while (m_oldest < m_next && slot (m_oldest).keyframe != m_oldest)
+      ++m_oldest;
+    if (empty ()) {
+      m_star_changes.begin = m_star_changes.end;
+      m_emissions.begin = m_emissions.end;
+    } else {
+      m_star_changes.begin = slot (m_oldest).stars_begin;
+      m_emissions.begin = slot (m_oldest).dust_begin;
+    }
+  }
+
+  void GameSessionHistory::record (const GameSession& session) {
+    session.capture (m_scratch);
+    const Stars::State& stars = m_scratch.stars;
+
+    const auto changed_stars = [&] {
+      std::size_t changed = 0;
+      for (std::size_t star = 0; star < stars.count; ++star)
+        changed += !same_star (stars.stars[star], m_previous_stars.stars[star]);
+      return changed;
+    };
+    bool keyframe = empty () || stars.count != m_previous_stars.count ||
+                    m_next - slot (m_next - 1).keyframe >= m_keyframe_interval;
+    std::size_t star_changes = keyframe ? stars.count : changed_stars ();
+    const std::vector<Dust::Emission>& emissions = m_scratch.dust.emissions;
+    std::uint64_t dust_begin = m_emissions.end;
+    std::size_t held = empty () ? 0 : held_emissions (dust_begin);
+    if (held == 0)
+      dust_begin = m_emissions.end;
+    while (!empty () && (size () == m_slots.size () ||
+                         m_star_changes.free () < star_changes ||
+                         m_emissions.free () < emissions.size () - held)) {
+      forget_oldest ();
+      if (empty ()) {
+        keyframe = true;
+        star_changes = stars.count;
+        held = 0;
+        dust_begin = m_emissions.end;
+      }
+    }
+
+    Snapshot& snapshot = slot (m_next);
+    snapshot.keyframe = keyframe ? m_next : slot (m_next - 1).keyframe;
+    snapshot.logic = m_scratch.logic;
+    snapshot.vehicle = m_scratch.vehicle;
+    snapshot.car = m_scratch.car;
+    snapshot.glider = m_scratch.glider;
+    snapshot.walker = m_scratch.walker;
+    snapshot.camera = m_scratch.camera;
+    snapshot.star_count = stars.count;
+    snapshot.stars_collected = stars.collected;
+    snapshot.stars_last_position = stars.last_position;
+    snapshot.stars_clock = stars.clock;
+    snapshot.dust_next_id = m_scratch.dust.next_id;
+    snapshot.dust_logical_time = m_scratch.dust.logical_time;
+
+    snapshot.stars_begin = m_star_changes.end;
+    for (std::size_t star = 0; star < stars.count; ++star)
+      if (keyframe ||
+          !same_star (stars.stars[star], m_previous_stars.stars[star]))
+        m_star_changes.push (
+          { static_cast<std::uint16_t> (star), stars.stars[star] });
+    snapshot.stars_end = m_star_changes.end;
+
+    snapshot.dust_begin = dust_begin;
+    for (std::size_t emission = held; emission < emissions.size (); ++emission)
+      m_emissions.push (emissions[emission]);
+    snapshot.dust_end = m_emissions.end;
+
+    m_previous_stars = stars;
+    ++m_next;
+  }
+
+  // Assembles the snapshot's whole state in the scratch state.
+  void GameSessionHistory::rebuild (std::uint64_t sequence) {
+    const Snapshot& snapshot = slot (sequence);
+    m_scratch.logic = snapshot.logic;
+    m_scratch.vehicle = snapshot.vehicle;
+    m_scratch.car = snapshot.car;
+    m_scratch.glider = snapshot.glider;
+    m_scratch.walker = snapshot.walker;
+    m_scratch.camera = snapshot.camera;
+
+    Stars::State& stars = m_scratch.stars;
+    stars.count = snapshot.star_count;
+    stars.collected = snapshot.stars_collected;
+    stars.last_position = snapshot.stars_last_position;
+    stars.clock = snapshot.stars_clock;
+    for (std::uint64_t step = snapshot.keyframe; step <= sequence; ++step)
+      for (std::uint64_t change = slot (step).stars_begin;
+           change < slot (step).stars_end;
+           ++change)
+        stars.stars[m_star_changes[change].index] =
+          m_star_changes[change].state;
+
+    Dust::State& dust = m_scratch.dust;
+    dust.emissions.clear ();
+    for (std::uint64_t position = snapshot.dust_begin;
+         position < snapshot.dust_end;
+         ++position)
+      if (!Dust::expired (m_emissions[position], snapshot.dust_logical_time))
+        dust.emissions.push_back (m_emissions[position]);
+    dust.next_id = snapshot.dust_next_id;
+    dust.logical_time = snapshot.dust_logical_time;
+  }
+
+  void GameSessionHistory::restore (GameSession& session,
+                                    std::size_t steps_back) {
+    rebuild (sequence_back (steps_back));
+    session.restore (m_scratch);
+  }
+
+  void GameSessionHistory::rewind (GameSession& session,
+                                   std::size_t steps_back) {
+    const std::uint64_t sequence = sequence_back (steps_back);
+    rebuild (sequence);
+    session.restore (m_scratch);
+    m_next = sequence + 1;
+    m_star_changes.end = slot (sequence).stars_end;
+    m_emissions.end = slot (sequence).dust_end;
+    m_previous_stars = m_scratch.stars;
+  }
+
+  std::size_t GameSessionHistory::owned_bytes () const {
+    return memory::owned_bytes (m_slots) +
+           memory::owned_bytes (m_star_changes.values) +
+           memory::owned_bytes (m_emissions.values) +
+           memory::owned_bytes (m_scratch.dust.emissions);
+  }
+}
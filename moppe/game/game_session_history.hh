@@ -0,0 +1,150 @@
+#ifndef MOPPE_GAME_GAME_SESSION_HISTORY_HH
+#define MOPPE_GAME_GAME_SESSION_HISTORY_HH
+
+#include <moppe/game/game_session.hh>
+#include <moppe/game/game_state.hh>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// The last few seconds of a session, one snapshot per simulation step, for
+// instant retry, replay and rollback. Recording a GameState every 120 Hz step
+// would copy the whole star field and allocate a dust log each time; the
+// history instead keeps every snapshot in storage it allocates once, up
+// front:
+//
+//   - a ring of snapshot slots holding the small per-step values;
+//   - a ring of star changes: every keyframe_interval-th snapshot keeps the
+//     whole star field, the rest only the stars that differ from the step
+//     before. A collected star holds its respawn time, so only the stars
+//     drawn towards the rider change from step to step;
+//   - a ring of dust emissions, each stored once, as it is born. An
+//     emission never changes afterwards, so a snapshot keeps only the span
+//     of the ring that may still be alive and the dust clock that says
+//     which of it is.
+//
+// Restoring a snapshot replays at most one keyframe interval of star
+// changes, so it costs the same however long the history is. The rings are
+// sized for ordinary riding, drifting and roosting included; a burst
+// beyond them drops the oldest snapshots rather than allocating.
+
+namespace moppe::game {
+  class GameSessionHistory {
+  public:
+    // Holds at least `snapshots` steps of ordinary riding; at 120 Hz, 1200
+    // is ten seconds.
+    explicit GameSessionHistory (std::size_t snapshots,
+                                 std::size_t keyframe_interval = 32);
+    GameSessionHistory (const GameSessionHistory&) = delete;
+    GameSessionHistory& operator= (const GameSessionHistory&) = delete;
+
+    // Appends the session as it stands, forgetting the oldest snapshots if
+    // there is no room. Allocates nothing.
+    void record (const GameSession& session);
+
+    // Snapshots that can be restored; the newest is zero steps back.
+    std::size_t size () const noexcept {
+      return static_cast<std::size_t> (m_next - m_oldest);
+    }
+    bool empty () const noexcept {
+      return m_next == m_oldest;
+    }
+    void clear () noexcept;
+
+    // The session clock of the snapshot `steps_back` steps before the newest.
+    double total_time (std::size_t steps_back) const;
+
+    // The fewest steps back to a snapshot at least `age` older than the
+    // newest, or the oldest snapshot when none is that old.
+    std::size_t steps_back_for (seconds_t age) const;
+
+    // Puts the session back as it was. The history is unchanged, so the
+    // same snapshot can be restored again. The session must be prepared
+    // against the same world, with the same star set, as when it was
+    // recorded.
+    void restore (GameSession& session, std::size_t steps_back);
+
+    // Restores, then forgets every newer snapshot, so recording continues
+    // from there: a retry, or a rollback to replay corrected input.
+    void rewind (GameSession& session, std::size_t steps_back);
+
+    // Everything the history holds, which recording never changes.
+    std::size_t owned_bytes () const;
+
+  private:
+    struct StarChange {
+      std::uint16_t index = 0;
+      Stars::StarState state;
+    };
+
+    struct Snapshot {
+      // The snapshot whose whole star field this one's changes build on.
+      std::uint64_t keyframe = 0;
+      GameLogicState logic;
+      mov::Vehicle::State vehicle;
+      mov::Vehicle::State car;
+      mov::Glider::State glider;
+      Walker::State walker;
+      ChaseCamera::State camera;
+      std::size_t star_count = 0;
+      int stars_collected = 0;
+      Vec3 stars_last_position;
+      float stars_clock = 0.0f;
+      std::uint64_t dust_next_id = 1;
+      seconds_t dust_logical_time {};
+      // Positions in the change rings, which only ever count upwards. The
+      // dust span starts at the oldest emission alive at this step.
+      std::uint64_t stars_begin = 0;
+      std::uint64_t stars_end = 0;
+      std::uint64_t dust_begin = 0;
+      std::uint64_t dust_end = 0;
+    };
+
+    // Fixed storage addressed by ever-increasing positions; [begin, end)
+    // are held.
+    template <typename T>
+    struct Ring {
+      std::vector<T> values;
+      std::uint64_t begin = 0;
+      std::uint64_t end = 0;
+
+      std::size_t free () const noexcept {
+        return values.size () - static_cast<std::size_t> (end - begin);
+      }
+      void push (const T& value) {
+        values[static_cast<std::size_t> (end++ % values.size ())] = value;
+      }
+      const T& operator[] (std::uint64_t position) const {
+        return values[static_cast<std::size_t> (position % values.size ())];
+      }
+    };
+
+    Snapshot& slot (std::uint64_t sequence) {
+      return m_slots[static_cast<std::size_t> (sequence % m_slots.size ())];
+    }
+    const Snapshot& slot (std::uint64_t sequence) const {
+      return m_slots[static_cast<std::size_t> (sequence % m_slots.size ())];
+    }
+
+    std::uint64_t sequence_back (std::size_t steps_back) const;
+    std::size_t held_emissions (std::uint64_t& first) const;
+    void forget_oldest ();
+    void rebuild (std::uint64_t sequence);
+
+    std::vector<Snapshot> m_slots;
+    std::size_t m_keyframe_interval;
+    Ring<StarChange> m_star_changes;
+    Ring<Dust::Emission> m_emissions;
+    // Snapshots [m_oldest, m_next) are held; m_oldest is always a keyframe.
+    std::uint64_t m_oldest = 0;
+    std::uint64_t m_next = 0;
+    // The stars as last recorded, which the next snapshot is encoded
+    // against.
+    Stars::State m_previous_stars;
+    // Reused by every capture and restore.
+    GameState m_scratch;
+  };
+}
+
+#endif
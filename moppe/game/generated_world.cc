@@ -95,12 +95,13 @@ namespace moppe::game {
     // The join names the readings in the order the bundle declares them; a
     // world is finished when every one of them is present.
     return { std::move (sheets),
-             spatial::join (std::move (moisture),
-                            terrain::waterline_proximity (waterline),
-                            map::analyze_geology_materials (geometry),
-                            std::move (habitat),
-                            std::move (cover),
-                            use) };
+             spatial::store_as<map::SurfaceReadings> (
+               spatial::join (std::move (moisture),
+                              terrain::waterline_proximity (waterline),
+                              map::analyze_geology_materials (geometry),
+                              std::move (habitat),
+                              std::move (cover),
+                              use)) };
   }
 
   GeneratedWorld::GeneratedWorld (WorldParams params,
@@ -116,4 +117,81 @@ namespace moppe::game {
         m_hydrology (std::move (hydrology)),
         m_water_surface (std::move (water)), m_trails (std::move (trails)),
         m_readings (std::move (readings)), m_forest (std::move (forest)) {}
+
+  HomeSpawn locate_home_spawn (const map::SurfaceGeometry& surface,
+                               const terrain::TrailNetwork& trails) {
+    const auto ground = [&] (float x, float z) {
+      return terrain::surface_elevation_value (
+        spatial::sample<terrain::surface_elevation> (
+          surface, moppe::position (Vec3 (x, 0.0f, z))));
+    };
+
+    HomeSpawn spawn;
+    const terrain::CellIndex home = trails.plan.home_base;
+    if (home != terrain::no_cell) {
+      const std::size_t width = trails.domain.width ();
+      const float x = (home.value % width) *
+                      trails.domain.spacing_x ().numerical_value_in (u::m);
+      const float z = (home.value / width) *
+                      trails.domain.spacing_z ().numerical_value_in (u::m);
+      spawn.home_base = Vec3 (x, ground (x, z), z);
+    }
+
+    const auto& points = trails.alignment.points;
+    if (points.size () >= 2) {
+      Vec3 along (points[1].x_m - points[0].x_m,
+                  0.0f,
+                  points[1].z_m - points[0].z_m);
+      if (length2 (along) > 1e-5f)
+        spawn.heading = normalized (along);
+    }
+
+    spawn.position = spawn.home_base - spawn.heading * 8.0f;
+    spawn.position[1] = ground (spawn.position[0], spawn.position[2]) + 1.2f;
+    return spawn;
+  }
+
+  memory::Ledger account_memory (const GeneratedWorld& world) {
+    memory::Ledger ledger;
+    const auto span_bytes = [] (auto values) {
+      return values.size () * sizeof (typename decltype (values)::value_type);
+    };
+    memory::account_bundle (ledger, "surface", world.surface ());
+    memory::account_bundle (ledger, "readings", world.readings ());
+
+    const auto& [flood, census, drainage, rivers] = world.hydrology ();
+    memory::account_bundle (ledger, "flood", flood.surface);
+    ledger.add ("flood.ocean", memory::owned_bytes (flood.ocean));
+    ledger.add ("flood.spill_receiver",
+                memory::owned_bytes (flood.spill_receiver));
+    // The census keeps its vectors private; their sizes are what it shows.
+    ledger.add ("census.membership",
+                span_bytes (census.membership ().values ()));
+    ledger.add ("census.water_bodies", span_bytes (census.water_bodies ()));
+    memory::account_bundle (ledger, "drainage", drainage.readings);
+    ledger.add ("drainage.receiver", memory::owned_bytes (drainage.receiver));
+    std::size_t reach_bytes = memory::owned_bytes (rivers.reaches);
+    for (const terrain::RiverReach& reach : rivers.reaches)
+      reach_bytes += memory::owned_bytes (reach.cells) +
+                     memory::owned_bytes (reach.alignment.points);
+    ledger.add ("rivers.reaches", reach_bytes);
+    ledger.add ("rivers.waterfalls", memory::owned_bytes (rivers.waterfalls));
+    ledger.add ("rivers.body_traversed",
+                memory::owned_bytes (rivers.body_traversed));
+
+    memory::account_bundle (ledger, "water", world.water_surface ());
+
+    const terrain::TrailNetwork& trails = world.trails ();
+    ledger.add ("trails.plan",
+                memory::owned_bytes (trails.plan.control_sites) +
+                  memory::owned_bytes (trails.plan.circuit));
+    ledger.add ("trails.alignment",
+                memory::owned_bytes (trails.alignment.points));
+    ledger.add ("trails.earthwork_delta",
+                memory::owned_bytes (trails.earthwork_delta_m));
+    memory::account_bundle (ledger, "trails.use", trails.use);
+
+    memory::account_bundle (ledger, "forest", world.forest ());
+    return ledger;
+  }
 }
@@ -4,6 +4,7 @@
 #include <moppe/game/forest_plan.hh>
 #include <moppe/game/world.hh>
 #include <moppe/map/surface.hh>
+#include <moppe/memory.hh>
 #include <moppe/terrain/flood.hh>
 #include <moppe/terrain/trail.hh>
 #include <moppe/terrain/watercourse.hh>
@@ -107,6 +108,22 @@ namespace moppe::game {
     map::SurfaceReadings m_readings;
     ForestPlan m_forest;
   };
+
+  // Where every ride on a world begins: a few metres short of the home base,
+  // facing along the first stretch of trail.
+  struct HomeSpawn {
+    Vec3 home_base;
+    Vec3 position;
+    Vec3 heading { 0, 0, 1 };
+  };
+
+  HomeSpawn locate_home_spawn (const map::SurfaceGeometry& surface,
+                               const terrain::TrailNetwork& trails);
+
+  // What a finished world holds, one entry per bundle column and per owned
+  // vector, named by where it lives: surface.sediment_thickness,
+  // rivers.reaches and so on.
+  memory::Ledger account_memory (const GeneratedWorld& world);
 }
 
 #endif
@@ -1,8 +1,11 @@
 #include <moppe/game/landscape_gazetteer.hh>
 
+#include <moppe/parallel.hh>
+
 #include <algorithm>
 #include <array>
 #include <cmath>
+#include <cstdint>
 #include <iomanip>
 #include <limits>
 #include <optional>
@@ -10,6 +13,7 @@
 #include <ranges>
 #include <sstream>
 #include <stdexcept>
+#include <vector>
 
 namespace moppe::game {
   namespace {
@@ -178,36 +182,6 @@ namespace moppe::game {
       });
     }
 
-    template <typename Score>
-    GazetteerCandidate
-    choose_land_site (const map::SurfaceGeometry& surface,
-                      const map::SurfaceReadings& readings,
-                      const terrain::FloodField& flood,
-                      const terrain::LakeCensus& census,
-                      const std::vector<terrain::CellIndex>& selected,
-                      Score score) {
-      GazetteerCandidate best;
-      const std::size_t width = surface.domain ().width ();
-      const std::size_t height = surface.domain ().height ();
-      const std::size_t stride = std::max<std::size_t> (1, width / 256);
-      for (std::size_t z = 0; z < height; z += stride)
-        for (std::size_t x = 0; x < width; x += stride) {
-          const terrain::CellIndex cell { static_cast<std::uint32_t> (
-            z * width + x) };
-          const SiteSample site =
-            sample_site (cell, surface, readings, flood, census);
-          if (site.water || !separated_from (cell, selected, surface.domain ()))
-            continue;
-          const float candidate_score = score (site);
-          if (candidate_score > best.score ||
-              (candidate_score == best.score && cell < best.site.cell))
-            best = { .site = site,
-                     .score = candidate_score,
-                     .direction = ground_direction (site) };
-        }
-      return best;
-    }
-
     float
     surface_height (const map::SurfaceGeometry& surface, float x, float z) {
       return terrain::surface_elevation_value (
@@ -286,151 +260,330 @@ namespace moppe::game {
                    flood);
     }
 
-    GazetteerCandidate
-    choose_highland (const map::SurfaceGeometry& surface,
-                     const map::SurfaceReadings& readings,
-                     const terrain::FloodField& flood,
-                     const terrain::LakeCensus& census,
-                     const std::vector<terrain::CellIndex>& selected) {
-      GazetteerCandidate best;
+    // The land objectives a plan chooses sites for. All are scored in one
+    // sweep of the planning lattice, before any site is chosen, since no
+    // score depends on what was chosen before it.
+    enum class SiteObjective {
+      Forest,
+      Sunward,
+      Shadowplay,
+      Interior,
+      Meadow,
+      Turf,
+      Wetland,
+      Geology,
+      Highland,
+    };
+
+    constexpr std::size_t site_objective_count = 9;
+
+    // Each objective's best lattice samples, best first. Separation from
+    // earlier picks is only tested when choosing, and almost always settles
+    // within the leaders; the rest of the lattice is ranked only when every
+    // leader lies too close to a site already taken.
+    constexpr std::size_t site_leader_count = 32;
+
+    struct SiteSurvey {
+      std::size_t stride = 1;
+      std::size_t columns = 0;
+      std::size_t rows = 0;
+      // Row-major lattice slots, so slot order is cell order.
+      std::vector<SiteSample> sites;
+      // NaN where a sample cannot serve the objective.
+      std::array<std::vector<float>, site_objective_count> scores;
+      std::vector<Vec3> highland_directions;
+      std::array<std::vector<std::size_t>, site_objective_count> leaders;
+      std::optional<GazetteerCandidate> coast;
+      std::optional<GazetteerCandidate> lake_shore;
+    };
+
+    std::array<float, site_objective_count>
+    score_land_site (const SiteSample& site, Vec3 home) {
+      const float away = std::min (
+        std::sqrt (length2 (Vec3 (
+          site.position[0] - home[0], 0.0f, site.position[2] - home[2]))) /
+          220.0f,
+        1.0f);
+      const float edge = site.forest * (1.0f - site.forest) * 4.0f;
+      const float shore =
+        1.0f - std::min (std::abs (site.waterline_m - 24.0f) / 110.0f, 1.0f);
+      return {
+        4.0f * site.forest + 1.3f * site.habitat + 0.4f * site.wetness +
+          1.5f * site.normal[1] - 1.2f * site.trail,
+        6.0f * site.forest + 1.0f * site.habitat + 1.2f * site.normal[1] -
+          1.0f * site.trail,
+        3.5f * edge + 1.2f * site.normal[1] + 0.5f * site.habitat -
+          0.8f * site.trail,
+        6.0f * site.forest + 0.8f * site.habitat + 0.5f * site.wetness -
+          1.0f * site.trail,
+        3.2f * (1.0f - site.forest) + 1.8f * site.normal[1] +
+          0.6f * site.habitat + 0.25f * site.wetness - 1.1f * site.trail,
+        3.0f * (1.0f - site.forest) + 2.0f * site.normal[1] +
+          1.2f * site.wetness + 1.5f * away - 3.0f * site.trail,
+        3.0f * site.wetness + 1.7f * shore + site.normal[1] -
+          0.5f * site.forest,
+        4.0f * site.erosion + 1.1f * (1.0f - site.normal[1]) +
+          0.4f * site.deposition - 0.8f * site.forest,
+        // The highland reads the ground around the site: score_highland.
+        std::numeric_limits<float>::quiet_NaN (),
+      };
+    }
+
+    // A highland looks out over the lowest ground in a ring around it; the
+    // direction faces that way.
+    void score_highland (SiteSurvey& survey,
+                         std::size_t slot,
+                         int x,
+                         int z,
+                         const map::SurfaceGeometry& surface) {
+      const SiteSample& site = survey.sites[slot];
+      if (site.normal[1] < 0.58f)
+        return;
       const int width = static_cast<int> (surface.domain ().width ());
       const int height = static_cast<int> (surface.domain ().height ());
-      const int stride = std::max (1, width / 256);
       const int radius = std::max (2, width / 64);
-      for (int z = 0; z < height; z += stride)
-        for (int x = 0; x < width; x += stride) {
-          const terrain::CellIndex cell { static_cast<std::uint32_t> (
-            z * width + x) };
-          const SiteSample site =
-            sample_site (cell, surface, readings, flood, census);
-          if (site.water || site.normal[1] < 0.58f ||
-              !separated_from (cell, selected, surface.domain ()))
+      float low = site.position[1];
+      Vec3 direction = fallback_direction (site.cell);
+      for (const std::array<int, 2> offset :
+           { std::array { -radius, 0 },
+             std::array { radius, 0 },
+             std::array { 0, -radius },
+             std::array { 0, radius },
+             std::array { -radius, -radius },
+             std::array { radius, -radius },
+             std::array { -radius, radius },
+             std::array { radius, radius } }) {
+        const int sx = terrain::wrap_index (x + offset[0], width);
+        const int sz = terrain::wrap_index (z + offset[1], height);
+        const float h =
+          surface_height (surface,
+                          sx * metres (surface.domain ().spacing_x ()),
+                          sz * metres (surface.domain ().spacing_z ()));
+        if (h < low) {
+          low = h;
+          direction = normalized (Vec3 (static_cast<float> (offset[0]),
+                                        0,
+                                        static_cast<float> (offset[1])));
+        }
+      }
+      const float prominence = site.position[1] - low;
+      survey.scores[static_cast<std::size_t> (SiteObjective::Highland)][slot] =
+        site.position[1] + 2.4f * prominence - 120.0f * site.trail;
+      survey.highland_directions[slot] = direction;
+    }
+
+    // Within a row the first best candidate wins, as a scan would keep it.
+    void keep_better (GazetteerCandidate& best,
+                      const SiteSample& site,
+                      float score,
+                      std::array<int, 2> offset) {
+      if (score > best.score)
+        best = { .site = site,
+                 .score = score,
+                 .direction = normalized (Vec3 (static_cast<float> (offset[0]),
+                                                0,
+                                                static_cast<float> (
+                                                  offset[1]))) };
+    }
+
+    constexpr std::array<std::array<int, 2>, 4> edge_offsets {
+      std::array { -1, 0 },
+      std::array { 1, 0 },
+      std::array { 0, -1 },
+      std::array { 0, 1 }
+    };
+
+    // Dry ground beside the sea, a pleasant height above it.
+    void survey_coast_row (GazetteerCandidate& best,
+                           int z,
+                           const map::SurfaceGeometry& surface,
+                           const map::SurfaceReadings& readings,
+                           const terrain::FloodField& flood,
+                           const terrain::LakeCensus& census) {
+      const int width = static_cast<int> (surface.domain ().width ());
+      const int height = static_cast<int> (surface.domain ().height ());
+      for (int x = 0; x < width; ++x) {
+        const terrain::CellIndex cell { static_cast<std::uint32_t> (
+          z * width + x) };
+        std::optional<SiteSample> site;
+        for (const std::array<int, 2> offset : edge_offsets) {
+          const int nx = terrain::wrap_index (x + offset[0], width);
+          const int nz = terrain::wrap_index (z + offset[1], height);
+          const std::size_t neighbour =
+            static_cast<std::size_t> (nz) * width + nx;
+          if (neighbour >= flood.ocean.size () || !flood.ocean[neighbour])
             continue;
-          float low = site.position[1];
-          Vec3 direction = fallback_direction (cell);
-          for (const std::array<int, 2> offset :
-               { std::array { -radius, 0 },
-                 std::array { radius, 0 },
-                 std::array { 0, -radius },
-                 std::array { 0, radius },
-                 std::array { -radius, -radius },
-                 std::array { radius, -radius },
-                 std::array { -radius, radius },
-                 std::array { radius, radius } }) {
-            const int sx = terrain::wrap_index (x + offset[0], width);
-            const int sz = terrain::wrap_index (z + offset[1], height);
-            const float h =
-              surface_height (surface,
-                              sx * metres (surface.domain ().spacing_x ()),
-                              sz * metres (surface.domain ().spacing_z ()));
-            if (h < low) {
-              low = h;
-              direction = normalized (Vec3 (static_cast<float> (offset[0]),
-                                            0,
-                                            static_cast<float> (offset[1])));
-            }
-          }
-          const float prominence = site.position[1] - low;
-          const float score =
-            site.position[1] + 2.4f * prominence - 120.0f * site.trail;
-          if (score > best.score)
-            best = { .site = site, .score = score, .direction = direction };
+          if (!site)
+            site = sample_site (cell, surface, readings, flood, census);
+          if (site->water)
+            break;
+          const float above_sea = site->position[1] - flood.sea_level;
+          const float useful_height =
+            1.0f - std::min (std::abs (above_sea - 9.0f) / 35.0f, 1.0f);
+          keep_better (best,
+                       *site,
+                       3.0f * useful_height + site->normal[1] -
+                         0.8f * site->forest,
+                       offset);
         }
-      return best;
+      }
     }
 
-    std::optional<GazetteerCandidate>
-    choose_coast (const map::SurfaceGeometry& surface,
-                  const map::SurfaceReadings& readings,
-                  const terrain::FloodField& flood,
-                  const terrain::LakeCensus& census) {
-      if (!flood.has_ocean)
-        return std::nullopt;
-      GazetteerCandidate best;
+    // Open, gentle land facing into the largest permanent lake.
+    void survey_lake_shore_row (GazetteerCandidate& best,
+                                int z,
+                                terrain::WaterBodyId lake,
+                                const map::SurfaceGeometry& surface,
+                                const map::SurfaceReadings& readings,
+                                const terrain::FloodField& flood,
+                                const terrain::LakeCensus& census) {
       const int width = static_cast<int> (surface.domain ().width ());
       const int height = static_cast<int> (surface.domain ().height ());
-      for (int z = 0; z < height; ++z)
-        for (int x = 0; x < width; ++x) {
-          const terrain::CellIndex cell { static_cast<std::uint32_t> (
-            z * width + x) };
+      for (int x = 0; x < width; ++x) {
+        const terrain::CellIndex water_cell { static_cast<std::uint32_t> (
+          z * width + x) };
+        if (census.body_at (water_cell) != lake)
+          continue;
+        for (const std::array<int, 2> offset : edge_offsets) {
+          const int lx = terrain::wrap_index (x - offset[0], width);
+          const int lz = terrain::wrap_index (z - offset[1], height);
+          const terrain::CellIndex land_cell { static_cast<std::uint32_t> (
+            lz * width + lx) };
           const SiteSample site =
-            sample_site (cell, surface, readings, flood, census);
+            sample_site (land_cell, surface, readings, flood, census);
           if (site.water)
             continue;
-          for (const std::array<int, 2> offset : { std::array { -1, 0 },
-                                                   std::array { 1, 0 },
-                                                   std::array { 0, -1 },
-                                                   std::array { 0, 1 } }) {
-            const int nx = terrain::wrap_index (x + offset[0], width);
-            const int nz = terrain::wrap_index (z + offset[1], height);
-            const std::size_t neighbour =
-              static_cast<std::size_t> (nz) * width + nx;
-            if (neighbour >= flood.ocean.size () || !flood.ocean[neighbour])
-              continue;
-            const float above_sea = site.position[1] - flood.sea_level;
-            const float useful_height =
-              1.0f - std::min (std::abs (above_sea - 9.0f) / 35.0f, 1.0f);
-            const float score =
-              3.0f * useful_height + site.normal[1] - 0.8f * site.forest;
-            if (score > best.score)
-              best = { .site = site,
-                       .score = score,
-                       .direction =
-                         normalized (Vec3 (static_cast<float> (offset[0]),
-                                           0,
-                                           static_cast<float> (offset[1]))) };
-          }
+          keep_better (best,
+                       site,
+                       site.normal[1] + 0.35f * site.habitat -
+                         0.6f * site.trail,
+                       offset);
         }
-      return best.present () ? std::optional (best) : std::nullopt;
+      }
     }
 
-    std::optional<GazetteerCandidate>
-    choose_lake_shore (const map::SurfaceGeometry& surface,
-                       const map::SurfaceReadings& readings,
-                       const terrain::FloodField& flood,
-                       const terrain::LakeCensus& census) {
+    // One sweep of the terrain's rows: land objectives on the strided
+    // planning lattice, coast and lake shore on every cell. Rows run in
+    // parallel and each keeps its own results, merged in row order so the
+    // survey is the same however the rows were scheduled.
+    SiteSurvey survey_sites (const map::SurfaceGeometry& surface,
+                             const map::SurfaceReadings& readings,
+                             const terrain::FloodField& flood,
+                             const terrain::LakeCensus& census,
+                             Vec3 home) {
+      const std::size_t width = surface.domain ().width ();
+      const std::size_t height = surface.domain ().height ();
+      SiteSurvey survey;
+      survey.stride = std::max<std::size_t> (1, width / 256);
+      survey.columns = (width + survey.stride - 1) / survey.stride;
+      survey.rows = (height + survey.stride - 1) / survey.stride;
+      const std::size_t slots = survey.columns * survey.rows;
+      survey.sites.resize (slots);
+      for (std::vector<float>& scores : survey.scores)
+        scores.assign (slots, std::numeric_limits<float>::quiet_NaN ());
+      survey.highland_directions.resize (slots);
+
       const terrain::WaterBody* lake = nullptr;
       for (const terrain::WaterBody& body : census.water_bodies ())
         if (body.classification != terrain::WaterBodyClass::Sea &&
             water_body_is_permanent (body) && !body.channel_like &&
             (!lake || body.area > lake->area))
           lake = &body;
-      if (!lake)
-        return std::nullopt;
 
-      GazetteerCandidate best;
-      const int width = static_cast<int> (surface.domain ().width ());
-      const int height = static_cast<int> (surface.domain ().height ());
-      for (int z = 0; z < height; ++z)
-        for (int x = 0; x < width; ++x) {
-          const terrain::CellIndex water_cell { static_cast<std::uint32_t> (
-            z * width + x) };
-          if (census.body_at (water_cell) != lake->id)
+      std::vector<GazetteerCandidate> coasts (flood.has_ocean ? height : 0);
+      std::vector<GazetteerCandidate> shores (lake ? height : 0);
+      parallel_rows (height, width * height, [&] (std::size_t row) {
+        const int z = static_cast<int> (row);
+        if (flood.has_ocean)
+          survey_coast_row (coasts[row], z, surface, readings, flood, census);
+        if (lake)
+          survey_lake_shore_row (
+            shores[row], z, lake->id, surface, readings, flood, census);
+        if (row % survey.stride != 0)
+          return;
+        for (std::size_t column = 0; column < survey.columns; ++column) {
+          const std::size_t x = column * survey.stride;
+          const std::size_t slot = row / survey.stride * survey.columns +
+                                   column;
+          const terrain::CellIndex cell { static_cast<std::uint32_t> (
+            row * width + x) };
+          survey.sites[slot] =
+            sample_site (cell, surface, readings, flood, census);
+          if (survey.sites[slot].water)
             continue;
-          for (const std::array<int, 2> offset : { std::array { -1, 0 },
-                                                   std::array { 1, 0 },
-                                                   std::array { 0, -1 },
-                                                   std::array { 0, 1 } }) {
-            const int lx = terrain::wrap_index (x - offset[0], width);
-            const int lz = terrain::wrap_index (z - offset[1], height);
-            const terrain::CellIndex land_cell { static_cast<std::uint32_t> (
-              lz * width + lx) };
-            const SiteSample site =
-              sample_site (land_cell, surface, readings, flood, census);
-            if (site.water)
-              continue;
-            const float score =
-              site.normal[1] + 0.35f * site.habitat - 0.6f * site.trail;
-            if (score > best.score)
-              best = { .site = site,
-                       .score = score,
-                       .direction =
-                         normalized (Vec3 (static_cast<float> (offset[0]),
-                                           0,
-                                           static_cast<float> (offset[1]))) };
-          }
+          const std::array<float, site_objective_count> scores =
+            score_land_site (survey.sites[slot], home);
+          for (std::size_t objective = 0; objective < site_objective_count;
+               ++objective)
+            survey.scores[objective][slot] = scores[objective];
+          score_highland (survey, slot, static_cast<int> (x), z, surface);
         }
-      return best.present () ? std::optional (best) : std::nullopt;
+      });
+
+      GazetteerCandidate coast;
+      for (const GazetteerCandidate& row : coasts)
+        if (row.score > coast.score)
+          coast = row;
+      if (coast.present ())
+        survey.coast = coast;
+      GazetteerCandidate shore;
+      for (const GazetteerCandidate& row : shores)
+        if (row.score > shore.score)
+          shore = row;
+      if (shore.present ())
+        survey.lake_shore = shore;
+
+      for (std::size_t objective = 0; objective < site_objective_count;
+           ++objective) {
+        const std::vector<float>& scores = survey.scores[objective];
+        std::vector<std::size_t>& leaders = survey.leaders[objective];
+        for (std::size_t slot = 0; slot < slots; ++slot)
+          if (!std::isnan (scores[slot]))
+            leaders.push_back (slot);
+        const std::size_t kept =
+          std::min (leaders.size (), site_leader_count);
+        std::ranges::partial_sort (
+          leaders, leaders.begin () + kept, [&] (std::size_t a, std::size_t b) {
+            return scores[a] > scores[b] || (scores[a] == scores[b] && a < b);
+          });
+        leaders.resize (kept);
+      }
+      return survey;
+    }
+
+    // The best-scoring sample clear of every site already chosen, ties to
+    // the earliest cell.
+    GazetteerCandidate
+    choose_site (const SiteSurvey& survey,
+                 SiteObjective objective,
+                 const std::vector<terrain::CellIndex>& selected,
+                 const terrain::TerrainDomain& domain) {
+      const std::size_t index = static_cast<std::size_t> (objective);
+      const std::vector<float>& scores = survey.scores[index];
+      const auto candidate = [&] (std::size_t slot) {
+        const SiteSample& site = survey.sites[slot];
+        return GazetteerCandidate {
+          .site = site,
+          .score = scores[slot],
+          .direction = objective == SiteObjective::Highland
+                         ? survey.highland_directions[slot]
+                         : ground_direction (site),
+        };
+      };
+      const std::vector<std::size_t>& leaders = survey.leaders[index];
+      for (const std::size_t slot : leaders)
+        if (separated_from (survey.sites[slot].cell, selected, domain))
+          return candidate (slot);
+      if (leaders.size () < site_leader_count)
+        return {};
+
+      std::optional<std::size_t> best;
+      for (std::size_t slot = 0; slot < scores.size (); ++slot)
+        if (!std::isnan (scores[slot]) &&
+            (!best || scores[slot] > scores[*best]) &&
+            separated_from (survey.sites[slot].cell, selected, domain))
+          best = slot;
+      return best ? candidate (*best) : GazetteerCandidate {};
     }
 
     Vec3 trail_point (const terrain::TrailAlignmentPoint& point,
@@ -579,16 +732,15 @@ namespace moppe::game {
       throw std::invalid_argument (
         "gazetteer inputs do not share one terrain domain");
 
+    const SiteSurvey survey = survey_sites (
+      surface, readings, flood, census, position_value (spawn));
     LandscapeGazetteer gazetteer;
     std::vector<terrain::CellIndex> selected;
     append_trail_views (
       gazetteer, selected, trail, spawn, surface, readings, flood);
 
-    const GazetteerCandidate forest = choose_land_site (
-      surface, readings, flood, census, selected, [] (const SiteSample& site) {
-        return 4.0f * site.forest + 1.3f * site.habitat + 0.4f * site.wetness +
-               1.5f * site.normal[1] - 1.2f * site.trail;
-      });
+    const GazetteerCandidate forest = choose_site (
+      survey, SiteObjective::Forest, selected, surface.domain ());
     append_candidate_view (gazetteer,
                            selected,
                            "forest-floor",
@@ -612,11 +764,8 @@ namespace moppe::game {
       length2 (toward_sun) > 1e-6f ? normalized (toward_sun) : Vec3 (0, 0, 1);
     const Vec3 sun_side (-toward_sun[2], 0, toward_sun[0]);
 
-    GazetteerCandidate sunward = choose_land_site (
-      surface, readings, flood, census, selected, [] (const SiteSample& site) {
-        return 6.0f * site.forest + 1.0f * site.habitat +
-               1.2f * site.normal[1] - 1.0f * site.trail;
-      });
+    GazetteerCandidate sunward = choose_site (
+      survey, SiteObjective::Sunward, selected, surface.domain ());
     sunward.direction = toward_sun;
     append_candidate_view (gazetteer,
                            selected,
@@ -632,12 +781,8 @@ namespace moppe::game {
                            readings,
                            flood);
 
-    GazetteerCandidate shadowplay = choose_land_site (
-      surface, readings, flood, census, selected, [] (const SiteSample& site) {
-        const float edge = site.forest * (1.0f - site.forest) * 4.0f;
-        return 3.5f * edge + 1.2f * site.normal[1] + 0.5f * site.habitat -
-               0.8f * site.trail;
-      });
+    GazetteerCandidate shadowplay = choose_site (
+      survey, SiteObjective::Shadowplay, selected, surface.domain ());
     shadowplay.direction = sun_side;
     append_candidate_view (gazetteer,
                            selected,
@@ -653,11 +798,8 @@ namespace moppe::game {
                            readings,
                            flood);
 
-    GazetteerCandidate interior = choose_land_site (
-      surface, readings, flood, census, selected, [] (const SiteSample& site) {
-        return 6.0f * site.forest + 0.8f * site.habitat + 0.5f * site.wetness -
-               1.0f * site.trail;
-      });
+    GazetteerCandidate interior = choose_site (
+      survey, SiteObjective::Interior, selected, surface.domain ());
     interior.direction = -toward_sun;
     append_candidate_view (gazetteer,
                            selected,
@@ -673,11 +815,8 @@ namespace moppe::game {
                            readings,
                            flood);
 
-    const GazetteerCandidate meadow = choose_land_site (
-      surface, readings, flood, census, selected, [] (const SiteSample& site) {
-        return 3.2f * (1.0f - site.forest) + 1.8f * site.normal[1] +
-               0.6f * site.habitat + 0.25f * site.wetness - 1.1f * site.trail;
-      });
+    const GazetteerCandidate meadow = choose_site (
+      survey, SiteObjective::Meadow, selected, surface.domain ());
     append_candidate_view (gazetteer,
                            selected,
                            "open-meadow",
@@ -699,23 +838,8 @@ namespace moppe::game {
     // at a known heading relative to the light. The site is the most
     // ordinary grass in the world: open, flat, a little damp, and away
     // from the home-base clearing and worn ground that empty the field.
-    const Vec3 home_pos = position_value (spawn);
-    const GazetteerCandidate turf = choose_land_site (
-      surface,
-      readings,
-      flood,
-      census,
-      selected,
-      [home_pos] (const SiteSample& site) {
-        const float away = std::min (
-          std::sqrt (length2 (Vec3 (site.position[0] - home_pos[0],
-                                    0.0f,
-                                    site.position[2] - home_pos[2]))) /
-            220.0f,
-          1.0f);
-        return 3.0f * (1.0f - site.forest) + 2.0f * site.normal[1] +
-               1.2f * site.wetness + 1.5f * away - 3.0f * site.trail;
-      });
+    const GazetteerCandidate turf = choose_site (
+      survey, SiteObjective::Turf, selected, surface.domain ());
     // Five metres up, above the chase camera: high enough that the band
     // structure lays out in depth instead of stacking at the horizon. The
     // down view looks steeply into the field, where per-blade and per-tuft
@@ -748,13 +872,8 @@ namespace moppe::game {
                              flood);
     }
 
-    const GazetteerCandidate wetland = choose_land_site (
-      surface, readings, flood, census, selected, [] (const SiteSample& site) {
-        const float shore =
-          1.0f - std::min (std::abs (site.waterline_m - 24.0f) / 110.0f, 1.0f);
-        return 3.0f * site.wetness + 1.7f * shore + site.normal[1] -
-               0.5f * site.forest;
-      });
+    const GazetteerCandidate wetland = choose_site (
+      survey, SiteObjective::Wetland, selected, surface.domain ());
     append_candidate_view (gazetteer,
                            selected,
                            "wetland-edge",
@@ -769,11 +888,8 @@ namespace moppe::game {
                            readings,
                            flood);
 
-    const GazetteerCandidate geology = choose_land_site (
-      surface, readings, flood, census, selected, [] (const SiteSample& site) {
-        return 4.0f * site.erosion + 1.1f * (1.0f - site.normal[1]) +
-               0.4f * site.deposition - 0.8f * site.forest;
-      });
+    const GazetteerCandidate geology = choose_site (
+      survey, SiteObjective::Geology, selected, surface.domain ());
     append_candidate_view (gazetteer,
                            selected,
                            "eroded-slope",
@@ -788,8 +904,8 @@ namespace moppe::game {
                            readings,
                            flood);
 
-    const GazetteerCandidate highland =
-      choose_highland (surface, readings, flood, census, selected);
+    const GazetteerCandidate highland = choose_site (
+      survey, SiteObjective::Highland, selected, surface.domain ());
     append_candidate_view (gazetteer,
                            selected,
                            "highland-vista",
@@ -860,8 +976,7 @@ namespace moppe::game {
                              drainage,
                              rivers);
 
-    if (const std::optional<GazetteerCandidate> shore =
-          choose_lake_shore (surface, readings, flood, census)) {
+    if (const std::optional<GazetteerCandidate>& shore = survey.lake_shore) {
       append_candidate_view (gazetteer,
                              selected,
                              "lake-shore",
@@ -888,8 +1003,7 @@ namespace moppe::game {
                              drainage,
                              rivers);
 
-    if (const std::optional<GazetteerCandidate> coast =
-          choose_coast (surface, readings, flood, census)) {
+    if (const std::optional<GazetteerCandidate>& coast = survey.coast) {
       const Vec3 side (-coast->direction[2], 0, coast->direction[0]);
       // Stand just off the beach: an inland documentary camera can be
       // swallowed by the very forest edge this view is trying to establish.
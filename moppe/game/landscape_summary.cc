@@ -211,8 +211,7 @@ namespace moppe::game {
     };
   }
 
-  void write_landscape_summary_csv (std::ostream& output,
-                                    const LandscapeSummary& s) {
+  void write_landscape_summary_columns (std::ostream& output) {
     output << "seed,resolution,spacing_x_m,spacing_z_m,evolution_years,"
               "uplift_years,channel_initiation_area_m2,runoff_m_per_year,"
               "sediment_concentration_at_unit_slope,"
@@ -231,7 +230,11 @@ namespace moppe::game {
               "largest_river_catchment_m2,inland_water_bodies,lakes,"
               "inland_water_area_m2,mobile_sediment_m3,eroded_sediment_m3,"
               "deposited_sediment_m3,inferred_bedrock_detached_m3,"
-              "inferred_exported_sediment_m3\n";
+              "inferred_exported_sediment_m3";
+  }
+
+  void write_landscape_summary_values (std::ostream& output,
+                                       const LandscapeSummary& s) {
     output << std::setprecision (12) << s.seed << ',' << s.resolution << ','
            << s.spacing_x_m << ',' << s.spacing_z_m << ',' << s.evolution_years
            << ',' << s.uplift_years << ',' << s.channel_initiation_area_m2
@@ -255,7 +258,15 @@ namespace moppe::game {
            << s.inland_water_area_m2 << ',' << s.mobile_sediment_m3 << ','
            << s.eroded_sediment_m3 << ',' << s.deposited_sediment_m3 << ','
            << s.inferred_bedrock_detached_m3 << ','
-           << s.inferred_exported_sediment_m3 << '\n';
+           << s.inferred_exported_sediment_m3;
+  }
+
+  void write_landscape_summary_csv (std::ostream& output,
+                                    const LandscapeSummary& summary) {
+    write_landscape_summary_columns (output);
+    output << '\n';
+    write_landscape_summary_values (output, summary);
+    output << '\n';
   }
 
   void write_landscape_elevation_f32 (std::ostream& output,
@@ -68,6 +68,12 @@ namespace moppe::game {
   void write_landscape_summary_csv (std::ostream& output,
                                     const LandscapeSummary& summary);
 
+  // The same header and row without line ends, for tables that put their
+  // own columns beside a summary.
+  void write_landscape_summary_columns (std::ostream& output);
+  void write_landscape_summary_values (std::ostream& output,
+                                       const LandscapeSummary& summary);
+
   // A compact reproducible elevation field accompanies a gazetteer so
   // terrain-scale evidence can be recalculated without rebuilding the world.
   void write_landscape_elevation_f32 (std::ostream& output,
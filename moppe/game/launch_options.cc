@@ -87,6 +87,20 @@ namespace moppe::game {
       return true;
     }
 
+    bool parse_coarse_levels (const char* value,
+                              int& result,
+                              std::string& error) {
+      char* end = nullptr;
+      errno = 0;
+      const long parsed = std::strtol (value, &end, 10);
+      if (errno || end == value || *end != '\0' || parsed < 1 || parsed > 3) {
+        error = "--coarse-orogeny must be an integer from 1 to 3";
+        return false;
+      }
+      result = static_cast<int> (parsed);
+      return true;
+    }
+
     bool set_world_cache_key (LaunchOptions& options,
                               const char* value,
                               std::string& error) {
@@ -498,6 +512,21 @@ namespace moppe::game {
             multiplier * proportion[mp_units::one];
           return true;
         } },
+      { "--coarse-orogeny",
+        "",
+        1,
+        "<LEVELS>",
+        "Run early geological steps on a lattice halved LEVELS times.",
+        [] (LaunchOptions& options,
+            const char* const* values,
+            std::string& error) {
+          int levels = 0;
+          if (!parse_coarse_levels (values[0], levels, error))
+            return false;
+          options.coarse_to_fine =
+            terrain::CoarseToFineEvolution { .coarse_levels = levels };
+          return true;
+        } },
       { "--world-cache-key",
         "",
         1,
@@ -526,6 +555,33 @@ namespace moppe::game {
           options.world_cache.mode = WorldCacheMode::Disabled;
           return true;
         } },
+      { "--no-world-preview",
+        "",
+        0,
+        "",
+        "Wait for the full world instead of riding a coarse preview.",
+        [] (LaunchOptions& options, const char* const*, std::string&) {
+          options.world_preview = false;
+          return true;
+        } },
+      { "--trace",
+        "",
+        1,
+        "<JSON>",
+        "Write a Chrome trace of the run's profiling zones on exit.",
+        [] (LaunchOptions& options, const char* const* values, std::string&) {
+          options.trace_path = values[0];
+          return true;
+        } },
+      { "--record-input",
+        "",
+        1,
+        "<TAPE>",
+        "Record every simulation step's input for game-session-benchmark.",
+        [] (LaunchOptions& options, const char* const* values, std::string&) {
+          options.input_tape_path = values[0];
+          return true;
+        } },
       { "--screenshot",
         "",
         1,
@@ -628,6 +684,9 @@ namespace moppe::game {
       // An automated run stays behind whatever the developer is looking at.
       options.config.activate = !options.config.capture_frames &&
                                 !options.benchmark && !options.stay_inactive;
+      // Nothing automated should measure a world about to be replaced.
+      if (options.config.capture_frames)
+        options.world_preview = false;
       // A capture pins its own seed so repeated runs compare like with like.
       if (options.config.capture_frames && options.seed < 0)
         options.seed = 123;
@@ -763,6 +822,7 @@ namespace moppe::game {
                                        options.channel_initiation_area,
                                        options.sediment_concentration,
                                        options.critical_hillslope_gradient,
-                                       options.maximum_hillslope_multiplier);
+                                       options.maximum_hillslope_multiplier,
+                                       options.coarse_to_fine);
   }
 }
@@ -53,7 +53,13 @@ namespace moppe::game {
     std::optional<terrain::SedimentConcentration> sediment_concentration;
     std::optional<proportion_t> critical_hillslope_gradient;
     std::optional<proportion_t> maximum_hillslope_multiplier;
+    // Early geological steps on a coarser lattice; the resulting world is a
+    // different world, with its own cache.
+    std::optional<terrain::CoarseToFineEvolution> coarse_to_fine;
     WorldCacheConfig world_cache;
+    // Ride a coarse preview of a large world while the full one builds.
+    // Captures and benchmarks always wait for the world they measure.
+    bool world_preview = true;
     std::string screenshot_path;
     std::optional<WaterShot> water_shot;
     std::optional<GraphicsBenchmarkConfig> benchmark;
@@ -64,6 +70,12 @@ namespace moppe::game {
     // Keeps a hand-started run behind the active application, the way
     // captures and benchmarks already stay out of the way.
     bool stay_inactive = false;
+    // Records the built-in profiler's zones and writes them as a Chrome
+    // trace here on exit. Empty leaves the recorder to MOPPE_TRACE.
+    std::string trace_path;
+    // Writes the input of every simulation step here, as a tape the headless
+    // session benchmark replays from the home spawn.
+    std::string input_tape_path;
     // Negative until the launch either names a seed or recalls a remembered
     // one; a capture always pins its own so comparisons stay reproducible.
     int seed = -1;
@@ -39,6 +39,10 @@ int main (int argc, char** argv) {
     std::cout << game::launch_options_help (argc > 0 ? argv[0] : "moppe");
     return 0;
   }
+#if !defined(TRACY_ENABLE)
+  if (!options.trace_path.empty ())
+    profile::record_trace (options.trace_path);
+#endif
   if (!game::apply_graphics_environment (options.graphics, error)) {
     std::cerr << error << '\n';
     return -1;
@@ -0,0 +1,120 @@
+#include <moppe/game/rider_water.hh>
+
+#include <moppe/profile.hh>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <numbers>
+
+namespace moppe::game {
+  namespace {
+    // Baked water over ground at a world position, in metres: the still
+    // depth, negative on land.
+    struct StillWater {
+      float level = 0.0f;
+      float depth = 0.0f;
+    };
+
+    StillWater still_water_at (const terrain::WaterSheets& water,
+                               const map::SurfaceGeometry& surface,
+                               float x,
+                               float z) {
+      const position_t where = position (Vec3 (x, 0.0f, z));
+      const float level = terrain::surface_elevation_value (
+        spatial::sample<terrain::surface_elevation> (water, where));
+      const float ground = terrain::surface_elevation_value (
+        spatial::sample<terrain::surface_elevation> (surface, where));
+      return { level, level - ground };
+    }
+
+    // The window's depth callback: world sites are whole spacings from the
+    // world's origin.
+    struct WindowDepth {
+      const terrain::WaterSheets& water;
+      const map::SurfaceGeometry& surface;
+      float spacing;
+
+      meters_t operator() (std::int64_t column, std::int64_t row) const {
+        return still_water_at (water,
+                               surface,
+                               static_cast<float> (column) * spacing,
+                               static_cast<float> (row) * spacing)
+                 .depth *
+               u::m;
+      }
+    };
+
+    // The corner that puts the site nearest `along` at the window's centre.
+    std::int64_t window_corner (float along, float spacing, std::size_t side) {
+      return static_cast<std::int64_t> (std::lround (along / spacing)) -
+             static_cast<std::int64_t> (side / 2);
+    }
+
+    lavoir::water_window rider_window (const terrain::WaterSheets& water,
+                                       const map::SurfaceGeometry& surface,
+                                       const Vec3& rider,
+                                       seconds_t step,
+                                       const RiderWaterParams& params) {
+      const float spacing = params.spacing.numerical_value_in (u::m);
+      return lavoir::water_window (
+        params.side,
+        params.spacing / lavoir::unit,
+        params.deepest,
+        static_cast<double> (seconds_value (step)) * mp_units::si::second /
+          lavoir::step,
+        window_corner (rider[0], spacing, params.side),
+        window_corner (rider[2], spacing, params.side),
+        WindowDepth { water, surface, spacing });
+    }
+  }
+
+  RiderWater::RiderWater (const terrain::WaterSheets& water,
+                          const map::SurfaceGeometry& surface,
+                          position_t rider,
+                          seconds_t step,
+                          const RiderWaterParams& params)
+      : m_water (water), m_surface (surface), m_params (params),
+        m_step (step),
+        m_window (rider_window (
+          water, surface, position_value (rider), step, params)),
+        m_workers (spare_row_workers (params.band_workers)) {}
+
+  void RiderWater::advance (const mov::Vehicle::State& vehicle) {
+    MOPPE_PROFILE_ZONE ("RiderWater::advance");
+    const Vec3& at = position_value (vehicle.position);
+    const float spacing = m_params.spacing.numerical_value_in (u::m);
+    m_window.follow (window_corner (at[0], spacing, m_params.side),
+                     window_corner (at[2], spacing, m_params.side),
+                     WindowDepth { m_water, m_surface, spacing });
+
+    const StillWater still = still_water_at (m_water, m_surface, at[0], at[2]);
+    const float clearance = m_params.wake_clearance.numerical_value_in (u::m);
+    if (still.depth > 0.0f && at[1] - still.level < clearance) {
+      const Vec3& velocity = velocity_value (vehicle.velocity);
+      const float travelled =
+        std::hypot (velocity[0], velocity[2]) * seconds_value (m_step);
+      // Gaussians a step apart along the track sum to sqrt(2 pi) radius
+      // over the step's length: pressing that share of the wake depth
+      // each step lays a trough wake_depth deep.
+      const float radius = m_params.wake_radius.numerical_value_in (u::m);
+      const float track =
+        std::sqrt (2.0f * std::numbers::pi_v<float>) * radius;
+      const float pressed = std::min (1.0f, travelled / track);
+      m_window.disturb (at[0] / spacing,
+                        at[2] / spacing,
+                        -pressed * m_params.wake_depth,
+                        radius / spacing);
+    }
+
+    m_window.tick ([this] (std::size_t bands, std::size_t, const auto& band) {
+      m_workers.run (bands, band);
+    });
+  }
+
+  meters_t RiderWater::displacement (const position_t& position) const {
+    const Vec3& at = position_value (position);
+    const float spacing = m_params.spacing.numerical_value_in (u::m);
+    return m_window.displacement_at (at[0] / spacing, at[2] / spacing);
+  }
+}
@@ -0,0 +1,73 @@
+#ifndef MOPPE_GAME_RIDER_WATER_HH
+#define MOPPE_GAME_RIDER_WATER_HH
+
+#include <moppe/map/surface.hh>
+#include <moppe/mov/vehicle.hh>
+#include <moppe/parallel.hh>
+#include <moppe/terrain/watercourse.hh>
+
+#include <lavoir/shallow_water.hh>
+
+#include <cstddef>
+
+namespace moppe::game {
+  // Live water around the rider. The baked water sheets say where water
+  // stands and how deep it is; a lavoir water window centred on the rider
+  // carries waves over that still water, pressed into it by the vehicle's
+  // wake. Every step updates the same number of sites, so the window's side
+  // is the step's CPU budget, and the water follows from the inputs alone.
+  struct RiderWaterParams {
+    // Sites along each edge of the window, and the world between them.
+    std::size_t side = 192;
+    meters_t spacing = 0.5f * u::m;
+    // Waves run fastest at this depth; deeper water is treated as this deep.
+    meters_t deepest = 2.5f * u::m;
+    // The trough a vehicle leaves along its track, pressed in a little at
+    // every step so its depth does not depend on how fast it crosses.
+    meters_t wake_depth = 0.03f * u::m;
+    meters_t wake_radius = 0.75f * u::m;
+    // A vehicle higher than this above the still surface leaves no wake.
+    meters_t wake_clearance = 1.0f * u::m;
+    // Threads besides the caller's that share the window's bands, kept
+    // for as long as the window; fewer where the hardware has fewer.
+    std::size_t band_workers = 3;
+  };
+
+  class RiderWater {
+  public:
+    // Borrows the water sheets and the ground, which must outlive it.
+    RiderWater (const terrain::WaterSheets& water,
+                const map::SurfaceGeometry& surface,
+                position_t rider,
+                seconds_t step,
+                const RiderWaterParams& params = {});
+
+    // One fixed simulation step: recentre on the vehicle, press its wake
+    // into the water and advance the waves. The window's bands are shared
+    // among its band workers.
+    void advance (const mov::Vehicle::State& vehicle);
+
+    // The moving water's height above the still sheet at a world position;
+    // zero on land and outside the window.
+    meters_t displacement (const position_t& position) const;
+
+    const lavoir::water_window& window () const noexcept {
+      return m_window;
+    }
+
+    // Threads that step the window's bands, the caller's included.
+    std::size_t band_threads () const noexcept {
+      return m_workers.size ();
+    }
+
+  private:
+    const terrain::WaterSheets& m_water;
+    const map::SurfaceGeometry& m_surface;
+    RiderWaterParams m_params;
+    seconds_t m_step;
+    lavoir::water_window m_window;
+    RowWorkers m_workers;
+  };
+}
+
+#endif
@@ -0,0 +1,224 @@
+#include <moppe/game/game_session.hh>
+#include <moppe/game/generated_world.hh>
+#include <moppe/game/rider_water.hh>
+#include <moppe/game/session_replay.hh>
+#include <moppe/game/world_cache.hh>
+#include <moppe/mov/vehicle.hh>
+#include <moppe/terrain/world_recipe.hh>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <exception>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Rides a cached world without a window as fast as the simulation allows:
+// each fixed 120 Hz step is advance_game_session alone, so vehicle, glider
+// and walker physics, and the water around the rider, can be measured, and
+// kept deterministic, on a machine with no GPU.
+
+namespace {
+  constexpr float step_seconds = 1.0f / 120.0f;
+
+  int parse_positive_int (std::string_view text, const char* name) {
+    std::size_t consumed = 0;
+    const int value = std::stoi (std::string (text), &consumed);
+    if (consumed != text.size () || value <= 0)
+      throw std::invalid_argument (std::string (name) +
+                                   " must be a positive integer");
+    return value;
+  }
+
+  std::uint32_t parse_seed (std::string_view text) {
+    std::size_t consumed = 0;
+    const unsigned long value = std::stoul (std::string (text), &consumed);
+    if (consumed != text.size () ||
+        value > std::numeric_limits<std::uint32_t>::max ())
+      throw std::invalid_argument ("seed must be a 32-bit unsigned integer");
+    return static_cast<std::uint32_t> (value);
+  }
+
+  moppe::terrain::TerrainGenerationProfile
+  parse_profile (std::string_view text) {
+    using Profile = moppe::terrain::TerrainGenerationProfile;
+    if (text == "smoke")
+      return Profile::Smoke;
+    if (text == "fast")
+      return Profile::Fast;
+    if (text == "play")
+      return Profile::Play;
+    if (text == "research")
+      return Profile::Research;
+    throw std::invalid_argument (
+      "profile must be smoke, fast, play, or research");
+  }
+
+  double microseconds_at (const std::vector<double>& sorted,
+                          double percentile) {
+    const std::size_t index = static_cast<std::size_t> (
+      percentile / 100.0 * static_cast<double> (sorted.size () - 1) + 0.5);
+    return sorted[index];
+  }
+
+  void print_latencies (const char* name, std::vector<double>& latencies) {
+    std::ranges::sort (latencies);
+    std::cout << std::fixed << std::setprecision (2) << name
+              << " latency us: p50 " << microseconds_at (latencies, 50.0)
+              << ", p90 " << microseconds_at (latencies, 90.0)
+              << ", p99 " << microseconds_at (latencies, 99.0) << ", max "
+              << latencies.back () << '\n';
+  }
+}
+
+int main (int argc, char** argv) {
+  using namespace moppe;
+  using namespace moppe::terrain;
+
+  try {
+    if (argc < 5)
+      throw std::invalid_argument (
+        "usage: game-session-benchmark CACHE_DIRECTORY RESOLUTION PROFILE "
+        "SEED [--steps N] [--tape FILE] [--write-tape FILE]");
+    const std::string cache = argv[1];
+    const int resolution = parse_positive_int (argv[2], "resolution");
+    const TerrainGenerationProfile profile = parse_profile (argv[3]);
+    const std::uint32_t seed = parse_seed (argv[4]);
+    int steps = 7200;
+    std::string tape_path;
+    std::string written_tape_path;
+    for (int arg = 5; arg < argc; ++arg) {
+      const std::string_view flag = argv[arg];
+      if (arg + 1 >= argc)
+        throw std::invalid_argument (std::string (flag) + " needs a value");
+      if (flag == "--steps")
+        steps = parse_positive_int (argv[++arg], "steps");
+      else if (flag == "--tape")
+        tape_path = argv[++arg];
+      else if (flag == "--write-tape")
+        written_tape_path = argv[++arg];
+      else
+        throw std::invalid_argument ("unknown option " + std::string (flag));
+    }
+
+    const WorldRecipe recipe = make_world_recipe (
+      spatial_extent_in_metres (Vec3 (5000.0f, 320.0f, 5000.0f)),
+      resolution,
+      Seed { seed },
+      50.0f * u::m,
+      profile);
+    const std::unique_ptr<game::GeneratedWorld> world =
+      game::try_load_world_cache (game::WorldParams {}, recipe, cache);
+    if (!world)
+      throw std::runtime_error ("no valid world cache in " + cache +
+                                " (bake one with terrain-cache-bake)");
+    const game::WorldParams& params = world->params ();
+    const map::SurfaceGeometry& surface = world->surface ();
+
+    // As the game prepares a fresh ride on a finished world.
+    const std::vector<mov::Box> obstacles;
+    game::GameSession session (params, surface);
+    session.bike ().set_water_level (params.water_level);
+    session.car ().set_water_level (params.water_level);
+    session.bike ().set_obstacles (&obstacles);
+    session.car ().set_obstacles (&obstacles);
+    session.follow_water (surface, world->water_surface ());
+    session.stars ().generate (surface, params, 80);
+    const game::HomeSpawn home =
+      game::locate_home_spawn (surface, world->trails ());
+    session.bike ().reset (home.position);
+    session.bike ().set_heading (home.heading);
+
+    std::vector<game::InputFrame> tape;
+    if (!tape_path.empty ()) {
+      tape = game::read_input_tape_file (tape_path);
+      if (tape.empty ())
+        throw std::runtime_error ("input tape " + tape_path + " is empty");
+      steps = static_cast<int> (tape.size ());
+    } else {
+      tape.reserve (static_cast<std::size_t> (steps));
+    }
+
+    std::cout << "Riding " << steps << " steps of "
+              << (tape_path.empty () ? "the demo autopilot" : tape_path)
+              << " on " << resolution << "x" << resolution << " "
+              << profile_id (profile) << " seed " << seed << "..."
+              << std::endl;
+
+    using clock = std::chrono::steady_clock;
+    std::vector<double> latencies;
+    latencies.reserve (static_cast<std::size_t> (steps));
+    // The ridden vehicle at every step, for timing the water on its own.
+    std::vector<mov::Vehicle::State> ridden;
+    ridden.reserve (static_cast<std::size_t> (steps));
+    const clock::time_point start = clock::now ();
+    for (int step = 0; step < steps; ++step) {
+      // As MoppeGame::tick does: the clock first, then the step.
+      session.logic ().m_total_time += step_seconds;
+      if (tape_path.empty ())
+        tape.push_back (
+          game::demo_autopilot_input (session.logic ().m_total_time));
+      const clock::time_point before = clock::now ();
+      game::advance_game_session (params,
+                                  surface,
+                                  obstacles,
+                                  session,
+                                  tape[static_cast<std::size_t> (step)],
+                                  seconds (step_seconds));
+      const clock::time_point after = clock::now ();
+      latencies.push_back (
+        std::chrono::duration<double, std::micro> (after - before).count ());
+      ridden.push_back (session.active_vehicle ().state ());
+    }
+    const double elapsed =
+      std::chrono::duration<double> (clock::now () - start).count ();
+
+    // RiderWater::advance alone, over the same ride, at the default window
+    // and band threads the session steps it with.
+    game::RiderWater water (world->water_surface (),
+                            surface,
+                            ridden.front ().position,
+                            seconds (step_seconds));
+    std::vector<double> water_latencies;
+    water_latencies.reserve (ridden.size ());
+    for (const mov::Vehicle::State& vehicle : ridden) {
+      const clock::time_point before = clock::now ();
+      water.advance (vehicle);
+      const clock::time_point after = clock::now ();
+      water_latencies.push_back (
+        std::chrono::duration<double, std::micro> (after - before).count ());
+    }
+
+    std::cout << std::fixed << std::setprecision (0)
+              << "steps/s: " << steps / elapsed << '\n';
+    print_latencies ("step", latencies);
+    std::cout << "rider water: " << game::RiderWaterParams {}.side << "x"
+              << game::RiderWaterParams {}.side << " sites on "
+              << water.band_threads () << " threads\n";
+    print_latencies ("rider water", water_latencies);
+    std::cout << "simulated " << steps * step_seconds << " s in " << elapsed
+              << " s\n"
+              << "final state: " << std::hex << std::setw (16)
+              << std::setfill ('0') << game::game_state_digest (session)
+              << std::dec << std::endl;
+
+    if (!written_tape_path.empty ()) {
+      std::ofstream output (written_tape_path);
+      game::write_input_tape (output, tape);
+      if (!output)
+        throw std::runtime_error ("cannot write input tape " +
+                                  written_tape_path);
+    }
+    return 0;
+  } catch (const std::exception& error) {
+    std::cerr << "game-session-benchmark: " << error.what () << '\n';
+    return -1;
+  }
+}
@@ -0,0 +1,182 @@
+#include <moppe/game/session_replay.hh>
+
+#include <bit>
+#include <cmath>
+#include <fstream>
+#include <istream>
+#include <limits>
+#include <ostream>
+#include <sstream>
+#include <stdexcept>
+
+namespace moppe::game {
+  namespace {
+    constexpr const char* input_tape_header = "moppe-input-tape 1";
+
+    class StateDigest {
+    public:
+      void add (std::uint64_t value) {
+        for (int byte = 0; byte < 8; ++byte) {
+          m_hash ^= (value >> (8 * byte)) & 0xffU;
+          m_hash *= 0x100000001b3ULL;
+        }
+      }
+      void add (float value) {
+        add (static_cast<std::uint64_t> (std::bit_cast<std::uint32_t> (value)));
+      }
+      void add (double value) {
+        add (std::bit_cast<std::uint64_t> (value));
+      }
+      void add (bool value) {
+        add (static_cast<std::uint64_t> (value));
+      }
+      void add (int value) {
+        add (static_cast<std::uint64_t> (static_cast<std::uint32_t> (value)));
+      }
+      void add (const Vec3& value) {
+        add (value[0]);
+        add (value[1]);
+        add (value[2]);
+      }
+
+      std::uint64_t value () const noexcept {
+        return m_hash;
+      }
+
+    private:
+      std::uint64_t m_hash = 0xcbf29ce484222325ULL;
+    };
+
+    void add_vehicle (StateDigest& digest, const mov::Vehicle::State& vehicle) {
+      digest.add (position_value (vehicle.position));
+      digest.add (velocity_value (vehicle.velocity));
+      digest.add (vehicle.heading);
+      digest.add (radians_value (vehicle.yaw));
+      digest.add (vehicle.lean);
+      digest.add (vehicle.susp);
+      digest.add (vehicle.boost_level);
+      digest.add (vehicle.boost_flight);
+    }
+  }
+
+  InputFrame demo_autopilot_input (double total_time) {
+    const float t = static_cast<float> (total_time);
+    InputFrame input;
+    input.turn = 0.35f * std::sin (t * 0.25f);
+    input.drive = 1.0f;
+    input.boost = std::fmod (t, 11.0f) < 1.35f ? 1.0f : 0.0f;
+    return input;
+  }
+
+  void write_input_tape_header (std::ostream& output) {
+    output << input_tape_header << '\n';
+  }
+
+  void write_input_frame (std::ostream& output, const InputFrame& input) {
+    const auto precision =
+      output.precision (std::numeric_limits<float>::max_digits10);
+    output << input_value (input.turn) << ' ' << input_value (input.drive)
+           << ' ' << input_value (input.boost) << ' ' << input.deploy_glider
+           << ' ' << input.deploy_glider_held << ' ' << input.toggle_mount
+           << ' ' << input.cycle_camera << ' ' << input.leave_cinematic
+           << '\n';
+    output.precision (precision);
+  }
+
+  void write_input_tape (std::ostream& output,
+                         std::span<const InputFrame> frames) {
+    write_input_tape_header (output);
+    for (const InputFrame& input : frames)
+      write_input_frame (output, input);
+  }
+
+  std::vector<InputFrame> read_input_tape (std::istream& input) {
+    std::string line;
+    if (!std::getline (input, line) || line != input_tape_header)
+      throw std::runtime_error ("not a moppe input tape");
+
+    std::vector<InputFrame> frames;
+    while (std::getline (input, line)) {
+      if (line.empty ())
+        continue;
+      std::istringstream fields (line);
+      float turn = 0.0f;
+      float drive = 0.0f;
+      float boost = 0.0f;
+      InputFrame frame;
+      fields >> turn >> drive >> boost >> frame.deploy_glider >>
+        frame.deploy_glider_held >> frame.toggle_mount >> frame.cycle_camera >>
+        frame.leave_cinematic;
+      if (!fields || !(fields >> std::ws).eof ())
+        throw std::runtime_error ("malformed input tape frame " +
+                                  std::to_string (frames.size () + 1));
+      frame.turn = turn;
+      frame.drive = drive;
+      frame.boost = boost;
+      frames.push_back (frame);
+    }
+    return frames;
+  }
+
+  std::vector<InputFrame> read_input_tape_file (const std::string& path) {
+    std::ifstream input (path);
+    if (!input)
+      throw std::runtime_error ("cannot open input tape " + path);
+    return read_input_tape (input);
+  }
+
+  namespace {
+    std::uint64_t digest_state (const GameState& state,
+                                const RiderWater* water) {
+      StateDigest digest;
+      const GameLogicState& logic = state.logic;
+      digest.add (logic.m_total_time);
+      digest.add (logic.m_odometer);
+      digest.add (logic.m_health);
+      digest.add (logic.m_lives);
+      digest.add (logic.m_score);
+      digest.add (static_cast<int> (logic.m_mode));
+      digest.add (logic.m_car_exists);
+
+      add_vehicle (digest, state.vehicle);
+      add_vehicle (digest, state.car);
+      digest.add (position_value (state.glider.position));
+      digest.add (velocity_value (state.glider.velocity));
+      digest.add (state.glider.heading);
+      digest.add (radians_value (state.glider.bank));
+      digest.add (position_value (state.walker.position));
+      digest.add (state.walker.heading);
+      digest.add (position_value (state.camera.position));
+      digest.add (position_value (state.camera.target));
+
+      digest.add (static_cast<std::uint64_t> (state.stars.count));
+      digest.add (state.stars.collected);
+      for (std::size_t star = 0; star < state.stars.count; ++star) {
+        digest.add (state.stars.stars[star].position);
+        digest.add (state.stars.stars[star].respawn_at);
+      }
+      digest.add (state.stars.clock);
+      digest.add (state.dust.next_id);
+      digest.add (static_cast<std::uint64_t> (state.dust.emissions.size ()));
+
+      if (water) {
+        const lavoir::water_window& window = water->window ();
+        digest.add (static_cast<std::uint64_t> (window.origin_column ()));
+        digest.add (static_cast<std::uint64_t> (window.origin_row ()));
+        digest.add (static_cast<std::uint64_t> (
+          window.age ().numerical_value_in (lavoir::step)));
+        for (const auto height : window.surface ().values ())
+          digest.add (height.numerical_value_in (mp_units::si::metre));
+      }
+      return digest.value ();
+    }
+  }
+
+  std::uint64_t game_state_digest (const GameState& state) {
+    return digest_state (state, nullptr);
+  }
+
+  std::uint64_t game_state_digest (const GameSession& session) {
+    return digest_state (session.state (), session.rider_water ());
+  }
+}
@@ -0,0 +1,45 @@
+#ifndef MOPPE_GAME_SESSION_REPLAY_HH
+#define MOPPE_GAME_SESSION_REPLAY_HH
+
+#include <moppe/game/game_session.hh>
+#include <moppe/game/game_state.hh>
+#include <moppe/game/input_frame.hh>
+
+#include <cstdint>
+#include <iosfwd>
+#include <span>
+#include <string>
+#include <vector>
+
+// Rides replayed without a window: the inputs of a session, written one fixed
+// step per line, and a digest of where they lead. A tape replays from the
+// home spawn of the world it was recorded on, so the same world and the same
+// tape always arrive at the same state; the digest is how a benchmark or a
+// test says so.
+
+namespace moppe::game {
+  // The demo ride: a lazy arc with periodic boost-assisted leaps, steered by
+  // the session clock alone.
+  InputFrame demo_autopilot_input (double total_time);
+
+  // A text tape: a header line, then one InputFrame per line. Controls are
+  // written with enough digits to read back exactly.
+  void write_input_tape_header (std::ostream& output);
+  void write_input_frame (std::ostream& output, const InputFrame& input);
+  void write_input_tape (std::ostream& output,
+                         std::span<const InputFrame> frames);
+
+  // Throws std::runtime_error for anything but a whole tape.
+  std::vector<InputFrame> read_input_tape (std::istream& input);
+  std::vector<InputFrame> read_input_tape_file (const std::string& path);
+
+  // FNV-1a over the session's logical state: the clock and scores, every
+  // body's pose and motion, the camera, the stars and the dust count. Equal
+  // states give equal digests on any platform with IEEE floats.
+  std::uint64_t game_state_digest (const GameState& state);
+  // The same over a live session, folding in the window of water around the
+  // rider when it has one: where it stands, its age and every height.
+  std::uint64_t game_state_digest (const GameSession& session);
+}
+
+#endif
@@ -17,10 +17,11 @@ namespace moppe {
       result.count = m_stars.size ();
       result.collected = m_collected;
       result.last_position = m_last_pos;
+      result.clock = m_clock;
       for (std::size_t i = 0; i < m_stars.size (); ++i)
         result.stars[i] = { m_stars[i].pos,
                             m_stars[i].phase,
-                            m_stars[i].respawn };
+                            m_stars[i].respawn_at };
       return result;
     }
 
@@ -30,10 +31,11 @@ namespace moppe {
           "star state does not match the generated star set");
       m_collected = state.collected;
       m_last_pos = state.last_position;
+      m_clock = state.clock;
       for (std::size_t i = 0; i < state.count; ++i) {
         m_stars[i].pos = state.stars[i].position;
         m_stars[i].phase = state.stars[i].phase;
-        m_stars[i].respawn = state.stars[i].respawn;
+        m_stars[i].respawn_at = state.stars[i].respawn_at;
       }
     }
 
@@ -51,6 +53,7 @@ namespace moppe {
               (surface.domain ().period_z ()).numerical_value_in (moppe::u::m));
       m_period = size;
       m_collected = 0;
+      m_clock = 0.0f;
 
       m_stars.clear ();
       while ((int)m_stars.size () < count) {
@@ -69,19 +72,21 @@ namespace moppe {
         s.pos[1] = ground + (high ? 14.0f + 8.0f * u (rng) : 2.5f);
         s.home = s.pos;
         s.phase = 360.0f * u (rng);
-        s.respawn = 0;
+        s.respawn_at = 0;
         m_stars.push_back (s);
       }
     }
 
     int Stars::update (const Vec3& vehicle_pos, float, float dt) {
       int picked = 0;
+      m_clock += dt;
       for (size_t i = 0; i < m_stars.size (); ++i) {
         Star& s = m_stars[i];
-        if (s.respawn > 0) {
-          s.respawn -= dt;
-          if (s.respawn <= 0)
+        if (s.respawn_at > 0) {
+          if (m_clock >= s.respawn_at) {
             s.pos = s.home;
+            s.respawn_at = 0;
+          }
           continue;
         }
         Vec3 delta = s.pos - vehicle_pos;
@@ -106,7 +111,7 @@ namespace moppe {
           delta[2] = terrain::minimum_image_delta (delta[2], m_period[2]);
         }
         if (length2 (delta) < 3.0f * 3.0f) {
-          s.respawn = 60.0f; // comes back later
+          s.respawn_at = m_clock + 60.0f; // comes back later
           ++m_collected;
           ++picked;
           m_last_pos = vehicle_pos + delta;
@@ -120,7 +125,7 @@ namespace moppe {
       const float time = seconds_value (env.time);
 
       // One shared ring-and-core mesh and one halo mesh, baked on the
-      // first frame; each visible star is then just two draw calls.
+      // first frame; every visible star is then one instance of each.
       if (!m_body) {
         render::DrawList dl;
         dl.lit (false);
@@ -146,9 +151,11 @@ namespace moppe {
       }
 
       const Vec3 y_axis (0, 1, 0), x_axis (1, 0, 0);
+      m_body_instances.clear ();
+      m_halo_instances.clear ();
       for (size_t i = 0; i < m_stars.size (); ++i) {
         const Star& s = m_stars[i];
-        if (s.respawn > 0)
+        if (s.respawn_at > 0)
           continue;
 
         Vec3 position = s.pos;
@@ -162,17 +169,21 @@ namespace moppe {
           Vec3 (position[0],
                 position[1] + 0.35f * std::sin (time * 2.0f + s.phase),
                 position[2]));
-        r.draw_mesh (
-          *m_body,
-          place * Mat4::rotation ((time * 150.0f + s.phase) * u::deg, y_axis) *
-            Mat4::rotation ((time * 95.0f + s.phase * 0.7f) * u::deg, x_axis),
-          0x100000 + i * 2);
+        m_body_instances.push_back (
+          { .model = place *
+                     Mat4::rotation ((time * 150.0f + s.phase) * u::deg,
+                                     y_axis) *
+                     Mat4::rotation ((time * 95.0f + s.phase * 0.7f) * u::deg,
+                                     x_axis),
+            .motion_id = 0x100000 + i * 2 });
 
         const float pulse = 1.0f + 0.15f * std::sin (time * 2.0f + s.phase);
-        r.draw_mesh (*m_halo,
-                     place * Mat4::scaling (Vec3 (pulse, pulse, pulse)),
-                     0x100001 + i * 2);
+        m_halo_instances.push_back (
+          { .model = place * Mat4::scaling (Vec3 (pulse, pulse, pulse)),
+            .motion_id = 0x100001 + i * 2 });
       }
+      r.draw_mesh_instances (*m_body, m_body_instances);
+      r.draw_mesh_instances (*m_halo, m_halo_instances);
     }
   }
 }
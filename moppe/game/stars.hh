@@ -18,10 +18,13 @@ namespace moppe {
     public:
       static constexpr std::size_t MAX_STARS = 250;
 
+      // A collected star keeps the time it comes back, on the stars' own
+      // clock, rather than counting down, so it stays unchanged while it
+      // waits. Zero while the star is out.
       struct StarState {
         Vec3 position {};
         float phase = 0.0f;
-        float respawn = 0.0f;
+        float respawn_at = 0.0f;
       };
 
       struct State {
@@ -29,6 +32,7 @@ namespace moppe {
         std::size_t count = 0;
         int collected = 0;
         Vec3 last_position {};
+        float clock = 0.0f;
       };
 
       Stars ();
@@ -57,15 +61,20 @@ namespace moppe {
         Vec3 home;
         Vec3 pos;
         float phase;
-        float respawn;
+        float respawn_at;
       };
 
       std::vector<Star> m_stars;
       render::MeshPtr m_body;
       render::MeshPtr m_halo;
+      // Per-frame placements, kept to reuse their storage.
+      std::vector<render::InstanceTransform> m_body_instances;
+      std::vector<render::InstanceTransform> m_halo_instances;
       int m_collected;
       Vec3 m_last_pos;
       Vec3 m_period;
+      // Seconds of updates since the stars were generated.
+      float m_clock = 0.0f;
     };
   }
 }
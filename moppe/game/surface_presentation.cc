@@ -3,6 +3,9 @@
 #include <moppe/profile.hh>
 #include <moppe/render/texture_pixels.hh>
 
+#include <concepts>
+#include <cstdint>
+
 namespace moppe::game {
   namespace {
     struct TerrainMaterialSource {
@@ -11,9 +14,32 @@ namespace moppe::game {
       bool include_forest;
     };
 
+    // A reading's decoded value, for lanes whose format differs from the
+    // column's encoding.
+    template <typename Column>
+    auto decoded_lane (const Column& column) {
+      return [&column] (std::size_t pixel) {
+        return render::detail::stored_scalar (column[pixel]);
+      };
+    }
+
+    // An 8-bit reading over the unit interval is already an rgba8unorm lane,
+    // byte for byte, so that format takes its codes as they are stored.
+    template <typename Column>
+    render::LaneCodes<std::uint8_t> stored_lane (const Column& column) {
+      static_assert (
+        std::same_as<typename Column::encoding, spatial::Unorm8<>>,
+        "only unit-interval 8-bit readings are texture lanes as stored");
+      return { column.codes () };
+    }
+
+    // Both material textures are four readings side by side. The readings
+    // are fixed here; the per-format packing is chosen once per upload.
     void write_landscape_materials (const void* opaque,
                                     render::PixelFormat format,
-                                    std::byte* destination) {
+                                    std::byte* destination,
+                                    std::size_t first_row,
+                                    std::size_t last_row) {
       const auto& source = *static_cast<const TerrainMaterialSource*> (opaque);
       const auto& moisture =
         spatial::get<map::surface_moisture> (source.readings);
@@ -22,26 +48,36 @@ namespace moppe::game {
       const auto& deposition =
         spatial::get<map::deposition_cover> (source.readings);
       const auto& forest = spatial::get<map::forest_cover> (source.readings);
-      const std::size_t stride = render::bytes_per_pixel (format);
-      for (std::size_t pixel = 0; pixel < moisture.size (); ++pixel) {
-        std::byte* at = destination + pixel * stride;
-        render::detail::write_channel (
-          at, format, render::detail::stored_scalar (moisture[pixel]));
-        render::detail::write_channel (
-          at + 1, format, render::detail::stored_scalar (erosion[pixel]));
-        render::detail::write_channel (
-          at + 2, format, render::detail::stored_scalar (deposition[pixel]));
-        render::detail::write_channel (
-          at + 3,
-          format,
-          source.include_forest ? render::detail::stored_scalar (forest[pixel])
-                                : 0.0f);
-      }
+      const bool include_forest = source.include_forest;
+      const auto forest_lane = [&] (std::size_t pixel) {
+        return include_forest ? render::detail::stored_scalar (forest[pixel])
+                              : 0.0f;
+      };
+      const auto pack = [&] (const auto&... lanes) {
+        render::pack_rows (format,
+                           destination,
+                           source.readings.domain ().width (),
+                           first_row,
+                           last_row,
+                           lanes...);
+      };
+      if (format == render::PixelFormat::rgba8unorm)
+        pack (decoded_lane (moisture),
+              stored_lane (erosion),
+              stored_lane (deposition),
+              forest_lane);
+      else
+        pack (decoded_lane (moisture),
+              decoded_lane (erosion),
+              decoded_lane (deposition),
+              forest_lane);
     }
 
     void write_ground_materials (const void* opaque,
                                  render::PixelFormat format,
-                                 std::byte* destination) {
+                                 std::byte* destination,
+                                 std::size_t first_row,
+                                 std::size_t last_row) {
       const auto& source = *static_cast<const TerrainMaterialSource*> (opaque);
       const auto& shore =
         spatial::get<map::waterline_distance> (source.readings);
@@ -49,22 +85,31 @@ namespace moppe::game {
       const auto& trail = spatial::get<map::trail_influence> (source.readings);
       const auto& home =
         spatial::get<map::home_base_influence> (source.readings);
-      const std::size_t stride = render::bytes_per_pixel (format);
-      for (std::size_t pixel = 0; pixel < shore.size (); ++pixel) {
-        std::byte* at = destination + pixel * stride;
-        const float shore_fraction =
-          render::detail::stored_scalar (shore[pixel]) /
-          render::terrain_shore_band_metres;
-        render::detail::write_channel (at, format, shore_fraction);
-        render::detail::write_channel (
-          at + 1, format, render::detail::stored_scalar (snow[pixel]));
-        render::detail::write_channel (
-          at + 2, format, render::detail::stored_scalar (trail[pixel]));
-        render::detail::write_channel (
-          at + 3, format, render::detail::stored_scalar (home[pixel]));
-      }
+      // The shore lane is the distance across the shore band, not the
+      // distance itself, so it is always converted.
+      const auto shore_lane = [&] (std::size_t pixel) {
+        return render::detail::stored_scalar (shore[pixel]) /
+               render::terrain_shore_band_metres;
+      };
+      const auto pack = [&] (const auto&... lanes) {
+        render::pack_rows (format,
+                           destination,
+                           source.readings.domain ().width (),
+                           first_row,
+                           last_row,
+                           lanes...);
+      };
+      if (format == render::PixelFormat::rgba8unorm)
+        pack (shore_lane,
+              decoded_lane (snow),
+              stored_lane (trail),
+              stored_lane (home));
+      else
+        pack (shore_lane,
+              decoded_lane (snow),
+              decoded_lane (trail),
+              decoded_lane (home));
     }
-
   }
 
   void upload_surface_readings (render::Renderer& renderer,
@@ -97,34 +97,87 @@ namespace moppe {
       m_chunks.clear ();
       m_chunks.reserve ((size_t)chunks_per_side * chunks_per_side);
       for (int cz = 0; cz < chunks_per_side; ++cz)
-        for (int cx = 0; cx < chunks_per_side; ++cx) {
-          float ymin = 1e9f, ymax = -1e9f;
-          for (int z = cz * CHUNK; z <= (cz + 1) * CHUNK; ++z)
-            for (int x = cx * CHUNK; x <= (cx + 1) * CHUNK; ++x) {
-              const float h = terrain::surface_elevation_value (
-                spatial::get<terrain::surface_elevation> (
-                  surface[terrain::TerrainIndex {
-                    static_cast<std::size_t> (terrain::wrap_index (
-                      x, static_cast<int> (surface.domain ().width ()))),
-                    static_cast<std::size_t> (terrain::wrap_index (
-                      z, static_cast<int> (surface.domain ().height ()))) }]));
-              ymin = std::min (ymin, h);
-              ymax = std::max (ymax, h);
-            }
+        for (int cx = 0; cx < chunks_per_side; ++cx)
+          m_chunks.push_back (bound_chunk (surface, cx, cz));
+    }
+
+    void Terrain::update_region (render::Renderer& r,
+                                 const map::SurfaceGeometry& surface,
+                                 const terrain::TerrainRect& changed) {
+      MOPPE_PROFILE_ZONE ("Terrain::update_region");
+      if (changed.empty ())
+        return;
+      r.update_terrain_region (
+        changed,
+        spatial::get<terrain::surface_elevation> (surface),
+        spatial::get<terrain::terrain_normal> (surface));
+
+      // A chunk spans CHUNK + 1 samples, sharing its last row and column
+      // with the next chunk (and, at the seam, with the first), so a changed
+      // sample on a chunk boundary belongs to both. A lattice narrower than
+      // a chunk, or a terrain never set up, has no bounds to refresh.
+      const int chunks_per_side =
+        static_cast<int> (surface.domain ().width ()) / CHUNK;
+      if (m_chunks.empty () || chunks_per_side == 0)
+        return;
+      const auto touched = [&] (std::size_t first, std::size_t count) {
+        std::vector<bool> chunks (chunks_per_side, false);
+        for (std::size_t sample = first; sample < first + count; ++sample) {
+          const int chunk = static_cast<int> (sample) / CHUNK;
+          if (chunk < chunks_per_side)
+            chunks[chunk] = true;
+          if (sample % CHUNK == 0 && chunks_per_side > 0)
+            chunks[(chunk + chunks_per_side - 1) % chunks_per_side] = true;
+        }
+        return chunks;
+      };
+      std::vector<bool> stale (m_chunks.size (), false);
+      surface.domain ().visit_unwrapped (
+        changed, [&] (const terrain::TerrainRect& piece) {
+          const std::vector<bool> columns =
+            touched (piece.origin.column, piece.columns);
+          const std::vector<bool> rows = touched (piece.origin.row, piece.rows);
+          for (int cz = 0; cz < chunks_per_side; ++cz)
+            for (int cx = 0; cx < chunks_per_side; ++cx)
+              if (rows[cz] && columns[cx])
+                stale[(size_t)cz * chunks_per_side + cx] = true;
+        });
+      for (int cz = 0; cz < chunks_per_side; ++cz)
+        for (int cx = 0; cx < chunks_per_side; ++cx)
+          if (stale[(size_t)cz * chunks_per_side + cx])
+            m_chunks[(size_t)cz * chunks_per_side + cx] =
+              bound_chunk (surface, cx, cz);
+    }
 
-          Chunk c;
-          c.x0 = cx * CHUNK;
-          c.z0 = cz * CHUNK;
-          const float x0 = c.x0 * m_scale[0];
-          const float x1 = (c.x0 + CHUNK) * m_scale[0];
-          const float z0 = c.z0 * m_scale[2];
-          const float z1 = (c.z0 + CHUNK) * m_scale[2];
-          c.center = Vec3 ((x0 + x1) / 2, (ymin + ymax) / 2, (z0 + z1) / 2);
-          const float hx = (x1 - x0) / 2, hy = (ymax - ymin) / 2,
-                      hz = (z1 - z0) / 2;
-          c.radius = std::sqrt (hx * hx + hy * hy + hz * hz);
-          m_chunks.push_back (c);
+    Terrain::Chunk Terrain::bound_chunk (const map::SurfaceGeometry& surface,
+                                         int cx,
+                                         int cz) const {
+      float ymin = 1e9f, ymax = -1e9f;
+      for (int z = cz * CHUNK; z <= (cz + 1) * CHUNK; ++z)
+        for (int x = cx * CHUNK; x <= (cx + 1) * CHUNK; ++x) {
+          const float h = terrain::surface_elevation_value (
+            spatial::get<terrain::surface_elevation> (
+              surface[terrain::TerrainIndex {
+                static_cast<std::size_t> (terrain::wrap_index (
+                  x, static_cast<int> (surface.domain ().width ()))),
+                static_cast<std::size_t> (terrain::wrap_index (
+                  z, static_cast<int> (surface.domain ().height ()))) }]));
+          ymin = std::min (ymin, h);
+          ymax = std::max (ymax, h);
         }
+
+      Chunk c;
+      c.x0 = cx * CHUNK;
+      c.z0 = cz * CHUNK;
+      const float x0 = c.x0 * m_scale[0];
+      const float x1 = (c.x0 + CHUNK) * m_scale[0];
+      const float z0 = c.z0 * m_scale[2];
+      const float z1 = (c.z0 + CHUNK) * m_scale[2];
+      c.center = Vec3 ((x0 + x1) / 2, (ymin + ymax) / 2, (z0 + z1) / 2);
+      const float hx = (x1 - x0) / 2, hy = (ymax - ymin) / 2,
+                  hz = (z1 - z0) / 2;
+      c.radius = std::sqrt (hx * hx + hy * hy + hz * hz);
+      return c;
     }
 
     void Terrain::render_shadow (render::Renderer& r,
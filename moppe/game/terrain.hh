@@ -24,6 +24,14 @@ namespace moppe {
                   const WorldParams& world,
                   const GraphicsSettings& graphics);
 
+      // Follows a local height edit without a full setup: re-uploads the
+      // samples in `changed` (normally map::GeometryChange::normals) and
+      // recomputes the bounds of the chunks they fall in. The material
+      // bands keep the land relief measured at setup.
+      void update_region (render::Renderer& r,
+                          const map::SurfaceGeometry& surface,
+                          const terrain::TerrainRect& changed);
+
       // Renders the one-time shadow map.  sun_dir points toward the
       // sun, world space.
       void render_shadow (render::Renderer& r,
@@ -53,6 +61,9 @@ namespace moppe {
         float radius;
       };
 
+      Chunk
+      bound_chunk (const map::SurfaceGeometry& surface, int cx, int cz) const;
+
       std::vector<Chunk> m_chunks;
       std::vector<render::ChunkDraw> m_draws;
       Vec3 m_scale;
@@ -0,0 +1,232 @@
+#include <moppe/game/world_batch.hh>
+
+#include <moppe/game/generated_world.hh>
+#include <moppe/profile.hh>
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <condition_variable>
+#include <exception>
+#include <iomanip>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <ostream>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace moppe::game {
+  namespace {
+    // Geometry and readings, the evolution's working columns, and the flood,
+    // drainage and river graphs over every cell, with room to spare. Erring
+    // high only costs concurrency; erring low costs the machine.
+    constexpr std::size_t world_batch_bytes_per_cell = 1024;
+
+    // Admits worlds while their estimated peaks fit in the budget.
+    class MemoryAdmission {
+    public:
+      explicit MemoryAdmission (std::size_t budget) : m_budget (budget) {}
+
+      void acquire (std::size_t bytes) {
+        std::unique_lock<std::mutex> lock (m_mutex);
+        m_released.wait (lock, [&] {
+          return m_in_use == 0 || m_in_use + bytes <= m_budget;
+        });
+        m_in_use += bytes;
+      }
+
+      void release (std::size_t bytes) {
+        {
+          const std::lock_guard<std::mutex> lock (m_mutex);
+          m_in_use -= bytes;
+        }
+        m_released.notify_all ();
+      }
+
+    private:
+      const std::size_t m_budget;
+      std::size_t m_in_use = 0;
+      std::mutex m_mutex;
+      std::condition_variable m_released;
+    };
+
+    // Results finish in any order and leave in recipe order.
+    class OrderedSink {
+    public:
+      explicit OrderedSink (const WorldBatchSink& sink) : m_sink (sink) {}
+
+      void deliver (WorldBatchResult result) {
+        const std::lock_guard<std::mutex> lock (m_mutex);
+        const std::size_t index = result.index;
+        m_waiting.emplace (index, std::move (result));
+        for (auto next = m_waiting.begin ();
+             next != m_waiting.end () && next->first == m_next;
+             next = m_waiting.erase (next), ++m_next)
+          m_sink (next->second);
+      }
+
+    private:
+      const WorldBatchSink& m_sink;
+      std::map<std::size_t, WorldBatchResult> m_waiting;
+      std::size_t m_next = 0;
+      std::mutex m_mutex;
+    };
+
+    // A reused surface must start exactly as a new one would.
+    template <typename Domain, typename... Quantities>
+    void clear_columns (spatial::Bundle<Domain, Quantities...>& bundle) {
+      [&]<std::size_t... Column> (std::index_sequence<Column...>) {
+        (std::ranges::fill (spatial::get<Column> (bundle), Quantities {}),
+         ...);
+      }(std::index_sequence_for<Quantities...> {});
+    }
+
+    // What a worker keeps from one world to the next of the same lattice.
+    struct BatchWorkspace {
+      std::optional<map::SurfaceGeometry> surface;
+      std::optional<terrain::StreamPowerWorkspace> evolution;
+    };
+
+    map::SurfaceGeometry& batch_surface (BatchWorkspace& workspace,
+                                         const terrain::WorldRecipe& recipe) {
+      const std::size_t resolution =
+        static_cast<std::size_t> (recipe.resolution ());
+      terrain::TerrainDomain domain (resolution, resolution, recipe.extent ());
+      if (!workspace.evolution || workspace.evolution->domain != domain)
+        workspace.evolution.emplace (domain);
+      if (workspace.surface && workspace.surface->domain () == domain)
+        clear_columns (*workspace.surface);
+      else
+        workspace.surface.emplace (std::move (domain));
+      return *workspace.surface;
+    }
+
+    WorldBatchResult
+    generate_batch_world (std::size_t index,
+                          const terrain::WorldRecipe& recipe,
+                          BatchWorkspace& workspace) {
+      MOPPE_PROFILE_ZONE ("WorldBatch::generate_world");
+      const auto start = std::chrono::steady_clock::now ();
+      WorldBatchResult result { .index = index };
+      map::SurfaceGeometry& surface = batch_surface (workspace, recipe);
+      const auto uplift = map::initialize_terrain (
+        surface, recipe.seed (), recipe.water_datum ());
+      result.evolution = map::evolve_terrain (
+        surface, *workspace.evolution, uplift, recipe.evolution ());
+      map::form_terrain_trails (surface, recipe.trail_formation ());
+      map::rebuild_geometry (surface);
+      const Hydrology hydrology = analyze_hydrology (surface, recipe);
+      const auto& [flood, census, drainage, rivers] = hydrology;
+      result.summary =
+        summarize_landscape (surface, flood, census, drainage, rivers, recipe);
+      result.elevation_hash = elevation_hash (surface);
+      result.elapsed_seconds =
+        std::chrono::duration<double> (std::chrono::steady_clock::now () -
+                                       start)
+          .count ();
+      return result;
+    }
+  }
+
+  std::size_t estimated_peak_bytes (const terrain::WorldRecipe& recipe) {
+    const std::size_t resolution =
+      static_cast<std::size_t> (recipe.resolution ());
+    return resolution * resolution * world_batch_bytes_per_cell;
+  }
+
+  std::uint64_t elevation_hash (const map::SurfaceGeometry& surface) {
+    std::uint64_t hash = 0xcbf29ce484222325ULL;
+    for (const terrain::SurfaceElevation elevation :
+         spatial::get<terrain::surface_elevation> (surface)) {
+      std::uint32_t bits = std::bit_cast<std::uint32_t> (
+        terrain::surface_elevation_value (elevation));
+      for (int byte = 0; byte < 4; ++byte, bits >>= 8) {
+        hash ^= bits & 0xffU;
+        hash *= 0x100000001b3ULL;
+      }
+    }
+    return hash;
+  }
+
+  void generate_world_batch (std::span<const terrain::WorldRecipe> recipes,
+                             const WorldBatchConfig& config,
+                             const WorldBatchSink& sink) {
+    MOPPE_PROFILE_ZONE ("WorldBatch::generate");
+    if (recipes.empty ())
+      return;
+    MemoryAdmission admission (config.memory_budget_bytes);
+    OrderedSink ordered (sink);
+    std::atomic<std::size_t> next_recipe = 0;
+
+    // Recipes are claimed in order, so a world waiting for memory is always
+    // the oldest one not yet running, and nothing behind it can starve it.
+    const auto work = [&] {
+      BatchWorkspace workspace;
+      for (;;) {
+        const std::size_t index =
+          next_recipe.fetch_add (1, std::memory_order_relaxed);
+        if (index >= recipes.size ())
+          break;
+        const terrain::WorldRecipe& recipe = recipes[index];
+        const std::size_t bytes = estimated_peak_bytes (recipe);
+        admission.acquire (bytes);
+        WorldBatchResult result;
+        try {
+          result = generate_batch_world (index, recipe, workspace);
+        } catch (const std::exception& error) {
+          // A half-drawn surface is no one's workspace.
+          workspace.surface.reset ();
+          result = WorldBatchResult { .index = index, .error = error.what () };
+        }
+        admission.release (bytes);
+        ordered.deliver (std::move (result));
+      }
+    };
+
+    const std::size_t worker_count =
+      std::clamp<std::size_t> (config.workers, 1, recipes.size ());
+    std::vector<std::jthread> workers;
+    workers.reserve (worker_count - 1);
+    for (std::size_t worker = 1; worker < worker_count; ++worker)
+      workers.emplace_back (work);
+    work ();
+  }
+
+  void write_world_batch_csv_header (std::ostream& output) {
+    output << "index,failed,elevation_hash,elapsed_s,evolution_steps,"
+              "hillslope_sweeps,tectonic_uplift_m3,eroded_m3,deposited_m3,"
+              "exported_sediment_m3,sediment_balance_residual_m3,"
+              "final_step_mean_change_m,final_step_maximum_change_m,";
+    write_landscape_summary_columns (output);
+    output << '\n';
+  }
+
+  void write_world_batch_csv_row (std::ostream& output,
+                                  const WorldBatchResult& result) {
+    constexpr auto cubic_metre =
+      mp_units::si::metre * mp_units::si::metre * mp_units::si::metre;
+    const terrain::StreamPowerEvolutionReport& report = result.evolution;
+    output << std::setprecision (12) << result.index << ','
+           << (result.error.empty () ? 0 : 1) << ',' << std::hex
+           << result.elevation_hash << std::dec << ','
+           << result.elapsed_seconds
+           << ',' << terrain::count_value (report.steps) << ','
+           << terrain::count_value (report.hillslope_sweeps) << ','
+           << report.tectonic_uplift_volume.numerical_value_in (cubic_metre)
+           << ',' << report.eroded_volume.numerical_value_in (cubic_metre)
+           << ',' << report.deposited_volume.numerical_value_in (cubic_metre)
+           << ','
+           << report.exported_sediment_volume.numerical_value_in (cubic_metre)
+           << ','
+           << report.sediment_balance_residual.numerical_value_in (cubic_metre)
+           << ','
+           << report.final_step_mean_change.numerical_value_in (u::m) << ','
+           << report.final_step_maximum_change.numerical_value_in (u::m)
+           << ',';
+    write_landscape_summary_values (output, result.summary);
+    output << '\n';
+  }
+}
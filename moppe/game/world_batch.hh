@@ -0,0 +1,73 @@
+#ifndef MOPPE_GAME_WORLD_BATCH_HH
+#define MOPPE_GAME_WORLD_BATCH_HH
+
+#include <moppe/game/landscape_summary.hh>
+#include <moppe/map/surface.hh>
+#include <moppe/terrain/stream_power_evolution.hh>
+#include <moppe/terrain/world_recipe.hh>
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iosfwd>
+#include <span>
+#include <string>
+
+// Many worlds in one process. A quality sweep over hundreds of seeds wants
+// each world's identity and measurements, not a playable world: the batch
+// runs the generation pipeline as far as the summary reaches -- geology,
+// evolution, trails, geometry and hydrology -- and skips the painted water,
+// readings and forest a game would go on to build.
+//
+// Several worlds run at once, each on its own worker, but only as many as
+// their estimated peaks allow inside one memory budget. A worker keeps the
+// surface it last generated and draws the next world of the same lattice
+// into it rather than allocating a new one.
+
+namespace moppe::game {
+  struct WorldBatchConfig {
+    // Worlds generated at once. Each world's own row passes already spread
+    // across the machine, so a few concurrent worlds are usually enough.
+    std::size_t workers = 2;
+    // A world is admitted only while its estimated peak fits beside the
+    // worlds already running. A world larger than the whole budget still
+    // runs, alone.
+    std::size_t memory_budget_bytes = std::size_t (8) << 30;
+  };
+
+  struct WorldBatchResult {
+    // Position of the recipe in the batch.
+    std::size_t index = 0;
+    // Identifies the finished heightfield, so two sweeps can be compared
+    // world by world without keeping the worlds.
+    std::uint64_t elevation_hash = 0;
+    terrain::StreamPowerEvolutionReport evolution;
+    LandscapeSummary summary;
+    double elapsed_seconds = 0.0;
+    // Empty unless this world failed; one failed world does not stop the
+    // rest of the batch.
+    std::string error;
+  };
+
+  // Called once per recipe, in recipe order, never from two threads at once.
+  using WorldBatchSink = std::function<void (const WorldBatchResult&)>;
+
+  // A generous allowance for what one world holds at its peak.
+  std::size_t estimated_peak_bytes (const terrain::WorldRecipe& recipe);
+
+  // FNV-1a over the bits of every elevation sample, in storage order: the
+  // same ledger terrain-orogeny-benchmark prints.
+  std::uint64_t elevation_hash (const map::SurfaceGeometry& surface);
+
+  void generate_world_batch (std::span<const terrain::WorldRecipe> recipes,
+                             const WorldBatchConfig& config,
+                             const WorldBatchSink& sink);
+
+  // One line per world: its position, identity, timing and evolution
+  // ledger, then the landscape summary's own columns.
+  void write_world_batch_csv_header (std::ostream& output);
+  void write_world_batch_csv_row (std::ostream& output,
+                                  const WorldBatchResult& result);
+}
+
+#endif
@@ -20,9 +20,12 @@ namespace moppe::game {
   namespace {
     constexpr std::array<char, 12> CACHE_MAGIC { 'M', 'O', 'P', 'P', 'E', 'W',
                                                  'O', 'R', 'L', 'D', '0', '1' };
-    // Version 13 reconstructs the full hillslope gradient before applying the
-    // nonlinear transport law. Version 12 used one cardinal component.
-    constexpr std::uint32_t CACHE_VERSION = 13;
+    // Version 16 measures lake bodies in scan order rather than flood-fill
+    // order. Version 15 stores the forest plan as an Arrow bundle beside the
+    // others. Version 14 records the coarse-to-fine evolution schedule.
+    // Version 13 reconstructs the full hillslope gradient before applying
+    // the nonlinear transport law. Version 12 used one cardinal component.
+    constexpr std::uint32_t CACHE_VERSION = 16;
 
     std::string recipe_cache_identity (const terrain::WorldRecipe& recipe) {
       const Vec3 extent = extent_value (recipe.extent ());
@@ -59,6 +62,11 @@ namespace moppe::game {
                 recipe.evolution ()
                   .maximum_hillslope_diffusivity_multiplier.numerical_value_in (
                     mp_units::one));
+      const terrain::CoarseToFineEvolution& schedule =
+        recipe.evolution ().coarse_to_fine;
+      if (schedule.enabled ())
+        name << "-coarse-" << schedule.coarse_levels << '-'
+             << schedule.fine_steps;
       return name.str ();
     }
 
@@ -224,6 +232,10 @@ namespace moppe::game {
         recipe.evolution ()
           .maximum_hillslope_diffusivity_multiplier.numerical_value_in (
             mp_units::one));
+      output.scalar (static_cast<std::uint32_t> (
+        recipe.evolution ().coarse_to_fine.coarse_levels));
+      output.scalar (static_cast<std::uint32_t> (
+        recipe.evolution ().coarse_to_fine.fine_steps));
     }
 
     bool read_recipe (BinaryReader& input, const terrain::WorldRecipe& recipe) {
@@ -240,6 +252,8 @@ namespace moppe::game {
       float concentration_at_unit_slope = 0.0f;
       float critical_hillslope_gradient = 0.0f;
       float maximum_hillslope_multiplier = 0.0f;
+      std::uint32_t coarse_levels = 0;
+      std::uint32_t fine_steps = 0;
       if (!input.bytes (magic.data (), magic.size ()) ||
           !input.scalar (version) || !input.scalar (resolution) ||
           !input.scalar (seed) || !input.scalar (profile))
@@ -256,6 +270,7 @@ namespace moppe::game {
              input.scalar (concentration_at_unit_slope) &&
              input.scalar (critical_hillslope_gradient) &&
              input.scalar (maximum_hillslope_multiplier) &&
+             input.scalar (coarse_levels) && input.scalar (fine_steps) &&
              magic == CACHE_MAGIC && version == CACHE_VERSION &&
              resolution == static_cast<std::uint32_t> (recipe.resolution ()) &&
              seed == recipe.seed ().value &&
@@ -283,7 +298,12 @@ namespace moppe::game {
              maximum_hillslope_multiplier ==
                recipe.evolution ()
                  .maximum_hillslope_diffusivity_multiplier.numerical_value_in (
-                   mp_units::one);
+                   mp_units::one) &&
+             coarse_levels ==
+               static_cast<std::uint32_t> (
+                 recipe.evolution ().coarse_to_fine.coarse_levels) &&
+             fine_steps == static_cast<std::uint32_t> (
+                             recipe.evolution ().coarse_to_fine.fine_steps);
     }
 
     void write_flood (BinaryWriter& output, const terrain::FloodField& flood) {
@@ -601,7 +621,7 @@ namespace moppe::game {
 
     const std::uint32_t forest_seed = recipe.seed ().value ^ 0xa34c91e5U;
     std::optional<ForestPlan> forest =
-      try_load_forest_plan (file_in (directory, "forest-plan.bin").string (),
+      try_load_forest_plan (file_in (directory, "forest.arrows").string (),
                             forest_seed,
                             forest_period (domain));
     if (!forest)
@@ -632,8 +652,7 @@ namespace moppe::game {
     save_bundle (world.readings (), file_in (directory, "readings.arrows"));
     save_bundle (world.trails ().use, file_in (directory, "trail-use.arrows"));
     save_forest_plan (world.forest (),
-                      world.recipe ().seed ().value ^ 0xa34c91e5U,
-                      file_in (directory, "forest-plan.bin").string ());
+                      file_in (directory, "forest.arrows").string ());
 
     BinaryWriter topology (file_in (directory, "topology.bin"));
     write_recipe (topology, world.recipe ());
@@ -9,6 +9,7 @@
 
 #include <moppe/game/world_cache.hh>
 
+#include <moppe/memory.hh>
 #include <moppe/platform/platform.hh>
 #include <moppe/profile.hh>
 
@@ -20,6 +21,8 @@
 #include <bit>
 #include <cmath>
 #include <cstdlib>
+#include <filesystem>
+#include <fstream>
 #include <iostream>
 #include <memory>
 #include <mutex>
@@ -77,8 +80,15 @@ namespace moppe::game {
            << bits (
                 recipe.evolution ()
                   .maximum_hillslope_diffusivity_multiplier.numerical_value_in (
-                    mp_units::one))
-           << ".arrows";
+                    mp_units::one));
+      // Worlds evolved wholly at full resolution keep the names they always
+      // had; a coarse-to-fine schedule is part of any other world's key.
+      const terrain::CoarseToFineEvolution& schedule =
+        recipe.evolution ().coarse_to_fine;
+      if (schedule.enabled ())
+        name << "-coarse-" << schedule.coarse_levels << '-'
+             << schedule.fine_steps;
+      name << ".arrows";
       return platform::cache_path (name.str ());
     }
 
@@ -101,7 +111,8 @@ namespace moppe::game {
         recipe.evolution ().critical_hillslope_gradient ==
           1.0f * proportion[mp_units::one] &&
         recipe.evolution ().maximum_hillslope_diffusivity_multiplier ==
-          1.0f * proportion[mp_units::one];
+          1.0f * proportion[mp_units::one] &&
+        !recipe.evolution ().coarse_to_fine.enabled ();
       if (is_apple_tv_default)
         return platform::asset_path (MOPPE_BUNDLED_WORLD_CACHE);
 #else
@@ -116,9 +127,11 @@ namespace moppe::game {
   class WorldLoadingState {
   public:
     WorldLoadingState (const terrain::WorldRecipe& initial_recipe,
-                       WorldCacheConfig initial_cache_config)
+                       WorldCacheConfig initial_cache_config,
+                       bool initial_progressive)
         : seed (initial_recipe.seed ().value), clock_start (platform::now ()),
-          cache_config (std::move (initial_cache_config)) {}
+          cache_config (std::move (initial_cache_config)),
+          progressive (initial_progressive) {}
 
     // Everything the mutex guards, resettable in one assignment.
     struct Shared {
@@ -126,6 +139,7 @@ namespace moppe::game {
       std::string detail;
       float progress = -1.0f;
       std::vector<LoadingEvent> events;
+      std::unique_ptr<GeneratedWorld> preview_world;
       std::unique_ptr<GeneratedWorld> completed_world;
     };
 
@@ -165,6 +179,11 @@ namespace moppe::game {
       shared.completed_world = std::move (world);
     }
 
+    void publish_preview (std::unique_ptr<GeneratedWorld> world) {
+      const std::lock_guard<std::mutex> lock (mutex);
+      shared.preview_world = std::move (world);
+    }
+
     // Written at reset, read from both threads.
     std::atomic<std::uint32_t> seed;
     double clock_start;
@@ -172,6 +191,7 @@ namespace moppe::game {
     std::atomic<bool> in_flight = false;
 
     const WorldCacheConfig cache_config;
+    const bool progressive;
 
     // Main-thread only.
     bool capture_done = false;
@@ -277,14 +297,135 @@ namespace moppe::game {
                 << wet << " wet cells\n";
     }
 
+    double megabytes (std::size_t bytes) {
+      return static_cast<double> (bytes) / double (1 << 20);
+    }
+
+    // Where the world's memory went, stage by stage, and what the finished
+    // world holds. MOPPE_MEMORY_REPORT names a file for the world's ledger,
+    // largest entry first; the stages follow below it.
+    void log_memory (const memory::StageMemoryReport& stages,
+                     const GeneratedWorld& world) {
+      for (const memory::StageMemory& stage : stages.stages ())
+        std::cerr << "moppe: memory: stage=" << stage.stage
+                  << " resident=" << megabytes (stage.resident.current_bytes)
+                  << "MB peak=" << megabytes (stage.resident.peak_bytes)
+                  << "MB transient-peak="
+                  << megabytes (stage.transient_peak_bytes) << "MB\n";
+      memory::Ledger ledger = account_memory (world);
+      std::cerr << "moppe: memory: world=" << megabytes (ledger.total_bytes ())
+                << "MB in " << ledger.entries ().size () << " entries"
+                << std::endl;
+      if (const char* path = ::getenv ("MOPPE_MEMORY_REPORT")) {
+        ledger.sort_by_size ();
+        std::ofstream report (path);
+        memory::write_ledger_csv (report, ledger);
+        report << '\n';
+        memory::write_stage_memory_csv (report, stages);
+        if (!report)
+          std::cerr << "moppe: memory report not written: " << path
+                    << std::endl;
+      }
+    }
+
     struct GenerationJob {
       std::shared_ptr<WorldLoadingState> state;
       WorldParams params;
       terrain::WorldRecipe recipe;
     };
 
-    // The whole build, in order. The surface comes from the cache or is
-    // evolved fresh; then water analysis and final assembly follow.
+    // A quarter of the full lattice is enough to ride on and costs about a
+    // sixteenth of the work. Small worlds are quick enough already and get
+    // no preview.
+    constexpr int minimum_preview_resolution = 128;
+
+    int preview_resolution (const terrain::WorldRecipe& recipe) {
+      const int preview = recipe.resolution () / 4;
+      return preview >= minimum_preview_resolution ? preview : 0;
+    }
+
+    // One world from its recipe: the surface comes from the terrain cache or
+    // is evolved fresh, then water analysis and final assembly follow. An
+    // empty cache path neither reads nor writes saved terrain.
+    std::unique_ptr<GeneratedWorld>
+    generate_world (WorldLoadingState& state,
+                    const WorldParams& params,
+                    const terrain::WorldRecipe& recipe,
+                    const std::string& cache) {
+      MOPPE_PROFILE_ZONE ("WorldLoading::generate_world");
+      memory::StageMemoryReport stages;
+      map::SurfaceGeometry surface =
+        map::SurfaceGeometry (terrain::TerrainDomain (
+          recipe.resolution (), recipe.resolution (), recipe.extent ()));
+      std::optional<terrain::TrailNetwork> evolved_trails;
+
+      bool saved = false;
+      if (!cache.empty ()) {
+        state.report ("Looking for saved terrain",
+                      "Checking this build, profile, and seed");
+        saved = map::try_load_cache (surface, cache);
+      }
+      if (saved) {
+        std::cerr << "moppe: terrain cache: local=" << cache << std::endl;
+        state.report ("Reading saved terrain",
+                      "Reusing the finished heightfield");
+      } else {
+        state.report ("Drawing the continents",
+                      "Materializing the geological field");
+        evolved_trails = evolve_terrain (state, recipe, surface);
+        if (!cache.empty ()) {
+          state.report ("Saving the terrain",
+                        "Keeping this expensive result for the next launch");
+          map::save_cache (surface, cache);
+        }
+      }
+      stages.mark (saved ? "load" : "evolution");
+
+      state.report ("Calculating slopes",
+                    "Rebuilding normals and broad surface readings");
+      map::rebuild_geometry (surface);
+      stages.mark ("geometry");
+
+      Hydrology hydrology =
+        analyze_hydrology (surface, recipe, [&state] (HydrologyStage stage) {
+          const auto [title, detail] = hydrology_report (stage);
+          state.report (title, detail);
+        });
+      log_standing_water (hydrology);
+      stages.mark ("hydrology");
+
+      state.report ("Assembling the world",
+                    "Painting water, moisture, materials, and the opening "
+                    "route");
+      terrain::TrailNetwork trails =
+        evolved_trails
+          ? std::move (*evolved_trails)
+          : terrain::analyze_trail_network (surface, recipe.trail_formation ());
+      auto [water, readings] =
+        analyze_surface (surface, recipe, hydrology, trails.use);
+      stages.mark ("surface");
+
+      state.report ("Planting the forests",
+                    "Choosing the persistent trees across the landscape");
+      ForestPlan forest = plan_global_forest (
+        surface, readings, recipe.seed ().value ^ 0xa34c91e5U);
+      stages.mark ("forest");
+
+      auto world = std::make_unique<GeneratedWorld> (params,
+                                                     recipe,
+                                                     std::move (surface),
+                                                     std::move (hydrology),
+                                                     std::move (water),
+                                                     std::move (trails),
+                                                     std::move (readings),
+                                                     std::move (forest));
+      log_memory (stages, *world);
+      return world;
+    }
+
+    // The whole build, in order. A saved world is used as it is; otherwise
+    // a progressive build rides ahead on a preview, then the full world is
+    // generated and saved.
     void build_world (GenerationJob& job) {
       MOPPE_PROFILE_ZONE ("WorldLoading::build_world");
       WorldLoadingState& state = *job.state;
@@ -325,65 +466,29 @@ namespace moppe::game {
         }
         std::cerr << "moppe: world cache miss: " << world_cache << std::endl;
       }
-      map::SurfaceGeometry surface =
-        map::SurfaceGeometry (terrain::TerrainDomain (
-          recipe.resolution (), recipe.resolution (), recipe.extent ()));
-      std::optional<terrain::TrailNetwork> evolved_trails;
 
       const char* cache_override = ::getenv ("MOPPE_MAPCACHE");
-      const std::string cache =
+      const std::string terrain_cache =
         cache_override ? cache_override : terrain_cache_path (recipe);
 
-      state.report ("Looking for saved terrain",
-                    "Checking this build, profile, and seed");
-      if (map::try_load_cache (surface, cache)) {
-        std::cerr << "moppe: terrain cache: local=" << cache << std::endl;
-        state.report ("Reading saved terrain",
-                      "Reusing the finished heightfield");
-      } else {
-        state.report ("Drawing the continents",
-                      "Materializing the geological field");
-        evolved_trails = evolve_terrain (state, recipe, surface);
-        state.report ("Saving the terrain",
-                      "Keeping this expensive result for the next launch");
-        map::save_cache (surface, cache);
+      // The preview is never saved: it exists only to be ridden until the
+      // full world arrives, which is what the caches are for. Saved terrain
+      // leaves only the analysis to run, which is not worth a preview.
+      if (const int preview = preview_resolution (recipe);
+          state.progressive && preview > 0 &&
+          !std::filesystem::exists (terrain_cache)) {
+        state.report ("Sketching the world",
+                      "A coarse preview to ride while the full world builds");
+        state.publish_preview (generate_world (
+          state, job.params, recipe.with_resolution (preview), {}));
+        std::cerr << "moppe: world preview: resolution=" << preview
+                  << std::endl;
+        state.report ("Building the full world",
+                      "Full-resolution terrain arrives when it is ready");
       }
 
-      state.report ("Calculating slopes",
-                    "Rebuilding normals and broad surface readings");
-      map::rebuild_geometry (surface);
-
-      Hydrology hydrology =
-        analyze_hydrology (surface, recipe, [&state] (HydrologyStage stage) {
-          const auto [title, detail] = hydrology_report (stage);
-          state.report (title, detail);
-        });
-      log_standing_water (hydrology);
-
-      state.report ("Assembling the world",
-                    "Painting water, moisture, materials, and the opening "
-                    "route");
-      terrain::TrailNetwork trails =
-        evolved_trails
-          ? std::move (*evolved_trails)
-          : terrain::analyze_trail_network (surface, recipe.trail_formation ());
-      auto [water, readings] =
-        analyze_surface (surface, recipe, hydrology, trails.use);
-
-      state.report ("Planting the forests",
-                    "Choosing the persistent trees across the landscape");
-      ForestPlan forest = plan_global_forest (
-        surface, readings, recipe.seed ().value ^ 0xa34c91e5U);
-
       std::unique_ptr<GeneratedWorld> world =
-        std::make_unique<GeneratedWorld> (job.params,
-                                          recipe,
-                                          std::move (surface),
-                                          std::move (hydrology),
-                                          std::move (water),
-                                          std::move (trails),
-                                          std::move (readings),
-                                          std::move (forest));
+        generate_world (state, job.params, recipe, terrain_cache);
       if (!world_cache.empty ()) {
         state.report ("Saving the finished world",
                       state.cache_config.key.empty ()
@@ -419,9 +524,10 @@ namespace moppe::game {
   // -- the main-thread facade --------------------------------------------
 
   WorldLoading::WorldLoading (const terrain::WorldRecipe& recipe,
-                              WorldCacheConfig cache_config)
+                              WorldCacheConfig cache_config,
+                              bool progressive)
       : m_state (std::make_shared<WorldLoadingState> (
-          recipe, std::move (cache_config))) {}
+          recipe, std::move (cache_config), progressive)) {}
 
   void WorldLoading::start (const WorldParams& world,
                             terrain::WorldRecipe recipe) {
@@ -453,6 +559,18 @@ namespace moppe::game {
     return std::move (m_state->shared.completed_world);
   }
 
+  std::unique_ptr<GeneratedWorld> WorldLoading::take_preview_world () {
+    const std::lock_guard<std::mutex> lock (m_state->mutex);
+    return std::move (m_state->shared.preview_world);
+  }
+
+  bool WorldLoading::building () const noexcept {
+    if (m_state->in_flight.load ())
+      return true;
+    const std::lock_guard<std::mutex> lock (m_state->mutex);
+    return m_state->shared.completed_world != nullptr;
+  }
+
   LoadingStatus WorldLoading::status () {
     WorldLoadingState& state = *m_state;
     const std::lock_guard<std::mutex> lock (state.mutex);
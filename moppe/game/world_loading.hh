@@ -35,10 +35,16 @@ namespace moppe::game {
   // reports what it is doing; the main thread reads status and takes the
   // finished world.  The worker never borrows the application object that
   // requested the build.
+  //
+  // A progressive loader that finds no saved world first builds a preview:
+  // the same recipe on a lattice a quarter as fine, ready in a fraction of
+  // the time.  The preview is published as soon as it is finished, and the
+  // full world follows from the same build.
   class WorldLoading {
   public:
     WorldLoading (const terrain::WorldRecipe& recipe,
-                  WorldCacheConfig cache_config);
+                  WorldCacheConfig cache_config,
+                  bool progressive = false);
 
     WorldLoading (const WorldLoading&) = delete;
     WorldLoading& operator= (const WorldLoading&) = delete;
@@ -52,6 +58,13 @@ namespace moppe::game {
     // Non-null exactly once per build, after the worker has finished.
     std::unique_ptr<GeneratedWorld> take_completed_world ();
 
+    // Non-null at most once per build, while the full world is still being
+    // built behind it.  A build that found its world saved has no preview.
+    std::unique_ptr<GeneratedWorld> take_preview_world ();
+
+    // True from start () until the completed world has been taken.
+    bool building () const noexcept;
+
     LoadingStatus status ();
 
     // Claims the one development loading capture.  The renderer's first
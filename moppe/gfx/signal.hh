@@ -5,7 +5,9 @@
 
 #include <algorithm>
 #include <cmath>
+#include <cstddef>
 #include <cstdint>
+#include <span>
 
 // The shaping primitives the world is built out of: a soft step between two
 // edges, a repeatable hash, and the periodic value noise laid over the torus.
@@ -74,32 +76,63 @@ namespace moppe {
   // hand; a field whose scale and period disagree simply stops closing.
   //
   // It has to be a whole number for the same reason.
+  // One axis of that lattice at one place: the patch it falls in, the next
+  // patch round the lap, and the eased step between their values. A place
+  // is resolved into one of these per axis, so a sweep over a lattice can
+  // resolve each column and each row once rather than once per site.
+  struct PeriodicNoiseAxis {
+    std::uint32_t lower;
+    std::uint32_t upper;
+    float step;
+  };
+
+  inline PeriodicNoiseAxis periodic_noise_axis (proportion_t along,
+                                                std::uint32_t patches_per_lap) {
+    const float patches = static_cast<float> (patches_per_lap);
+    const float place = along.numerical_value_in (mp_units::one) * patches;
+    const float whole = std::floor (place);
+    const std::int64_t period = static_cast<std::int64_t> (patches_per_lap);
+    const std::int64_t cell = static_cast<std::int64_t> (whole);
+    const std::uint32_t lower =
+      static_cast<std::uint32_t> ((cell % period + period) % period);
+    return { .lower = lower,
+             .upper = (lower + 1) % patches_per_lap,
+             .step = smoothstep (0.0f, 1.0f, place - whole) };
+  }
+
+  inline noise_signal_t periodic_noise (const PeriodicNoiseAxis& x,
+                                        const PeriodicNoiseAxis& z,
+                                        std::uint32_t seed) {
+    const float a = unit_hash (lattice_hash (x.lower, z.lower, seed));
+    const float b = unit_hash (lattice_hash (x.upper, z.lower, seed));
+    const float c = unit_hash (lattice_hash (x.lower, z.upper, seed));
+    const float d = unit_hash (lattice_hash (x.upper, z.upper, seed));
+    return std::lerp (std::lerp (a, b, x.step),
+                      std::lerp (c, d, x.step),
+                      z.step) *
+           noise_signal[mp_units::one];
+  }
+
   inline noise_signal_t periodic_noise (proportion_t along_x,
                                         proportion_t along_z,
                                         std::uint32_t patches_per_lap,
                                         std::uint32_t seed) {
-    const float patches = static_cast<float> (patches_per_lap);
-    const float x = along_x.numerical_value_in (mp_units::one) * patches;
-    const float z = along_z.numerical_value_in (mp_units::one) * patches;
-    const float xf = std::floor (x);
-    const float zf = std::floor (z);
-    const auto wrap = [patches_per_lap] (float value) {
-      const std::int64_t period = static_cast<std::int64_t> (patches_per_lap);
-      const std::int64_t whole = static_cast<std::int64_t> (value);
-      return static_cast<std::uint32_t> ((whole % period + period) % period);
-    };
-    const std::uint32_t x0 = wrap (xf);
-    const std::uint32_t z0 = wrap (zf);
-    const std::uint32_t x1 = (x0 + 1) % patches_per_lap;
-    const std::uint32_t z1 = (z0 + 1) % patches_per_lap;
-    const float tx = smoothstep (0.0f, 1.0f, x - xf);
-    const float tz = smoothstep (0.0f, 1.0f, z - zf);
-    const float a = unit_hash (lattice_hash (x0, z0, seed));
-    const float b = unit_hash (lattice_hash (x1, z0, seed));
-    const float c = unit_hash (lattice_hash (x0, z1, seed));
-    const float d = unit_hash (lattice_hash (x1, z1, seed));
-    return std::lerp (std::lerp (a, b, tx), std::lerp (c, d, tx), tz) *
-           noise_signal[mp_units::one];
+    return periodic_noise (periodic_noise_axis (along_x, patches_per_lap),
+                           periodic_noise_axis (along_z, patches_per_lap),
+                           seed);
+  }
+
+  // The same noise along a row of places sharing one z axis, out[i] taking
+  // the place whose x axis is across[i]. What is left per place is four
+  // hashes and three blends, with no floor or division among them, in one
+  // pass a compiler can keep in registers. The answers are the point
+  // answers, bit for bit.
+  inline void periodic_noise_row (std::span<const PeriodicNoiseAxis> across,
+                                  const PeriodicNoiseAxis& z,
+                                  std::uint32_t seed,
+                                  std::span<noise_signal_t> out) {
+    for (std::size_t place = 0; place < across.size (); ++place)
+      out[place] = periodic_noise (across[place], z, seed);
   }
 }
 
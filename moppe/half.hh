@@ -0,0 +1,56 @@
+#ifndef MOPPE_HALF_HH
+#define MOPPE_HALF_HH
+
+#include <bit>
+#include <cstdint>
+
+// IEEE binary16 as sixteen bits in an integer: what a half-precision texture
+// lane holds, and what a half-precision bundle column stores.
+
+namespace moppe {
+  // IEEE binary16. Written out rather than borrowed from a compiler extension
+  // so the packing is the same on every backend this builds for.
+  constexpr std::uint16_t float_to_half (float value) {
+    const std::uint32_t bits = std::bit_cast<std::uint32_t> (value);
+    const std::uint32_t sign = (bits >> 16) & 0x8000u;
+    const std::int32_t exponent =
+      static_cast<std::int32_t> ((bits >> 23) & 0xffu) - 127 + 15;
+    std::uint32_t mantissa = bits & 0x7fffffu;
+    if (exponent >= 0x1f)
+      return static_cast<std::uint16_t> (sign | 0x7c00u |
+                                         (mantissa != 0 ? 0x200u : 0u));
+    if (exponent <= 0) {
+      if (exponent < -10)
+        return static_cast<std::uint16_t> (sign);
+      mantissa |= 0x800000u;
+      const std::uint32_t shift = static_cast<std::uint32_t> (14 - exponent);
+      return static_cast<std::uint16_t> (sign | (mantissa >> shift));
+    }
+    return static_cast<std::uint16_t> (
+      sign | (static_cast<std::uint32_t> (exponent) << 10) | (mantissa >> 13));
+  }
+
+  // The inverse, exact for every finite half.
+  inline float half_to_float (std::uint16_t half) {
+    const std::uint32_t sign = (static_cast<std::uint32_t> (half) & 0x8000u)
+                               << 16;
+    std::uint32_t exponent = (half >> 10) & 0x1fu;
+    std::uint32_t mantissa = half & 0x3ffu;
+    if (exponent == 0) {
+      if (mantissa == 0)
+        return std::bit_cast<float> (sign);
+      exponent = 1;
+      while ((mantissa & 0x400u) == 0) {
+        mantissa <<= 1;
+        --exponent;
+      }
+      mantissa &= 0x3ffu;
+    } else if (exponent == 0x1f) {
+      return std::bit_cast<float> (sign | 0x7f800000u | (mantissa << 13));
+    }
+    return std::bit_cast<float> (sign | ((exponent + 127 - 15) << 23) |
+                                 (mantissa << 13));
+  }
+}
+
+#endif
@@ -8,6 +8,7 @@
 #include <moppe/terrain/river.hh>
 
 #include <algorithm>
+#include <array>
 #include <cmath>
 #include <cstdint>
 #include <fstream>
@@ -63,67 +64,100 @@ namespace moppe::map {
       return support / support.magnitude ();
     }
 
+    // Snow answers to how level that broad plane lies, which is the plane
+    // projected onto the vertical -- the same reading the habitat rule takes
+    // of the ground itself.
+    SnowSupport snow_support_at (const SurfaceGeometry& geometry,
+                                 const SnowSupportStencil& stencil,
+                                 terrain::TerrainIndex site) {
+      const auto world_up = Vec3 (0.0f, 1.0f, 0.0f) * one;
+      constexpr auto level_ground = terrain::terrain_normal[one];
+      const SurfaceNormal support =
+        snow_support_normal (geometry, stencil, site);
+      const auto levelness = std::clamp (
+        dot (support, world_up), 0.0f * level_ground, 1.0f * level_ground);
+      return levelness.magnitude ();
+    }
+
     void populate_snow_support (SurfaceGeometry& geometry) {
       MOPPE_PROFILE_ZONE ("surface.populate_snow_support");
       const SnowSupportStencil stencil =
         snow_support_stencil (geometry.domain ());
-      // Snow answers to how level that broad plane lies, which is the plane
-      // projected onto the vertical -- the same reading the habitat rule
-      // takes of the ground itself.
-      const auto world_up = Vec3 (0.0f, 1.0f, 0.0f) * one;
-      constexpr auto level_ground = terrain::terrain_normal[one];
       spatial::for_each_site (geometry, [&] (const auto& site) {
-        const SurfaceNormal support =
-          snow_support_normal (geometry, stencil, site.index ());
-        const auto levelness = std::clamp (
-          dot (support, world_up), 0.0f * level_ground, 1.0f * level_ground);
-        spatial::get<snow_support> (site) = levelness.magnitude ();
+        spatial::get<snow_support> (site) =
+          snow_support_at (geometry, stencil, site.index ());
       });
     }
 
-    void recompute_surface_normals (SurfaceGeometry& geometry) {
-      MOPPE_PROFILE_ZONE ("map::recompute_normals");
-      const terrain::TerrainDomain& domain = geometry.domain ();
-      std::ranges::fill (spatial::get<terrain::terrain_normal> (geometry),
-                         Vec3 (0, 0, 0) *
-                           terrain::terrain_normal[mp_units::one]);
+    // The two triangles of the cell each site owns, the one reaching one step
+    // further along both axes.
+    class SurfaceFacets {
+    public:
+      explicit SurfaceFacets (const SurfaceGeometry& geometry)
+          : m_geometry (geometry),
+            // One lattice step in world space. This is the only place the
+            // cell spacing becomes a number, and it does so once for the
+            // whole sweep rather than per corner.
+            m_step_x (
+              geometry.domain ().spacing_x ().numerical_value_in (u::m)),
+            m_step_z (
+              geometry.domain ().spacing_z ().numerical_value_in (u::m)) {}
+
+      struct Cell {
+        SurfaceNormal left;
+        SurfaceNormal right;
+      };
 
-      // One lattice step in world space. This is the only place the cell
-      // spacing becomes a number, and it does so once for the whole sweep
-      // rather than per corner.
-      const float step_x = domain.spacing_x ().numerical_value_in (u::m);
-      const float step_z = domain.spacing_z ().numerical_value_in (u::m);
+      Cell cell (terrain::TerrainIndex site) const {
+        const position_t origin = corner (site, 0, 0);
+        return { .left = facet (site, origin, 0, 1, 1, 1),
+                 .right = facet (site, origin, 1, 1, 1, 0) };
+      }
 
+    private:
       // A cell corner as a place in the world. The elevation is read at the
       // wrapped position, but the horizontal coordinate does not wrap: a face
       // spanning the seam has to stay continuous, or its normal would fold
       // back on itself there.
-      const auto corner = [&] (terrain::TerrainIndex site, int dx, int dz) {
+      position_t corner (terrain::TerrainIndex site, int dx, int dz) const {
         const float along_x =
-          step_x * static_cast<float> (static_cast<int> (site.column) + dx);
+          m_step_x * static_cast<float> (static_cast<int> (site.column) + dx);
         const float along_z =
-          step_z * static_cast<float> (static_cast<int> (site.row) + dz);
+          m_step_z * static_cast<float> (static_cast<int> (site.row) + dz);
         const float height = terrain::surface_elevation_value (
           spatial::get<terrain::surface_elevation> (
-            geometry[domain.shifted (site, dx, dz)]));
+            m_geometry[m_geometry.domain ().shifted (site, dx, dz)]));
         return position (Vec3 (along_x, height, along_z));
-      };
+      }
 
       // The normal of the triangle spanned by two corners and the origin.
       // Crossing two edges of a surface gives a vector along its normal whose
       // length is twice the triangle's area, so dividing by its own magnitude
       // is what leaves a direction and nothing else.
-      const auto facet = [&] (terrain::TerrainIndex site,
-                              const position_t& origin,
-                              int dx1,
-                              int dz1,
-                              int dx2,
-                              int dz2) -> SurfaceNormal {
+      SurfaceNormal facet (terrain::TerrainIndex site,
+                           const position_t& origin,
+                           int dx1,
+                           int dz1,
+                           int dx2,
+                           int dz2) const {
         const auto spanned = cross (corner (site, dx1, dz1) - origin,
                                     corner (site, dx2, dz2) - origin);
         return spanned / spanned.magnitude () *
                terrain::terrain_normal[mp_units::one];
-      };
+      }
+
+      const SurfaceGeometry& m_geometry;
+      float m_step_x;
+      float m_step_z;
+    };
+
+    void recompute_surface_normals (SurfaceGeometry& geometry) {
+      MOPPE_PROFILE_ZONE ("map::recompute_normals");
+      const terrain::TerrainDomain& domain = geometry.domain ();
+      std::ranges::fill (spatial::get<terrain::terrain_normal> (geometry),
+                         Vec3 (0, 0, 0) *
+                           terrain::terrain_normal[mp_units::one]);
+      const SurfaceFacets facets (geometry);
 
       const auto add = [&] (terrain::TerrainIndex site,
                             int dx,
@@ -133,20 +167,17 @@ namespace moppe::map {
           geometry[domain.shifted (site, dx, dz)]) += face;
       };
 
-      // Each site owns the cell reaching one step further along both axes,
-      // split into two triangles whose normals every touched corner
-      // accumulates. A corner shared by several faces ends up holding their
-      // sum, which points along the average of the surface there.
+      // Each site's two triangles are added to every corner they touch. A
+      // corner shared by several faces ends up holding their sum, which
+      // points along the average of the surface there.
       for (const terrain::TerrainIndex site : spatial::sites (geometry)) {
-        const position_t origin = corner (site, 0, 0);
-        const SurfaceNormal left = facet (site, origin, 0, 1, 1, 1);
-        const SurfaceNormal right = facet (site, origin, 1, 1, 1, 0);
-        add (site, 0, 0, left);
-        add (site, 0, 1, left);
-        add (site, 1, 1, left);
-        add (site, 0, 0, right);
-        add (site, 1, 0, right);
-        add (site, 1, 1, right);
+        const SurfaceFacets::Cell cell = facets.cell (site);
+        add (site, 0, 0, cell.left);
+        add (site, 0, 1, cell.left);
+        add (site, 1, 1, cell.left);
+        add (site, 0, 0, cell.right);
+        add (site, 1, 0, cell.right);
+        add (site, 1, 1, cell.right);
       }
 
       // Those sums carry the faces' areas as their length; only the direction
@@ -155,6 +186,54 @@ namespace moppe::map {
            spatial::get<terrain::terrain_normal> (geometry))
         value = value / value.magnitude ();
     }
+
+    // The same normal for one corner, gathered instead of scattered. The four
+    // cells that touch a corner are summed in the order the whole-lattice
+    // sweep reaches them -- storage order, left triangle before right -- so a
+    // local rebuild is bit-identical to a full one, seams included.
+    SurfaceNormal gather_surface_normal (const SurfaceGeometry& geometry,
+                                         const SurfaceFacets& facets,
+                                         terrain::TerrainIndex corner) {
+      const terrain::TerrainDomain& domain = geometry.domain ();
+      struct Touch {
+        std::size_t offset;
+        terrain::TerrainIndex site;
+        bool left;
+        bool right;
+      };
+      const auto touch = [&] (int dx, int dz, bool left, bool right) {
+        const terrain::TerrainIndex site = domain.shifted (corner, dx, dz);
+        return Touch { domain.offset (site), site, left, right };
+      };
+      std::array<Touch, 4> touches { touch (0, 0, true, true),
+                                     touch (0, -1, true, false),
+                                     touch (-1, 0, false, true),
+                                     touch (-1, -1, true, true) };
+      std::ranges::sort (touches, {}, &Touch::offset);
+
+      SurfaceNormal sum =
+        Vec3 (0, 0, 0) * terrain::terrain_normal[mp_units::one];
+      for (const Touch& cell_touch : touches) {
+        const SurfaceFacets::Cell cell = facets.cell (cell_touch.site);
+        if (cell_touch.left)
+          sum += cell.left;
+        if (cell_touch.right)
+          sum += cell.right;
+      }
+      return sum / sum.magnitude ();
+    }
+
+    template <typename Visit>
+    void for_each_site_in (const terrain::TerrainDomain& domain,
+                           const terrain::TerrainRect& rect,
+                           Visit&& visit) {
+      domain.visit_unwrapped (rect, [&] (const terrain::TerrainRect& piece) {
+        for (std::size_t row = 0; row < piece.rows; ++row)
+          for (std::size_t column = 0; column < piece.columns; ++column)
+            visit (terrain::TerrainIndex { piece.origin.column + column,
+                                           piece.origin.row + row });
+      });
+    }
   }
 
   void rebuild_geometry (SurfaceGeometry& geometry) {
@@ -163,6 +242,39 @@ namespace moppe::map {
     populate_snow_support (geometry);
   }
 
+  GeometryChange rebuild_geometry (SurfaceGeometry& geometry,
+                                   const terrain::TerrainRect& changed) {
+    MOPPE_PROFILE_ZONE ("map::rebuild_geometry_region");
+    const terrain::TerrainDomain& domain = geometry.domain ();
+    // A corner's normal reads the cells on either side of it, so a changed
+    // height moves the normals one step around it; the support plane reads
+    // those normals a whole stencil away.
+    if (changed.empty ())
+      return {};
+    const SnowSupportStencil stencil = snow_support_stencil (domain);
+    const GeometryChange change {
+      .normals = domain.grown (changed, 1, 1),
+      .snow_support = domain.grown (
+        domain.grown (changed, 1, 1),
+        static_cast<std::size_t> (stencil.dx),
+        static_cast<std::size_t> (stencil.dz)),
+    };
+
+    const SurfaceFacets facets (geometry);
+    auto& normals = spatial::get<terrain::terrain_normal> (geometry);
+    for_each_site_in (domain, change.normals, [&] (terrain::TerrainIndex site) {
+      normals[domain.offset (site)] =
+        gather_surface_normal (geometry, facets, site);
+    });
+    auto& support = spatial::get<snow_support> (geometry);
+    for_each_site_in (
+      domain, change.snow_support, [&] (terrain::TerrainIndex site) {
+        support[domain.offset (site)] =
+          snow_support_at (geometry, stencil, site);
+      });
+    return change;
+  }
+
   // ---- Generation ----
 
   namespace {
@@ -235,11 +347,27 @@ namespace moppe::map {
                   std::span<const meters_per_julian_year_t> uplift,
                   const terrain::StreamPowerEvolution& parameters,
                   const terrain::StreamPowerProgress& progress) {
+    terrain::StreamPowerWorkspace workspace (surface.domain ());
+    return evolve_terrain (surface, workspace, uplift, parameters, progress);
+  }
+
+  terrain::StreamPowerEvolutionReport
+  evolve_terrain (SurfaceGeometry& surface,
+                  terrain::StreamPowerWorkspace& workspace,
+                  std::span<const meters_per_julian_year_t> uplift,
+                  const terrain::StreamPowerEvolution& parameters,
+                  const terrain::StreamPowerProgress& progress) {
     MOPPE_PROFILE_ZONE ("terrain.evolve");
     const auto& initial_sediment =
       spatial::get<terrain::sediment_thickness> (surface);
-    terrain::StreamPowerEvolutionResult result = terrain::evolve_stream_power (
-      surface, uplift, parameters, progress, {}, initial_sediment);
+    terrain::StreamPowerEvolutionResult result =
+      terrain::evolve_stream_power (workspace,
+                                    surface,
+                                    uplift,
+                                    parameters,
+                                    progress,
+                                    {},
+                                    initial_sediment);
     set_evolution_result (surface, result);
     return result.report;
   }
@@ -402,15 +530,38 @@ namespace moppe::map {
     // on -- one number now, so the two cannot drift apart.
     constexpr std::uint32_t stands_per_lap = 7;
     constexpr std::uint32_t breaks_per_lap = 23;
+    constexpr std::uint32_t stands_seed_mix = 0x4b1d9e37U;
+    constexpr std::uint32_t breaks_seed_mix = 0x91e10da5U;
     constexpr auto signal = noise_signal[one];
 
+    // The noise is swept a row at a time. Where a column falls on each
+    // lattice is the same on every row, so it is worked out once up front.
+    const std::size_t width = domain.width ();
+    std::vector<PeriodicNoiseAxis> stand_columns (width);
+    std::vector<PeriodicNoiseAxis> break_columns (width);
+    for (std::size_t column = 0; column < width; ++column) {
+      const auto along_x = domain.lap_position ({ column, 0 }).along_x;
+      stand_columns[column] = periodic_noise_axis (along_x, stands_per_lap);
+      break_columns[column] = periodic_noise_axis (along_x, breaks_per_lap);
+    }
+    std::vector<noise_signal_t> stand_row (width);
+    std::vector<noise_signal_t> break_row (width);
+
     for (const terrain::TerrainIndex site : spatial::sites (habitat)) {
-      const auto where = domain.lap_position (site);
+      if (site.column == 0) {
+        const auto along_z = domain.lap_position (site).along_z;
+        periodic_noise_row (stand_columns,
+                            periodic_noise_axis (along_z, stands_per_lap),
+                            seed ^ stands_seed_mix,
+                            stand_row);
+        periodic_noise_row (break_columns,
+                            periodic_noise_axis (along_z, breaks_per_lap),
+                            seed ^ breaks_seed_mix,
+                            break_row);
+      }
 
-      const noise_signal_t stands = periodic_noise (
-        where.along_x, where.along_z, stands_per_lap, seed ^ 0x4b1d9e37U);
-      const noise_signal_t breaks = periodic_noise (
-        where.along_x, where.along_z, breaks_per_lap, seed ^ 0x91e10da5U);
+      const noise_signal_t stands = stand_row[site.column];
+      const noise_signal_t breaks = break_row[site.column];
       const noise_signal_t mosaic = 0.72f * stands + 0.28f * breaks;
 
       // Habitat raised slightly above one: good ground stays good, and
@@ -64,16 +64,21 @@ namespace moppe::map {
                                           ErodedSurfaceMaterial,
                                           DepositedSurfaceMaterial,
                                           SnowSupport>;
-  using SurfaceReadings = spatial::Bundle<terrain::TerrainDomain,
-                                          SurfaceMoisture,
-                                          SoilWetness,
-                                          WaterlineDistance,
-                                          ErosionExposure,
-                                          DepositionCover,
-                                          TreeHabitat,
-                                          ForestCover,
-                                          TrailInfluence,
-                                          HomeBaseInfluence>;
+  // Readings are kept at the precision their consumers can tell apart.
+  // Proportions later analysis thresholds keep sixteen bits; those that only
+  // ever reach an 8-bit texture lane keep eight; shore distance keeps half
+  // precision, finest near the water where it is read.
+  using SurfaceReadings = spatial::Bundle<
+    terrain::TerrainDomain,
+    spatial::Quantized<SurfaceMoisture, spatial::Unorm16<>>,
+    spatial::Quantized<SoilWetness, spatial::Unorm16<>>,
+    spatial::Quantized<WaterlineDistance, spatial::Half>,
+    spatial::Quantized<ErosionExposure, spatial::Unorm8<>>,
+    spatial::Quantized<DepositionCover, spatial::Unorm8<>>,
+    spatial::Quantized<TreeHabitat, spatial::Unorm16<>>,
+    spatial::Quantized<ForestCover, spatial::Unorm16<>>,
+    spatial::Quantized<TrailInfluence, spatial::Unorm8<>>,
+    spatial::Quantized<HomeBaseInfluence, spatial::Unorm8<>>>;
 
   // ---- Geometry ----
 
@@ -81,6 +86,19 @@ namespace moppe::map {
   // them whenever the heightfield changes.
   void rebuild_geometry (SurfaceGeometry& geometry);
 
+  // Where a local height change reached once the derived geometry followed
+  // it: the normals around the changed sites, which is also what a renderer
+  // has to upload again, and the wider reach of the snow support plane.
+  struct GeometryChange {
+    terrain::TerrainRect normals;
+    terrain::TerrainRect snow_support;
+  };
+
+  // The same rebuild, limited to what heights changed inside `changed` can
+  // reach. The result is bit-identical to rebuilding the whole surface.
+  GeometryChange rebuild_geometry (SurfaceGeometry& geometry,
+                                   const terrain::TerrainRect& changed);
+
   // ---- Generation ----
 
   // Draw the canonical seeded geology into a physical surface and return the
@@ -97,6 +115,14 @@ namespace moppe::map {
                   std::span<const meters_per_julian_year_t> uplift,
                   const terrain::StreamPowerEvolution& parameters,
                   const terrain::StreamPowerProgress& progress = {});
+  // The same, stepping in a workspace sized for this surface's lattice, so
+  // that many worlds of one resolution share it.
+  terrain::StreamPowerEvolutionReport
+  evolve_terrain (SurfaceGeometry& surface,
+                  terrain::StreamPowerWorkspace& workspace,
+                  std::span<const meters_per_julian_year_t> uplift,
+                  const terrain::StreamPowerEvolution& parameters,
+                  const terrain::StreamPowerProgress& progress = {});
 
   // Form the canonical built circuit in place and return its useful network.
   terrain::TrailNetwork
@@ -106,9 +132,9 @@ namespace moppe::map {
   // ---- Readings ----
   //
   // Every reading over the world's surface comes from one analysis of the
-  // finished geometry. Each returns its own narrow bundle; a completed world
-  // joins them, in the order SurfaceReadings declares, into the wide store the
-  // game samples.
+  // finished geometry. Each returns its own narrow bundle at full precision;
+  // a completed world joins them, in the order SurfaceReadings declares, and
+  // stores the result as the quantized wide store the game samples.
 
   using GeologyMaterials =
     spatial::Bundle<terrain::TerrainDomain, ErosionExposure, DepositionCover>;
@@ -0,0 +1,280 @@
+#ifndef MOPPE_MEMORY_HH
+#define MOPPE_MEMORY_HH
+
+#include <moppe/spatial/bundle.hh>
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <format>
+#include <fstream>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#if defined(__APPLE__)
+#include <mach/mach.h>
+#endif
+
+// Where the bytes go. The television and phone builds live under hard memory
+// ceilings, and which columns to quantize or drop there is a question of
+// counting. Three counts answer it:
+//
+//   - a ledger of what a finished structure owns, entry by entry: each
+//     bundle column and each vector it holds;
+//   - a counter behind an allocator that generation's transient buffers opt
+//     into, with its high-water mark;
+//   - the process's resident size and its high-water mark between stages.
+//
+// The ledger counts capacity, not size, because capacity is what is held.
+
+namespace moppe::memory {
+  // ---- Owned bytes ----
+
+  template <typename T, typename Allocator>
+  std::size_t owned_bytes (const std::vector<T, Allocator>& values);
+
+  template <typename T>
+  concept OwnsMemory = requires (const T& value) {
+    { owned_bytes (value) } -> std::convertible_to<std::size_t>;
+  };
+
+  // Heap bytes a vector holds, including what its elements own in turn.
+  template <typename T, typename Allocator>
+  std::size_t owned_bytes (const std::vector<T, Allocator>& values) {
+    std::size_t bytes = values.capacity () * sizeof (T);
+    if constexpr (OwnsMemory<T>)
+      for (const T& value : values)
+        bytes += owned_bytes (value);
+    return bytes;
+  }
+
+  // A quantized column holds only its codes.
+  template <typename Value, typename Encoding>
+  std::size_t
+  owned_bytes (const spatial::QuantizedColumn<Value, Encoding>& column) {
+    return column.capacity () *
+           sizeof (typename spatial::QuantizedColumn<Value,
+                                                     Encoding>::code_type);
+  }
+
+  struct LedgerEntry {
+    std::string name;
+    std::size_t bytes = 0;
+  };
+
+  class Ledger {
+  public:
+    void add (std::string name, std::size_t bytes) {
+      m_entries.push_back ({ std::move (name), bytes });
+    }
+
+    const std::vector<LedgerEntry>& entries () const noexcept {
+      return m_entries;
+    }
+
+    std::size_t total_bytes () const noexcept {
+      std::size_t total = 0;
+      for (const LedgerEntry& entry : m_entries)
+        total += entry.bytes;
+      return total;
+    }
+
+    // Largest first, so a report starts with what is worth cutting.
+    void sort_by_size () {
+      std::ranges::stable_sort (
+        m_entries, std::ranges::greater {}, &LedgerEntry::bytes);
+    }
+
+  private:
+    std::vector<LedgerEntry> m_entries;
+  };
+
+  inline void write_ledger_csv (std::ostream& output, const Ledger& ledger) {
+    output << "entry,bytes\n";
+    for (const LedgerEntry& entry : ledger.entries ())
+      output << entry.name << ',' << entry.bytes << '\n';
+  }
+
+  namespace detail {
+    // The quantity's own name, without its namespace.
+    template <typename Value>
+    std::string column_name () {
+      using spec = std::remove_cvref_t<decltype (Value::quantity_spec)>;
+      const std::string_view full = mp_units::detail::type_name<spec> ();
+      const std::size_t separator = full.rfind ("::");
+      return std::string (separator == std::string_view::npos
+                            ? full
+                            : full.substr (separator + 2));
+    }
+  }
+
+  // One entry per column, named prefix.quantity.
+  template <typename Domain, typename... Quantities>
+  void account_bundle (Ledger& ledger,
+                       std::string_view prefix,
+                       const spatial::Bundle<Domain, Quantities...>& bundle) {
+    [&]<std::size_t... Column> (std::index_sequence<Column...>) {
+      (ledger.add (
+         std::format ("{}.{}", prefix, detail::column_name<Quantities> ()),
+         owned_bytes (spatial::get<Column> (bundle))),
+       ...);
+    }(std::index_sequence_for<Quantities...> {});
+  }
+
+  // ---- Transient buffers ----
+
+  namespace detail {
+    inline std::atomic<std::size_t> transient_bytes { 0 };
+    inline std::atomic<std::size_t> transient_peak_bytes { 0 };
+  }
+
+  // Bytes held right now by tracked buffers, across every thread.
+  inline std::size_t transient_bytes () noexcept {
+    return detail::transient_bytes.load (std::memory_order_relaxed);
+  }
+
+  // The most tracked buffers held at once since the last reset.
+  inline std::size_t transient_peak_bytes () noexcept {
+    return detail::transient_peak_bytes.load (std::memory_order_relaxed);
+  }
+
+  inline void reset_transient_peak () noexcept {
+    detail::transient_peak_bytes.store (transient_bytes (),
+                                        std::memory_order_relaxed);
+  }
+
+  // std::allocator, counted. A buffer opts in by its type, so the count
+  // covers exactly the storage a stage chose to account for.
+  template <typename T>
+  struct TrackedAllocator {
+    using value_type = T;
+
+    TrackedAllocator () noexcept = default;
+    template <typename U>
+    TrackedAllocator (const TrackedAllocator<U>&) noexcept {}
+
+    T* allocate (std::size_t count) {
+      T* values = std::allocator<T> {}.allocate (count);
+      const std::size_t held =
+        detail::transient_bytes.fetch_add (count * sizeof (T),
+                                           std::memory_order_relaxed) +
+        count * sizeof (T);
+      std::size_t peak = transient_peak_bytes ();
+      while (held > peak &&
+             !detail::transient_peak_bytes.compare_exchange_weak (
+               peak, held, std::memory_order_relaxed))
+        ;
+      return values;
+    }
+
+    void deallocate (T* values, std::size_t count) noexcept {
+      detail::transient_bytes.fetch_sub (count * sizeof (T),
+                                         std::memory_order_relaxed);
+      std::allocator<T> {}.deallocate (values, count);
+    }
+
+    friend bool operator== (const TrackedAllocator&,
+                            const TrackedAllocator&) = default;
+  };
+
+  template <typename T>
+  using tracked_vector = std::vector<T, TrackedAllocator<T>>;
+
+  // ---- Resident size ----
+
+  struct ResidentMemory {
+    std::size_t current_bytes = 0;
+    // The process's high-water mark since it started. Platforms that cannot
+    // say report zero for both.
+    std::size_t peak_bytes = 0;
+  };
+
+  inline ResidentMemory resident_memory () {
+#if defined(__APPLE__)
+    mach_task_basic_info_data_t info {};
+    mach_msg_type_number_t count = MACH_TASK_BASIC_INFO_COUNT;
+    if (task_info (mach_task_self (),
+                   MACH_TASK_BASIC_INFO,
+                   reinterpret_cast<task_info_t> (&info),
+                   &count) != KERN_SUCCESS)
+      return {};
+    return { static_cast<std::size_t> (info.resident_size),
+             static_cast<std::size_t> (info.resident_size_max) };
+#elif defined(__linux__)
+    // Lines such as "VmHWM:\t  123456 kB" among many that are not sizes.
+    const auto kilobytes = [] (std::string_view line) -> std::size_t {
+      const std::size_t digits = line.find_first_of ("0123456789");
+      return digits == std::string_view::npos
+               ? 0
+               : std::stoull (std::string (line.substr (digits))) * 1024;
+    };
+    ResidentMemory memory;
+    std::ifstream status ("/proc/self/status");
+    for (std::string line; std::getline (status, line);) {
+      if (line.starts_with ("VmRSS:"))
+        memory.current_bytes = kilobytes (line);
+      else if (line.starts_with ("VmHWM:"))
+        memory.peak_bytes = kilobytes (line);
+    }
+    return memory;
+#else
+    return {};
+#endif
+  }
+
+  // ---- Stages ----
+
+  struct StageMemory {
+    std::string stage;
+    // Resident size as the stage ended, and the process high-water mark by
+    // then: a stage that raised the mark is the one that set it.
+    ResidentMemory resident;
+    // The most tracked transient storage held at once during the stage.
+    std::size_t transient_peak_bytes = 0;
+  };
+
+  // A pipeline marks the end of each stage in turn.
+  class StageMemoryReport {
+  public:
+    StageMemoryReport () {
+      reset_transient_peak ();
+    }
+
+    void mark (std::string stage) {
+      m_stages.push_back ({ std::move (stage),
+                            resident_memory (),
+                            memory::transient_peak_bytes () });
+      reset_transient_peak ();
+    }
+
+    const std::vector<StageMemory>& stages () const noexcept {
+      return m_stages;
+    }
+
+    std::size_t largest_transient_peak_bytes () const noexcept {
+      std::size_t peak = 0;
+      for (const StageMemory& stage : m_stages)
+        peak = std::max (peak, stage.transient_peak_bytes);
+      return peak;
+    }
+
+  private:
+    std::vector<StageMemory> m_stages;
+  };
+
+  inline void write_stage_memory_csv (std::ostream& output,
+                                      const StageMemoryReport& report) {
+    output << "stage,resident_bytes,resident_peak_bytes,"
+              "transient_peak_bytes\n";
+    for (const StageMemory& stage : report.stages ())
+      output << stage.stage << ',' << stage.resident.current_bytes << ','
+             << stage.resident.peak_bytes << ',' << stage.transient_peak_bytes
+             << '\n';
+  }
+}
+
+#endif
@@ -0,0 +1,201 @@
+#ifndef MOPPE_PARALLEL_HH
+#define MOPPE_PARALLEL_HH
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#if defined(__EMSCRIPTEN__)
+#include <emscripten/threading.h>
+#endif
+
+// Lattice passes whose rows are independent share one shape of parallelism:
+// a few workers claim whole rows from a shared counter until none remain.
+// Each row is written by exactly one worker, so a pass that is deterministic
+// per row stays deterministic however the rows happen to be scheduled.
+//
+// Small lattices stay on the calling thread, where starting workers would
+// cost more than the rows. So does the browser's main thread, which must
+// never block on a join.
+
+namespace moppe {
+  constexpr std::size_t parallel_rows_minimum_cells = 65536;
+
+  inline std::size_t row_worker_count (std::size_t rows, std::size_t cells) {
+#if defined(__EMSCRIPTEN__)
+    if (emscripten_is_main_browser_thread ())
+      return 1;
+#endif
+    if (cells < parallel_rows_minimum_cells || rows < 2)
+      return 1;
+    const std::size_t hardware_threads =
+      std::max (1u, std::thread::hardware_concurrency ());
+    const std::size_t available_threads =
+      hardware_threads > 1 ? hardware_threads - 1 : 1;
+    return std::min (rows, available_threads);
+  }
+
+  // Call body (row) once for every row in [0, rows). `cells` is the total
+  // work the rows cover and decides whether workers are worth starting.
+  template <typename Body>
+  void parallel_rows (std::size_t rows, std::size_t cells, Body&& body) {
+    const std::size_t worker_count = row_worker_count (rows, cells);
+    if (worker_count == 1) {
+      for (std::size_t row = 0; row < rows; ++row)
+        body (row);
+      return;
+    }
+    std::atomic<std::size_t> next_row = 0;
+    const auto claim_rows = [&] {
+      for (;;) {
+        const std::size_t row =
+          next_row.fetch_add (1, std::memory_order_relaxed);
+        if (row >= rows)
+          break;
+        body (row);
+      }
+    };
+    std::vector<std::jthread> workers;
+    workers.reserve (worker_count - 1);
+    for (std::size_t worker = 1; worker < worker_count; ++worker)
+      workers.emplace_back (claim_rows);
+    claim_rows ();
+  }
+
+  // Threads a pass may keep besides the caller's: one fewer than the
+  // hardware has, at most `limit`, and none on the browser's main thread.
+  inline std::size_t spare_row_workers (std::size_t limit) {
+#if defined(__EMSCRIPTEN__)
+    if (emscripten_is_main_browser_thread ())
+      return 0;
+#endif
+    const std::size_t hardware_threads =
+      std::max (1u, std::thread::hardware_concurrency ());
+    return std::min (limit, hardware_threads - 1);
+  }
+
+  // Row workers kept for a pass that runs again and again, such as a fixed
+  // simulation step. parallel_rows starts and joins its workers on every
+  // call; these are started once and only woken for each run, so a run costs
+  // no thread creation and no allocation. The calling thread claims rows as
+  // well. One run at a time, and a row body must not throw.
+  class RowWorkers {
+  public:
+    explicit RowWorkers (std::size_t helpers) {
+      try {
+        m_threads.reserve (helpers);
+        for (std::size_t helper = 0; helper < helpers; ++helper)
+          m_threads.emplace_back ([this] { serve (); });
+      } catch (...) {
+        stop ();
+        throw;
+      }
+    }
+
+    ~RowWorkers () {
+      stop ();
+    }
+
+    RowWorkers (const RowWorkers&) = delete;
+    RowWorkers& operator= (const RowWorkers&) = delete;
+
+    // Threads that run rows, the caller's included.
+    std::size_t size () const noexcept {
+      return m_threads.size () + 1;
+    }
+
+    // Call body (row) once for every row in [0, rows), returning once all
+    // of them have run.
+    template <typename Body>
+    void run (std::size_t rows, Body&& body) {
+      if (m_threads.empty () || rows < 2) {
+        for (std::size_t row = 0; row < rows; ++row)
+          body (row);
+        return;
+      }
+      using Callable = std::remove_reference_t<Body>;
+      {
+        const std::lock_guard<std::mutex> lock (m_mutex);
+        m_rows = rows;
+        m_next_row.store (0, std::memory_order_relaxed);
+        m_body = const_cast<void*> (
+          static_cast<const void*> (std::addressof (body)));
+        m_call = [] (void* body, std::size_t row) {
+          (*static_cast<Callable*> (body)) (row);
+        };
+        m_busy = m_threads.size ();
+        ++m_generation;
+      }
+      m_wake.notify_all ();
+      claim_rows ();
+      std::unique_lock<std::mutex> lock (m_mutex);
+      m_done.wait (lock, [this] { return m_busy == 0; });
+    }
+
+  private:
+    // Wakes every worker to leave; the threads are joined as they go.
+    void stop () noexcept {
+      {
+        const std::lock_guard<std::mutex> lock (m_mutex);
+        m_stopping = true;
+      }
+      m_wake.notify_all ();
+    }
+
+    void claim_rows () {
+      for (;;) {
+        const std::size_t row =
+          m_next_row.fetch_add (1, std::memory_order_relaxed);
+        if (row >= m_rows)
+          break;
+        m_call (m_body, row);
+      }
+    }
+
+    void serve () {
+      std::uint64_t served = 0;
+      for (;;) {
+        {
+          std::unique_lock<std::mutex> lock (m_mutex);
+          m_wake.wait (lock, [&] {
+            return m_stopping || m_generation != served;
+          });
+          if (m_stopping)
+            return;
+          served = m_generation;
+        }
+        claim_rows ();
+        bool last = false;
+        {
+          const std::lock_guard<std::mutex> lock (m_mutex);
+          last = --m_busy == 0;
+        }
+        if (last)
+          m_done.notify_one ();
+      }
+    }
+
+    std::mutex m_mutex;
+    std::condition_variable m_wake;
+    std::condition_variable m_done;
+    bool m_stopping = false;
+    std::uint64_t m_generation = 0;
+    std::size_t m_busy = 0;
+    // The run in progress, published under the mutex with its generation.
+    std::size_t m_rows = 0;
+    std::atomic<std::size_t> m_next_row = 0;
+    void* m_body = nullptr;
+    void (*m_call) (void*, std::size_t) = nullptr;
+    // Last, so the threads are joined before anything they use goes away.
+    std::vector<std::jthread> m_threads;
+  };
+}
+
+#endif
@@ -2,9 +2,10 @@
 
 #include <cstdint>
 
-// Tracy compiles these macros away completely in ordinary builds.  Keeping
-// the dependency behind this small vocabulary lets Moppe's profiling map stay
-// meaningful without spreading profiler-specific names through the game.
+// With TRACY_ENABLE these macros are Tracy's; every other build records them
+// into the small ring recorder below.  Keeping either behind this small
+// vocabulary lets Moppe's profiling map stay meaningful without spreading
+// profiler-specific names through the game.
 #if defined(TRACY_ENABLE)
 #include <tracy/Tracy.hpp>
 
@@ -27,10 +28,395 @@ namespace moppe::profile {
   ZoneNamedN (variable, name, true)
 #define MOPPE_PROFILE_WAIT() ::moppe::profile::wait_for_profiler ()
 #else
-#define MOPPE_PROFILE_FRAME() ((void)0)
-#define MOPPE_PROFILE_PLOT(name, value) ((void)0)
-#define MOPPE_PROFILE_THREAD(name) ((void)0)
-#define MOPPE_PROFILE_ZONE(name) ((void)0)
-#define MOPPE_PROFILE_NAMED_ZONE(variable, name) ((void)0)
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <format>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Every other build carries a small recorder of its own, so a release build,
+// a headless Linux run or a device in the field can still be profiled.  It
+// sleeps -- one relaxed load per zone -- until MOPPE_TRACE or --trace names a
+// file, or until start_recording is called.  From then on each thread keeps
+// its newest zones, plots and frame marks in a ring of its own, and the rings
+// are written as Chrome trace-event JSON when the process exits or whenever
+// write_trace is called.  chrome://tracing and ui.perfetto.dev both read it.
+//
+// Names must outlive the process, as the string literals the macros are
+// given do: the rings hold the pointers, not copies.
+
+namespace moppe::profile {
+  // Enough for a few seconds of frames or a whole world's generation stages
+  // on each thread, at 32 bytes an event.
+  inline constexpr std::size_t default_trace_events = std::size_t (1) << 16;
+
+  enum class TraceEventKind : std::uint8_t { zone, plot, frame };
+
+  namespace detail {
+    using trace_clock = std::chrono::steady_clock;
+
+    inline std::atomic<bool> trace_recording { false };
+
+    inline std::int64_t trace_now () noexcept {
+      static const trace_clock::time_point epoch = trace_clock::now ();
+      return std::chrono::duration_cast<std::chrono::nanoseconds> (
+               trace_clock::now () - epoch)
+        .count ();
+    }
+
+    // Relaxed atomics throughout, so a dump may read a ring its thread is
+    // still writing without either of them taking a lock.
+    struct TraceEvent {
+      std::atomic<const char*> name { nullptr };
+      std::atomic<std::int64_t> start { 0 };
+      // A zone's duration in nanoseconds, or a plot's value.
+      std::atomic<std::int64_t> value { 0 };
+      std::atomic<TraceEventKind> kind { TraceEventKind::zone };
+    };
+
+    // One thread's ring. Only its own thread writes it; `begun` counts
+    // events whose slot is being or has been written, `written` those that
+    // are complete, so a reader can tell which slots it may have caught
+    // mid-write.
+    struct ThreadTrace {
+      std::uint32_t id = 0;
+      std::atomic<const char*> name { nullptr };
+      std::size_t capacity = 0;
+      std::unique_ptr<TraceEvent[]> events;
+      std::atomic<std::uint64_t> begun { 0 };
+      std::atomic<std::uint64_t> written { 0 };
+    };
+
+    // Threads are registered for good: a thread that has exited still has
+    // its events written out. The registry is never destroyed, so a worker
+    // still running while the process exits cannot outlive its ring.
+    class TraceRegistry {
+    public:
+      ThreadTrace& current_thread () {
+        thread_local ThreadTrace* trace = nullptr;
+        if (!trace) {
+          const std::lock_guard<std::mutex> lock (m_mutex);
+          m_threads.push_back (std::make_unique<ThreadTrace> ());
+          trace = m_threads.back ().get ();
+          trace->id = static_cast<std::uint32_t> (m_threads.size ());
+        }
+        return *trace;
+      }
+
+      // The calling thread's ring, allocated if it has none yet. A thread
+      // whose ring cannot be allocated gets null and records nothing.
+      ThreadTrace* prepared_thread () noexcept {
+        try {
+          ThreadTrace& trace = current_thread ();
+          if (!trace.events) {
+            trace.capacity = capacity ();
+            trace.events = std::make_unique<TraceEvent[]> (trace.capacity);
+          }
+          return &trace;
+        } catch (...) {
+          return nullptr;
+        }
+      }
+
+      void record (TraceEventKind kind,
+                   const char* name,
+                   std::int64_t start,
+                   std::int64_t value) noexcept;
+
+      void start (std::size_t events_per_thread) {
+        const std::lock_guard<std::mutex> lock (m_mutex);
+        m_capacity = std::max<std::size_t> (events_per_thread, 1);
+        m_since = trace_now ();
+        trace_recording.store (true, std::memory_order_release);
+      }
+
+      std::size_t capacity () {
+        const std::lock_guard<std::mutex> lock (m_mutex);
+        return m_capacity;
+      }
+
+      void set_path (std::string path) {
+        const std::lock_guard<std::mutex> lock (m_mutex);
+        m_path = std::move (path);
+      }
+
+      std::string path () {
+        const std::lock_guard<std::mutex> lock (m_mutex);
+        return m_path;
+      }
+
+      void write (std::ostream& output);
+
+    private:
+      std::mutex m_mutex;
+      std::vector<std::unique_ptr<ThreadTrace>> m_threads;
+      std::size_t m_capacity = default_trace_events;
+      // Events from before the latest start belong to an earlier recording.
+      std::int64_t m_since = 0;
+      std::string m_path;
+    };
+
+    inline TraceRegistry& trace_registry () {
+      static TraceRegistry* registry = new TraceRegistry;
+      return *registry;
+    }
+
+    // Writes one event into a ring that already exists: no allocation, no
+    // lock, nothing that can throw.
+    inline void write_event (ThreadTrace& trace,
+                             TraceEventKind kind,
+                             const char* name,
+                             std::int64_t start,
+                             std::int64_t value) noexcept {
+      const std::uint64_t count =
+        trace.written.load (std::memory_order_relaxed);
+      trace.begun.store (count + 1, std::memory_order_relaxed);
+      std::atomic_thread_fence (std::memory_order_release);
+      TraceEvent& event = trace.events[count % trace.capacity];
+      event.name.store (name, std::memory_order_relaxed);
+      event.start.store (start, std::memory_order_relaxed);
+      event.value.store (value, std::memory_order_relaxed);
+      event.kind.store (kind, std::memory_order_relaxed);
+      trace.written.store (count + 1, std::memory_order_release);
+    }
+
+    inline void TraceRegistry::record (TraceEventKind kind,
+                                       const char* name,
+                                       std::int64_t start,
+                                       std::int64_t value) noexcept {
+      if (ThreadTrace* trace = prepared_thread ())
+        write_event (*trace, kind, name, start, value);
+    }
+
+    struct CopiedEvent {
+      const char* name;
+      std::int64_t start;
+      std::int64_t value;
+      TraceEventKind kind;
+    };
+
+    // The events a ring still holds, oldest first, leaving out any slot its
+    // thread may have begun overwriting while they were copied.
+    inline std::vector<CopiedEvent> copy_events (const ThreadTrace& trace) {
+      const std::uint64_t written =
+        trace.written.load (std::memory_order_acquire);
+      if (written == 0)
+        return {};
+      const std::uint64_t capacity = trace.capacity;
+      const std::uint64_t first = written > capacity ? written - capacity : 0;
+      std::vector<CopiedEvent> events;
+      events.reserve (static_cast<std::size_t> (written - first));
+      for (std::uint64_t index = first; index < written; ++index) {
+        const TraceEvent& event = trace.events[index % capacity];
+        events.push_back ({ event.name.load (std::memory_order_relaxed),
+                            event.start.load (std::memory_order_relaxed),
+                            event.value.load (std::memory_order_relaxed),
+                            event.kind.load (std::memory_order_relaxed) });
+      }
+      std::atomic_thread_fence (std::memory_order_acquire);
+      const std::uint64_t begun = trace.begun.load (std::memory_order_relaxed);
+      const std::uint64_t intact = begun > capacity ? begun - capacity : 0;
+      if (intact > first)
+        events.erase (
+          events.begin (),
+          events.begin () +
+            static_cast<std::ptrdiff_t> (std::min (intact, written) - first));
+      return events;
+    }
+
+    inline void write_json_string (std::ostream& output, const char* text) {
+      output << '"';
+      for (const char c : std::string_view (text ? text : "")) {
+        if (c == '"' || c == '\\')
+          output << '\\' << c;
+        else if (static_cast<unsigned char> (c) < 0x20)
+          output << std::format ("\\u{:04x}", static_cast<unsigned> (c));
+        else
+          output << c;
+      }
+      output << '"';
+    }
+
+    inline void TraceRegistry::write (std::ostream& output) {
+      const std::lock_guard<std::mutex> lock (m_mutex);
+      // Chrome's microseconds, to the nanosecond the clock gives.
+      const auto microseconds = [] (std::int64_t nanoseconds) {
+        return std::format ("{:.3f}", static_cast<double> (nanoseconds) / 1e3);
+      };
+      const char* separator = "\n";
+      const auto begin_event = [&] (const char* name,
+                                    std::string_view phase,
+                                    std::uint32_t thread) {
+        output << separator << "{\"name\":";
+        write_json_string (output, name);
+        output << ",\"ph\":\"" << phase << "\",\"pid\":1,\"tid\":" << thread;
+        separator = ",\n";
+      };
+
+      output << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+      begin_event ("process_name", "M", 0);
+      output << ",\"args\":{\"name\":\"moppe\"}}";
+      for (const std::unique_ptr<ThreadTrace>& trace : m_threads) {
+        if (const char* name = trace->name.load (std::memory_order_relaxed)) {
+          begin_event ("thread_name", "M", trace->id);
+          output << ",\"args\":{\"name\":";
+          write_json_string (output, name);
+          output << "}}";
+        }
+        for (const CopiedEvent& event : copy_events (*trace)) {
+          if (event.start < m_since)
+            continue;
+          switch (event.kind) {
+          case TraceEventKind::zone:
+            begin_event (event.name, "X", trace->id);
+            output << ",\"ts\":" << microseconds (event.start)
+                   << ",\"dur\":" << microseconds (event.value) << '}';
+            break;
+          case TraceEventKind::plot:
+            begin_event (event.name, "C", trace->id);
+            output << ",\"ts\":" << microseconds (event.start)
+                   << ",\"args\":{\"value\":" << event.value << "}}";
+            break;
+          case TraceEventKind::frame:
+            begin_event (event.name, "i", trace->id);
+            output << ",\"ts\":" << microseconds (event.start)
+                   << ",\"s\":\"g\"}";
+            break;
+          }
+        }
+      }
+      output << "\n]}\n";
+    }
+  }
+
+  inline bool recording () noexcept {
+    return detail::trace_recording.load (std::memory_order_relaxed);
+  }
+
+  // Starts a new recording; what earlier recordings left in the rings is no
+  // longer written. A thread's ring is sized when it first records.
+  inline void start_recording (
+    std::size_t events_per_thread = default_trace_events) {
+    detail::trace_registry ().start (events_per_thread);
+  }
+
+  // The rings keep what they hold until the next start.
+  inline void stop_recording () noexcept {
+    detail::trace_recording.store (false, std::memory_order_relaxed);
+  }
+
+  // Records from now on and writes the trace to `path` when the process
+  // exits, or on demand through write_trace_file.
+  inline void record_trace (std::string path,
+                            std::size_t events_per_thread =
+                              default_trace_events) {
+    detail::trace_registry ().set_path (std::move (path));
+    start_recording (events_per_thread);
+  }
+
+  inline std::string trace_path () {
+    return detail::trace_registry ().path ();
+  }
+
+  // Everything the rings hold from the current recording, as Chrome
+  // trace-event JSON. Safe to call while other threads record.
+  inline void write_trace (std::ostream& output) {
+    detail::trace_registry ().write (output);
+  }
+
+  // False without a path or when the file cannot be written.
+  inline bool write_trace_file () {
+    const std::string path = trace_path ();
+    if (path.empty ())
+      return false;
+    std::ofstream output (path, std::ios::binary | std::ios::trunc);
+    write_trace (output);
+    return static_cast<bool> (output);
+  }
+
+  inline void name_thread (const char* name) {
+    detail::trace_registry ().current_thread ().name.store (
+      name, std::memory_order_relaxed);
+  }
+
+  inline void mark_frame () {
+    if (recording ())
+      detail::trace_registry ().record (
+        TraceEventKind::frame, "frame", detail::trace_now (), 0);
+  }
+
+  inline void plot (const char* name, std::int64_t value) {
+    if (recording ())
+      detail::trace_registry ().record (
+        TraceEventKind::plot, name, detail::trace_now (), value);
+  }
+
+  // A zone that began while recording is recorded as it ends. The thread's
+  // ring is found, or allocated, as the zone begins, so ending it only writes
+  // into a ring that is already there.
+  class Zone {
+  public:
+    explicit Zone (const char* name) noexcept
+        : m_name (name),
+          m_trace (recording () ? detail::trace_registry ().prepared_thread ()
+                                : nullptr),
+          m_start (m_trace ? detail::trace_now () : 0) {}
+
+    ~Zone () {
+      if (m_trace)
+        detail::write_event (*m_trace,
+                             TraceEventKind::zone,
+                             m_name,
+                             m_start,
+                             detail::trace_now () - m_start);
+    }
+
+    Zone (const Zone&) = delete;
+    Zone& operator= (const Zone&) = delete;
+
+  private:
+    const char* m_name;
+    detail::ThreadTrace* m_trace;
+    std::int64_t m_start;
+  };
+
+  namespace detail {
+    // MOPPE_TRACE=<file> records the whole run; the file is written as
+    // static objects are destroyed.
+    struct TraceAtExit {
+      TraceAtExit () {
+        if (const char* path = std::getenv ("MOPPE_TRACE"); path && *path)
+          record_trace (path);
+      }
+
+      ~TraceAtExit () {
+        write_trace_file ();
+      }
+    };
+
+    inline const TraceAtExit trace_at_exit;
+  }
+}
+
+#define MOPPE_PROFILE_CONCAT_(a, b) a##b
+#define MOPPE_PROFILE_CONCAT(a, b) MOPPE_PROFILE_CONCAT_ (a, b)
+
+#define MOPPE_PROFILE_FRAME() ::moppe::profile::mark_frame ()
+#define MOPPE_PROFILE_PLOT(name, value)                                        \
+  ::moppe::profile::plot (name, static_cast<int64_t> (value))
+#define MOPPE_PROFILE_THREAD(name) ::moppe::profile::name_thread (name)
+#define MOPPE_PROFILE_ZONE(name)                                               \
+  const ::moppe::profile::Zone MOPPE_PROFILE_CONCAT (moppe_profile_zone_,      \
+                                                     __LINE__) (name)
+#define MOPPE_PROFILE_NAMED_ZONE(variable, name)                               \
+  const ::moppe::profile::Zone variable (name)
 #define MOPPE_PROFILE_WAIT() ((void)0)
 #endif
@@ -243,6 +243,14 @@ namespace moppe::game {
                  mp_units::dimensionless,
                  mp_units::non_negative,
                  mp_units::is_kind);
+
+  // What names an individual rather than measuring it: the draw its every
+  // variation hashes from, and the codes of its growth form and age class.
+  // Each is a kind of its own, so a population can hold them as columns
+  // beside its measured attributes without any arithmetic between them.
+  QUANTITY_SPEC (tree_seed, mp_units::dimensionless, mp_units::is_kind);
+  QUANTITY_SPEC (tree_form, mp_units::dimensionless, mp_units::is_kind);
+  QUANTITY_SPEC (tree_age_class, mp_units::dimensionless, mp_units::is_kind);
 }
 
 #endif
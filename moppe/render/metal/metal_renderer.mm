@@ -73,6 +73,10 @@ namespace moppe {
       const int PROBE_H = 16;
       const int MAX_TIMESTAMP_SAMPLES = 64;
       const std::size_t FRAME_ARENA_CAPACITY = 8 << 20;
+      // Reflection terrain is refined until it sits within two pixels of
+      // the full surface on screen; off screen, a few metres are never seen.
+      const ReflectionProxyTolerance REFLECTION_PROXY_TOLERANCE = { 2.0f,
+                                                                    4.0f };
 
       double cpu_time () {
         using Clock = std::chrono::steady_clock;
@@ -178,6 +182,16 @@ namespace moppe {
         "reflection", "upscale", "interpolation", "present"
       };
 
+      // Normals travel as RG16Snorm xz; the shader rebuilds y.
+      void pack_terrain_normal (const terrain::TerrainNormal& normal,
+                                int16_t* packed) {
+        const Vec3 n = normal.numerical_value_in (mp_units::one);
+        const float x = std::clamp (n[0], -1.0f, 1.0f);
+        const float z = std::clamp (n[2], -1.0f, 1.0f);
+        packed[0] = (int16_t)(x * 32767.0f);
+        packed[1] = (int16_t)(z * 32767.0f);
+      }
+
       struct FrameTiming {
         std::mutex mutex;
         double interval_start = 0;
@@ -826,11 +840,11 @@ namespace moppe {
                                const DrawList& list,
                                const std::vector<Vertex>& previous,
                                float reactive);
+        // One instance per uniform block; uber_vertex picks its block by
+        // instance id, so a single draw is simply one block.
         static void draw_mesh (const MetalScenePassInputs& inputs,
                                const Mesh& mesh,
-                               const Mat4& model,
-                               const Mat4& previous_model,
-                               float reactive);
+                               std::span<const MoppeDrawUniforms> instances);
       };
 
       class MetalPostPass {
@@ -874,6 +888,10 @@ namespace moppe {
       set_terrain (const TerrainParams& params,
                    std::span<const terrain::SurfaceElevation> heights,
                    std::span<const terrain::TerrainNormal> normals) override;
+      void update_terrain_region (
+        const terrain::TerrainRect& region,
+        std::span<const terrain::SurfaceElevation> heights,
+        std::span<const terrain::TerrainNormal> normals) override;
       void set_terrain_topology_overlay (bool enabled) override;
       void set_terrain_textures (TexturePtr grass,
                                  TexturePtr dirt,
@@ -881,6 +899,9 @@ namespace moppe {
                                  TexturePtr snow) override;
       void set_terrain_overlay (const TerrainOverlayParams& params,
                                 std::span<const float> values) override;
+      void
+      update_terrain_overlay_region (const terrain::TerrainRect& region,
+                                     std::span<const float> values) override;
       void clear_terrain_overlay () override;
       void render_terrain_shadow (const Mat4& light_view_proj,
                                   bool include_forest) override;
@@ -946,6 +967,9 @@ namespace moppe {
       void draw_mesh (const Mesh& mesh,
                       const Mat4& model,
                       uint64_t motion_id = 0) override;
+      void draw_mesh_instances (
+        const Mesh& mesh,
+        std::span<const InstanceTransform> instances) override;
       void draw_list (const DrawList& list, uint64_t motion_id = 0) override;
       void reconstruct_scene () override;
       void apply_gtao (const GtaoParams& params) override;
@@ -989,6 +1013,17 @@ namespace moppe {
                            int h,
                            int bytes_per_pixel,
                            bool gen_mips);
+      // Draw uniforms for a mesh placement, with the previous transform its
+      // motion id recorded last frame.
+      MoppeDrawUniforms mesh_draw_uniforms (const Mat4& model,
+                                            uint64_t motion_id);
+      void upload_texture_region (id<MTLTexture> tex,
+                                  const void* pixels,
+                                  int x,
+                                  int y,
+                                  int w,
+                                  int h,
+                                  int bytes_per_pixel);
       id<MTLBuffer> create_private_buffer (const void* bytes,
                                            std::size_t size,
                                            NSString* label);
@@ -1073,6 +1108,7 @@ namespace moppe {
       bool m_camera_history_valid = false;
       std::unordered_map<uint64_t, Mat4> m_previous_models;
       std::unordered_map<uint64_t, Mat4> m_current_models;
+      std::vector<MoppeDrawUniforms> m_instance_uniforms;
       std::unordered_map<uint64_t, std::vector<Vertex>> m_previous_lists;
       std::unordered_map<uint64_t, std::vector<Vertex>> m_current_lists;
       bool m_profile_gpu = false;
@@ -2100,6 +2136,41 @@ namespace moppe {
       [m_residency commit];
     }
 
+    // A sub-rectangle of an existing texture. `pixels` holds only the
+    // rectangle, tightly packed.
+    void MetalRenderer::upload_texture_region (id<MTLTexture> tex,
+                                               const void* pixels,
+                                               int x,
+                                               int y,
+                                               int w,
+                                               int h,
+                                               int bpp) {
+      MOPPE_PROFILE_ZONE ("MetalRenderer::upload_texture_region");
+      const size_t bytes = (size_t)w * h * bpp;
+      id<MTLBuffer> staging =
+        [m_device newBufferWithBytes:pixels
+                              length:bytes
+                             options:MTLResourceStorageModeShared];
+      make_resident (staging);
+      id<MTL4CommandAllocator> allocator = [m_device newCommandAllocator];
+      id<MTL4CommandBuffer> cmd = [m_device newCommandBuffer];
+      [cmd beginCommandBufferWithAllocator:allocator];
+      id<MTL4ComputeCommandEncoder> blit = [cmd computeCommandEncoder];
+      [blit copyFromBuffer:staging
+               sourceOffset:0
+          sourceBytesPerRow:(NSUInteger)w * bpp
+        sourceBytesPerImage:bytes
+                 sourceSize:MTLSizeMake (w, h, 1)
+                  toTexture:tex
+           destinationSlice:0
+           destinationLevel:0
+          destinationOrigin:MTLOriginMake (x, y, 0)];
+      [blit endEncoding];
+      submit_and_wait (cmd);
+      [m_residency removeAllocation:staging];
+      [m_residency commit];
+    }
+
     void MetalRenderer::make_resident (id<MTLAllocation> allocation) {
       if (!allocation)
         return;
@@ -2193,14 +2264,14 @@ namespace moppe {
         forward = Vec3 (0.0f, 0.0f, -1.0f);
       const Vec3 focus = m_frame.params.camera_pos + forward * 1024.0f;
       const double proxy_start = cpu_time ();
-      ReflectionTerrainProxy proxy = build_reflection_terrain_proxy (
+      ReflectionTerrainProxy proxy = build_adaptive_reflection_terrain_proxy (
         m_terrain_resources.params,
         m_reflection_heights,
         focus,
         m_frame.params.proj * m_frame.params.view,
         static_cast<int> (m_frame.drawable.texture.width),
         static_cast<int> (m_frame.drawable.texture.height),
-        8,
+        REFLECTION_PROXY_TOLERANCE,
         2048.0f);
       const double proxy_ms = (cpu_time () - proxy_start) * 1000.0;
 
@@ -2533,6 +2604,10 @@ namespace moppe {
       output << "usage=prefer_fast_intersection\n";
       output << "ordinary_water_rendering=unchanged\n";
       output << "panels=normal,distance,primitive_barycentric,hit_mask\n";
+      output << "triangulation=adaptive_rtin\n";
+      output << "tolerance_px=" << REFLECTION_PROXY_TOLERANCE.projected_px
+             << '\n';
+      output << "tolerance_m=" << REFLECTION_PROXY_TOLERANCE.height_m << '\n';
       output << "source_stride=" << proxy.source_stride << '\n';
       output << "cells=" << proxy.cells_x << 'x' << proxy.cells_z << '\n';
       output << "bounds_m=" << proxy.minimum_x << ',' << proxy.minimum_z << ','
@@ -2713,13 +2788,8 @@ namespace moppe {
                       false);
       // Normals: RG16Snorm xz, y reconstructed in the shader.
       std::vector<int16_t> packed ((size_t)w * h * 2);
-      for (size_t i = 0; i < (size_t)w * h; ++i) {
-        const Vec3 n = normals[i].numerical_value_in (mp_units::one);
-        const float x = std::clamp (n[0], -1.0f, 1.0f);
-        const float z = std::clamp (n[2], -1.0f, 1.0f);
-        packed[i * 2 + 0] = (int16_t)(x * 32767.0f);
-        packed[i * 2 + 1] = (int16_t)(z * 32767.0f);
-      }
+      for (size_t i = 0; i < (size_t)w * h; ++i)
+        pack_terrain_normal (normals[i], &packed[i * 2]);
       if (!m_terrain_resources.normals ||
           m_terrain_resources.normals.width != (NSUInteger)w ||
           m_terrain_resources.normals.height != (NSUInteger)h) {
@@ -2764,6 +2834,62 @@ namespace moppe {
       m_terrain_resources.have_terrain = true;
     }
 
+    void MetalRenderer::update_terrain_region (
+      const terrain::TerrainRect& region,
+      std::span<const terrain::SurfaceElevation> heights,
+      std::span<const terrain::TerrainNormal> normals) {
+      MOPPE_PROFILE_ZONE ("MetalRenderer::update_terrain_region");
+      const TerrainParams& params = m_terrain_resources.params;
+      const std::size_t sample_count =
+        static_cast<std::size_t> (params.width) * params.height;
+      if (!m_terrain_resources.have_terrain ||
+          heights.size () != sample_count || normals.size () != sample_count)
+        throw std::invalid_argument ("invalid Metal terrain region");
+      const terrain::TerrainDomain lattice (params.width, params.height);
+#if !TARGET_OS_IPHONE
+      // The reflection proxy drops its heights once it is built, so a
+      // rebuild after an edit starts again from the whole current lattice.
+      if (reflection_requested ()) {
+        retire_reflection_geometry ();
+        m_reflection_heights.assign (heights.begin (), heights.end ());
+      }
+#endif
+      // Each piece of the region is a plain sub-rectangle of both textures;
+      // only its rows are gathered and only its normals are packed.
+      std::vector<float> piece_heights;
+      std::vector<int16_t> piece_normals;
+      lattice.visit_unwrapped (region, [&] (const terrain::TerrainRect& piece) {
+        piece_heights.resize (piece.columns * piece.rows);
+        piece_normals.resize (piece.columns * piece.rows * 2);
+        for (std::size_t row = 0; row < piece.rows; ++row) {
+          const std::size_t first =
+            (piece.origin.row + row) * params.width + piece.origin.column;
+          for (std::size_t column = 0; column < piece.columns; ++column) {
+            const std::size_t at = row * piece.columns + column;
+            piece_heights[at] =
+              terrain::surface_elevation_value (heights[first + column]);
+            pack_terrain_normal (normals[first + column],
+                                 &piece_normals[at * 2]);
+          }
+        }
+        const int x = static_cast<int> (piece.origin.column);
+        const int y = static_cast<int> (piece.origin.row);
+        const int w = static_cast<int> (piece.columns);
+        const int h = static_cast<int> (piece.rows);
+        upload_texture_region (m_terrain_resources.heights,
+                               piece_heights.data (),
+                               x,
+                               y,
+                               w,
+                               h,
+                               sizeof (float));
+        upload_texture_region (
+          m_terrain_resources.normals, piece_normals.data (), x, y, w, h, 4);
+      });
+      // The setup-time shadow map saw the old heights.
+      m_terrain_resources.have_shadow = false;
+    }
+
     void MetalRenderer::set_terrain_topology_overlay (bool enabled) {
       m_terrain_resources.params.topology_overlay = enabled;
     }
@@ -2807,6 +2933,34 @@ namespace moppe {
       m_terrain_resources.have_overlay = true;
     }
 
+    void MetalRenderer::update_terrain_overlay_region (
+      const terrain::TerrainRect& region,
+      std::span<const float> values) {
+      const TerrainOverlayParams& params = m_terrain_resources.overlay_params;
+      if (!m_terrain_resources.have_overlay ||
+          values.size () !=
+            static_cast<std::size_t> (params.width) * params.height)
+        throw std::invalid_argument ("invalid terrain overlay region");
+      const terrain::TerrainDomain lattice (params.width, params.height);
+      std::vector<float> piece_values;
+      lattice.visit_unwrapped (region, [&] (const terrain::TerrainRect& piece) {
+        piece_values.resize (piece.columns * piece.rows);
+        for (std::size_t row = 0; row < piece.rows; ++row)
+          std::copy_n (values.begin () +
+                         (piece.origin.row + row) * params.width +
+                         piece.origin.column,
+                       piece.columns,
+                       piece_values.begin () + row * piece.columns);
+        upload_texture_region (m_terrain_resources.overlay,
+                               piece_values.data (),
+                               static_cast<int> (piece.origin.column),
+                               static_cast<int> (piece.origin.row),
+                               static_cast<int> (piece.columns),
+                               static_cast<int> (piece.rows),
+                               sizeof (float));
+      });
+    }
+
     void MetalRenderer::clear_terrain_overlay () {
       m_terrain_resources.have_overlay = false;
     }
@@ -5397,30 +5551,20 @@ namespace moppe {
                                            : 0.0f);
     }
 
-    void MetalScenePass::draw_mesh (const MetalScenePassInputs& inputs,
-                                    const Mesh& mesh,
-                                    const Mat4& model,
-                                    const Mat4& previous_model,
-                                    float reactive) {
+    void MetalScenePass::draw_mesh (
+      const MetalScenePassInputs& inputs,
+      const Mesh& mesh,
+      std::span<const MoppeDrawUniforms> instances) {
       id<MTL4RenderCommandEncoder> enc = inputs.encoder;
       const MetalPipelines& pipelines = inputs.pipelines;
       const MetalTerrainResources& terrain = inputs.terrain;
       MetalFrameEncoding& frame = inputs.frame;
       const MetalMesh& m = (const MetalMesh&)mesh;
 
-      MoppeDrawUniforms du;
-      std::memset (&du, 0, sizeof (du));
-      du.model = m4 (model);
-      du.previous_model = m4 (previous_model);
-      const NormalMat nm = NormalMat::from (model);
-      du.nrm0 = f4 (nm.c0);
-      du.nrm1 = f4 (nm.c1);
-      du.nrm2 = f4 (nm.c2);
-      du.temporal.y = reactive;
       bind_address (frame,
                     MTLRenderStageVertex,
                     MOPPE_BUF_DRAW,
-                    frame.arena[frame.slot].write (du));
+                    frame.arena[frame.slot].write (instances));
       bind_address (
         frame, MTLRenderStageVertex, MOPPE_BUF_FRAME, frame.frame_uniforms);
       bind_address (
@@ -5440,18 +5584,13 @@ namespace moppe {
           enc, pipelines, terrain, frame, r.state, r.texture, false);
         [enc drawPrimitives:MTLPrimitiveTypeTriangle
                 vertexStart:r.first
-                vertexCount:r.count];
+                vertexCount:r.count
+              instanceCount:instances.size ()];
       }
     }
 
-    void MetalRenderer::draw_mesh (const Mesh& mesh,
-                                   const Mat4& model,
-                                   uint64_t motion_id) {
-      const MetalMesh& metal_mesh = (const MetalMesh&)mesh;
-      if (!metal_mesh.vertices)
-        return;
-      id<MTL4RenderCommandEncoder> encoder = scene_encoder ();
-      begin_gpu_pass (encoder, GpuPass::Scene);
+    MoppeDrawUniforms
+    MetalRenderer::mesh_draw_uniforms (const Mat4& model, uint64_t motion_id) {
       Mat4 previous = model;
       bool have_previous = false;
       if (motion_id && m_camera_history_valid) {
@@ -5463,6 +5602,39 @@ namespace moppe {
       }
       if (motion_id)
         m_current_models[motion_id] = model;
+
+      MoppeDrawUniforms du;
+      std::memset (&du, 0, sizeof (du));
+      du.model = m4 (model);
+      du.previous_model = m4 (previous);
+      const NormalMat nm = NormalMat::from (model);
+      du.nrm0 = f4 (nm.c0);
+      du.nrm1 = f4 (nm.c1);
+      du.nrm2 = f4 (nm.c2);
+      du.temporal.y = motion_id && !have_previous ? 1.0f : 0.0f;
+      return du;
+    }
+
+    void MetalRenderer::draw_mesh (const Mesh& mesh,
+                                   const Mat4& model,
+                                   uint64_t motion_id) {
+      const InstanceTransform instance { .model = model,
+                                         .motion_id = motion_id };
+      draw_mesh_instances (mesh, std::span (&instance, 1));
+    }
+
+    void MetalRenderer::draw_mesh_instances (
+      const Mesh& mesh,
+      std::span<const InstanceTransform> instances) {
+      const MetalMesh& metal_mesh = (const MetalMesh&)mesh;
+      if (!metal_mesh.vertices || instances.empty ())
+        return;
+      id<MTL4RenderCommandEncoder> encoder = scene_encoder ();
+      begin_gpu_pass (encoder, GpuPass::Scene);
+      m_instance_uniforms.clear ();
+      for (const InstanceTransform& instance : instances)
+        m_instance_uniforms.push_back (
+          mesh_draw_uniforms (instance.model, instance.motion_id));
       MetalScenePass::draw_mesh ({ m_device,
                                    m_residency,
                                    encoder,
@@ -5471,9 +5643,7 @@ namespace moppe {
                                    m_scene_resources,
                                    m_frame },
                                  mesh,
-                                 model,
-                                 previous,
-                                 motion_id && !have_previous ? 1.0f : 0.0f);
+                                 m_instance_uniforms);
     }
 
     void MetalWaterPass::draw_waterfalls (const MetalWaterPassInputs& inputs,
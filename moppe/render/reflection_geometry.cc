@@ -1,7 +1,10 @@
 #include <moppe/render/reflection_geometry.hh>
 
 #include <algorithm>
+#include <bit>
 #include <cmath>
+#include <cstdlib>
+#include <limits>
 #include <stdexcept>
 
 namespace moppe::render {
@@ -80,6 +83,253 @@ namespace moppe::render {
                ndc_x >= -1.0f && ndc_x <= 1.0f && ndc_y >= -1.0f &&
                  ndc_y <= 1.0f };
     }
+
+    struct SampleError {
+      float height_m = 0.0f;
+      float projected_px = 0.0f;
+      bool projected = false;
+    };
+
+    // How far the proxy's height at a sample strays from the authoritative
+    // one, vertically and, when both land on screen, in pixels.
+    SampleError sample_error (const Mat4& view_projection,
+                              int viewport_width,
+                              int viewport_height,
+                              float world_x,
+                              float world_z,
+                              float authoritative,
+                              float approximated) {
+      SampleError result;
+      result.height_m = std::abs (authoritative - approximated);
+      const ProjectedPoint actual =
+        project (view_projection,
+                 Vec3 (world_x, authoritative, world_z),
+                 viewport_width,
+                 viewport_height);
+      if (!actual.visible)
+        return result;
+      const ProjectedPoint proxy =
+        project (view_projection,
+                 Vec3 (world_x, approximated, world_z),
+                 viewport_width,
+                 viewport_height);
+      if (!proxy.visible)
+        return result;
+      const float dx = actual.x - proxy.x;
+      const float dy = actual.y - proxy.y;
+      result.projected_px = std::sqrt (dx * dx + dy * dy);
+      result.projected = true;
+      return result;
+    }
+
+    void validate_proxy_input (
+      const TerrainParams& terrain,
+      std::span<const terrain::SurfaceElevation> heights,
+      int viewport_width,
+      int viewport_height,
+      float half_extent_m) {
+      const std::size_t expected =
+        static_cast<std::size_t> (terrain.width) * terrain.height;
+      if (terrain.width < 2 || terrain.height < 2 ||
+          heights.size () != expected || terrain.scale[0] <= 0.0f ||
+          terrain.scale[2] <= 0.0f || half_extent_m <= 0.0f ||
+          viewport_width < 1 || viewport_height < 1)
+        throw std::invalid_argument ("invalid reflection terrain proxy input");
+    }
+
+    // Fills the proxy's metrics from every source sample of its window,
+    // given the height its triangles take at each.
+    template <typename Approximate>
+    void measure_proxy (ReflectionTerrainProxy& result,
+                        const TerrainParams& terrain,
+                        std::span<const terrain::SurfaceElevation> heights,
+                        const Mat4& view_projection,
+                        int viewport_width,
+                        int viewport_height,
+                        Approximate&& approximate) {
+      std::vector<float> height_errors;
+      std::vector<float> projected_errors;
+      const int fine_width = result.cells_x * result.source_stride;
+      const int fine_height = result.cells_z * result.source_stride;
+      height_errors.reserve (static_cast<std::size_t> (fine_width + 1) *
+                             (fine_height + 1));
+      double squared_error = 0.0;
+      float maximum_height_error = 0.0f;
+      float maximum_projected_error = 0.0f;
+      for (int local_z = 0; local_z <= fine_height; ++local_z)
+        for (int local_x = 0; local_x <= fine_width; ++local_x) {
+          const int x = result.start_sample_x + local_x;
+          const int z = result.start_sample_z + local_z;
+          const SampleError error =
+            sample_error (view_projection,
+                          viewport_width,
+                          viewport_height,
+                          x * terrain.scale[0],
+                          z * terrain.scale[2],
+                          source_height (terrain, heights, x, z),
+                          approximate (local_x, local_z));
+          height_errors.push_back (error.height_m);
+          squared_error += static_cast<double> (error.height_m) *
+                           error.height_m;
+          maximum_height_error =
+            std::max (maximum_height_error, error.height_m);
+          if (!error.projected)
+            continue;
+          projected_errors.push_back (error.projected_px);
+          maximum_projected_error =
+            std::max (maximum_projected_error, error.projected_px);
+        }
+
+      result.metrics.triangle_count = result.triangles.size () / 3;
+      result.metrics.source_sample_count = height_errors.size ();
+      result.metrics.projected_sample_count = projected_errors.size ();
+      result.metrics.height_rms_m = static_cast<float> (std::sqrt (
+        squared_error / std::max<std::size_t> (1, height_errors.size ())));
+      result.metrics.height_p95_m = percentile_95 (height_errors);
+      result.metrics.height_max_m = maximum_height_error;
+      result.metrics.projected_p95_px = percentile_95 (projected_errors);
+      result.metrics.projected_max_px = maximum_projected_error;
+    }
+
+    // A right-triangulated irregular network over a square window of
+    // (side + 1)^2 samples, side a power of two. Every triangle is right
+    // isosceles; splitting one at the midpoint of its hypotenuse gives two
+    // more, and every sample but the corners is such a midpoint. Whether a
+    // midpoint joins the mesh is decided once, for the sample, so the two
+    // triangles sharing a hypotenuse always agree and the mesh has no
+    // cracks.
+    struct NetworkTriangle {
+      int ax, az; // hypotenuse
+      int bx, bz;
+      int cx, cz; // right angle
+    };
+
+    class ProxyNetwork {
+    public:
+      ProxyNetwork (int side, std::vector<float> surface)
+          : m_side (side),
+            m_surface (std::move (surface)),
+            m_errors (m_surface.size (), 0.0f) {}
+
+      std::size_t index (int x, int z) const {
+        return static_cast<std::size_t> (z) * (m_side + 1) + x;
+      }
+
+      float height (int x, int z) const {
+        return m_surface[index (x, z)];
+      }
+
+      // Scores each midpoint by the weighted error of leaving it out of the
+      // triangle whose hypotenuse it halves, then raises every score to at
+      // least those of the midpoints below it, finest triangles first, so a
+      // sample is only reached through splits that are themselves needed.
+      // Scores above one split; forced samples keep theirs.
+      void score (std::span<const float> weight_per_m) {
+        const std::size_t side = static_cast<std::size_t> (m_side);
+        const std::size_t count = 2 * side * side - 2;
+        const std::size_t parents = count - side * side;
+        for (std::size_t triangle = count; triangle-- > 0;) {
+          const NetworkTriangle t = locate (triangle + 2);
+          const std::size_t middle =
+            index ((t.ax + t.bx) / 2, (t.az + t.bz) / 2);
+          const float interpolated =
+            0.5f * (height (t.ax, t.az) + height (t.bx, t.bz));
+          float error = std::abs (interpolated - m_surface[middle]) *
+                        weight_per_m[middle];
+          if (triangle < parents)
+            error = std::max ({ error,
+                                m_errors[index ((t.ax + t.cx) / 2,
+                                                (t.az + t.cz) / 2)],
+                                m_errors[index ((t.bx + t.cx) / 2,
+                                                (t.bz + t.cz) / 2)] });
+          m_errors[middle] = std::max (m_errors[middle], error);
+        }
+      }
+
+      void force (int x, int z) {
+        m_errors[index (x, z)] = std::numeric_limits<float>::infinity ();
+      }
+
+      std::vector<NetworkTriangle> triangles () const {
+        std::vector<NetworkTriangle> result;
+        split (result, { 0, 0, m_side, m_side, m_side, 0 });
+        split (result, { m_side, m_side, 0, 0, 0, m_side });
+        return result;
+      }
+
+      // The height each sample takes on the mesh.
+      std::vector<float>
+      interpolate (std::span<const NetworkTriangle> triangles) const {
+        std::vector<float> result (m_surface.size ());
+        for (const NetworkTriangle& t : triangles) {
+          const int ux = t.bx - t.ax;
+          const int uz = t.bz - t.az;
+          const int vx = t.cx - t.ax;
+          const int vz = t.cz - t.az;
+          const int sign = ux * vz - uz * vx < 0 ? -1 : 1;
+          const int area = sign * (ux * vz - uz * vx);
+          const float ha = height (t.ax, t.az);
+          const float hb = height (t.bx, t.bz) - ha;
+          const float hc = height (t.cx, t.cz) - ha;
+          for (int z = std::min ({ t.az, t.bz, t.cz });
+               z <= std::max ({ t.az, t.bz, t.cz });
+               ++z)
+            for (int x = std::min ({ t.ax, t.bx, t.cx });
+                 x <= std::max ({ t.ax, t.bx, t.cx });
+                 ++x) {
+              const int px = x - t.ax;
+              const int pz = z - t.az;
+              const int along_b = sign * (px * vz - pz * vx);
+              const int along_c = sign * (ux * pz - uz * px);
+              if (along_b < 0 || along_c < 0 || along_b + along_c > area)
+                continue;
+              result[index (x, z)] =
+                ha + (static_cast<float> (along_b) * hb +
+                      static_cast<float> (along_c) * hc) /
+                       static_cast<float> (area);
+            }
+        }
+        return result;
+      }
+
+    private:
+      // Triangle id in the implicit binary tree: 2 and 3 are the window's
+      // halves, and the low bits below the leading one choose left or right
+      // halves on the way down.
+      NetworkTriangle locate (std::size_t id) const {
+        NetworkTriangle t {};
+        if (id & 1)
+          t = { 0, 0, m_side, m_side, m_side, 0 };
+        else
+          t = { m_side, m_side, 0, 0, 0, m_side };
+        while ((id >>= 1) > 1) {
+          const int mx = (t.ax + t.bx) / 2;
+          const int mz = (t.az + t.bz) / 2;
+          if (id & 1)
+            t = { t.cx, t.cz, t.ax, t.az, mx, mz };
+          else
+            t = { t.bx, t.bz, t.cx, t.cz, mx, mz };
+        }
+        return t;
+      }
+
+      void split (std::vector<NetworkTriangle>& result,
+                  const NetworkTriangle& t) const {
+        const int mx = (t.ax + t.bx) / 2;
+        const int mz = (t.az + t.bz) / 2;
+        if (std::abs (t.ax - t.cx) + std::abs (t.az - t.cz) > 1 &&
+            m_errors[index (mx, mz)] > 1.0f) {
+          split (result, { t.cx, t.cz, t.ax, t.az, mx, mz });
+          split (result, { t.bx, t.bz, t.cx, t.cz, mx, mz });
+        } else {
+          result.push_back (t);
+        }
+      }
+
+      int m_side;
+      std::vector<float> m_surface;
+      std::vector<float> m_errors;
+    };
   }
 
   ReflectionTerrainProxy build_reflection_terrain_proxy (
@@ -91,12 +341,9 @@ namespace moppe::render {
     int viewport_height,
     int source_stride,
     float half_extent_m) {
-    const std::size_t expected =
-      static_cast<std::size_t> (terrain.width) * terrain.height;
-    if (terrain.width < 2 || terrain.height < 2 ||
-        heights.size () != expected || terrain.scale[0] <= 0.0f ||
-        terrain.scale[2] <= 0.0f || source_stride < 1 ||
-        half_extent_m <= 0.0f || viewport_width < 1 || viewport_height < 1)
+    validate_proxy_input (
+      terrain, heights, viewport_width, viewport_height, half_extent_m);
+    if (source_stride < 1)
       throw std::invalid_argument ("invalid reflection terrain proxy input");
 
     ReflectionTerrainProxy result;
@@ -146,60 +393,144 @@ namespace moppe::render {
                                  { v00, v01, v10, v10, v01, v11 });
       }
 
-    std::vector<float> height_errors;
-    std::vector<float> projected_errors;
-    const int fine_width = result.cells_x * source_stride;
-    const int fine_height = result.cells_z * source_stride;
-    height_errors.reserve (static_cast<std::size_t> (fine_width + 1) *
-                           (fine_height + 1));
-    double squared_error = 0.0;
-    float maximum_height_error = 0.0f;
-    float maximum_projected_error = 0.0f;
-    for (int local_z = 0; local_z <= fine_height; ++local_z)
-      for (int local_x = 0; local_x <= fine_width; ++local_x) {
+    measure_proxy (result,
+                   terrain,
+                   heights,
+                   view_projection,
+                   viewport_width,
+                   viewport_height,
+                   [&] (int local_x, int local_z) {
+                     return proxy_height (terrain,
+                                          heights,
+                                          result.start_sample_x + local_x,
+                                          result.start_sample_z + local_z,
+                                          source_stride);
+                   });
+    return result;
+  }
+
+  ReflectionTerrainProxy build_adaptive_reflection_terrain_proxy (
+    const TerrainParams& terrain,
+    std::span<const terrain::SurfaceElevation> heights,
+    const Vec3& focus,
+    const Mat4& view_projection,
+    int viewport_width,
+    int viewport_height,
+    const ReflectionProxyTolerance& tolerance,
+    float half_extent_m) {
+    validate_proxy_input (
+      terrain, heights, viewport_width, viewport_height, half_extent_m);
+    if (!(tolerance.projected_px > 0.0f) || !(tolerance.height_m > 0.0f))
+      throw std::invalid_argument ("invalid reflection terrain proxy input");
+
+    const int span = std::max (
+      { 2,
+        static_cast<int> (std::ceil (2.0f * half_extent_m / terrain.scale[0])),
+        static_cast<int> (
+          std::ceil (2.0f * half_extent_m / terrain.scale[2])) });
+    const int side = static_cast<int> (
+      std::bit_ceil (static_cast<unsigned int> (span)));
+
+    ReflectionTerrainProxy result;
+    result.source_stride = 1;
+    result.cells_x = side;
+    result.cells_z = side;
+    result.start_sample_x =
+      static_cast<int> (std::floor (focus[0] / terrain.scale[0])) - side / 2;
+    result.start_sample_z =
+      static_cast<int> (std::floor (focus[2] / terrain.scale[2])) - side / 2;
+    result.minimum_x = result.start_sample_x * terrain.scale[0];
+    result.minimum_z = result.start_sample_z * terrain.scale[2];
+    result.maximum_x = (result.start_sample_x + side) * terrain.scale[0];
+    result.maximum_z = (result.start_sample_z + side) * terrain.scale[2];
+
+    // Each sample's error is weighed so that one is exactly the tolerance:
+    // on screen by the pixels a metre of height moves it, off screen by the
+    // height bound alone.
+    const std::size_t samples =
+      static_cast<std::size_t> (side + 1) * (side + 1);
+    std::vector<float> surface;
+    std::vector<float> weight_per_m;
+    surface.reserve (samples);
+    weight_per_m.reserve (samples);
+    for (int local_z = 0; local_z <= side; ++local_z)
+      for (int local_x = 0; local_x <= side; ++local_x) {
         const int x = result.start_sample_x + local_x;
         const int z = result.start_sample_z + local_z;
-        const float authoritative = source_height (terrain, heights, x, z);
-        const float approximated =
-          proxy_height (terrain, heights, x, z, source_stride);
-        const float error = std::abs (authoritative - approximated);
-        height_errors.push_back (error);
-        squared_error += static_cast<double> (error) * error;
-        maximum_height_error = std::max (maximum_height_error, error);
-
-        const float world_x = x * terrain.scale[0];
-        const float world_z = z * terrain.scale[2];
-        const ProjectedPoint actual =
-          project (view_projection,
-                   Vec3 (world_x, authoritative, world_z),
-                   viewport_width,
-                   viewport_height);
-        if (!actual.visible)
-          continue;
-        const ProjectedPoint proxy =
-          project (view_projection,
-                   Vec3 (world_x, approximated, world_z),
-                   viewport_width,
-                   viewport_height);
-        if (!proxy.visible)
-          continue;
-        const float dx = actual.x - proxy.x;
-        const float dy = actual.y - proxy.y;
-        const float pixel_error = std::sqrt (dx * dx + dy * dy);
-        projected_errors.push_back (pixel_error);
-        maximum_projected_error =
-          std::max (maximum_projected_error, pixel_error);
+        const float height = source_height (terrain, heights, x, z);
+        const SampleError metre = sample_error (view_projection,
+                                                viewport_width,
+                                                viewport_height,
+                                                x * terrain.scale[0],
+                                                z * terrain.scale[2],
+                                                height,
+                                                height + 1.0f);
+        surface.push_back (height);
+        weight_per_m.push_back (metre.projected
+                                  ? metre.projected_px / tolerance.projected_px
+                                  : 1.0f / tolerance.height_m);
       }
 
-    result.metrics.triangle_count = result.triangles.size () / 3;
-    result.metrics.source_sample_count = height_errors.size ();
-    result.metrics.projected_sample_count = projected_errors.size ();
-    result.metrics.height_rms_m = static_cast<float> (std::sqrt (
-      squared_error / std::max<std::size_t> (1, height_errors.size ())));
-    result.metrics.height_p95_m = percentile_95 (height_errors);
-    result.metrics.height_max_m = maximum_height_error;
-    result.metrics.projected_p95_px = percentile_95 (projected_errors);
-    result.metrics.projected_max_px = maximum_projected_error;
+    // The weights linearise the projection, so the finished mesh is checked
+    // against the exact measure and every sample still out of bounds is
+    // forced in until none is. Each round adds samples, and a sample on the
+    // mesh has no error, so this ends.
+    ProxyNetwork network (side, std::move (surface));
+    std::vector<NetworkTriangle> triangles;
+    std::vector<float> approximated;
+    for (bool refined = true; refined;) {
+      network.score (weight_per_m);
+      triangles = network.triangles ();
+      approximated = network.interpolate (triangles);
+      refined = false;
+      for (int local_z = 0; local_z <= side; ++local_z)
+        for (int local_x = 0; local_x <= side; ++local_x) {
+          const SampleError error = sample_error (
+            view_projection,
+            viewport_width,
+            viewport_height,
+            (result.start_sample_x + local_x) * terrain.scale[0],
+            (result.start_sample_z + local_z) * terrain.scale[2],
+            network.height (local_x, local_z),
+            approximated[network.index (local_x, local_z)]);
+          if (error.projected ? error.projected_px > tolerance.projected_px
+                              : error.height_m > tolerance.height_m) {
+            network.force (local_x, local_z);
+            refined = true;
+          }
+        }
+    }
+
+    // Wound as the grid proxy's triangles are.
+    result.triangles.reserve (triangles.size () * 3);
+    const auto vertex = [&] (int local_x, int local_z) {
+      return ReflectionProxyVertex {
+        (result.start_sample_x + local_x) * terrain.scale[0],
+        network.height (local_x, local_z),
+        (result.start_sample_z + local_z) * terrain.scale[2]
+      };
+    };
+    for (const NetworkTriangle& t : triangles) {
+      const bool grid_winding =
+        (t.bx - t.ax) * (t.cz - t.az) - (t.bz - t.az) * (t.cx - t.ax) < 0;
+      const ReflectionProxyVertex a = vertex (t.ax, t.az);
+      const ReflectionProxyVertex b = vertex (t.bx, t.bz);
+      const ReflectionProxyVertex c = vertex (t.cx, t.cz);
+      if (grid_winding)
+        result.triangles.insert (result.triangles.end (), { a, b, c });
+      else
+        result.triangles.insert (result.triangles.end (), { a, c, b });
+    }
+
+    measure_proxy (result,
+                   terrain,
+                   heights,
+                   view_projection,
+                   viewport_width,
+                   viewport_height,
+                   [&] (int local_x, int local_z) {
+                     return approximated[network.index (local_x, local_z)];
+                   });
     return result;
   }
 }
@@ -25,9 +25,20 @@ namespace moppe::render {
     float projected_max_px = 0.0f;
   };
 
+  // How far an adaptive proxy may stray from the authoritative surface. On
+  // screen the bound is the distance in pixels between where the proxy and
+  // the full surface put a sample; off screen, where reflections still look,
+  // it is in vertical metres.
+  struct ReflectionProxyTolerance {
+    float projected_px = 1.0f;
+    float height_m = 4.0f;
+  };
+
   struct ReflectionTerrainProxy {
     std::vector<ReflectionProxyVertex> triangles;
     ReflectionProxyMetrics metrics;
+    // An adaptive proxy reports stride one and the cells its window spans;
+    // its triangles are not a grid over them.
     int source_stride = 0;
     int cells_x = 0;
     int cells_z = 0;
@@ -51,6 +62,22 @@ namespace moppe::render {
     int viewport_height,
     int source_stride = 8,
     float half_extent_m = 2048.0f);
+
+  // Builds the same bounded proxy as a right-triangulated irregular network:
+  // a square power-of-two window of source samples, bisected along longest
+  // edges only where the coarser triangle would break the tolerance. The
+  // network is measured as the grid proxy is and refined again until its
+  // own metrics honour the bound, so flat or distant ground costs a handful
+  // of triangles and projected_max_px never exceeds tolerance.projected_px.
+  ReflectionTerrainProxy build_adaptive_reflection_terrain_proxy (
+    const TerrainParams& terrain,
+    std::span<const terrain::SurfaceElevation> heights,
+    const Vec3& focus,
+    const Mat4& view_projection,
+    int viewport_width,
+    int viewport_height,
+    const ReflectionProxyTolerance& tolerance = {},
+    float half_extent_m = 2048.0f);
 }
 
 #endif
@@ -172,6 +172,13 @@ namespace moppe {
       float offset_z = 0.0f;
     };
 
+    // One placement of a retained mesh in an instanced draw. The motion id
+    // means what it means for a single draw_mesh.
+    struct InstanceTransform {
+      Mat4 model;
+      uint64_t motion_id = 0;
+    };
+
     struct SkyParams {
       float time;
       float sun_height;
@@ -266,6 +273,13 @@ namespace moppe {
       set_terrain (const TerrainParams& params,
                    std::span<const terrain::SurfaceElevation> heights,
                    std::span<const terrain::TerrainNormal> normals) = 0;
+      // Re-uploads the samples inside `region` after a local height edit.
+      // The spans cover the whole lattice, as for set_terrain, but only the
+      // region's sites are read; it may wrap across either seam.
+      virtual void update_terrain_region (
+        const terrain::TerrainRect& region,
+        std::span<const terrain::SurfaceElevation> heights,
+        std::span<const terrain::TerrainNormal> normals) = 0;
       // Hot development control: changes only terrain shading state, leaving
       // height/normal textures and chunk geometry intact.
       virtual void set_terrain_topology_overlay (bool enabled) = 0;
@@ -275,6 +289,14 @@ namespace moppe {
                                          TexturePtr snow) = 0;
       virtual void set_terrain_overlay (const TerrainOverlayParams& params,
                                         std::span<const float> values) = 0;
+      // The same partial refresh for an overlay already set; renderers
+      // without one ignore it.
+      virtual void
+      update_terrain_overlay_region (const terrain::TerrainRect& region,
+                                     std::span<const float> values) {
+        (void)region;
+        (void)values;
+      }
       virtual void clear_terrain_overlay () = 0;
       // Renders the one-time terrain shadow map from the fixed sun.
       // light_view_proj maps world to light NDC (conventional Z).
@@ -347,6 +369,15 @@ namespace moppe {
       virtual void draw_mesh (const Mesh& mesh,
                               const Mat4& model,
                               uint64_t motion_id = 0) = 0;
+      // Many placements of one retained mesh in a single submission, each
+      // with its own transform. Backends without instancing draw them one by
+      // one, which is always equivalent.
+      virtual void
+      draw_mesh_instances (const Mesh& mesh,
+                           std::span<const InstanceTransform> instances) {
+        for (const InstanceTransform& instance : instances)
+          draw_mesh (mesh, instance.model, instance.motion_id);
+      }
       virtual void draw_list (const DrawList& list, uint64_t motion_id = 0) = 0;
       // Resolve the low-resolution 3D scene before screen-space effects. It
       // is idempotent so backend-specific callers can safely enforce the
@@ -2,14 +2,20 @@
 #define MOPPE_RENDER_TEXTURE_PIXELS_HH
 
 #include <moppe/gfx/math.hh>
+#include <moppe/half.hh>
+#include <moppe/parallel.hh>
 #include <moppe/spatial/bundle.hh>
 
 #include <algorithm>
 #include <bit>
+#include <concepts>
 #include <cstddef>
 #include <cstdint>
 #include <cstring>
+#include <span>
 #include <stdexcept>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
 // A texture that has not been built yet.
@@ -80,82 +86,114 @@ namespace moppe::render {
     return channels_in (format) * channel_bytes (format);
   }
 
-  // IEEE binary16. Written out rather than borrowed from a compiler extension
-  // so the packing is the same on every backend this builds for.
-  constexpr std::uint16_t float_to_half (float value) {
-    const std::uint32_t bits = std::bit_cast<std::uint32_t> (value);
-    const std::uint32_t sign = (bits >> 16) & 0x8000u;
-    const std::int32_t exponent =
-      static_cast<std::int32_t> ((bits >> 23) & 0xffu) - 127 + 15;
-    std::uint32_t mantissa = bits & 0x7fffffu;
-    if (exponent >= 0x1f)
-      return static_cast<std::uint16_t> (sign | 0x7c00u |
-                                         (mantissa != 0 ? 0x200u : 0u));
-    if (exponent <= 0) {
-      if (exponent < -10)
-        return static_cast<std::uint16_t> (sign);
-      mantissa |= 0x800000u;
-      const std::uint32_t shift = static_cast<std::uint32_t> (14 - exponent);
-      return static_cast<std::uint16_t> (sign | (mantissa >> shift));
+  // Half precision is shared with quantized bundle columns, so the packing a
+  // texture lane uses is the one a stored reading already has.
+  using moppe::float_to_half;
+  using moppe::half_to_float;
+
+  namespace detail {
+    // float_to_half with every branch turned into a select, so a block of
+    // lanes takes one path and the compiler can keep it in vector registers.
+    // It must agree with float_to_half bit for bit, including that function's
+    // truncation and its treatment of large finite values; the surface tests
+    // sweep the two against each other.
+    constexpr std::uint16_t float_to_half_lane (float value) {
+      const std::uint32_t bits = std::bit_cast<std::uint32_t> (value);
+      const std::uint32_t sign = (bits >> 16) & 0x8000u;
+      const std::int32_t exponent =
+        static_cast<std::int32_t> ((bits >> 23) & 0xffu) - 127 + 15;
+      const std::uint32_t mantissa = bits & 0x7fffffu;
+      const std::uint32_t overflow =
+        sign | 0x7c00u | (mantissa != 0 ? 0x200u : 0u);
+      const std::uint32_t shift =
+        static_cast<std::uint32_t> (std::clamp (14 - exponent, 14, 24));
+      const std::uint32_t subnormal =
+        exponent < -10 ? sign : sign | ((mantissa | 0x800000u) >> shift);
+      const std::uint32_t normal =
+        sign | (static_cast<std::uint32_t> (exponent) << 10) | (mantissa >> 13);
+      return static_cast<std::uint16_t> (
+        exponent >= 0x1f ? overflow : (exponent <= 0 ? subnormal : normal));
     }
-    return static_cast<std::uint16_t> (
-      sign | (static_cast<std::uint32_t> (exponent) << 10) | (mantissa >> 13));
-  }
 
-  // The inverse, for reading a packed texture back. Tests and tools want it;
-  // the upload path never does.
-  inline float half_to_float (std::uint16_t half) {
-    const std::uint32_t sign = (static_cast<std::uint32_t> (half) & 0x8000u)
-                               << 16;
-    std::uint32_t exponent = (half >> 10) & 0x1fu;
-    std::uint32_t mantissa = half & 0x3ffu;
-    if (exponent == 0) {
-      if (mantissa == 0)
-        return std::bit_cast<float> (sign);
-      exponent = 1;
-      while ((mantissa & 0x400u) == 0) {
-        mantissa <<= 1;
-        --exponent;
+    // One texel lane per format: its storage type and how a stored float
+    // becomes it.
+    struct FloatLane {
+      using type = float;
+      static constexpr type encode (float value) {
+        return value;
       }
-      mantissa &= 0x3ffu;
-    } else if (exponent == 0x1f) {
-      return std::bit_cast<float> (sign | 0x7f800000u | (mantissa << 13));
-    }
-    return std::bit_cast<float> (sign | ((exponent + 127 - 15) << 23) |
-                                 (mantissa << 13));
-  }
+    };
 
-  namespace detail {
-    inline void write_channel (std::byte* at, PixelFormat format, float value) {
-      switch (format) {
-      case PixelFormat::r32f:
-      case PixelFormat::rg32f:
-        std::memcpy (at, &value, sizeof (float));
-        return;
-      case PixelFormat::r16f:
-      case PixelFormat::rg16f: {
-        const std::uint16_t half = float_to_half (value);
-        std::memcpy (at, &half, sizeof half);
-        return;
+    struct HalfLane {
+      using type = std::uint16_t;
+      static constexpr type encode (float value) {
+        return float_to_half_lane (value);
       }
-      case PixelFormat::rg16snorm: {
-        const std::int16_t packed = static_cast<std::int16_t> (
-          std::clamp (value, -1.0f, 1.0f) * 32767.0f);
-        std::memcpy (at, &packed, sizeof packed);
-        return;
+    };
+
+    struct Snorm16Lane {
+      using type = std::int16_t;
+      static constexpr type encode (float value) {
+        return static_cast<type> (std::clamp (value, -1.0f, 1.0f) * 32767.0f);
       }
-      case PixelFormat::rgba8unorm: {
-        const std::uint8_t packed = static_cast<std::uint8_t> (
-          std::clamp (value, 0.0f, 1.0f) * 255.0f + 0.5f);
-        std::memcpy (at, &packed, sizeof packed);
-        return;
+    };
+
+    struct Unorm8Lane {
+      using type = std::uint8_t;
+      static constexpr type encode (float value) {
+        return static_cast<type> (std::clamp (value, 0.0f, 1.0f) * 255.0f +
+                                  0.5f);
       }
-      case PixelFormat::rg8snorm: {
-        const std::int8_t packed =
-          static_cast<std::int8_t> (std::clamp (value, -1.0f, 1.0f) * 127.0f);
-        std::memcpy (at, &packed, sizeof packed);
-        return;
+    };
+
+    struct Snorm8Lane {
+      using type = std::int8_t;
+      static constexpr type encode (float value) {
+        return static_cast<type> (std::clamp (value, -1.0f, 1.0f) * 127.0f);
       }
+    };
+
+    template <PixelFormat Format>
+    struct PixelLane;
+    template <>
+    struct PixelLane<PixelFormat::r32f> : FloatLane {};
+    template <>
+    struct PixelLane<PixelFormat::rg32f> : FloatLane {};
+    template <>
+    struct PixelLane<PixelFormat::r16f> : HalfLane {};
+    template <>
+    struct PixelLane<PixelFormat::rg16f> : HalfLane {};
+    template <>
+    struct PixelLane<PixelFormat::rg16snorm> : Snorm16Lane {};
+    template <>
+    struct PixelLane<PixelFormat::rgba8unorm> : Unorm8Lane {};
+    template <>
+    struct PixelLane<PixelFormat::rg8snorm> : Snorm8Lane {};
+
+    // Pixels are packed a block at a time: gather each channel's floats, then
+    // encode and interleave a fixed-size block. The encode loop has a constant
+    // trip count and no branches, which is what lets it vectorize.
+    constexpr std::size_t pack_block = 16;
+
+    // Turn a runtime format into a compile-time one, once per upload rather
+    // than once per channel of every texel.
+    template <typename Visit>
+    void visit_pixel_format (PixelFormat format, Visit&& visit) {
+      switch (format) {
+      case PixelFormat::r32f:
+        return visit.template operator()<PixelFormat::r32f> ();
+      case PixelFormat::rg32f:
+        return visit.template operator()<PixelFormat::rg32f> ();
+      case PixelFormat::r16f:
+        return visit.template operator()<PixelFormat::r16f> ();
+      case PixelFormat::rg16f:
+        return visit.template operator()<PixelFormat::rg16f> ();
+      case PixelFormat::rg16snorm:
+        return visit.template operator()<PixelFormat::rg16snorm> ();
+      case PixelFormat::rgba8unorm:
+        return visit.template operator()<PixelFormat::rgba8unorm> ();
+      case PixelFormat::rg8snorm:
+        return visit.template operator()<PixelFormat::rg8snorm> ();
       }
     }
 
@@ -176,11 +214,108 @@ namespace moppe::render {
     }
   }
 
+  // A channel already held in its texture lane's own codes -- a quantized
+  // column whose encoding is the lane's -- is copied into place instead of
+  // being decoded and packed again.
+  template <typename Packed>
+  struct LaneCodes {
+    std::span<const Packed> codes;
+  };
+
+  namespace detail {
+    template <typename Source>
+    struct IsLaneCodes : std::false_type {};
+    template <typename Packed>
+    struct IsLaneCodes<LaneCodes<Packed>> : std::true_type {};
+
+    // Every lane-code source carries exactly the format's lane type.
+    template <PixelFormat Format, typename Source>
+    constexpr bool fits_lane =
+      !IsLaneCodes<Source>::value ||
+      std::same_as<Source, LaneCodes<typename PixelLane<Format>::type>>;
+  }
+
+  // Pack `count` consecutive pixels, starting at pixel `first`, into an image
+  // whose first byte is `destination`. Each source is a callable giving the
+  // stored float of its channel at one pixel, or the channel's LaneCodes, in
+  // channel order.
+  template <PixelFormat Format, typename... Sources>
+  void pack_pixels (std::byte* destination,
+                    std::size_t first,
+                    std::size_t count,
+                    const Sources&... sources) {
+    using Lane = detail::PixelLane<Format>;
+    using Packed = typename Lane::type;
+    constexpr std::size_t channels = sizeof...(Sources);
+    constexpr std::size_t block = detail::pack_block;
+    static_assert (channels == channels_in (Format),
+                   "texture format wants a different number of channels");
+    static_assert (sizeof (Packed) == channel_bytes (Format));
+    static_assert ((detail::fits_lane<Format, Sources> && ...),
+                   "lane codes must be the texture format's own lanes");
+
+    std::byte* at = destination + first * bytes_per_pixel (Format);
+    Packed packed[channels * block];
+    for (std::size_t begin = 0; begin < count; begin += block) {
+      const std::size_t filled = std::min (block, count - begin);
+      [&]<std::size_t... Channel> (std::index_sequence<Channel...>) {
+        (
+          [&] {
+            if constexpr (detail::IsLaneCodes<Sources>::value) {
+              const Packed* codes = sources.codes.data () + first + begin;
+              for (std::size_t pixel = 0; pixel < filled; ++pixel)
+                packed[pixel * channels + Channel] = codes[pixel];
+            } else {
+              float lane[block];
+              for (std::size_t pixel = 0; pixel < filled; ++pixel)
+                lane[pixel] = sources (first + begin + pixel);
+              for (std::size_t pixel = filled; pixel < block; ++pixel)
+                lane[pixel] = 0.0f;
+              for (std::size_t pixel = 0; pixel < block; ++pixel)
+                packed[pixel * channels + Channel] = Lane::encode (lane[pixel]);
+            }
+          }(),
+          ...);
+      }(std::make_index_sequence<channels> {});
+      std::memcpy (at + begin * bytes_per_pixel (Format),
+                   packed,
+                   filled * bytes_per_pixel (Format));
+    }
+  }
+
+  // The same kernel chosen by a runtime format, over whole lattice rows. A
+  // format whose lanes are not the lane codes given is rejected.
+  template <typename... Sources>
+  void pack_rows (PixelFormat format,
+                  std::byte* destination,
+                  std::size_t width,
+                  std::size_t first_row,
+                  std::size_t last_row,
+                  const Sources&... sources) {
+    detail::visit_pixel_format (format, [&]<PixelFormat Format> () {
+      if constexpr (channels_in (Format) != sizeof...(Sources))
+        throw std::invalid_argument (
+          "texture format wants a different number of channels");
+      else if constexpr (!(detail::fits_lane<Format, Sources> && ...))
+        throw std::invalid_argument (
+          "texture format does not share the given lane codes");
+      else
+        pack_pixels<Format> (destination,
+                             first_row * width,
+                             (last_row - first_row) * width,
+                             sources...);
+    });
+  }
+
   class TexturePixels {
   public:
+    // Write rows [first_row, last_row) of the image whose first byte is
+    // `destination`. Rows are independent, so any split of them is valid.
     using Writer = void (*) (const void* source,
                              PixelFormat format,
-                             std::byte* destination);
+                             std::byte* destination,
+                             std::size_t first_row,
+                             std::size_t last_row);
 
     TexturePixels () = default;
 
@@ -210,8 +345,18 @@ namespace moppe::render {
       return m_width * m_height * bytes_per_pixel (m_format);
     }
 
+    // The whole image, its rows shared among workers when there are enough
+    // texels to be worth it.
     void write_into (std::byte* destination) const {
-      m_writer (m_source, m_format, destination);
+      parallel_rows (m_height, m_width * m_height, [&] (std::size_t row) {
+        m_writer (m_source, m_format, destination, row, row + 1);
+      });
+    }
+
+    void write_rows (std::byte* destination,
+                     std::size_t first_row,
+                     std::size_t last_row) const {
+      m_writer (m_source, m_format, destination, first_row, last_row);
     }
 
   private:
@@ -269,36 +414,36 @@ namespace moppe::render {
     template <typename Bundle, auto... QS>
     void write_scalar_channels (const void* source,
                                 PixelFormat format,
-                                std::byte* destination) {
+                                std::byte* destination,
+                                std::size_t first_row,
+                                std::size_t last_row) {
       const Bundle& bundle = *static_cast<const Bundle*> (source);
-      const std::size_t stride = bytes_per_pixel (format);
-      const std::size_t lane = channel_bytes (format);
-      std::size_t channel = 0;
-      (
-        [&] {
-          const auto& column = spatial::get<QS> (bundle);
-          for (std::size_t pixel = 0; pixel < column.size (); ++pixel)
-            write_channel (destination + pixel * stride + channel * lane,
-                           format,
-                           stored_scalar (column[pixel]));
-          ++channel;
-        }(),
-        ...);
+      pack_rows (format,
+                 destination,
+                 bundle.domain ().width (),
+                 first_row,
+                 last_row,
+                 [&column = spatial::get<QS> (bundle)] (std::size_t pixel) {
+                   return stored_scalar (column[pixel]);
+                 }...);
     }
 
     template <typename Bundle, auto QS>
     void write_xz_channels (const void* source,
                             PixelFormat format,
-                            std::byte* destination) {
+                            std::byte* destination,
+                            std::size_t first_row,
+                            std::size_t last_row) {
       const Bundle& bundle = *static_cast<const Bundle*> (source);
       const auto& column = spatial::get<QS> (bundle);
-      const std::size_t stride = bytes_per_pixel (format);
-      const std::size_t lane = channel_bytes (format);
-      for (std::size_t pixel = 0; pixel < column.size (); ++pixel) {
-        const Vec3 value = stored_vector (column[pixel]);
-        write_channel (destination + pixel * stride, format, value[0]);
-        write_channel (destination + pixel * stride + lane, format, value[2]);
-      }
+      pack_rows (
+        format,
+        destination,
+        bundle.domain ().width (),
+        first_row,
+        last_row,
+        [&] (std::size_t pixel) { return stored_vector (column[pixel])[0]; },
+        [&] (std::size_t pixel) { return stored_vector (column[pixel])[2]; });
     }
   }
 
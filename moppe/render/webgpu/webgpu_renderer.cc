@@ -4,6 +4,7 @@
 
 #include <algorithm>
 #include <array>
+#include <chrono>
 #include <cmath>
 #include <cstdint>
 #include <cstring>
@@ -42,10 +43,16 @@ struct VertexOutput {
   @location(3) foliage: f32,
 };
 
-@vertex
-fn world_vertex(input: VertexInput) -> VertexOutput {
+struct InstanceInput {
+  @location(5) model_x: vec4<f32>,
+  @location(6) model_y: vec4<f32>,
+  @location(7) model_z: vec4<f32>,
+  @location(8) model_w: vec4<f32>,
+};
+
+fn placed_vertex(model: mat4x4<f32>, input: VertexInput) -> VertexOutput {
   var output: VertexOutput;
-  let world = frame.model * vec4<f32>(input.position, 1.0);
+  let world = model * vec4<f32>(input.position, 1.0);
   output.position = frame.view_proj * world;
   output.uv = input.uv;
   output.color = input.color;
@@ -54,6 +61,19 @@ fn world_vertex(input: VertexInput) -> VertexOutput {
   return output;
 }
 
+@vertex
+fn world_vertex(input: VertexInput) -> VertexOutput {
+  return placed_vertex(frame.model, input);
+}
+
+@vertex
+fn world_instance_vertex(input: VertexInput,
+                         instance: InstanceInput) -> VertexOutput {
+  return placed_vertex(mat4x4<f32>(instance.model_x, instance.model_y,
+                                   instance.model_z, instance.model_w),
+                       input);
+}
+
 @vertex
 fn hud_vertex(input: VertexInput) -> VertexOutput {
   var output: VertexOutput;
@@ -832,6 +852,26 @@ fn sky_fragment(input: VertexOutput) -> @location(0) vec4<f32> {
     // capture submits the canonical tile plus its eight neighbours.
     constexpr uint32_t terrain_chunk_uniform_slots = 4096;
     constexpr uint64_t stream_vertex_buffer_bytes = 32 * 1024 * 1024;
+    // Room for 65536 instanced placements a frame.
+    constexpr uint64_t stream_instance_buffer_bytes = 65536 * sizeof (Mat4);
+
+    // The API traffic of one frame. In the browser every pass and queue call
+    // crosses into JavaScript, so on a slow laptop these counts, not the GPU,
+    // decide the frame time.
+    struct FrameCounters {
+      uint64_t pipeline_switches = 0;
+      uint64_t bind_group_switches = 0;
+      uint64_t buffer_creations = 0;
+      uint64_t bytes_written = 0;
+
+      FrameCounters& operator+= (const FrameCounters& other) {
+        pipeline_switches += other.pipeline_switches;
+        bind_group_switches += other.bind_group_switches;
+        buffer_creations += other.buffer_creations;
+        bytes_written += other.bytes_written;
+        return *this;
+      }
+    };
 
     struct WebGpuTexture final : Texture {
       wgpu::Texture texture;
@@ -847,10 +887,10 @@ fn sky_fragment(input: VertexOutput) -> @location(0) vec4<f32> {
       mutable wgpu::Buffer river_vertex_buffer;
     };
 
-    int pipeline_key (const DrawState& state, bool hud) {
+    int pipeline_key (const DrawState& state, bool hud, bool instanced) {
       return (hud ? 1 : 0) | (state.blend ? 2 : 0) | (state.additive ? 4 : 0) |
              (state.depth_test ? 8 : 0) | (state.depth_write ? 16 : 0) |
-             (state.cull ? 32 : 0);
+             (state.cull ? 32 : 0) | (instanced ? 64 : 0);
     }
 
     template <typename T>
@@ -869,6 +909,17 @@ fn sky_fragment(input: VertexOutput) -> @location(0) vec4<f32> {
       return buffer;
     }
 
+    // RGBA8Snorm texel for one lattice normal; a missing normal points up.
+    void pack_terrain_normal (const terrain::TerrainNormal* normal,
+                              int8_t* packed) {
+      const Vec3 value = normal ? normal->numerical_value_in (mp_units::one)
+                                : Vec3 (0.0f, 1.0f, 0.0f);
+      for (int component = 0; component < 3; ++component)
+        packed[component] = static_cast<int8_t> (
+          std::round (std::clamp (value[component], -1.0f, 1.0f) * 127.0f));
+      packed[3] = 127;
+    }
+
     float srgb_to_linear (uint8_t value) {
       const float encoded = value / 255.0f;
       return encoded <= 0.04045f ? encoded / 12.92f
@@ -964,6 +1015,8 @@ fn sky_fragment(input: VertexOutput) -> @location(0) vec4<f32> {
     wgpu::BindGroupLayout terrain_shadow_layout;
     wgpu::PipelineLayout terrain_shadow_pipeline_layout;
     wgpu::RenderPipeline terrain_shadow_pipeline;
+    wgpu::Buffer terrain_shadow_uniform_buffer;
+    wgpu::BindGroup terrain_shadow_bind_group;
     wgpu::Texture terrain_shadow_texture;
     wgpu::TextureView terrain_shadow_view;
     wgpu::Sampler terrain_shadow_sampler;
@@ -998,10 +1051,31 @@ fn sky_fragment(input: VertexOutput) -> @location(0) vec4<f32> {
     uint32_t frame_uniform_cursor = 0;
     wgpu::Buffer stream_vertex_buffer;
     uint64_t stream_vertex_cursor = 0;
+    wgpu::Buffer stream_instance_buffer;
+    uint64_t stream_instance_cursor = 0;
+    // Instance transforms gathered for the next streamed write; cleared for
+    // every draw but never freed, so a warm frame does not allocate.
+    std::vector<Mat4> instance_models;
     FrameParams frame_params;
     std::string device_error;
     bool frame_open = false;
 
+    // What the open pass has bound. WebGPU keeps bind groups across
+    // pipeline changes, so a repeat of either is skipped rather than
+    // re-issued.
+    WGPURenderPipeline bound_pipeline = nullptr;
+    int bound_pipeline_key = -1;
+    std::array<WGPUBindGroup, 2> bound_groups {};
+    std::array<uint32_t, 2> bound_offsets {};
+    // The level whose grid buffers are bound, until any other draw binds a
+    // vertex buffer of its own.
+    int bound_terrain_lod = -1;
+
+    FrameCounters counters;
+    FrameCounters profile_totals;
+    std::chrono::steady_clock::time_point profile_interval_start;
+    int profile_frames = 0;
+
     State (const char* selector, int width, int height, float factor)
         : canvas_selector (selector), width_points (width),
           height_points (height), scale (factor),
@@ -1075,6 +1149,8 @@ fn sky_fragment(input: VertexOutput) -> @location(0) vec4<f32> {
       stream_descriptor.usage =
         wgpu::BufferUsage::Vertex | wgpu::BufferUsage::CopyDst;
       stream_vertex_buffer = device.CreateBuffer (&stream_descriptor);
+      stream_descriptor.size = stream_instance_buffer_bytes;
+      stream_instance_buffer = device.CreateBuffer (&stream_descriptor);
 
       std::array<wgpu::BindGroupLayoutEntry, 2> texture_entries {};
       texture_entries[0].binding = 0;
@@ -1521,6 +1597,30 @@ fn sky_fragment(input: VertexOutput) -> @location(0) vec4<f32> {
       }
     }
 
+    void ensure_terrain_shadow_bind_group () {
+      if (terrain_shadow_bind_group)
+        return;
+      if (!terrain_shadow_uniform_buffer) {
+        wgpu::BufferDescriptor descriptor {};
+        descriptor.size = sizeof (ShadowUniforms);
+        descriptor.usage =
+          wgpu::BufferUsage::Uniform | wgpu::BufferUsage::CopyDst;
+        terrain_shadow_uniform_buffer = device.CreateBuffer (&descriptor);
+        ++counters.buffer_creations;
+      }
+      std::array<wgpu::BindGroupEntry, 2> entries {};
+      entries[0].binding = 0;
+      entries[0].buffer = terrain_shadow_uniform_buffer;
+      entries[0].size = sizeof (ShadowUniforms);
+      entries[1].binding = 1;
+      entries[1].textureView = terrain_height_view;
+      wgpu::BindGroupDescriptor descriptor {};
+      descriptor.layout = terrain_shadow_layout;
+      descriptor.entryCount = entries.size ();
+      descriptor.entries = entries.data ();
+      terrain_shadow_bind_group = device.CreateBindGroup (&descriptor);
+    }
+
     void ensure_terrain_frame_bind_group () {
       if (terrain_frame_bind_group)
         return;
@@ -1628,11 +1728,11 @@ fn sky_fragment(input: VertexOutput) -> @location(0) vec4<f32> {
           static_cast<uint32_t> (level_height),
           1,
         };
-        queue.WriteTexture (&destination,
-                            levels[level].data (),
-                            levels[level].size (),
-                            &layout,
-                            &extent);
+        write_texture (destination,
+                       levels[level].data (),
+                       levels[level].size (),
+                       layout,
+                       extent);
         level_width = std::max (1, level_width / 2);
         level_height = std::max (1, level_height / 2);
       }
@@ -1667,8 +1767,94 @@ fn sky_fragment(input: VertexOutput) -> @location(0) vec4<f32> {
       return result;
     }
 
-    wgpu::RenderPipeline pipeline_for (const DrawState& state, bool hud) {
-      const int key = pipeline_key (state, hud);
+    void reset_bindings () {
+      bound_pipeline = nullptr;
+      bound_pipeline_key = -1;
+      bound_groups = {};
+      bound_offsets = {};
+      bound_terrain_lod = -1;
+    }
+
+    void bind_pipeline (const wgpu::RenderPipeline& pipeline) {
+      if (pipeline.Get () == bound_pipeline)
+        return;
+      pass.SetPipeline (pipeline);
+      bound_pipeline = pipeline.Get ();
+      bound_pipeline_key = -1;
+      ++counters.pipeline_switches;
+    }
+
+    // Group 0 of the DrawList pipelines carries a dynamic offset into the
+    // frame uniform ring; the other groups have none.
+    void bind_group (uint32_t index,
+                     const wgpu::BindGroup& group,
+                     const uint32_t* dynamic_offset = nullptr) {
+      const uint32_t offset = dynamic_offset ? *dynamic_offset : 0;
+      if (group.Get () == bound_groups[index] &&
+          offset == bound_offsets[index])
+        return;
+      pass.SetBindGroup (index, group, dynamic_offset ? 1 : 0, dynamic_offset);
+      bound_groups[index] = group.Get ();
+      bound_offsets[index] = offset;
+      ++counters.bind_group_switches;
+    }
+
+    void write_buffer (const wgpu::Buffer& buffer,
+                       uint64_t offset,
+                       const void* data,
+                       std::size_t size) {
+      queue.WriteBuffer (buffer, offset, data, size);
+      counters.bytes_written += size;
+    }
+
+    void write_texture (const wgpu::TexelCopyTextureInfo& destination,
+                        const void* data,
+                        std::size_t size,
+                        const wgpu::TexelCopyBufferLayout& layout,
+                        const wgpu::Extent3D& extent) {
+      queue.WriteTexture (&destination, data, size, &layout, &extent);
+      counters.bytes_written += size;
+    }
+
+    template <typename T>
+    wgpu::Buffer upload (const std::vector<T>& values,
+                         wgpu::BufferUsage usage) {
+      wgpu::Buffer buffer = upload_buffer (device, values, usage);
+      if (buffer) {
+        ++counters.buffer_creations;
+        counters.bytes_written += values.size () * sizeof (T);
+      }
+      return buffer;
+    }
+
+    // Averaged over about a second of profiled frames, the same cadence as
+    // the native renderer's GPU timing.
+    void report_frame_counters () {
+      const auto now = std::chrono::steady_clock::now ();
+      if (profile_frames == 0)
+        profile_interval_start = now;
+      profile_totals += counters;
+      ++profile_frames;
+      if (now - profile_interval_start < std::chrono::seconds (1))
+        return;
+      const double frames = profile_frames;
+      std::cerr << "frame API: "
+                << profile_totals.pipeline_switches / frames
+                << " pipeline switches, "
+                << profile_totals.bind_group_switches / frames
+                << " bind-group switches, "
+                << profile_totals.buffer_creations / frames
+                << " buffers created, "
+                << profile_totals.bytes_written / frames / 1024.0
+                << " KiB written (" << profile_frames << " frames)"
+                << std::endl;
+      profile_totals = {};
+      profile_frames = 0;
+    }
+
+    wgpu::RenderPipeline
+    pipeline_for (const DrawState& state, bool hud, bool instanced) {
+      const int key = pipeline_key (state, hud, instanced);
       if (const auto found = pipelines.find (key); found != pipelines.end ())
         return found->second;
 
@@ -1694,6 +1880,22 @@ fn sky_fragment(input: VertexOutput) -> @location(0) vec4<f32> {
       vertex_layout.attributeCount = attributes.size ();
       vertex_layout.attributes = attributes.data ();
 
+      // Instanced placements arrive as the four columns of a model matrix.
+      std::array<wgpu::VertexAttribute, 4> instance_attributes {};
+      for (uint32_t column = 0; column < instance_attributes.size ();
+           ++column) {
+        instance_attributes[column].format = wgpu::VertexFormat::Float32x4;
+        instance_attributes[column].offset = column * 4 * sizeof (float);
+        instance_attributes[column].shaderLocation = 5 + column;
+      }
+      std::array<wgpu::VertexBufferLayout, 2> vertex_layouts {
+        vertex_layout, {}
+      };
+      vertex_layouts[1].arrayStride = sizeof (Mat4);
+      vertex_layouts[1].stepMode = wgpu::VertexStepMode::Instance;
+      vertex_layouts[1].attributeCount = instance_attributes.size ();
+      vertex_layouts[1].attributes = instance_attributes.data ();
+
       wgpu::BlendComponent color_blend {};
       color_blend.operation = wgpu::BlendOperation::Add;
       color_blend.srcFactor = wgpu::BlendFactor::SrcAlpha;
@@ -1730,9 +1932,11 @@ fn sky_fragment(input: VertexOutput) -> @location(0) vec4<f32> {
       wgpu::RenderPipelineDescriptor descriptor {};
       descriptor.layout = pipeline_layout;
       descriptor.vertex.module = shader;
-      descriptor.vertex.entryPoint = hud ? "hud_vertex" : "world_vertex";
-      descriptor.vertex.bufferCount = 1;
-      descriptor.vertex.buffers = &vertex_layout;
+      descriptor.vertex.entryPoint = hud         ? "hud_vertex"
+                                     : instanced ? "world_instance_vertex"
+                                                 : "world_vertex";
+      descriptor.vertex.bufferCount = instanced ? 2 : 1;
+      descriptor.vertex.buffers = vertex_layouts.data ();
       descriptor.primitive.topology = wgpu::PrimitiveTopology::TriangleList;
       descriptor.primitive.frontFace = wgpu::FrontFace::CCW;
       descriptor.primitive.cullMode =
@@ -1746,14 +1950,20 @@ fn sky_fragment(input: VertexOutput) -> @location(0) vec4<f32> {
       return pipeline;
     }
 
+    // A nonzero instance count draws every run once per model matrix
+    // already written at instance_offset in the streamed instance buffer;
+    // `model` is then ignored.
     void play_buffer (const wgpu::Buffer& vertex_buffer,
                       std::size_t vertex_count,
                       const std::vector<DrawList::Run>& runs,
                       bool hud,
                       const Mat4& model,
-                      uint64_t vertex_offset = 0) {
+                      uint64_t vertex_offset = 0,
+                      uint32_t instance_count = 0,
+                      uint64_t instance_offset = 0) {
       if (!frame_open || !vertex_buffer || vertex_count == 0)
         return;
+      const bool instanced = instance_count > 0;
       if (frame_uniform_cursor >= frame_uniform_slots)
         throw std::runtime_error ("WebGPU frame uniform ring exhausted");
       const FrameUniforms uniforms {
@@ -1764,21 +1974,33 @@ fn sky_fragment(input: VertexOutput) -> @location(0) vec4<f32> {
       };
       const uint32_t uniform_offset =
         frame_uniform_cursor++ * frame_uniform_stride;
-      queue.WriteBuffer (
-        frame_buffer, uniform_offset, &uniforms, sizeof (uniforms));
+      write_buffer (frame_buffer, uniform_offset, &uniforms, sizeof (uniforms));
       pass.SetVertexBuffer (
         0, vertex_buffer, vertex_offset, vertex_count * sizeof (Vertex));
-      pass.SetBindGroup (0, frame_bind_group, 1, &uniform_offset);
-
+      bound_terrain_lod = -1;
+      if (instanced)
+        pass.SetVertexBuffer (1,
+                              stream_instance_buffer,
+                              instance_offset,
+                              instance_count * sizeof (Mat4));
+      bind_group (0, frame_bind_group, &uniform_offset);
+
+      // Runs are cut wherever any state changes, but neighbouring runs
+      // usually still agree on the pipeline or on the texture; only what
+      // differs is set again. The key check also spares the pipeline map.
       for (const DrawList::Run& run : runs) {
         if (run.count == 0)
           continue;
-        pass.SetPipeline (pipeline_for (run.state, hud));
+        const int key = pipeline_key (run.state, hud, instanced);
+        if (key != bound_pipeline_key) {
+          bind_pipeline (pipeline_for (run.state, hud, instanced));
+          bound_pipeline_key = key;
+        }
         const auto* texture = static_cast<const WebGpuTexture*> (run.texture);
         if (!texture)
           texture = white.get ();
-        pass.SetBindGroup (1, texture->bind_group);
-        pass.Draw (run.count, 1, run.first, 0);
+        bind_group (1, texture->bind_group);
+        pass.Draw (run.count, instanced ? instance_count : 1, run.first, 0);
       }
     }
 
@@ -1790,10 +2012,10 @@ fn sky_fragment(input: VertexOutput) -> @location(0) vec4<f32> {
       const uint64_t byte_count = vertices.size () * sizeof (Vertex);
       if (stream_vertex_cursor + byte_count > stream_vertex_buffer_bytes)
         throw std::runtime_error ("WebGPU streamed vertex buffer exhausted");
-      queue.WriteBuffer (stream_vertex_buffer,
-                         stream_vertex_cursor,
-                         vertices.data (),
-                         byte_count);
+      write_buffer (stream_vertex_buffer,
+                    stream_vertex_cursor,
+                    vertices.data (),
+                    byte_count);
       play_buffer (stream_vertex_buffer,
                    vertices.size (),
                    runs,
@@ -1894,8 +2116,8 @@ fn sky_fragment(input: VertexOutput) -> @location(0) vec4<f32> {
     auto mesh = std::make_shared<WebGpuMesh> ();
     mesh->vertices = recorded.vertices ();
     mesh->runs = recorded.runs ();
-    mesh->vertex_buffer = upload_buffer (
-      m_state->device, mesh->vertices, wgpu::BufferUsage::Vertex);
+    mesh->vertex_buffer =
+      m_state->upload (mesh->vertices, wgpu::BufferUsage::Vertex);
     return mesh;
   }
 
@@ -1934,28 +2156,20 @@ fn sky_fragment(input: VertexOutput) -> @location(0) vec4<f32> {
       static_cast<uint32_t> (params.height),
       1,
     };
-    m_state->queue.WriteTexture (&height_destination,
-                                 heights.data (),
-                                 heights.size () *
-                                   sizeof (terrain::SurfaceElevation),
-                                 &height_layout,
-                                 &extent);
+    m_state->write_texture (height_destination,
+                            heights.data (),
+                            heights.size () *
+                              sizeof (terrain::SurfaceElevation),
+                            height_layout,
+                            extent);
 
     std::vector<int8_t> packed_normals (
       static_cast<std::size_t> (params.width) * params.height * 4);
     for (std::size_t i = 0;
          i < static_cast<std::size_t> (params.width) * params.height;
-         ++i) {
-      const Vec3 normal = normals.empty ()
-                            ? Vec3 (0.0f, 1.0f, 0.0f)
-                            : normals[i].numerical_value_in (mp_units::one);
-      for (int component = 0; component < 3; ++component) {
-        const float value = std::clamp (normal[component], -1.0f, 1.0f);
-        packed_normals[i * 4 + component] =
-          static_cast<int8_t> (std::round (value * 127.0f));
-      }
-      packed_normals[i * 4 + 3] = 127;
-    }
+         ++i)
+      pack_terrain_normal (normals.empty () ? nullptr : &normals[i],
+                           &packed_normals[i * 4]);
     wgpu::TextureDescriptor normal_descriptor = height_descriptor;
     normal_descriptor.format = wgpu::TextureFormat::RGBA8Snorm;
     m_state->terrain_normals =
@@ -1966,15 +2180,82 @@ fn sky_fragment(input: VertexOutput) -> @location(0) vec4<f32> {
     wgpu::TexelCopyBufferLayout normal_layout {};
     normal_layout.bytesPerRow = params.width * 4;
     normal_layout.rowsPerImage = params.height;
-    m_state->queue.WriteTexture (&normal_destination,
-                                 packed_normals.data (),
-                                 packed_normals.size (),
-                                 &normal_layout,
-                                 &extent);
+    m_state->write_texture (normal_destination,
+                            packed_normals.data (),
+                            packed_normals.size (),
+                            normal_layout,
+                            extent);
     m_state->have_terrain_shadow = false;
     m_state->terrain_frame_bind_group = {};
+    m_state->terrain_shadow_bind_group = {};
     m_state->have_terrain = true;
   }
+
+  void WebGpuRenderer::update_terrain_region (
+    const terrain::TerrainRect& region,
+    std::span<const terrain::SurfaceElevation> heights,
+    std::span<const terrain::TerrainNormal> normals) {
+    const TerrainParams& params = m_state->terrain_params;
+    const std::size_t sample_count =
+      static_cast<std::size_t> (params.width) * params.height;
+    if (!m_state->have_terrain || heights.size () != sample_count ||
+        (!normals.empty () && normals.size () != sample_count))
+      throw std::invalid_argument ("invalid WebGPU terrain region");
+
+    // Each piece of the region is a plain sub-rectangle of both textures.
+    // Heights are read straight out of the lattice rows; only the piece's
+    // normals are repacked.
+    const terrain::TerrainDomain lattice (params.width, params.height);
+    std::vector<int8_t> packed_normals;
+    lattice.visit_unwrapped (region, [&] (const terrain::TerrainRect& piece) {
+      const std::size_t first =
+        piece.origin.row * params.width + piece.origin.column;
+      const wgpu::Extent3D extent = {
+        static_cast<uint32_t> (piece.columns),
+        static_cast<uint32_t> (piece.rows),
+        1,
+      };
+      wgpu::TexelCopyTextureInfo height_destination {};
+      height_destination.texture = m_state->terrain_heights;
+      height_destination.origin = {
+        static_cast<uint32_t> (piece.origin.column),
+        static_cast<uint32_t> (piece.origin.row),
+        0,
+      };
+      wgpu::TexelCopyBufferLayout height_layout {};
+      height_layout.bytesPerRow = params.width * sizeof (float);
+      height_layout.rowsPerImage = static_cast<uint32_t> (piece.rows);
+      const std::size_t height_bytes =
+        ((piece.rows - 1) * params.width + piece.columns) * sizeof (float);
+      m_state->write_texture (height_destination,
+                              heights.data () + first,
+                              height_bytes,
+                              height_layout,
+                              extent);
+
+      packed_normals.resize (piece.columns * piece.rows * 4);
+      for (std::size_t row = 0; row < piece.rows; ++row)
+        for (std::size_t column = 0; column < piece.columns; ++column) {
+          const std::size_t source = first + row * params.width + column;
+          pack_terrain_normal (
+            normals.empty () ? nullptr : &normals[source],
+            &packed_normals[(row * piece.columns + column) * 4]);
+        }
+      wgpu::TexelCopyTextureInfo normal_destination = height_destination;
+      normal_destination.texture = m_state->terrain_normals;
+      wgpu::TexelCopyBufferLayout normal_layout {};
+      normal_layout.bytesPerRow = static_cast<uint32_t> (piece.columns * 4);
+      normal_layout.rowsPerImage = static_cast<uint32_t> (piece.rows);
+      m_state->write_texture (normal_destination,
+                              packed_normals.data (),
+                              packed_normals.size (),
+                              normal_layout,
+                              extent);
+    });
+    // The setup-time shadow map saw the old heights.
+    m_state->have_terrain_shadow = false;
+  }
+
   void WebGpuRenderer::set_terrain_topology_overlay (bool enabled) {
     m_state->terrain_params.topology_overlay = enabled;
   }
@@ -2015,21 +2296,14 @@ fn sky_fragment(input: VertexOutput) -> @location(0) vec4<f32> {
                          terrain.scale[2],
                          0.0f },
     };
-    std::vector<ShadowUniforms> uniform_values { uniforms };
-    wgpu::Buffer uniform_buffer = upload_buffer (
-      m_state->device, uniform_values, wgpu::BufferUsage::Uniform);
-    std::array<wgpu::BindGroupEntry, 2> entries {};
-    entries[0].binding = 0;
-    entries[0].buffer = uniform_buffer;
-    entries[0].size = sizeof (ShadowUniforms);
-    entries[1].binding = 1;
-    entries[1].textureView = m_state->terrain_height_view;
-    wgpu::BindGroupDescriptor group_descriptor {};
-    group_descriptor.layout = m_state->terrain_shadow_layout;
-    group_descriptor.entryCount = entries.size ();
-    group_descriptor.entries = entries.data ();
-    wgpu::BindGroup frame_group =
-      m_state->device.CreateBindGroup (&group_descriptor);
+    // Each shadow pass is submitted before the next one writes, so the
+    // queue orders one persistent uniform slot and its bind group lives as
+    // long as the height texture it reads.
+    m_state->ensure_terrain_shadow_bind_group ();
+    m_state->write_buffer (m_state->terrain_shadow_uniform_buffer,
+                           0,
+                           &uniforms,
+                           sizeof (uniforms));
 
     wgpu::CommandEncoder encoder = m_state->device.CreateCommandEncoder ();
     wgpu::RenderPassDepthStencilAttachment depth {};
@@ -2041,7 +2315,9 @@ fn sky_fragment(input: VertexOutput) -> @location(0) vec4<f32> {
     pass_descriptor.depthStencilAttachment = &depth;
     wgpu::RenderPassEncoder pass = encoder.BeginRenderPass (&pass_descriptor);
     pass.SetPipeline (m_state->terrain_shadow_pipeline);
-    pass.SetBindGroup (0, frame_group);
+    pass.SetBindGroup (0, m_state->terrain_shadow_bind_group);
+    ++m_state->counters.pipeline_switches;
+    ++m_state->counters.bind_group_switches;
 
     int lod = static_cast<int> (TerrainLod::Native);
     constexpr int requested_step = 1;
@@ -2078,12 +2354,13 @@ fn sky_fragment(input: VertexOutput) -> @location(0) vec4<f32> {
                                 0.0f },
             };
             const uint64_t offset = chunk_index * frame_uniform_stride;
-            m_state->queue.WriteBuffer (m_state->terrain_chunk_buffer,
-                                        offset,
-                                        &chunk_uniforms,
-                                        sizeof (chunk_uniforms));
+            m_state->write_buffer (m_state->terrain_chunk_buffer,
+                                   offset,
+                                   &chunk_uniforms,
+                                   sizeof (chunk_uniforms));
             pass.SetBindGroup (1,
                                m_state->terrain_chunk_bind_groups[chunk_index]);
+            ++m_state->counters.bind_group_switches;
             pass.DrawIndexed (m_state->terrain_index_counts[lod]);
             ++chunk_index;
           }
@@ -2130,6 +2407,7 @@ fn sky_fragment(input: VertexOutput) -> @location(0) vec4<f32> {
     m_state->command_encoder = m_state->device.CreateCommandEncoder ();
     m_state->frame_params = params;
     m_state->stream_vertex_cursor = 0;
+    m_state->stream_instance_cursor = 0;
     m_state->frame_uniform_cursor = 0;
 
     wgpu::RenderPassColorAttachment color {};
@@ -2152,6 +2430,7 @@ fn sky_fragment(input: VertexOutput) -> @location(0) vec4<f32> {
     pass_descriptor.colorAttachments = &color;
     pass_descriptor.depthStencilAttachment = &depth;
     m_state->pass = m_state->command_encoder.BeginRenderPass (&pass_descriptor);
+    m_state->reset_bindings ();
     m_state->frame_open = true;
     return true;
   }
@@ -2203,14 +2482,14 @@ fn sky_fragment(input: VertexOutput) -> @location(0) vec4<f32> {
                          0.0f },
       .weather_params = { frame.time, frame.cloud_cover, 0.0f, 0.0f },
     };
-    m_state->queue.WriteBuffer (
+    m_state->write_buffer (
       m_state->terrain_frame_buffer, 0, &uniforms, sizeof (uniforms));
     m_state->ensure_terrain_frame_bind_group ();
     m_state->ensure_terrain_chunk_bind_groups (
       static_cast<std::size_t> (count));
 
-    m_state->pass.SetPipeline (m_state->terrain_pipeline);
-    m_state->pass.SetBindGroup (0, m_state->terrain_frame_bind_group);
+    m_state->bind_pipeline (m_state->terrain_pipeline);
+    m_state->bind_group (0, m_state->terrain_frame_bind_group);
     for (int i = 0; i < count; ++i) {
       const int requested_lod = static_cast<int> (chunks[i].lod);
       const int lod = std::clamp (requested_lod, 0, terrain_lod_count - 1);
@@ -2226,15 +2505,20 @@ fn sky_fragment(input: VertexOutput) -> @location(0) vec4<f32> {
         .world_offset = { chunks[i].offset_x, 0.0f, chunks[i].offset_z, 0.0f },
       };
       const uint64_t offset = static_cast<uint64_t> (i) * frame_uniform_stride;
-      m_state->queue.WriteBuffer (m_state->terrain_chunk_buffer,
-                                  offset,
-                                  &chunk_uniforms,
-                                  sizeof (chunk_uniforms));
-      m_state->pass.SetBindGroup (
+      m_state->write_buffer (m_state->terrain_chunk_buffer,
+                             offset,
+                             &chunk_uniforms,
+                             sizeof (chunk_uniforms));
+      m_state->bind_group (
         1, m_state->terrain_chunk_bind_groups[static_cast<std::size_t> (i)]);
-      m_state->pass.SetVertexBuffer (0, m_state->terrain_vertices[lod]);
-      m_state->pass.SetIndexBuffer (m_state->terrain_indices[lod],
-                                    wgpu::IndexFormat::Uint32);
+      // The camera sorts nothing by level, but neighbouring chunks mostly
+      // share one, and its grid buffers with it.
+      if (lod != m_state->bound_terrain_lod) {
+        m_state->pass.SetVertexBuffer (0, m_state->terrain_vertices[lod]);
+        m_state->pass.SetIndexBuffer (m_state->terrain_indices[lod],
+                                      wgpu::IndexFormat::Uint32);
+        m_state->bound_terrain_lod = lod;
+      }
       m_state->pass.DrawIndexed (m_state->terrain_index_counts[lod]);
     }
   }
@@ -2258,11 +2542,12 @@ fn sky_fragment(input: VertexOutput) -> @location(0) vec4<f32> {
                      1.0f },
       .params = { params.time, params.sun_height, params.cloudiness, 0.0f },
     };
-    m_state->queue.WriteBuffer (
+    m_state->write_buffer (
       m_state->sky_uniform_buffer, 0, &uniforms, sizeof (uniforms));
-    m_state->pass.SetPipeline (m_state->sky_pipeline);
-    m_state->pass.SetBindGroup (0, m_state->sky_bind_group);
+    m_state->bind_pipeline (m_state->sky_pipeline);
+    m_state->bind_group (0, m_state->sky_bind_group);
     m_state->pass.SetVertexBuffer (0, m_state->sky_vertices);
+    m_state->bound_terrain_lod = -1;
     m_state->pass.Draw (m_state->sky_vertex_count);
   }
   void WebGpuRenderer::draw_ocean (const OceanParams& params) {
@@ -2292,7 +2577,7 @@ fn sky_fragment(input: VertexOutput) -> @location(0) vec4<f32> {
         vertex.color = PackedRgba8 (color.red, color.green, color.blue, alpha);
       }
       source.river_vertex_buffer =
-        upload_buffer (m_state->device, vertices, wgpu::BufferUsage::Vertex);
+        m_state->upload (vertices, wgpu::BufferUsage::Vertex);
     }
     m_state->play_buffer (source.river_vertex_buffer,
                           source.vertices.size (),
@@ -2310,6 +2595,36 @@ fn sky_fragment(input: VertexOutput) -> @location(0) vec4<f32> {
       source.vertex_buffer, source.vertices.size (), source.runs, false, model);
   }
 
+  void WebGpuRenderer::draw_mesh_instances (
+    const Mesh& mesh,
+    std::span<const InstanceTransform> instances) {
+    if (!m_state->frame_open || instances.empty ())
+      return;
+    const uint64_t byte_count = instances.size () * sizeof (Mat4);
+    if (m_state->stream_instance_cursor + byte_count >
+        stream_instance_buffer_bytes)
+      throw std::runtime_error ("WebGPU streamed instance buffer exhausted");
+    // This backend keeps no motion history, so only the transforms travel.
+    std::vector<Mat4>& models = m_state->instance_models;
+    models.clear ();
+    for (const InstanceTransform& instance : instances)
+      models.push_back (instance.model);
+    m_state->write_buffer (m_state->stream_instance_buffer,
+                           m_state->stream_instance_cursor,
+                           models.data (),
+                           byte_count);
+    const auto& source = static_cast<const WebGpuMesh&> (mesh);
+    m_state->play_buffer (source.vertex_buffer,
+                          source.vertices.size (),
+                          source.runs,
+                          false,
+                          Mat4::identity (),
+                          0,
+                          static_cast<uint32_t> (instances.size ()),
+                          m_state->stream_instance_cursor);
+    m_state->stream_instance_cursor += byte_count;
+  }
+
   void WebGpuRenderer::draw_list (const DrawList& list, uint64_t motion_id) {
     (void)motion_id;
     m_state->play (list.vertices (), list.runs (), false);
@@ -2329,6 +2644,9 @@ fn sky_fragment(input: VertexOutput) -> @location(0) vec4<f32> {
     m_state->pass.End ();
     wgpu::CommandBuffer command = m_state->command_encoder.Finish ();
     m_state->queue.Submit (1, &command);
+    if (m_state->frame_params.profile)
+      m_state->report_frame_counters ();
+    m_state->counters = {};
     m_state->frame_open = false;
     m_state->pass = {};
     m_state->command_encoder = {};
@@ -27,6 +27,10 @@ namespace moppe::render {
     void set_terrain (const TerrainParams& params,
                       std::span<const terrain::SurfaceElevation> heights,
                       std::span<const terrain::TerrainNormal> normals) override;
+    void update_terrain_region (
+      const terrain::TerrainRect& region,
+      std::span<const terrain::SurfaceElevation> heights,
+      std::span<const terrain::TerrainNormal> normals) override;
     void set_terrain_topology_overlay (bool enabled) override;
     void set_terrain_textures (TexturePtr grass,
                                TexturePtr dirt,
@@ -48,6 +52,9 @@ namespace moppe::render {
     void draw_mesh (const Mesh& mesh,
                     const Mat4& model,
                     uint64_t motion_id = 0) override;
+    void draw_mesh_instances (
+      const Mesh& mesh,
+      std::span<const InstanceTransform> instances) override;
     void draw_list (const DrawList& list, uint64_t motion_id = 0) override;
     void apply_underwater (float time) override;
     void apply_motion_blur (float strength) override;
@@ -20,15 +20,19 @@ struct UberVaryings {
   float reactive [[flat]];
 };
 
+// Instanced mesh draws bind one MoppeDrawUniforms per instance; every other
+// draw binds one block and is instance zero.
 vertex UberVaryings uber_vertex (uint vid [[vertex_id]],
+                                 uint iid [[instance_id]],
                                  const device MoppeVertexIn* verts
                                  [[buffer (MOPPE_BUF_VERTICES)]],
                                  constant MoppeFrameUniforms& frame
                                  [[buffer (MOPPE_BUF_FRAME)]],
-                                 constant MoppeDrawUniforms& draw
+                                 constant MoppeDrawUniforms* draws
                                  [[buffer (MOPPE_BUF_DRAW)]],
                                  const device MoppeVertexIn* previous_verts
                                  [[buffer (MOPPE_BUF_PREVIOUS_VERTICES)]]) {
+  constant MoppeDrawUniforms& draw = draws[iid];
   const MoppeVertexIn v = verts[vid];
   const MoppeVertexIn previous_v =
     draw.temporal.x > 0.5 ? previous_verts[vid] : v;
@@ -1,6 +1,8 @@
 #ifndef MOPPE_SPATIAL_BUNDLE_HH
 #define MOPPE_SPATIAL_BUNDLE_HH
 
+#include <moppe/spatial/quantized.hh>
+
 #include <mp-units/framework.h>
 
 #include <array>
@@ -52,8 +54,32 @@ namespace moppe::spatial {
         position, detail::InterpolationProbe<typename Domain::index_type> {});
     };
 
+  namespace detail {
+    // How a declared column type is held: most as a vector of themselves, a
+    // quantized one as its codes.
+    template <typename T>
+    struct BundleColumn {
+      using value_type = T;
+      using type = std::vector<T>;
+    };
+
+    template <typename Value, typename Encoding>
+    struct BundleColumn<Quantized<Value, Encoding>> {
+      using value_type = Value;
+      using type = QuantizedColumn<Value, Encoding>;
+    };
+  }
+
+  // The quantity a column type holds, and the column that holds it.
   template <typename T>
-  concept BundleValue = mp_units::Quantity<T> || mp_units::QuantityPoint<T>;
+  using bundle_value_t = typename detail::BundleColumn<T>::value_type;
+
+  template <typename T>
+  using bundle_column_t = typename detail::BundleColumn<T>::type;
+
+  template <typename T>
+  concept BundleValue = mp_units::Quantity<bundle_value_t<T>> ||
+                        mp_units::QuantityPoint<bundle_value_t<T>>;
 
   template <typename Domain, typename... Quantities>
     requires FiniteDomain<Domain> && (BundleValue<Quantities> && ...)
@@ -86,10 +112,12 @@ namespace moppe::spatial {
     using index_type = typename Domain::index_type;
 
     template <std::size_t Index>
-    using value_type = std::tuple_element_t<Index, std::tuple<Quantities...>>;
+    using value_type = bundle_value_t<
+      std::tuple_element_t<Index, std::tuple<Quantities...>>>;
 
     template <std::size_t Index>
-    using column_type = std::vector<value_type<Index>>;
+    using column_type = bundle_column_t<
+      std::tuple_element_t<Index, std::tuple<Quantities...>>>;
 
     static constexpr std::size_t column_count = sizeof...(Quantities);
 
@@ -108,11 +136,11 @@ namespace moppe::spatial {
 
     explicit Bundle (Domain domain)
         : m_domain (std::move (domain)),
-          m_columns (std::vector<Quantities> (m_domain.size ())...) {
+          m_columns (bundle_column_t<Quantities> (m_domain.size ())...) {
       validate_specs ();
     }
 
-    Bundle (Domain domain, std::vector<Quantities>... columns)
+    Bundle (Domain domain, bundle_column_t<Quantities>... columns)
         : m_domain (std::move (domain)), m_columns (std::move (columns)...) {
       validate_specs ();
       const bool sizes_match = std::apply (
@@ -155,6 +183,18 @@ namespace moppe::spatial {
       return BundleRow<const Bundle> (*this, m_domain.offset (index));
     }
 
+    // Takes the bundle apart into its domain and columns. An analysis that
+    // refills one bundle step after step builds the next from these, so it
+    // keeps the storage instead of allocating it afresh.
+    std::tuple<Domain, bundle_column_t<Quantities>...> release () && {
+      return std::apply (
+        [this] (auto&... columns) {
+          return std::tuple<Domain, bundle_column_t<Quantities>...> (
+            std::move (m_domain), std::move (columns)...);
+        },
+        m_columns);
+    }
+
   private:
     static consteval void validate_specs () {
       static_assert (
@@ -165,7 +205,7 @@ namespace moppe::spatial {
     }
 
     Domain m_domain;
-    std::tuple<std::vector<Quantities>...> m_columns;
+    std::tuple<bundle_column_t<Quantities>...> m_columns;
   };
 
   template <typename BundleType>
@@ -256,6 +296,27 @@ namespace moppe::spatial {
                  std::move (rest)...);
   }
 
+  // The same columns, held as another bundle type declares them: a column
+  // the target quantizes is encoded on the way, any other moves across. An
+  // analysis builds its readings at full precision and stores them once.
+  template <typename Target, typename Domain, typename... Quantities>
+    requires std::same_as<typename Target::domain_type, Domain> &&
+             (Target::column_count == sizeof...(Quantities))
+  Target store_as (Bundle<Domain, Quantities...> source) {
+    using Source = Bundle<Domain, Quantities...>;
+    return [&]<std::size_t... Column> (std::index_sequence<Column...>) {
+      static_assert (
+        (std::same_as<typename Target::template value_type<Column>,
+                      typename Source::template value_type<Column>> &&
+         ...),
+        "a bundle is stored as one holding the same quantities in order");
+      return Target (
+        source.domain (),
+        typename Target::template column_type<Column> (
+          std::move (get<Column> (source)))...);
+    }(std::index_sequence_for<Quantities...> {});
+  }
+
   // Reconstruct a continuously sampled value from a finite bundle.  The
   // mp-units category chooses the algebra: quantities form an ordinary
   // weighted sum, while quantity points are reconstructed affinely from one
@@ -25,6 +25,7 @@
 // as one Arrow IPC stream record batch: scalar representations are Arrow
 // numeric arrays, vector representations are fixed-size lists, and unusual
 // trivially-copyable representations remain available as fixed-size binary.
+// Quantized columns are stored as their codes.
 //
 // Units and quantity semantics live in field metadata. The domain's generic
 // binary description lives in schema metadata. Arrow makes the tabular part
@@ -246,7 +247,20 @@ namespace moppe::spatial {
     // directions. A representation Arrow has no better shape for travels as
     // its own bytes, which is what the primary template does.
 
-    template <typename Value, typename Rep = value_rep<Value>>
+    // What a column stores per site: its quantity's representation, or for
+    // a quantized column, the encoding's codes.
+    template <typename Value>
+    struct StoredRepresentation {
+      using type = value_rep<Value>;
+    };
+
+    template <typename Value, typename Encoding>
+    struct StoredRepresentation<Quantized<Value, Encoding>> {
+      using type = Encoding;
+    };
+
+    template <typename Value,
+              typename Rep = typename StoredRepresentation<Value>::type>
     struct ColumnEncoding {
       static std::string name () {
         return std::format ("opaque[{}]", sizeof (Value));
@@ -337,6 +351,43 @@ namespace moppe::spatial {
       }
     };
 
+    // A quantized column travels as its codes, so a round trip is exact and
+    // the file is as small as the column. Half codes are Arrow's own half
+    // floats; unorm codes are unsigned integers whose range the storage name
+    // records.
+    template <typename Value, QuantizedEncoding Encoding>
+    struct ColumnEncoding<Value, Encoding> {
+      using Code = typename Encoding::code_type;
+
+      static std::string name () {
+        return Encoding::name ();
+      }
+
+      static bool configure (ArrowSchema& schema) {
+        if constexpr (std::same_as<Encoding, Half>)
+          return ok (ArrowSchemaSetType (&schema, NANOARROW_TYPE_HALF_FLOAT));
+        else
+          return ok (ArrowSchemaSetType (&schema, arrow_scalar_type<Code> ()));
+      }
+
+      static bool append (ArrowArray& array, Code code) {
+        if constexpr (std::same_as<Encoding, Half>)
+          return ok (ArrowArrayAppendDouble (&array, Encoding::decode (code)));
+        else
+          return append_scalar (array, code);
+      }
+
+      static bool
+      read (const ArrowArrayView& view, std::int64_t row, Code& code) {
+        if constexpr (std::same_as<Encoding, Half>)
+          code = Encoding::encode (
+            static_cast<float> (ArrowArrayViewGetDoubleUnsafe (&view, row)));
+        else
+          code = scalar_at<Code> (view, row);
+        return true;
+      }
+    };
+
     template <typename Value>
     Metadata column_metadata () {
       return { { std::string (kind_key), quantity_kind<Value> () },
@@ -384,11 +435,26 @@ namespace moppe::spatial {
              metadata_matches (actual, column_metadata<Value> ());
     }
 
-    template <typename Value>
+    // One site of a column, as its encoding carries it.
+    template <typename Value, typename Column>
     bool
-    read_value (const ArrowArrayView& view, std::int64_t row, Value& value) {
-      return !ArrowArrayViewIsNull (&view, row) &&
-             ColumnEncoding<Value>::read (view, row, value);
+    append_site (ArrowArray& array, const Column& column, std::size_t row) {
+      if constexpr (QuantizedValue<Value>)
+        return ColumnEncoding<Value>::append (array, column.codes ()[row]);
+      else
+        return ColumnEncoding<Value>::append (array, column[row]);
+    }
+
+    template <typename Value, typename Column>
+    bool
+    read_site (const ArrowArrayView& view, std::size_t row, Column& column) {
+      const auto index = static_cast<std::int64_t> (row);
+      if (ArrowArrayViewIsNull (&view, index))
+        return false;
+      if constexpr (QuantizedValue<Value>)
+        return ColumnEncoding<Value>::read (view, index, column.codes ()[row]);
+      else
+        return ColumnEncoding<Value>::read (view, index, column[row]);
     }
 
     // Fold a check over the columns of a bundle, handing each one its value
@@ -503,8 +569,8 @@ namespace moppe::spatial {
       for (std::size_t row = 0; row < bundle.size (); ++row) {
         const bool appended = every_column<Quantities...> (
           [&]<typename Value, std::size_t Column> () {
-            return ColumnEncoding<Value>::append (*array.children[Column],
-                                                  get<Column> (bundle)[row]);
+            return append_site<Value> (
+              *array.children[Column], get<Column> (bundle), row);
           });
         if (!appended || !ok (ArrowArrayFinishElement (&array)))
           return false;
@@ -656,9 +722,8 @@ namespace moppe::spatial {
       for (std::size_t row = 0; row < bundle.size (); ++row) {
         const bool values_read = detail::every_column<Quantities...> (
           [&]<typename Value, std::size_t Column> () {
-            return detail::read_value (*view.children[Column],
-                                       static_cast<std::int64_t> (row),
-                                       get<Column> (bundle)[row]);
+            return detail::read_site<Value> (
+              *view.children[Column], row, get<Column> (bundle));
           });
         if (!values_read)
           return false;
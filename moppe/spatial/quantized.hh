@@ -0,0 +1,335 @@
+#ifndef MOPPE_SPATIAL_QUANTIZED_HH
+#define MOPPE_SPATIAL_QUANTIZED_HH
+
+#include <moppe/half.hh>
+
+#include <mp-units/framework.h>
+
+#include <compare>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <format>
+#include <iterator>
+#include <limits>
+#include <span>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+// A bundle column may keep its quantity in fewer bits than the quantity's own
+// representation. Most surface readings are proportions that end as 8-bit
+// texture lanes; storing them as floats spends four bytes a site on
+// precision nothing downstream can see.
+//
+// A quantized column is declared by wrapping its value type, as in
+// Quantized<SurfaceMoisture, Unorm16<>>. The bundle still speaks the
+// quantity: a site reads back a decoded value, a write is encoded as it
+// lands, and sampling interpolates decoded values. What changes is that the
+// column is a QuantizedColumn rather than a std::vector of values, so code
+// that wants a span of the quantity itself has to decode it first.
+
+namespace moppe::spatial {
+  // ---- Encodings ----
+  //
+  // An encoding turns one stored number -- the quantity's value in its own
+  // unit -- into a code and back, and names itself for storage metadata.
+
+  template <typename Encoding>
+  concept QuantizedEncoding =
+    std::unsigned_integral<typename Encoding::code_type> &&
+    requires (float value, typename Encoding::code_type code) {
+      {
+        Encoding::encode (value)
+      } -> std::same_as<typename Encoding::code_type>;
+      { Encoding::decode (code) } -> std::same_as<float>;
+      { Encoding::name () } -> std::convertible_to<std::string>;
+    };
+
+  // The interval a unorm encoding spreads its codes across, in the
+  // quantity's stored unit. A reading outside it is clamped on the way in.
+  struct UnitInterval {
+    static constexpr float low = 0.0f;
+    static constexpr float high = 1.0f;
+  };
+
+  template <typename Range>
+  concept EncodingRange = requires {
+    { Range::low } -> std::convertible_to<float>;
+    { Range::high } -> std::convertible_to<float>;
+  } && (Range::low < Range::high);
+
+  // Evenly spaced codes over a closed range, both ends exact. Encoding
+  // rounds to the nearest code, so decoding and encoding again gives back
+  // the same code.
+  template <std::unsigned_integral Code, EncodingRange Range = UnitInterval>
+  struct Unorm {
+    using code_type = Code;
+    using range = Range;
+
+    static constexpr float low = Range::low;
+    static constexpr float high = Range::high;
+    static constexpr Code largest = std::numeric_limits<Code>::max ();
+
+    static std::string name () {
+      return std::format ("unorm{}[{},{}]", 8 * sizeof (Code), low, high);
+    }
+
+    static constexpr Code encode (float value) {
+      const float unit = (value - low) / (high - low);
+      // NaN fails every comparison and lands on the low end with the rest.
+      if (!(unit > 0.0f))
+        return 0;
+      if (unit >= 1.0f)
+        return largest;
+      return static_cast<Code> (unit * static_cast<float> (largest) + 0.5f);
+    }
+
+    static constexpr float decode (Code code) {
+      return low + (high - low) * (static_cast<float> (code) /
+                                   static_cast<float> (largest));
+    }
+  };
+
+  template <EncodingRange Range = UnitInterval>
+  using Unorm8 = Unorm<std::uint8_t, Range>;
+
+  template <EncodingRange Range = UnitInterval>
+  using Unorm16 = Unorm<std::uint16_t, Range>;
+
+  // IEEE binary16: no range to declare, about three significant digits
+  // anywhere on it, finest near zero.
+  struct Half {
+    using code_type = std::uint16_t;
+
+    static std::string name () {
+      return "half";
+    }
+
+    static constexpr code_type encode (float value) {
+      return float_to_half (value);
+    }
+
+    static float decode (code_type code) {
+      return half_to_float (code);
+    }
+  };
+
+  // ---- Columns ----
+
+  // The declaration of a quantized column: which quantity it holds and how.
+  // It answers the questions a bundle asks of a column type -- which
+  // quantity, in what unit -- as its quantity would.
+  template <typename Value, QuantizedEncoding Encoding>
+    requires mp_units::Quantity<Value> &&
+             std::convertible_to<typename Value::rep, float>
+  struct Quantized {
+    using value_type = Value;
+    using encoding = Encoding;
+
+    static constexpr auto quantity_spec = Value::quantity_spec;
+    static constexpr auto dimension = Value::dimension;
+    static constexpr auto unit = Value::unit;
+    static constexpr auto reference = Value::reference;
+  };
+
+  namespace detail {
+    template <typename T>
+    struct IsQuantized : std::false_type {};
+
+    template <typename Value, typename Encoding>
+    struct IsQuantized<Quantized<Value, Encoding>> : std::true_type {};
+  }
+
+  template <typename T>
+  concept QuantizedValue = detail::IsQuantized<T>::value;
+
+  // One code per site. Reading a const column gives values; a mutable
+  // column's elements are proxies that decode when read and encode when
+  // assigned, so `std::ranges::fill` and `column[i] = value` work as they do
+  // on a vector.
+  template <typename Value, QuantizedEncoding Encoding>
+  class QuantizedColumn {
+  public:
+    using value_type = Value;
+    using encoding = Encoding;
+    using code_type = typename Encoding::code_type;
+
+    static code_type encode (const Value& value) {
+      return Encoding::encode (
+        static_cast<float> (value.numerical_value_in (Value::unit)));
+    }
+
+    static Value decode (code_type code) {
+      return Value (static_cast<typename Value::rep> (Encoding::decode (code)),
+                    Value::reference);
+    }
+
+    class reference {
+    public:
+      explicit reference (code_type* code) : m_code (code) {}
+      reference (const reference&) = default;
+
+      operator Value () const {
+        return decode (*m_code);
+      }
+
+      const reference& operator= (const Value& value) const {
+        *m_code = encode (value);
+        return *this;
+      }
+
+      // Assigning one site to another copies the site, not the proxy.
+      const reference& operator= (const reference& other) const {
+        *m_code = *other.m_code;
+        return *this;
+      }
+
+    private:
+      code_type* m_code;
+    };
+
+    template <bool Mutable>
+    class basic_iterator {
+    public:
+      using iterator_concept = std::random_access_iterator_tag;
+      using iterator_category = std::input_iterator_tag;
+      using value_type = Value;
+      using difference_type = std::ptrdiff_t;
+      using code_pointer =
+        std::conditional_t<Mutable, code_type*, const code_type*>;
+
+      basic_iterator () = default;
+      explicit basic_iterator (code_pointer code) : m_code (code) {}
+
+      auto operator* () const {
+        if constexpr (Mutable)
+          return reference (m_code);
+        else
+          return decode (*m_code);
+      }
+
+      auto operator[] (difference_type offset) const {
+        return *(*this + offset);
+      }
+
+      basic_iterator& operator++ () {
+        ++m_code;
+        return *this;
+      }
+      basic_iterator operator++ (int) {
+        basic_iterator previous = *this;
+        ++m_code;
+        return previous;
+      }
+      basic_iterator& operator-- () {
+        --m_code;
+        return *this;
+      }
+      basic_iterator operator-- (int) {
+        basic_iterator previous = *this;
+        --m_code;
+        return previous;
+      }
+      basic_iterator& operator+= (difference_type offset) {
+        m_code += offset;
+        return *this;
+      }
+      basic_iterator& operator-= (difference_type offset) {
+        m_code -= offset;
+        return *this;
+      }
+
+      friend basic_iterator operator+ (basic_iterator at,
+                                       difference_type offset) {
+        return at += offset;
+      }
+      friend basic_iterator operator+ (difference_type offset,
+                                       basic_iterator at) {
+        return at += offset;
+      }
+      friend basic_iterator operator- (basic_iterator at,
+                                       difference_type offset) {
+        return at -= offset;
+      }
+      friend difference_type operator- (basic_iterator a, basic_iterator b) {
+        return a.m_code - b.m_code;
+      }
+
+      friend bool operator== (basic_iterator, basic_iterator) = default;
+      friend auto operator<=> (basic_iterator, basic_iterator) = default;
+
+    private:
+      code_pointer m_code = nullptr;
+    };
+
+    using iterator = basic_iterator<true>;
+    using const_iterator = basic_iterator<false>;
+
+    QuantizedColumn () = default;
+
+    explicit QuantizedColumn (std::size_t count,
+                              const Value& value = Value::zero ())
+        : m_codes (count, encode (value)) {}
+
+    explicit QuantizedColumn (std::span<const Value> values) {
+      m_codes.reserve (values.size ());
+      for (const Value& value : values)
+        m_codes.push_back (encode (value));
+    }
+
+    explicit QuantizedColumn (const std::vector<Value>& values)
+        : QuantizedColumn (std::span<const Value> (values)) {}
+
+    std::size_t size () const noexcept {
+      return m_codes.size ();
+    }
+
+    bool empty () const noexcept {
+      return m_codes.empty ();
+    }
+
+    // Codes held, which is what the column costs.
+    std::size_t capacity () const noexcept {
+      return m_codes.capacity ();
+    }
+
+    Value operator[] (std::size_t index) const {
+      return decode (m_codes[index]);
+    }
+
+    reference operator[] (std::size_t index) {
+      return reference (&m_codes[index]);
+    }
+
+    const_iterator begin () const {
+      return const_iterator (m_codes.data ());
+    }
+    const_iterator end () const {
+      return const_iterator (m_codes.data () + m_codes.size ());
+    }
+    iterator begin () {
+      return iterator (m_codes.data ());
+    }
+    iterator end () {
+      return iterator (m_codes.data () + m_codes.size ());
+    }
+
+    // The stored codes themselves, for storage and for texture lanes that
+    // share the encoding.
+    std::span<const code_type> codes () const noexcept {
+      return m_codes;
+    }
+    std::span<code_type> codes () noexcept {
+      return m_codes;
+    }
+
+    friend bool operator== (const QuantizedColumn&,
+                            const QuantizedColumn&) = default;
+
+  private:
+    std::vector<code_type> m_codes;
+  };
+}
+
+#endif
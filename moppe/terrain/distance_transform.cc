@@ -0,0 +1,179 @@
+#include <moppe/terrain/distance_transform.hh>
+
+#include <moppe/parallel.hh>
+#include <moppe/profile.hh>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <stdexcept>
+
+namespace moppe::terrain {
+  namespace {
+    constexpr double unreached = std::numeric_limits<double>::infinity ();
+    const meters_t unreached_distance =
+      std::numeric_limits<float>::infinity () * u::m;
+
+    // Columns swept together by one worker. Reading a band a row at a time
+    // keeps the column pass in storage order.
+    constexpr std::size_t column_band = 64;
+
+    // Squared distance in metres down each column of a band to its nearest
+    // source, wrapping round the lap. Two laps forward and two back see
+    // every source from both sides of every site. Anything beyond reach is
+    // left unreached, which lets the row pass pass it over.
+    void column_pass (std::span<const std::uint8_t> sources,
+                      std::size_t width,
+                      std::size_t height,
+                      std::size_t first_column,
+                      double spacing,
+                      double reach,
+                      std::span<double> squared) {
+      const std::size_t columns =
+        std::min (column_band, width - first_column);
+      std::vector<double> steps (columns * height);
+      std::vector<double> since (columns, unreached);
+      for (std::size_t lap_row = 0; lap_row < 2 * height; ++lap_row) {
+        const std::size_t row = lap_row % height;
+        const std::uint8_t* flags =
+          sources.data () + row * width + first_column;
+        for (std::size_t column = 0; column < columns; ++column) {
+          since[column] = flags[column] != 0 ? 0.0 : since[column] + 1.0;
+          if (lap_row >= height)
+            steps[row * columns + column] = since[column];
+        }
+      }
+      std::fill (since.begin (), since.end (), unreached);
+      for (std::size_t lap_row = 2 * height; lap_row-- > 0;) {
+        const std::size_t row = lap_row % height;
+        const std::uint8_t* flags =
+          sources.data () + row * width + first_column;
+        for (std::size_t column = 0; column < columns; ++column) {
+          since[column] = flags[column] != 0 ? 0.0 : since[column] + 1.0;
+          if (lap_row < height)
+            steps[row * columns + column] =
+              std::min (steps[row * columns + column], since[column]);
+        }
+      }
+      for (std::size_t row = 0; row < height; ++row)
+        for (std::size_t column = 0; column < columns; ++column) {
+          const double metres = steps[row * columns + column] * spacing;
+          squared[row * width + first_column + column] =
+            metres > reach ? unreached : metres * metres;
+        }
+    }
+
+    // The row pass of Felzenszwalb and Huttenlocher's transform: each column
+    // crossing the row contributes a parabola rooted at its position and
+    // raised by its squared column distance, and a site's squared distance
+    // is the lowest of them there.
+    //
+    // The row is laid out a lap and a margin wide, the margin repeating the
+    // far end of the row before its start and the near end after it, so
+    // every site sees the nearest image of every column. The margin is half
+    // a lap, or less when nothing beyond reach counts.
+    void row_pass (std::span<const double> squared,
+                   std::size_t width,
+                   std::size_t row,
+                   double spacing,
+                   std::size_t margin,
+                   std::span<meters_t> distance) {
+      const std::size_t first = width - margin;
+      const std::size_t places = width + 2 * margin;
+      const auto raised_at = [&] (std::size_t place) {
+        return squared[row * width + (first + place) % width];
+      };
+      const auto position = [&] (std::size_t place) {
+        return static_cast<double> (place) * spacing;
+      };
+      std::vector<std::size_t> roots (places);
+      std::vector<double> bounds (places + 1);
+      std::ptrdiff_t last = -1;
+      for (std::size_t place = 0; place < places; ++place) {
+        const double raised = raised_at (place);
+        if (raised == unreached)
+          continue;
+        const double root = position (place);
+        double start = -unreached;
+        while (last >= 0) {
+          const std::size_t previous = roots[static_cast<std::size_t> (last)];
+          const double previous_root = position (previous);
+          start = ((raised + root * root) -
+                   (raised_at (previous) + previous_root * previous_root)) /
+                  (2.0 * (root - previous_root));
+          if (start > bounds[static_cast<std::size_t> (last)])
+            break;
+          --last;
+          start = -unreached;
+        }
+        ++last;
+        roots[static_cast<std::size_t> (last)] = place;
+        bounds[static_cast<std::size_t> (last)] = start;
+        bounds[static_cast<std::size_t> (last) + 1] = unreached;
+      }
+
+      meters_t* out = distance.data () + row * width;
+      if (last < 0) {
+        std::fill (out, out + width, unreached_distance);
+        return;
+      }
+      std::size_t lowest = 0;
+      for (std::size_t column = 0; column < width; ++column) {
+        const double site = position (column + margin);
+        while (bounds[lowest + 1] < site)
+          ++lowest;
+        const double along = site - position (roots[lowest]);
+        out[column] =
+          static_cast<float> (
+            std::sqrt (along * along + raised_at (roots[lowest]))) *
+          u::m;
+      }
+    }
+  }
+
+  std::vector<meters_t> distance_to_sources (
+    const TerrainDomain& domain,
+    std::span<const std::uint8_t> sources,
+    meters_t reach) {
+    MOPPE_PROFILE_ZONE ("distance_to_sources");
+    if (sources.size () != domain.size ())
+      throw std::invalid_argument ("distance sources do not cover domain");
+    if (!(reach > 0.0f * u::m))
+      throw std::invalid_argument ("distance reach must be positive");
+    const std::size_t width = domain.width ();
+    const std::size_t height = domain.height ();
+    const double spacing_x = domain.spacing_x ().numerical_value_in (u::m);
+    const double spacing_z = domain.spacing_z ().numerical_value_in (u::m);
+    const double reach_m = reach.numerical_value_in (u::m);
+
+    std::vector<double> squared (domain.size ());
+    const std::size_t bands = (width + column_band - 1) / column_band;
+    parallel_rows (bands, domain.size (), [&] (std::size_t band) {
+      column_pass (sources,
+                   width,
+                   height,
+                   band * column_band,
+                   spacing_z,
+                   reach_m,
+                   squared);
+    });
+
+    const double reach_columns = std::ceil (reach_m / spacing_x);
+    const std::size_t half_lap = (width + 1) / 2;
+    const std::size_t margin =
+      reach_columns < static_cast<double> (half_lap)
+        ? static_cast<std::size_t> (reach_columns)
+        : half_lap;
+    std::vector<meters_t> distance (domain.size ());
+    parallel_rows (height, domain.size (), [&] (std::size_t row) {
+      row_pass (squared, width, row, spacing_x, margin, distance);
+      for (std::size_t column = 0; column < width; ++column) {
+        meters_t& site = distance[row * width + column];
+        if (site > reach)
+          site = unreached_distance;
+      }
+    });
+    return distance;
+  }
+}
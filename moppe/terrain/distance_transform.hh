@@ -0,0 +1,33 @@
+#ifndef MOPPE_TERRAIN_DISTANCE_TRANSFORM_HH
+#define MOPPE_TERRAIN_DISTANCE_TRANSFORM_HH
+
+#include <moppe/terrain/domain.hh>
+
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <vector>
+
+namespace moppe::terrain {
+  // Straight-line distance from every lattice site to the nearest source
+  // site, measured between lattice positions across the torus with the
+  // domain's own spacings. sources holds one flag per site in storage
+  // order; a non-zero flag marks a source.
+  //
+  // The transform is exact, not a chamfer or a step count: one pass down
+  // every column finds the nearest source along it, and one pass along
+  // every row takes the lower envelope of the parabolas those columns
+  // describe. Both passes are independent line by line and run in
+  // parallel.
+  //
+  // A site farther than reach from every source reads as infinitely far,
+  // as does every site of a lattice with no source at all. A caller that
+  // only cares about a band round its sources says so here, and both
+  // passes skip what cannot land inside it.
+  std::vector<meters_t> distance_to_sources (
+    const TerrainDomain& domain,
+    std::span<const std::uint8_t> sources,
+    meters_t reach = std::numeric_limits<float>::infinity () * u::m);
+}
+
+#endif
@@ -8,6 +8,7 @@
 #include <mp-units/framework.h>
 
 #include <algorithm>
+#include <array>
 #include <cmath>
 #include <concepts>
 #include <cstddef>
@@ -226,6 +227,22 @@ namespace moppe::terrain {
     friend bool operator== (const TerrainIndex&, const TerrainIndex&) = default;
   };
 
+  // A rectangle of sites on the torus: `columns` by `rows` sites whose first
+  // corner is `origin`, continuing across the seam when it reaches an edge.
+  // It is how a local change says where it happened, so everything derived
+  // from the changed sites can follow it there instead of over the world.
+  struct TerrainRect {
+    TerrainIndex origin;
+    std::size_t columns = 0;
+    std::size_t rows = 0;
+
+    bool empty () const noexcept {
+      return columns == 0 || rows == 0;
+    }
+
+    friend bool operator== (const TerrainRect&, const TerrainRect&) = default;
+  };
+
   // The one finite periodic lattice shared by terrain bundles. Exact section
   // access uses TerrainIndex; continuous access asks the domain for its
   // reconstruction stencil.
@@ -322,6 +339,61 @@ namespace moppe::terrain {
                              static_cast<int> (m_height))) };
     }
 
+    TerrainRect whole () const noexcept {
+      return { .origin = { 0, 0 }, .columns = m_width, .rows = m_height };
+    }
+
+    // A rectangle grown by a margin of sites on every side: the reach of a
+    // stencil that reads that far. Growing to a full lap on an axis covers
+    // the whole axis, starting from the lattice edge.
+    TerrainRect grown (const TerrainRect& rect,
+                       std::size_t columns,
+                       std::size_t rows) const {
+      validate (rect);
+      const auto grow = [] (std::size_t origin,
+                            std::size_t size,
+                            std::size_t margin,
+                            std::size_t period) {
+        if (size + 2 * margin >= period)
+          return std::pair<std::size_t, std::size_t> { 0, period };
+        return std::pair<std::size_t, std::size_t> {
+          (origin + period - margin) % period, size + 2 * margin
+        };
+      };
+      const auto [column, width] =
+        grow (rect.origin.column, rect.columns, columns, m_width);
+      const auto [row, height] =
+        grow (rect.origin.row, rect.rows, rows, m_height);
+      return { .origin = { column, row }, .columns = width, .rows = height };
+    }
+
+    // A rectangle as the pieces of storage it occupies: one, two, or four
+    // rectangles that stop at the lattice edge instead of wrapping, so each
+    // is a plain run of rows a copy or an upload can address directly.
+    template <typename Visitor>
+    void visit_unwrapped (const TerrainRect& rect, Visitor&& visitor) const {
+      validate (rect);
+      if (rect.empty ())
+        return;
+      const std::size_t first_columns =
+        std::min (rect.columns, m_width - rect.origin.column);
+      const std::size_t first_rows =
+        std::min (rect.rows, m_height - rect.origin.row);
+      const std::pair<std::size_t, std::size_t> column_spans[] = {
+        { rect.origin.column, first_columns },
+        { 0, rect.columns - first_columns },
+      };
+      const std::pair<std::size_t, std::size_t> row_spans[] = {
+        { rect.origin.row, first_rows },
+        { 0, rect.rows - first_rows },
+      };
+      for (const auto& [row, rows] : row_spans)
+        for (const auto& [column, columns] : column_spans)
+          if (rows > 0 && columns > 0)
+            visitor (TerrainRect {
+              .origin = { column, row }, .columns = columns, .rows = rows });
+    }
+
     // The metric neighbourhood: the four cardinal neighbours, each carrying
     // the inverse square of the spacing that separates it. With that
     // influence, folding influence * (neighbour - centre) over the
@@ -370,12 +442,102 @@ namespace moppe::terrain {
     }
 
   private:
+    void validate (const TerrainRect& rect) const {
+      if (rect.origin.column >= m_width || rect.origin.row >= m_height ||
+          rect.columns > m_width || rect.rows > m_height)
+        throw std::out_of_range ("terrain rectangle outside domain");
+    }
+
     std::size_t m_width;
     std::size_t m_height;
     meters_t m_spacing_x;
     meters_t m_spacing_z;
   };
 
+  // ---- Neighbourhood stencils ----
+
+  struct CellOffset {
+    int columns;
+    int rows;
+  };
+
+  // The eight neighbours in storage order: the row before, the two beside,
+  // then the row after.
+  inline constexpr std::array<CellOffset, 8> scan_neighbours { { { -1, -1 },
+                                                                 { 0, -1 },
+                                                                 { 1, -1 },
+                                                                 { -1, 0 },
+                                                                 { 1, 0 },
+                                                                 { -1, 1 },
+                                                                 { 0, 1 },
+                                                                 { 1, 1 } } };
+
+  // A ring of neighbour offsets fixed at compile time, bound to one
+  // lattice's dimensions. Routing and flooding ask for the neighbours of
+  // every cell they touch, so the common case is made cheap: away from the
+  // border a neighbour is the cell's storage offset plus a step precomputed
+  // once per lattice, and only cells within reach of an edge pay for the
+  // wrap across the torus. Neighbours come back in the order of Offsets.
+  template <auto Offsets>
+  class CellStencil {
+  public:
+    static constexpr std::size_t size = Offsets.size ();
+    static constexpr std::size_t reach = [] {
+      std::size_t result = 0;
+      for (const CellOffset offset : Offsets)
+        result = std::max ({ result,
+                             static_cast<std::size_t> (
+                               offset.columns < 0 ? -offset.columns
+                                                  : offset.columns),
+                             static_cast<std::size_t> (
+                               offset.rows < 0 ? -offset.rows : offset.rows) });
+      return result;
+    }();
+
+    explicit CellStencil (const TerrainDomain& domain)
+        : m_width (domain.width ()), m_height (domain.height ()) {
+      for (std::size_t slot = 0; slot < size; ++slot)
+        m_steps[slot] = static_cast<std::ptrdiff_t> (Offsets[slot].rows) *
+                          static_cast<std::ptrdiff_t> (m_width) +
+                        Offsets[slot].columns;
+    }
+
+    std::array<std::uint32_t, size> around (std::size_t column,
+                                            std::size_t row) const {
+      std::array<std::uint32_t, size> cells;
+      if (column >= reach && column + reach < m_width && row >= reach &&
+          row + reach < m_height) {
+        const auto cell = static_cast<std::ptrdiff_t> (row * m_width + column);
+        for (std::size_t slot = 0; slot < size; ++slot)
+          cells[slot] = static_cast<std::uint32_t> (cell + m_steps[slot]);
+        return cells;
+      }
+      for (std::size_t slot = 0; slot < size; ++slot)
+        cells[slot] = wrapped (column, row, Offsets[slot]);
+      return cells;
+    }
+
+    std::array<std::uint32_t, size> around (std::uint32_t cell) const {
+      return around (cell % m_width, cell / m_width);
+    }
+
+  private:
+    std::uint32_t
+    wrapped (std::size_t column, std::size_t row, CellOffset offset) const {
+      const int x = wrap_index (static_cast<int> (column) + offset.columns,
+                                static_cast<int> (m_width));
+      const int y = wrap_index (static_cast<int> (row) + offset.rows,
+                                static_cast<int> (m_height));
+      return static_cast<std::uint32_t> (static_cast<std::size_t> (y) *
+                                           m_width +
+                                         static_cast<std::size_t> (x));
+    }
+
+    std::size_t m_width;
+    std::size_t m_height;
+    std::array<std::ptrdiff_t, size> m_steps {};
+  };
+
   // ---- Elevation over the lattice ----
 
   using ElevationMap = spatial::Bundle<TerrainDomain, SurfaceElevation>;
@@ -15,24 +15,18 @@
 
 namespace moppe::terrain {
   namespace {
-    struct Offset {
-      int x;
-      int y;
-    };
-
-    constexpr std::array<Offset, 8> neighbors { { { -1, -1 },
-                                                  { 0, -1 },
-                                                  { 1, -1 },
-                                                  { -1, 0 },
-                                                  { 1, 0 },
-                                                  { -1, 1 },
-                                                  { 0, 1 },
-                                                  { 1, 1 } } };
-
-    std::size_t wrapped (int value, std::size_t period) {
-      const int n = static_cast<int> (period);
-      const int result = value % n;
-      return static_cast<std::size_t> (result < 0 ? result + n : result);
+    // Distances to the scan_neighbours of a cell, in their order. A lattice
+    // has only eight of them, so kernels measure them once, not per cell.
+    std::array<float, scan_neighbours.size ()>
+    neighbour_distances (const TerrainDomain& grid) {
+      std::array<float, scan_neighbours.size ()> distances;
+      for (std::size_t slot = 0; slot < distances.size (); ++slot)
+        distances[slot] = std::hypot (
+          scan_neighbours[slot].columns *
+            (grid.spacing_x ()).numerical_value_in (moppe::u::m),
+          scan_neighbours[slot].rows *
+            (grid.spacing_z ()).numerical_value_in (moppe::u::m));
+      return distances;
     }
 
     meters_t receiver_distance (std::uint32_t cell,
@@ -382,26 +376,23 @@ namespace moppe::terrain {
     std::vector<float> slope (count, 0.0f);
     {
       MOPPE_PROFILE_ZONE ("drainage.choose_receivers");
+      const CellStencil<scan_neighbours> neighbours (domain);
+      const auto distances = neighbour_distances (domain);
       for (std::size_t y = 0; y < height; ++y)
         for (std::size_t x = 0; x < width; ++x) {
           const std::size_t cell = index (x, y);
           receiver[cell] = static_cast<std::uint32_t> (cell);
           const float elevation = elevation_at (domain, elevations, x, y);
+          const auto ring = neighbours.around (x, y);
           float steepest = 0.0f;
-          for (const Offset offset : neighbors) {
-            const int raw_x = static_cast<int> (x) + offset.x;
-            const int raw_y = static_cast<int> (y) + offset.y;
-            const std::size_t nx = wrapped (raw_x, width);
-            const std::size_t ny = wrapped (raw_y, height);
+          for (std::size_t slot = 0; slot < ring.size (); ++slot) {
             const float neighbor_elevation =
-              elevation_at (domain, elevations, nx, ny);
-            const float distance = std::hypot (
-              offset.x * domain.spacing_x ().numerical_value_in (u::m),
-              offset.y * domain.spacing_z ().numerical_value_in (u::m));
-            const float candidate = (elevation - neighbor_elevation) / distance;
+              surface_elevation_value (elevations[ring[slot]]);
+            const float candidate =
+              (elevation - neighbor_elevation) / distances[slot];
             if (candidate > steepest) {
               steepest = candidate;
-              receiver[cell] = static_cast<std::uint32_t> (index (nx, ny));
+              receiver[cell] = ring[slot];
             }
           }
           slope[cell] = steepest;
@@ -429,8 +420,24 @@ namespace moppe::terrain {
              .receiver = std::move (receiver) };
   }
 
+  WetDrainageWorkspace::WetDrainageWorkspace (const TerrainDomain& domain)
+      : routing { .domain = domain,
+                  .receiver = std::vector<CellIndex> (domain.size ()),
+                  .slope = std::vector<float> (domain.size ()) } {
+    routed.reserve (domain.size ());
+    frontier.reserve (domain.size ());
+  }
+
   WetDrainageRouting route_wet_drainage (const FloodField& flood,
                                          const LakeCensus& census) {
+    WetDrainageWorkspace workspace (flood.domain ());
+    route_wet_drainage (workspace, flood, census);
+    return std::move (workspace.routing);
+  }
+
+  const WetDrainageRouting& route_wet_drainage (WetDrainageWorkspace& workspace,
+                                                const FloodField& flood,
+                                                const LakeCensus& census) {
     MOPPE_PROFILE_ZONE ("route_wet_drainage");
     const TerrainDomain& grid = flood.domain ();
     const std::size_t width = grid.width ();
@@ -438,36 +445,37 @@ namespace moppe::terrain {
     const std::size_t count = width * height;
     if (census.cell_count () != count)
       throw std::invalid_argument ("lake census does not match terrain");
+    if (workspace.routing.domain != grid)
+      throw std::invalid_argument (
+        "wet drainage workspace was sized for another lattice");
 
     const std::span<const SurfaceElevation> surface = flood.water_levels ();
     const auto index = [width] (std::size_t x, std::size_t y) {
       return y * width + x;
     };
+    const CellStencil<scan_neighbours> neighbours (grid);
 
-    std::vector<CellIndex> receiver (count, no_cell);
-    std::vector<float> slope (count, 0.0f);
+    std::vector<CellIndex>& receiver = workspace.routing.receiver;
+    std::vector<float>& slope = workspace.routing.slope;
+    receiver.assign (count, no_cell);
+    slope.assign (count, 0.0f);
     {
       MOPPE_PROFILE_ZONE ("wet_drainage.choose_receivers");
+      const auto distances = neighbour_distances (grid);
       for (std::size_t y = 0; y < height; ++y)
         for (std::size_t x = 0; x < width; ++x) {
           const std::size_t cell = index (x, y);
           receiver[cell] = flood.spill_receiver[cell];
+          const auto ring = neighbours.around (x, y);
           float steepest = 0.0f;
-          for (const Offset offset : neighbors) {
-            const int raw_x = static_cast<int> (x) + offset.x;
-            const int raw_y = static_cast<int> (y) + offset.y;
-            const std::size_t nx = wrapped (raw_x, width);
-            const std::size_t ny = wrapped (raw_y, height);
-            const std::size_t next = index (nx, ny);
-            const float distance = std::hypot (
-              offset.x * (grid.spacing_x ()).numerical_value_in (moppe::u::m),
-              offset.y * (grid.spacing_z ()).numerical_value_in (moppe::u::m));
+          for (std::size_t slot = 0; slot < ring.size (); ++slot) {
+            const std::uint32_t next = ring[slot];
             const float candidate = (surface_elevation_value (surface[cell]) -
                                      surface_elevation_value (surface[next])) /
-                                    distance;
+                                    distances[slot];
             if (candidate > steepest) {
               steepest = candidate;
-              receiver[cell] = static_cast<std::uint32_t> (next);
+              receiver[cell] = next;
             }
           }
           slope[cell] = steepest;
@@ -479,39 +487,30 @@ namespace moppe::terrain {
     // tree leading to that spill, so the body's full discharge stays whole.
     {
       MOPPE_PROFILE_ZONE ("wet_drainage.route_lake_interiors");
-      std::vector<std::uint8_t> routed (count, 0);
-      std::queue<std::uint32_t> body_frontier;
+      std::vector<std::uint8_t>& routed = workspace.routed;
+      std::vector<std::uint32_t>& body_frontier = workspace.frontier;
+      routed.assign (count, 0);
       for (const WaterBody& body : census.water_bodies ()) {
         if (body.ocean_connected || body.outlet_cell == WaterBody::no_cell)
           continue;
         receiver[body.outlet_cell] = body.spill_cell;
         routed[body.outlet_cell] = 1;
-        body_frontier.push (body.outlet_cell);
-        while (!body_frontier.empty ()) {
-          const std::uint32_t cell = body_frontier.front ();
-          body_frontier.pop ();
-          const std::size_t x = cell % width;
-          const std::size_t y = cell / width;
-          for (const Offset offset : neighbors) {
-            const int raw_x = static_cast<int> (x) + offset.x;
-            const int raw_y = static_cast<int> (y) + offset.y;
-            const std::size_t nx = wrapped (raw_x, width);
-            const std::size_t ny = wrapped (raw_y, height);
-            const std::uint32_t next =
-              static_cast<std::uint32_t> (index (nx, ny));
+        body_frontier.clear ();
+        body_frontier.push_back (body.outlet_cell);
+        for (std::size_t head = 0; head < body_frontier.size (); ++head) {
+          const std::uint32_t cell = body_frontier[head];
+          for (const std::uint32_t next : neighbours.around (cell)) {
             if (routed[next] || census.body_at (CellIndex { next }) != body.id)
               continue;
             routed[next] = 1;
             receiver[next] = cell;
-            body_frontier.push (next);
+            body_frontier.push_back (next);
           }
         }
       }
     }
 
-    return { .domain = grid,
-             .receiver = std::move (receiver),
-             .slope = std::move (slope) };
+    return workspace.routing;
   }
 
   DrainageGraph analyze_wet_drainage (const FloodField& flood,
@@ -44,6 +44,19 @@ namespace moppe::terrain {
     std::vector<float> slope;
   };
 
+  // Where wet routing writes, kept by a caller that routes the same lattice
+  // again and again. The routing's columns and the lake-interior scratch
+  // keep their capacity, so routing again allocates nothing, and the
+  // returned routing holds until the next call.
+  struct WetDrainageWorkspace {
+    explicit WetDrainageWorkspace (const TerrainDomain& domain);
+
+    WetDrainageRouting routing;
+    std::vector<std::uint8_t> routed;
+    // A breadth-first fill through one body, read from its front.
+    std::vector<std::uint32_t> frontier;
+  };
+
   // A compact functional graph. Dry drainage uses strictly lower receivers;
   // wet drainage may also follow acyclic equal-surface routes through water.
   // Its readings bundle contains the same unique periodic terrain samples.
@@ -161,6 +174,11 @@ namespace moppe::terrain {
 
   WetDrainageRouting route_wet_drainage (const FloodField& flood,
                                          const LakeCensus& census);
+  // Throws std::invalid_argument when the workspace was sized for another
+  // lattice.
+  const WetDrainageRouting& route_wet_drainage (WetDrainageWorkspace& workspace,
+                                                const FloodField& flood,
+                                                const LakeCensus& census);
   DrainageGraph analyze_wet_drainage (const FloodField& flood,
                                       const LakeCensus& census);
   RiverNetwork
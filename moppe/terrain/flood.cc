@@ -1,217 +1,270 @@
 #include <moppe/terrain/flood.hh>
 
+#include <moppe/parallel.hh>
 #include <moppe/profile.hh>
 
 #include <algorithm>
 #include <array>
+#include <atomic>
 #include <cmath>
 #include <limits>
-#include <queue>
+#include <numeric>
+#include <span>
 #include <stdexcept>
 #include <utility>
+#include <vector>
 
 namespace moppe::terrain {
   namespace {
-    struct FloodOffset {
-      int x;
-      int y;
-    };
-
-    constexpr std::array<FloodOffset, 8> flood_neighbors { { { -1, -1 },
-                                                             { 0, -1 },
-                                                             { 1, -1 },
-                                                             { -1, 0 },
-                                                             { 1, 0 },
-                                                             { -1, 1 },
-                                                             { 0, 1 },
-                                                             { 1, 1 } } };
-
     std::size_t flood_wrapped (int value, std::size_t period) {
       const int n = static_cast<int> (period);
       const int result = value % n;
       return static_cast<std::size_t> (result < 0 ? result + n : result);
     }
 
-    struct Cell {
-      float level;
-      std::uint32_t index;
-    };
+    // Rows a lake-census worker labels at once. Bands are fixed by the
+    // lattice rather than the thread count, so the labelling is the same on
+    // any machine.
+    constexpr std::size_t census_band_rows = 16;
+
+    std::uint32_t component_root (std::vector<std::uint32_t>& parent,
+                                  std::uint32_t cell) {
+      while (parent[cell] != cell) {
+        parent[cell] = parent[parent[cell]];
+        cell = parent[cell];
+      }
+      return cell;
+    }
+
+    // Hang the later root under the earlier, so every tree's root is its
+    // first cell in scan order and parents only ever point backward.
+    void join_components (std::vector<std::uint32_t>& parent,
+                          std::size_t first,
+                          std::size_t second) {
+      const std::uint32_t a =
+        component_root (parent, static_cast<std::uint32_t> (first));
+      const std::uint32_t b =
+        component_root (parent, static_cast<std::uint32_t> (second));
+      if (a < b)
+        parent[b] = a;
+      else if (b < a)
+        parent[a] = b;
+    }
 
     struct HigherCell {
-      bool operator() (const Cell& left, const Cell& right) const noexcept {
+      bool operator() (const detail::FloodCell& left,
+                       const detail::FloodCell& right) const noexcept {
         if (left.level != right.level)
           return left.level > right.level;
         return left.index > right.index;
       }
     };
-  }
 
-  FloodField
-  detail::analyze_standing_water (const TerrainDomain& grid,
-                                  std::span<const SurfaceElevation> elevations,
-                                  float sea_level) {
-    MOPPE_PROFILE_ZONE ("analyze_standing_water");
-    if (!std::isfinite (sea_level))
-      throw std::invalid_argument ("standing-water sea level must be finite");
+    void flood_standing_water (detail::FloodScratch& scratch,
+                               FloodField& flood,
+                               const TerrainDomain& grid,
+                               std::span<const SurfaceElevation> elevations,
+                               float sea_level) {
+      MOPPE_PROFILE_ZONE ("analyze_standing_water");
+      if (!std::isfinite (sea_level))
+        throw std::invalid_argument (
+          "standing-water sea level must be finite");
 
-    const std::size_t width = grid.width ();
-    const std::size_t height = grid.height ();
-    const std::size_t count = width * height;
-    const auto index = [width] (std::size_t x, std::size_t y) {
-      return y * width + x;
-    };
+      const std::size_t width = grid.width ();
+      const std::size_t height = grid.height ();
+      const std::size_t count = width * height;
+      const auto index = [width] (std::size_t x, std::size_t y) {
+        return y * width + x;
+      };
+      const CellStencil<scan_neighbours> neighbours (grid);
+
+      std::vector<float>& water = scratch.water;
+      std::vector<CellIndex>& receiver = flood.spill_receiver;
+      std::vector<std::uint8_t>& visited = scratch.visited;
+      std::vector<detail::FloodCell>& frontier = scratch.frontier;
+      water.assign (count, std::numeric_limits<float>::infinity ());
+      receiver.assign (count, CellIndex { 0 });
+      visited.assign (count, 0);
+      frontier.clear ();
+      // The same heap a std::priority_queue keeps, so cells leave it in the
+      // same order.
+      const auto push_frontier = [&] (detail::FloodCell cell) {
+        frontier.push_back (cell);
+        std::push_heap (frontier.begin (), frontier.end (), HigherCell {});
+      };
 
-    std::vector<float> water (count, std::numeric_limits<float>::infinity ());
-    std::vector<float> depth (count, 0.0f);
-    std::vector<CellIndex> receiver (count, CellIndex { 0 });
-    std::vector<std::uint8_t> visited (count, 0);
-    std::priority_queue<Cell, std::vector<Cell>, HigherCell> frontier;
+      // A torus has no exterior boundary that identifies the ocean. Treat the
+      // largest connected below-sea component as the global ocean; enclosed
+      // low components must earn their own higher spill level. Scan order
+      // breaks equal-size ties deterministically.
+      std::vector<std::uint8_t>& submerged_seen = scratch.submerged_seen;
+      std::vector<std::uint32_t>& component = scratch.component;
+      std::vector<std::uint32_t>& global_ocean = scratch.global_ocean;
+      submerged_seen.assign (count, 0);
+      global_ocean.clear ();
+      {
+        MOPPE_PROFILE_ZONE ("flood.find_ocean_components");
+        for (std::uint32_t origin = 0; origin < count; ++origin) {
+          if (submerged_seen[origin] ||
+              elevation_at (grid, elevations, origin % width, origin / width) >
+                sea_level)
+            continue;
+          component.clear ();
+          submerged_seen[origin] = 1;
+          component.push_back (origin);
+          for (std::size_t head = 0; head < component.size (); ++head) {
+            const std::uint32_t cell = component[head];
+            for (const std::uint32_t next : neighbours.around (cell)) {
+              if (submerged_seen[next] ||
+                  surface_elevation_value (elevations[next]) > sea_level)
+                continue;
+              submerged_seen[next] = 1;
+              component.push_back (next);
+            }
+          }
+          if (component.size () > global_ocean.size ())
+            std::swap (component, global_ocean);
+        }
+      }
 
-    // A torus has no exterior boundary that identifies the ocean. Treat the
-    // largest connected below-sea component as the global ocean; enclosed
-    // low components must earn their own higher spill level. Scan order
-    // breaks equal-size ties deterministically.
-    std::queue<std::uint32_t> sea_frontier;
-    std::vector<std::uint8_t> submerged_seen (count, 0);
-    std::vector<std::uint32_t> component;
-    std::vector<std::uint32_t> global_ocean;
-    {
-      MOPPE_PROFILE_ZONE ("flood.find_ocean_components");
-      for (std::uint32_t origin = 0; origin < count; ++origin) {
-        if (submerged_seen[origin] ||
-            elevation_at (grid, elevations, origin % width, origin / width) >
-              sea_level)
-          continue;
+      std::vector<std::uint8_t>& ocean_cell = flood.ocean;
+      ocean_cell.assign (count, 0);
+      if (!global_ocean.empty ()) {
+        MOPPE_PROFILE_ZONE ("flood.seed_global_ocean");
+        for (const std::uint32_t cell : global_ocean)
+          ocean_cell[cell] = 1;
+        const std::uint32_t root = global_ocean.front ();
+        water[root] = sea_level;
+        receiver[root] = root;
+        visited[root] = 1;
         component.clear ();
-        submerged_seen[origin] = 1;
-        sea_frontier.push (origin);
-        while (!sea_frontier.empty ()) {
-          const std::uint32_t cell = sea_frontier.front ();
-          sea_frontier.pop ();
-          component.push_back (cell);
-          const std::size_t x = cell % width;
-          const std::size_t y = cell / width;
-          for (const FloodOffset offset : flood_neighbors) {
-            const int raw_x = static_cast<int> (x) + offset.x;
-            const int raw_y = static_cast<int> (y) + offset.y;
-            const std::size_t nx = flood_wrapped (raw_x, width);
-            const std::size_t ny = flood_wrapped (raw_y, height);
-            const std::uint32_t next =
-              static_cast<std::uint32_t> (index (nx, ny));
-            if (submerged_seen[next] ||
-                elevation_at (grid, elevations, nx, ny) > sea_level)
+        component.push_back (root);
+        for (std::size_t head = 0; head < component.size (); ++head) {
+          const std::uint32_t cell = component[head];
+          push_frontier ({ sea_level, cell });
+          for (const std::uint32_t next : neighbours.around (cell)) {
+            if (!ocean_cell[next] || visited[next])
               continue;
-            submerged_seen[next] = 1;
-            sea_frontier.push (next);
+            water[next] = sea_level;
+            receiver[next] = cell;
+            visited[next] = 1;
+            component.push_back (next);
           }
         }
-        if (component.size () > global_ocean.size ())
-          global_ocean = component;
       }
-    }
+      const bool has_ocean = !global_ocean.empty ();
 
-    std::vector<std::uint8_t> ocean_cell (count, 0);
-    if (!global_ocean.empty ()) {
-      MOPPE_PROFILE_ZONE ("flood.seed_global_ocean");
-      for (const std::uint32_t cell : global_ocean)
-        ocean_cell[cell] = 1;
-      const std::uint32_t root = global_ocean.front ();
-      water[root] = sea_level;
-      receiver[root] = root;
-      visited[root] = 1;
-      sea_frontier.push (root);
-      while (!sea_frontier.empty ()) {
-        const std::uint32_t cell = sea_frontier.front ();
-        sea_frontier.pop ();
-        frontier.push ({ sea_level, cell });
-        const std::size_t x = cell % width;
-        const std::size_t y = cell / width;
-        for (const FloodOffset offset : flood_neighbors) {
-          const int raw_x = static_cast<int> (x) + offset.x;
-          const int raw_y = static_cast<int> (y) + offset.y;
-          const std::size_t nx = flood_wrapped (raw_x, width);
-          const std::size_t ny = flood_wrapped (raw_y, height);
-          const std::uint32_t next =
-            static_cast<std::uint32_t> (index (nx, ny));
-          if (!ocean_cell[next] || visited[next])
-            continue;
-          water[next] = sea_level;
-          receiver[next] = cell;
-          visited[next] = 1;
-          sea_frontier.push (next);
+      // An all-land torus has no geometric boundary. Root its minimax water
+      // surface at the deterministic global minimum so the analysis remains
+      // defined.
+      if (!has_ocean) {
+        MOPPE_PROFILE_ZONE ("flood.seed_endorheic_minimum");
+        std::uint32_t minimum_cell = 0;
+        float minimum = elevation_at (grid, elevations, 0, 0);
+        for (std::uint32_t cell = 1; cell < count; ++cell) {
+          const float value =
+            elevation_at (grid, elevations, cell % width, cell / width);
+          if (value < minimum) {
+            minimum = value;
+            minimum_cell = cell;
+          }
         }
+        water[minimum_cell] = minimum;
+        receiver[minimum_cell] = minimum_cell;
+        visited[minimum_cell] = 1;
+        push_frontier ({ minimum, minimum_cell });
       }
-    }
-    const bool has_ocean = !global_ocean.empty ();
 
-    // An all-land torus has no geometric boundary. Root its minimax water
-    // surface at the deterministic global minimum so the analysis remains
-    // defined.
-    if (!has_ocean) {
-      MOPPE_PROFILE_ZONE ("flood.seed_endorheic_minimum");
-      std::uint32_t minimum_cell = 0;
-      float minimum = elevation_at (grid, elevations, 0, 0);
-      for (std::uint32_t cell = 1; cell < count; ++cell) {
-        const float value =
-          elevation_at (grid, elevations, cell % width, cell / width);
-        if (value < minimum) {
-          minimum = value;
-          minimum_cell = cell;
+      {
+        MOPPE_PROFILE_ZONE ("flood.priority_flood");
+        while (!frontier.empty ()) {
+          std::pop_heap (frontier.begin (), frontier.end (), HigherCell {});
+          const detail::FloodCell current = frontier.back ();
+          frontier.pop_back ();
+          for (const std::uint32_t next : neighbours.around (current.index)) {
+            if (visited[next])
+              continue;
+            visited[next] = 1;
+            water[next] = std::max (surface_elevation_value (elevations[next]),
+                                    current.level);
+            receiver[next] = current.index;
+            push_frontier ({ water[next], next });
+          }
         }
       }
-      water[minimum_cell] = minimum;
-      receiver[minimum_cell] = minimum_cell;
-      visited[minimum_cell] = 1;
-      frontier.push ({ minimum, minimum_cell });
-    }
 
-    {
-      MOPPE_PROFILE_ZONE ("flood.priority_flood");
-      while (!frontier.empty ()) {
-        const Cell current = frontier.top ();
-        frontier.pop ();
-        const std::size_t x = current.index % width;
-        const std::size_t y = current.index / width;
-        for (const FloodOffset offset : flood_neighbors) {
-          const int raw_x = static_cast<int> (x) + offset.x;
-          const int raw_y = static_cast<int> (y) + offset.y;
-          const std::size_t nx = flood_wrapped (raw_x, width);
-          const std::size_t ny = flood_wrapped (raw_y, height);
-          const std::uint32_t next =
-            static_cast<std::uint32_t> (index (nx, ny));
-          if (visited[next])
-            continue;
-          visited[next] = 1;
-          water[next] =
-            std::max (elevation_at (grid, elevations, nx, ny), current.level);
-          receiver[next] = current.index;
-          frontier.push ({ water[next], next });
-        }
+      {
+        MOPPE_PROFILE_ZONE ("flood.compute_water_depth");
+        auto& levels = spatial::get<surface_elevation> (flood.surface);
+        auto& depths = spatial::get<standing_water_depth> (flood.surface);
+        for (std::size_t y = 0; y < height; ++y)
+          for (std::size_t x = 0; x < width; ++x) {
+            const std::size_t cell = index (x, y);
+            levels[cell] =
+              SurfaceElevation (water[cell] * surface_elevation[u::m]);
+            depths[cell] =
+              std::max (0.0f,
+                        water[cell] - elevation_at (grid, elevations, x, y)) *
+              standing_water_depth[u::m];
+          }
       }
+      flood.sea_level = sea_level;
+      flood.has_ocean = has_ocean;
     }
+  }
 
-    {
-      MOPPE_PROFILE_ZONE ("flood.compute_water_depth");
-      for (std::size_t y = 0; y < height; ++y)
-        for (std::size_t x = 0; x < width; ++x) {
-          const std::size_t cell = index (x, y);
-          depth[cell] = std::max (
-            0.0f, water[cell] - elevation_at (grid, elevations, x, y));
-        }
-    }
+  FloodWorkspace::FloodWorkspace (const TerrainDomain& domain)
+      : flood { .surface = FloodSurface (domain),
+                .sea_level = 0.0f,
+                .has_ocean = false,
+                .ocean = std::vector<std::uint8_t> (domain.size ()),
+                .spill_receiver = std::vector<CellIndex> (domain.size ()) },
+        census (std::vector<WaterBodyId> (domain.size (), LakeCensus::dry),
+                {}),
+        // As many helpers as parallel_rows would start over the lattice.
+        census_workers (row_worker_count (domain.height (), domain.size ()) -
+                        1) {
+    const std::size_t count = domain.size ();
+    for (std::vector<std::uint32_t>* column :
+         { &flooding.component,
+           &flooding.global_ocean,
+           &counting.parent,
+           &counting.members,
+           &counting.sweep })
+      column->reserve (count);
+    flooding.water.reserve (count);
+    flooding.visited.reserve (count);
+    flooding.submerged_seen.reserve (count);
+    // Every cell joins the frontier at most once.
+    flooding.frontier.reserve (count);
+    counting.shore_distance.reserve (count);
+  }
 
-    FloodSurface surface (grid);
-    auto& levels = spatial::get<surface_elevation> (surface);
-    auto& depths = spatial::get<standing_water_depth> (surface);
-    for (std::size_t cell = 0; cell < count; ++cell) {
-      levels[cell] = SurfaceElevation (water[cell] * surface_elevation[u::m]);
-      depths[cell] = depth[cell] * standing_water_depth[u::m];
-    }
-    return { .surface = std::move (surface),
-             .sea_level = sea_level,
-             .has_ocean = has_ocean,
-             .ocean = std::move (ocean_cell),
-             .spill_receiver = std::move (receiver) };
+  FloodField
+  detail::analyze_standing_water (const TerrainDomain& grid,
+                                  std::span<const SurfaceElevation> elevations,
+                                  float sea_level) {
+    detail::FloodScratch scratch;
+    FloodField flood { .surface = FloodSurface (grid),
+                       .sea_level = sea_level,
+                       .has_ocean = false,
+                       .ocean = {},
+                       .spill_receiver = {} };
+    flood_standing_water (scratch, flood, grid, elevations, sea_level);
+    return flood;
+  }
+
+  const FloodField&
+  detail::analyze_standing_water (FloodWorkspace& workspace,
+                                  const TerrainDomain& grid,
+                                  std::span<const SurfaceElevation> elevations,
+                                  float sea_level) {
+    if (workspace.flood.domain () != grid)
+      throw std::invalid_argument (
+        "flood workspace was sized for another lattice");
+    flood_standing_water (
+      workspace.flooding, workspace.flood, grid, elevations, sea_level);
+    return workspace.flood;
   }
 
   WaterBodyMembership::WaterBodyMembership (
@@ -234,167 +287,330 @@ namespace moppe::terrain {
           "water-body row identity does not match its domain");
   }
 
-  LakeCensus census_lakes (const FloodField& flood, float wet_epsilon) {
-    MOPPE_PROFILE_ZONE ("census_lakes");
-    if (!std::isfinite (wet_epsilon) || wet_epsilon < 0.0f)
-      throw std::invalid_argument ("lake census epsilon must be non-negative");
-    const std::size_t width = flood.width ();
-    const std::size_t height = flood.height ();
-    const std::size_t count = width * height;
-    const std::span<const StandingWaterDepth> depth = flood.water_depths ();
-    const std::span<const SurfaceElevation> level = flood.water_levels ();
-    std::vector<WaterBodyId> body_at_cell (count, LakeCensus::dry);
-    std::vector<WaterBody> bodies;
-    std::queue<std::uint32_t> frontier;
-    const square_meters_t cell_area = flood.domain ().cell_area ();
+  namespace {
+    // run_rows (rows, cells, body) calls body (row) for every row in
+    // [0, rows), as parallel_rows does.
+    template <typename RunRows>
+    void count_lakes (detail::CensusScratch& scratch,
+                      LakeCensus& census,
+                      const FloodField& flood,
+                      float wet_epsilon,
+                      RunRows&& run_rows) {
+      MOPPE_PROFILE_ZONE ("census_lakes");
+      if (!std::isfinite (wet_epsilon) || wet_epsilon < 0.0f)
+        throw std::invalid_argument (
+          "lake census epsilon must be non-negative");
+      const std::size_t width = flood.width ();
+      const std::size_t height = flood.height ();
+      const std::size_t count = width * height;
+      const std::span<const StandingWaterDepth> depth = flood.water_depths ();
+      const std::span<const SurfaceElevation> level = flood.water_levels ();
+      LakeCensus::Columns columns = std::move (census).release ();
+      std::vector<WaterBodyId>& body_at_cell = columns.body_at_cell;
+      std::vector<WaterBody>& bodies = columns.water_bodies;
+      body_at_cell.assign (count, LakeCensus::dry);
+      const square_meters_t cell_area = flood.domain ().cell_area ();
+      const auto wet = [&] (std::size_t cell) {
+        return depth[cell].numerical_value_in (u::m) > wet_epsilon;
+      };
 
-    for (std::uint32_t origin = 0; origin < count; ++origin) {
-      if (depth[origin].numerical_value_in (u::m) <= wet_epsilon ||
-          body_at_cell[origin] != LakeCensus::dry)
-        continue;
-      const WaterBodyId id { static_cast<std::uint32_t> (bodies.size ()) };
-      WaterBody body { .id = id,
-                       .cells = cell_count (0),
-                       .area = 0.0f * mp_units::si::metre * mp_units::si::metre,
-                       .maximum_depth = 0.0f * mp_units::si::metre,
-                       .mean_depth = 0.0f * mp_units::si::metre,
-                       .volume = 0.0f * mp_units::si::metre *
-                                 mp_units::si::metre * mp_units::si::metre,
-                       .surface_level = 0.0f * mp_units::si::metre,
-                       .ocean_connected = false,
-                       .outlet_cell = WaterBody::no_cell,
-                       .spill_cell = WaterBody::no_cell,
-                       .classification = WaterBodyClass::Puddle,
-                       .inradius = 0.0f * mp_units::si::metre,
-                       .channel_like = false };
-      double surface_sum_m = 0.0;
-      std::vector<std::uint32_t> members;
-      body_at_cell[origin] = id;
-      frontier.push (origin);
-      while (!frontier.empty ()) {
-        const std::uint32_t cell = frontier.front ();
-        frontier.pop ();
-        members.push_back (cell);
-        const std::size_t x = cell % width;
-        const std::size_t y = cell / width;
-        const meters_t depth_m =
-          depth[cell].numerical_value_in (u::m) * mp_units::si::metre;
-        ++body.cells;
-        body.maximum_depth = std::max (body.maximum_depth, depth_m);
-        body.volume += depth_m * cell_area;
-        surface_sum_m +=
-          static_cast<double> (surface_elevation_value (level[cell]));
-        for (const FloodOffset offset : flood_neighbors) {
-          const int raw_x = static_cast<int> (x) + offset.x;
-          const int raw_y = static_cast<int> (y) + offset.y;
-          const std::size_t nx = flood_wrapped (raw_x, width);
-          const std::size_t ny = flood_wrapped (raw_y, height);
-          const std::uint32_t next =
-            static_cast<std::uint32_t> (ny * width + nx);
-          if (depth[next].numerical_value_in (u::m) > wet_epsilon) {
-            if (body_at_cell[next] == LakeCensus::dry) {
-              body_at_cell[next] = id;
-              frontier.push (next);
+      // Connected components by union-find. Bands of rows are joined
+      // internally in parallel, then stitched across their seams, the torus
+      // wrap among them. Every tree hangs from its smallest cell, which is
+      // where a scan-order flood fill would have started the body.
+      const std::size_t bands =
+        (height + census_band_rows - 1) / census_band_rows;
+      const auto band_rows = [&] (std::size_t band) {
+        return std::pair { band * census_band_rows,
+                           std::min (height, (band + 1) * census_band_rows) };
+      };
+      std::vector<std::uint32_t>& parent = scratch.parent;
+      parent.resize (count);
+      {
+        MOPPE_PROFILE_ZONE ("census.label_components");
+        run_rows (bands, count, [&] (std::size_t band) {
+          const auto [first_row, last_row] = band_rows (band);
+          const std::size_t first = first_row * width;
+          const std::size_t last = last_row * width;
+          std::iota (parent.begin () + first,
+                     parent.begin () + last,
+                     static_cast<std::uint32_t> (first));
+          for (std::size_t y = first_row; y < last_row; ++y)
+            for (std::size_t x = 0; x < width; ++x) {
+              const std::size_t cell = y * width + x;
+              if (!wet (cell))
+                continue;
+              const std::size_t right =
+                y * width + flood_wrapped (static_cast<int> (x) + 1, width);
+              if (wet (right))
+                join_components (parent, cell, right);
+              if (y + 1 == last_row)
+                continue;
+              for (int dx = -1; dx <= 1; ++dx) {
+                const std::size_t below =
+                  (y + 1) * width +
+                  flood_wrapped (static_cast<int> (x) + dx, width);
+                if (wet (below))
+                  join_components (parent, cell, below);
+              }
+            }
+          // Parents only ever point back in scan order, so one forward pass
+          // hangs every cell directly from its band's root.
+          for (std::size_t cell = first; cell < last; ++cell)
+            parent[cell] = parent[parent[cell]];
+        });
+        for (std::size_t band = 0; band < bands; ++band) {
+          const std::size_t y = band_rows (band).second - 1;
+          const std::size_t below = (y + 1) % height;
+          for (std::size_t x = 0; x < width; ++x) {
+            const std::size_t cell = y * width + x;
+            if (!wet (cell))
+              continue;
+            for (int dx = -1; dx <= 1; ++dx) {
+              const std::size_t next =
+                below * width +
+                flood_wrapped (static_cast<int> (x) + dx, width);
+              if (wet (next))
+                join_components (parent, cell, next);
             }
           }
         }
       }
-      body.area = static_cast<float> (body.cells) * cell_area;
-      body.mean_depth = body.volume / body.area;
-      body.surface_level =
-        static_cast<float> (surface_sum_m / static_cast<double> (body.cells)) *
-        mp_units::si::metre;
-      body.ocean_connected =
-        flood.has_ocean &&
-        std::fabs (surface_elevation_value (level[members.front ()]) -
-                   flood.sea_level) <= wet_epsilon;
-      if (!body.ocean_connected) {
-        // A priority-flood path can leave a connected flat, cross a dry
-        // saddle, and re-enter the same flat.  Use its final departure as the
-        // body's spill; rebuilding the body as one drainage tree at an earlier
-        // departure would point that tree back into itself.
-        std::uint32_t cell = members.front ();
-        std::size_t steps = 0;
-        while (flood.spill_receiver[cell] != cell && steps < count) {
-          const std::uint32_t next = flood.spill_receiver[cell];
-          if (body_at_cell[cell] == id && body_at_cell[next] != id) {
-            body.outlet_cell = cell;
-            body.spill_cell = next;
+
+      // Number the roots in scan order, then give every wet cell its root's
+      // identity: the dense numbering the flood fill produced.
+      std::vector<std::uint32_t>& roots_before = scratch.roots_before;
+      roots_before.assign (bands + 1, 0);
+      {
+        MOPPE_PROFILE_ZONE ("census.number_bodies");
+        run_rows (bands, count, [&] (std::size_t band) {
+          const auto [first_row, last_row] = band_rows (band);
+          std::uint32_t roots = 0;
+          for (std::size_t cell = first_row * width; cell < last_row * width;
+               ++cell) {
+            if (!wet (cell))
+              continue;
+            std::uint32_t root = parent[cell];
+            while (parent[root] != root)
+              root = parent[root];
+            body_at_cell[cell] = WaterBodyId { root };
+            roots += root == cell;
           }
-          cell = next;
-          ++steps;
-        }
-        if (steps == count)
-          throw std::logic_error (
-            "standing-water spill routing contains a cycle");
+          roots_before[band + 1] = roots;
+        });
+        std::partial_sum (
+          roots_before.begin (), roots_before.end (), roots_before.begin ());
+        run_rows (bands, count, [&] (std::size_t band) {
+          const auto [first_row, last_row] = band_rows (band);
+          std::uint32_t next = roots_before[band];
+          for (std::size_t cell = first_row * width; cell < last_row * width;
+               ++cell)
+            if (wet (cell) && body_at_cell[cell] == cell)
+              parent[cell] = next++;
+        });
+        run_rows (bands, count, [&] (std::size_t band) {
+          const auto [first_row, last_row] = band_rows (band);
+          for (std::size_t cell = first_row * width; cell < last_row * width;
+               ++cell)
+            if (wet (cell))
+              body_at_cell[cell] =
+                WaterBodyId { parent[body_at_cell[cell].value] };
+        });
       }
-      if (body.ocean_connected)
-        body.classification = WaterBodyClass::Sea;
-      else if (!water_body_is_permanent (body))
-        body.classification = WaterBodyClass::Puddle;
-      else if (body.area < 50000.0f * mp_units::si::metre * mp_units::si::metre)
-        body.classification = WaterBodyClass::Pond;
-      else
-        body.classification = WaterBodyClass::Lake;
-      bodies.push_back (body);
-    }
 
-    // Shape reading: a multi-source sweep from every dry cell measures each
-    // wet cell's distance to shore in cell steps, and a body's largest such
-    // distance is its flooded inradius. A permanent inland body no wider
-    // than a few cells is a flooded channel segment, not a terminating lake:
-    // the running field can carry current through it without flattening the
-    // rest of the reach into a chain of body-owned plates.
-    {
-      MOPPE_PROFILE_ZONE ("census.measure_body_shape");
-      // Two cells of inradius limits channel classification to pools four to
-      // five cells wide. Wider flooded reaches can hide arms the alignment
-      // never visits and should remain terminating standing bodies.
-      constexpr float channel_inradius_cells = 2.05f;
-      const float cell_step_m = std::min (
-        (flood.domain ().spacing_x ()).numerical_value_in (moppe::u::m),
-        (flood.domain ().spacing_z ()).numerical_value_in (moppe::u::m));
-      std::vector<std::int32_t> shore_distance (count, -1);
-      std::queue<std::uint32_t> sweep;
-      for (std::uint32_t cell = 0; cell < count; ++cell)
-        if (body_at_cell[cell] == LakeCensus::dry) {
-          shore_distance[cell] = 0;
-          sweep.push (cell);
-        }
-      while (!sweep.empty ()) {
-        const std::uint32_t cell = sweep.front ();
-        sweep.pop ();
-        const std::size_t x = cell % width;
-        const std::size_t y = cell / width;
-        for (const FloodOffset offset : flood_neighbors) {
-          const int raw_x = static_cast<int> (x) + offset.x;
-          const int raw_y = static_cast<int> (y) + offset.y;
-          const std::size_t nx = flood_wrapped (raw_x, width);
-          const std::size_t ny = flood_wrapped (raw_y, height);
-          const std::uint32_t next =
-            static_cast<std::uint32_t> (ny * width + nx);
-          if (shore_distance[next] < 0) {
-            shore_distance[next] = shore_distance[cell] + 1;
-            sweep.push (next);
+      // Members of each body in scan order, then each body measured on its
+      // own. Sums run over a body's cells in that fixed order, so no reading
+      // depends on the worker count.
+      const std::size_t body_count = roots_before.back ();
+      std::vector<std::uint32_t>& member_start = scratch.member_start;
+      member_start.assign (body_count + 1, 0);
+      for (const WaterBodyId id : body_at_cell)
+        if (id != LakeCensus::dry)
+          ++member_start[id.value + 1];
+      std::partial_sum (
+        member_start.begin (), member_start.end (), member_start.begin ());
+      std::vector<std::uint32_t>& members = scratch.members;
+      members.resize (member_start.back ());
+      {
+        std::vector<std::uint32_t>& cursor = scratch.cursor;
+        cursor.assign (member_start.begin (), member_start.end () - 1);
+        for (std::uint32_t cell = 0; cell < count; ++cell)
+          if (body_at_cell[cell] != LakeCensus::dry)
+            members[cursor[body_at_cell[cell].value]++] = cell;
+      }
+
+      bodies.clear ();
+      bodies.resize (body_count);
+      std::atomic<bool> spill_cycle = false;
+      {
+        MOPPE_PROFILE_ZONE ("census.measure_bodies");
+        run_rows (body_count, members.size (), [&] (std::size_t offset) {
+          const std::span<const std::uint32_t> cells (
+            members.data () + member_start[offset],
+            member_start[offset + 1] - member_start[offset]);
+          const WaterBodyId id { static_cast<std::uint32_t> (offset) };
+          WaterBody body {
+            .id = id,
+            .cells = cells.size () * cell_count[mp_units::one],
+            .area = 0.0f * mp_units::si::metre * mp_units::si::metre,
+            .maximum_depth = 0.0f * mp_units::si::metre,
+            .mean_depth = 0.0f * mp_units::si::metre,
+            .volume = 0.0f * mp_units::si::metre * mp_units::si::metre *
+                      mp_units::si::metre,
+            .surface_level = 0.0f * mp_units::si::metre,
+            .ocean_connected = false,
+            .outlet_cell = WaterBody::no_cell,
+            .spill_cell = WaterBody::no_cell,
+            .classification = WaterBodyClass::Puddle,
+            .inradius = 0.0f * mp_units::si::metre,
+            .channel_like = false
+          };
+          double depth_sum_m = 0.0;
+          double surface_sum_m = 0.0;
+          for (const std::uint32_t cell : cells) {
+            const float depth_m = depth[cell].numerical_value_in (u::m);
+            body.maximum_depth =
+              std::max (body.maximum_depth, depth_m * mp_units::si::metre);
+            depth_sum_m += depth_m;
+            surface_sum_m +=
+              static_cast<double> (surface_elevation_value (level[cell]));
           }
-        }
+          body.area = static_cast<float> (cells.size ()) * cell_area;
+          body.volume =
+            static_cast<float> (depth_sum_m) * mp_units::si::metre * cell_area;
+          body.mean_depth = body.volume / body.area;
+          body.surface_level =
+            static_cast<float> (surface_sum_m /
+                                static_cast<double> (cells.size ())) *
+            mp_units::si::metre;
+          body.ocean_connected =
+            flood.has_ocean &&
+            std::fabs (surface_elevation_value (level[cells.front ()]) -
+                       flood.sea_level) <= wet_epsilon;
+          if (!body.ocean_connected) {
+            // A priority-flood path can leave a connected flat, cross a dry
+            // saddle, and re-enter the same flat.  Use its final departure as
+            // the body's spill; rebuilding the body as one drainage tree at an
+            // earlier departure would point that tree back into itself.
+            std::uint32_t cell = cells.front ();
+            std::size_t steps = 0;
+            while (flood.spill_receiver[cell] != cell && steps < count) {
+              const std::uint32_t next = flood.spill_receiver[cell];
+              if (body_at_cell[cell] == id && body_at_cell[next] != id) {
+                body.outlet_cell = cell;
+                body.spill_cell = next;
+              }
+              cell = next;
+              ++steps;
+            }
+            // A worker cannot throw across its join; the census throws once
+            // every body is measured.
+            if (steps == count)
+              spill_cycle.store (true, std::memory_order_relaxed);
+          }
+          if (body.ocean_connected)
+            body.classification = WaterBodyClass::Sea;
+          else if (!water_body_is_permanent (body))
+            body.classification = WaterBodyClass::Puddle;
+          else if (body.area <
+                   50000.0f * mp_units::si::metre * mp_units::si::metre)
+            body.classification = WaterBodyClass::Pond;
+          else
+            body.classification = WaterBodyClass::Lake;
+          bodies[offset] = body;
+        });
       }
-      for (std::uint32_t cell = 0; cell < count; ++cell) {
-        const WaterBodyId id = body_at_cell[cell];
-        if (id == LakeCensus::dry || shore_distance[cell] < 0)
-          continue;
-        WaterBody& body = bodies[id.value];
-        body.inradius = std::max (body.inradius,
-                                  static_cast<float> (shore_distance[cell]) *
-                                    cell_step_m * mp_units::si::metre);
+      if (spill_cycle.load ())
+        throw std::logic_error (
+          "standing-water spill routing contains a cycle");
+
+      // Shape reading: a multi-source sweep from every dry cell measures each
+      // wet cell's distance to shore in cell steps, and a body's largest such
+      // distance is its flooded inradius. A permanent inland body no wider
+      // than a few cells is a flooded channel segment, not a terminating lake:
+      // the running field can carry current through it without flattening the
+      // rest of the reach into a chain of body-owned plates.
+      {
+        MOPPE_PROFILE_ZONE ("census.measure_body_shape");
+        // Two cells of inradius limits channel classification to pools four to
+        // five cells wide. Wider flooded reaches can hide arms the alignment
+        // never visits and should remain terminating standing bodies.
+        constexpr float channel_inradius_cells = 2.05f;
+        const float cell_step_m = std::min (
+          (flood.domain ().spacing_x ()).numerical_value_in (moppe::u::m),
+          (flood.domain ().spacing_z ()).numerical_value_in (moppe::u::m));
+        const CellStencil<scan_neighbours> neighbours (flood.domain ());
+        std::vector<std::int32_t>& shore_distance = scratch.shore_distance;
+        std::vector<std::uint32_t>& sweep = scratch.sweep;
+        shore_distance.assign (count, -1);
+        sweep.clear ();
+        for (std::uint32_t cell = 0; cell < count; ++cell)
+          if (body_at_cell[cell] == LakeCensus::dry) {
+            shore_distance[cell] = 0;
+            sweep.push_back (cell);
+          }
+        for (std::size_t head = 0; head < sweep.size (); ++head) {
+          const std::uint32_t cell = sweep[head];
+          for (const std::uint32_t next : neighbours.around (cell)) {
+            if (shore_distance[next] < 0) {
+              shore_distance[next] = shore_distance[cell] + 1;
+              sweep.push_back (next);
+            }
+          }
+        }
+        for (std::uint32_t cell = 0; cell < count; ++cell) {
+          const WaterBodyId id = body_at_cell[cell];
+          if (id == LakeCensus::dry || shore_distance[cell] < 0)
+            continue;
+          WaterBody& body = bodies[id.value];
+          body.inradius = std::max (body.inradius,
+                                    static_cast<float> (shore_distance[cell]) *
+                                      cell_step_m * mp_units::si::metre);
+        }
+        for (WaterBody& body : bodies)
+          body.channel_like =
+            !body.ocean_connected && water_body_is_permanent (body) &&
+            body.inradius <=
+              channel_inradius_cells * cell_step_m * mp_units::si::metre;
       }
-      for (WaterBody& body : bodies)
-        body.channel_like =
-          !body.ocean_connected && water_body_is_permanent (body) &&
-          body.inradius <=
-            channel_inradius_cells * cell_step_m * mp_units::si::metre;
+      census = LakeCensus (std::move (body_at_cell), std::move (bodies));
     }
-    return LakeCensus (std::move (body_at_cell), std::move (bodies));
+  }
+
+  LakeCensus census_lakes (const FloodField& flood, float wet_epsilon) {
+    detail::CensusScratch scratch;
+    LakeCensus census;
+    count_lakes (scratch,
+                 census,
+                 flood,
+                 wet_epsilon,
+                 [] (std::size_t rows, std::size_t cells, const auto& body) {
+                   parallel_rows (rows, cells, body);
+                 });
+    return census;
+  }
+
+  const LakeCensus& census_lakes (FloodWorkspace& workspace,
+                                  const FloodField& flood,
+                                  float wet_epsilon) {
+    if (flood.domain () != workspace.flood.domain ())
+      throw std::invalid_argument (
+        "flood workspace was sized for another lattice");
+    RowWorkers& workers = workspace.census_workers;
+    count_lakes (workspace.counting,
+                 workspace.census,
+                 flood,
+                 wet_epsilon,
+                 [&] (std::size_t rows, std::size_t cells, const auto& body) {
+                   // Too little work for the workers stays on this thread,
+                   // as parallel_rows would keep it.
+                   if (row_worker_count (rows, cells) == 1)
+                     for (std::size_t row = 0; row < rows; ++row)
+                       body (row);
+                   else
+                     workers.run (rows, body);
+                 });
+    return workspace.census;
   }
 
   bool water_body_is_permanent (const WaterBody& body,
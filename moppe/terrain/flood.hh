@@ -1,6 +1,7 @@
 #ifndef MOPPE_TERRAIN_FLOOD_HH
 #define MOPPE_TERRAIN_FLOOD_HH
 
+#include <moppe/parallel.hh>
 #include <moppe/terrain/domain.hh>
 
 #include <cstdint>
@@ -127,6 +128,12 @@ namespace moppe::terrain {
       return m_body_at_cell;
     }
 
+    // Hands the identities back and leaves the membership empty.
+    std::vector<WaterBodyId> release () && noexcept {
+      m_bodies = WaterBodyDomain {};
+      return std::exchange (m_body_at_cell, {});
+    }
+
   private:
     WaterBodyDomain m_bodies;
     std::vector<WaterBodyId> m_body_at_cell;
@@ -136,10 +143,24 @@ namespace moppe::terrain {
   public:
     static constexpr WaterBodyId dry = WaterBodyMembership::dry;
 
+    // What a census is built from, handed back by release so that the next
+    // census can be counted into the same storage.
+    struct Columns {
+      std::vector<WaterBodyId> body_at_cell;
+      std::vector<WaterBody> water_bodies;
+    };
+
     LakeCensus () = default;
     LakeCensus (std::vector<WaterBodyId> body_at_cell,
                 std::vector<WaterBody> water_bodies);
 
+    // Leaves the census empty.
+    Columns release () && noexcept {
+      m_domain = WaterBodyDomain {};
+      return { .body_at_cell = std::move (m_membership).release (),
+               .water_bodies = std::exchange (m_water_bodies, {}) };
+    }
+
     const WaterBodyDomain& domain () const noexcept {
       return m_domain;
     }
@@ -190,11 +211,70 @@ namespace moppe::terrain {
   bool water_body_terminates_rivers (const WaterBody& body,
                                      const WaterPermanence& permanence = {});
 
+  namespace detail {
+    // A cell on the priority flood's frontier, at the level water reaches it.
+    struct FloodCell {
+      float level;
+      std::uint32_t index;
+    };
+
+    // What analyze_standing_water works in besides its result. The frontier
+    // is kept as a heap. A breadth-first fill reads the component from its
+    // front while appending to its back, so the component is its own queue.
+    struct FloodScratch {
+      std::vector<float> water;
+      std::vector<std::uint8_t> visited;
+      std::vector<std::uint8_t> submerged_seen;
+      std::vector<FloodCell> frontier;
+      std::vector<std::uint32_t> component;
+      std::vector<std::uint32_t> global_ocean;
+    };
+
+    // What census_lakes works in besides its result: the union-find parents,
+    // the roots counted in each band, every body's members in scan order,
+    // and the sweep that measures distance to shore.
+    struct CensusScratch {
+      std::vector<std::uint32_t> parent;
+      std::vector<std::uint32_t> roots_before;
+      std::vector<std::uint32_t> member_start;
+      std::vector<std::uint32_t> members;
+      std::vector<std::uint32_t> cursor;
+      std::vector<std::int32_t> shore_distance;
+      std::vector<std::uint32_t> sweep;
+    };
+  }
+
+  // Where flood analysis and the lake census keep their results and scratch
+  // between calls, sized once for one lattice. Each call refills the same
+  // columns, queues and union-find arrays with assign, which keeps their
+  // capacity, and the census runs its bands on row workers started with the
+  // workspace rather than per call. Past its first use on a lattice neither
+  // stage allocates; columns indexed by water body grow to the most bodies
+  // any census has found. A returned result refers into the workspace and
+  // holds until that stage runs on it again.
+  struct FloodWorkspace {
+    explicit FloodWorkspace (const TerrainDomain& domain);
+
+    FloodField flood;
+    LakeCensus census;
+    detail::FloodScratch flooding;
+    detail::CensusScratch counting;
+    RowWorkers census_workers;
+  };
+
   namespace detail {
     FloodField
     analyze_standing_water (const TerrainDomain& domain,
                             std::span<const SurfaceElevation> elevations,
                             float sea_level);
+
+    // Throws std::invalid_argument when the workspace was sized for another
+    // lattice.
+    const FloodField&
+    analyze_standing_water (FloodWorkspace& workspace,
+                            const TerrainDomain& domain,
+                            std::span<const SurfaceElevation> elevations,
+                            float sea_level);
   }
 
   template <TerrainElevations Terrain>
@@ -202,7 +282,20 @@ namespace moppe::terrain {
     return detail::analyze_standing_water (
       terrain.domain (), elevations (terrain), sea_level);
   }
+
+  template <TerrainElevations Terrain>
+  const FloodField& analyze_standing_water (FloodWorkspace& workspace,
+                                            const Terrain& terrain,
+                                            float sea_level) {
+    return detail::analyze_standing_water (
+      workspace, terrain.domain (), elevations (terrain), sea_level);
+  }
   LakeCensus census_lakes (const FloodField& flood, float wet_epsilon = 1e-7f);
+  // Throws std::invalid_argument when the flood lies on another lattice than
+  // the workspace.
+  const LakeCensus& census_lakes (FloodWorkspace& workspace,
+                                  const FloodField& flood,
+                                  float wet_epsilon = 1e-7f);
   ElevationMap permanent_water_surface (const FloodField& flood,
                                         const LakeCensus& census,
                                         const WaterPermanence& permanence = {});
@@ -8,8 +8,9 @@
 #include <array>
 #include <cmath>
 #include <cstdint>
+#include <functional>
+#include <memory>
 #include <numbers>
-#include <queue>
 #include <stdexcept>
 #include <utility>
 #include <vector>
@@ -29,26 +30,6 @@ namespace moppe::terrain {
     using RoutingSurface =
       spatial::Bundle<TerrainCellDomain, RoutingSurfaceElevation>;
 
-    constexpr std::array neighbour_offsets {
-      std::array { 1, 0 },   std::array { 1, -1 }, std::array { 0, -1 },
-      std::array { -1, -1 }, std::array { -1, 0 }, std::array { -1, 1 },
-      std::array { 0, 1 },   std::array { 1, 1 }
-    };
-
-    struct FacetOffsets {
-      int cardinal_x;
-      int cardinal_y;
-      int diagonal_x;
-      int diagonal_y;
-    };
-
-    constexpr std::array facet_offsets {
-      FacetOffsets { 1, 0, 1, -1 },   FacetOffsets { 0, -1, 1, -1 },
-      FacetOffsets { 0, -1, -1, -1 }, FacetOffsets { -1, 0, -1, -1 },
-      FacetOffsets { -1, 0, -1, 1 },  FacetOffsets { 0, 1, -1, 1 },
-      FacetOffsets { 0, 1, 1, 1 },    FacetOffsets { 1, 0, 1, 1 }
-    };
-
     float normalized_angle (float radians) {
       constexpr float turn = 2.0f * std::numbers::pi_v<float>;
       radians = std::fmod (radians, turn);
@@ -90,7 +71,7 @@ namespace moppe::terrain {
     };
 
     struct FacetGeometry {
-      FacetOffsets offsets;
+      CompassFacet slots;
       meters_t d1;
       meters_t d2;
       float extent;
@@ -100,14 +81,17 @@ namespace moppe::terrain {
       float u2_z;
     };
 
+    // Geometry for every compass slot and facet, measured once per lattice.
+    // Slots index compass_neighbours, so a cell's ring of neighbours lines
+    // up with them.
     struct DInfinityStencil {
-      std::array<NeighbourGeometry, neighbour_offsets.size ()> neighbours;
-      std::array<FacetGeometry, facet_offsets.size ()> facets;
+      std::array<NeighbourGeometry, compass_neighbours.size ()> neighbours;
+      std::array<FacetGeometry, compass_facets.size ()> facets;
 
       explicit DInfinityStencil (const TerrainDomain& grid) {
-        for (std::size_t i = 0; i < neighbour_offsets.size (); ++i) {
-          const int columns = neighbour_offsets[i][0];
-          const int rows = neighbour_offsets[i][1];
+        for (std::size_t i = 0; i < compass_neighbours.size (); ++i) {
+          const int columns = compass_neighbours[i].columns;
+          const int rows = compass_neighbours[i].rows;
           const DrainageDirection direction =
             direction_for_offset (columns, rows, grid);
           neighbours[i] = { .columns = columns,
@@ -116,28 +100,30 @@ namespace moppe::terrain {
                             .direction = direction,
                             .unit_direction = direction_vector (direction) };
         }
-        for (std::size_t i = 0; i < facet_offsets.size (); ++i) {
-          const FacetOffsets offsets = facet_offsets[i];
+        for (std::size_t i = 0; i < compass_facets.size (); ++i) {
+          const CompassFacet slots = compass_facets[i];
+          const CellOffset cardinal = compass_neighbours[slots.cardinal];
+          const CellOffset diagonal = compass_neighbours[slots.diagonal];
           const meters_t d1 =
-            offset_distance (offsets.cardinal_x, offsets.cardinal_y, grid);
+            offset_distance (cardinal.columns, cardinal.rows, grid);
           const meters_t d2 =
-            offset_distance (offsets.diagonal_x - offsets.cardinal_x,
-                             offsets.diagonal_y - offsets.cardinal_y,
+            offset_distance (diagonal.columns - cardinal.columns,
+                             diagonal.rows - cardinal.rows,
                              grid);
           const float d1_m = (d1).numerical_value_in (moppe::u::m);
           const float d2_m = (d2).numerical_value_in (moppe::u::m);
           facets[i] = {
-            .offsets = offsets,
+            .slots = slots,
             .d1 = d1,
             .d2 = d2,
             .extent = std::atan2 (d2_m, d1_m),
-            .u1_x = offsets.cardinal_x *
+            .u1_x = cardinal.columns *
                     (grid.spacing_x ()).numerical_value_in (moppe::u::m) / d1_m,
-            .u1_z = offsets.cardinal_y *
+            .u1_z = cardinal.rows *
                     (grid.spacing_z ()).numerical_value_in (moppe::u::m) / d1_m,
-            .u2_x = (offsets.diagonal_x - offsets.cardinal_x) *
+            .u2_x = (diagonal.columns - cardinal.columns) *
                     (grid.spacing_x ()).numerical_value_in (moppe::u::m) / d2_m,
-            .u2_z = (offsets.diagonal_y - offsets.cardinal_y) *
+            .u2_z = (diagonal.rows - cardinal.rows) *
                     (grid.spacing_z ()).numerical_value_in (moppe::u::m) / d2_m
           };
         }
@@ -231,13 +217,12 @@ namespace moppe::terrain {
 
       // Single-neighbour candidates cover bounded edges and are also the
       // clamped-to-edge cases of the triangular-facet construction.
-      for (const NeighbourGeometry& geometry : stencil.neighbours) {
-        const auto receiver =
-          domain.neighbour (cell, geometry.columns, geometry.rows);
-        if (!receiver)
-          continue;
+      const std::array<std::uint32_t, 8> ring = domain.compass (cell);
+      for (std::size_t slot = 0; slot < ring.size (); ++slot) {
+        const NeighbourGeometry& geometry = stencil.neighbours[slot];
+        const CellIndex receiver { ring[slot] };
         const auto drop = center - spatial::get<routing_surface_elevation> (
-                                     focus.row (*receiver));
+                                     focus.row (receiver));
         const float slope =
           (drop / geometry.distance).numerical_value_in (mp_units::one);
         const float score = route_score (
@@ -245,24 +230,19 @@ namespace moppe::terrain {
         if (score > best_score) {
           best_score = score;
           best.route =
-            single_route (*receiver, geometry.columns, geometry.rows, grid);
+            single_route (receiver, geometry.columns, geometry.rows, grid);
           best.direction = geometry.direction;
           best.slope = slope * terrain_slope[mp_units::one];
         }
       }
 
       for (const FacetGeometry& geometry : stencil.facets) {
-        const FacetOffsets offsets = geometry.offsets;
-        const auto cardinal =
-          domain.neighbour (cell, offsets.cardinal_x, offsets.cardinal_y);
-        const auto diagonal =
-          domain.neighbour (cell, offsets.diagonal_x, offsets.diagonal_y);
-        if (!cardinal || !diagonal)
-          continue;
+        const CellIndex cardinal { ring[geometry.slots.cardinal] };
+        const CellIndex diagonal { ring[geometry.slots.diagonal] };
         const RoutingSurfaceElevation cardinal_height =
-          spatial::get<routing_surface_elevation> (focus.row (*cardinal));
+          spatial::get<routing_surface_elevation> (focus.row (cardinal));
         const RoutingSurfaceElevation diagonal_height =
-          spatial::get<routing_surface_elevation> (focus.row (*diagonal));
+          spatial::get<routing_surface_elevation> (focus.row (diagonal));
         const float s1 = ((center - cardinal_height) / geometry.d1)
                            .numerical_value_in (mp_units::one);
         const float s2 = ((cardinal_height - diagonal_height) / geometry.d2)
@@ -294,10 +274,10 @@ namespace moppe::terrain {
           continue;
         best_score = score;
 
-        best.route.arcs[0] = { .receiver = *cardinal,
+        best.route.arcs[0] = { .receiver = cardinal,
                                .fraction = (1.0f - diagonal_fraction) *
                                            flow_fraction[mp_units::one] };
-        best.route.arcs[1] = { .receiver = *diagonal,
+        best.route.arcs[1] = { .receiver = diagonal,
                                .fraction = diagonal_fraction *
                                            flow_fraction[mp_units::one] };
         best.route.arc_count = 2;
@@ -311,14 +291,16 @@ namespace moppe::terrain {
       return best;
     }
 
-    std::vector<CellIndex>
-    accumulate (const TerrainCellDomain& lattice,
-                const std::vector<FractionalFlowRoute>& routes,
-                const std::vector<DrainageDirection>& directions,
-                std::vector<FractionalContributingArea>& areas,
-                std::vector<ChannelTangent>& tangents,
-                std::vector<ChannelAreaFlux>& area_fluxes) {
-      std::vector<std::uint32_t> donors (lattice.size (), 0);
+    // Sources first, then each cell once all its donors are placed; ties go
+    // to the lowest cell, so the order is deterministic. Cells whose donors
+    // are all placed wait in `ready`, a heap kept as std::priority_queue
+    // keeps one.
+    void order_routes (const TerrainCellDomain& lattice,
+                       const std::vector<FractionalFlowRoute>& routes,
+                       std::vector<std::uint32_t>& donors,
+                       std::vector<std::uint32_t>& ready,
+                       std::vector<CellIndex>& order) {
+      donors.assign (lattice.size (), 0);
       for (std::size_t offset = 0; offset < routes.size (); ++offset) {
         const FractionalFlowRoute& route = routes[offset];
         float total_fraction = 0.0f;
@@ -338,54 +320,103 @@ namespace moppe::terrain {
             "fractional drainage route does not conserve flow");
       }
 
-      std::priority_queue<std::uint32_t,
-                          std::vector<std::uint32_t>,
-                          std::greater<std::uint32_t>>
-        ready;
+      const auto make_ready = [&] (std::uint32_t cell) {
+        ready.push_back (cell);
+        std::push_heap (
+          ready.begin (), ready.end (), std::greater<std::uint32_t> {});
+      };
+      ready.clear ();
       for (std::uint32_t cell = 0; cell < lattice.size (); ++cell)
         if (donors[cell] == 0)
-          ready.push (cell);
+          make_ready (cell);
 
-      std::vector<CellIndex> order;
+      order.clear ();
       order.reserve (lattice.size ());
-      std::vector<Vec3> incoming_area_flux (lattice.size (), Vec3 ());
       while (!ready.empty ()) {
-        const CellIndex cell { ready.top () };
-        ready.pop ();
+        std::pop_heap (
+          ready.begin (), ready.end (), std::greater<std::uint32_t> {});
+        const CellIndex cell { ready.back () };
+        ready.pop_back ();
         order.push_back (cell);
         const FractionalFlowRoute& route = routes[cell.value];
-        const float area_m2 = areas[cell.value].numerical_value_in (
-          mp_units::si::metre * mp_units::si::metre);
-        Vec3 combined = incoming_area_flux[cell.value];
+        for (std::uint8_t arc = 0; arc < route.arc_count; ++arc)
+          if (--donors[route.arcs[arc].receiver.value] == 0)
+            make_ready (route.arcs[arc].receiver.value);
+      }
+      if (order.size () != lattice.size ())
+        throw std::logic_error ("fractional drainage routing contains a cycle");
+    }
+
+    // The positions' columns accumulate works in.
+    struct OrderedColumns {
+      std::vector<DrainageDirection> directions;
+      std::vector<float> areas;
+      std::vector<Vec3> tangents;
+      std::vector<Vec3> fluxes;
+      std::vector<Vec3> incoming_area_flux;
+    };
+
+    // Carries area and area flux downstream in topological positions, then
+    // returns them to the lattice.
+    void accumulate (const FractionalFlowDomain& flow,
+                     const std::vector<DrainageDirection>& directions,
+                     float cell_area_m2,
+                     OrderedColumns& ordered,
+                     std::vector<FractionalContributingArea>& areas,
+                     std::vector<ChannelTangent>& tangents,
+                     std::vector<ChannelAreaFlux>& area_fluxes) {
+      const std::span<const TopologicalFlowRoute> routes =
+        flow.topological_routes ();
+      std::vector<DrainageDirection>& ordered_directions = ordered.directions;
+      ordered_directions.resize (flow.size ());
+      flow.gather (directions, ordered_directions);
+      std::vector<float>& ordered_areas = ordered.areas;
+      std::vector<Vec3>& ordered_tangents = ordered.tangents;
+      std::vector<Vec3>& ordered_fluxes = ordered.fluxes;
+      std::vector<Vec3>& incoming_area_flux = ordered.incoming_area_flux;
+      ordered_areas.assign (flow.size (), cell_area_m2);
+      ordered_tangents.resize (flow.size ());
+      ordered_fluxes.resize (flow.size ());
+      incoming_area_flux.assign (flow.size (), Vec3 ());
+      for (std::size_t position = 0; position < flow.size (); ++position) {
+        const TopologicalFlowRoute& route = routes[position];
+        const float area_m2 = ordered_areas[position];
+        Vec3 combined = incoming_area_flux[position];
         if (!route.empty ())
-          combined += area_m2 * direction_vector (directions[cell.value]);
+          combined += area_m2 * direction_vector (ordered_directions[position]);
         Vec3 tangent;
         if (length2 (combined) > 1e-12f)
           tangent = normalized (combined);
         const Vec3 outgoing_area_flux = area_m2 * tangent;
-        tangents[cell.value] = tangent * channel_tangent[mp_units::one];
-        area_fluxes[cell.value] =
-          outgoing_area_flux *
-          channel_area_flux[mp_units::si::metre * mp_units::si::metre];
+        ordered_tangents[position] = tangent;
+        ordered_fluxes[position] = outgoing_area_flux;
         for (std::uint8_t arc = 0; arc < route.arc_count; ++arc) {
-          const FractionalFlowArc& flow = route.arcs[arc];
+          const TopologicalFlowArc& downstream = route.arcs[arc];
           const float fraction =
-            flow.fraction.numerical_value_in (mp_units::one);
-          areas[flow.receiver.value] += fraction * areas[cell.value];
-          incoming_area_flux[flow.receiver.value] +=
+            downstream.fraction.numerical_value_in (mp_units::one);
+          ordered_areas[downstream.receiver] += fraction * area_m2;
+          incoming_area_flux[downstream.receiver] +=
             fraction * outgoing_area_flux;
-          if (--donors[flow.receiver.value] == 0)
-            ready.push (flow.receiver.value);
         }
       }
-      if (order.size () != lattice.size ())
-        throw std::logic_error ("fractional drainage routing contains a cycle");
-      return order;
+
+      for (std::size_t position = 0; position < flow.size (); ++position) {
+        const std::size_t cell = flow.topological_order ()[position].value;
+        areas[cell] =
+          ordered_areas[position] *
+          fractional_contributing_area[mp_units::si::metre *
+                                       mp_units::si::metre];
+        tangents[cell] =
+          ordered_tangents[position] * channel_tangent[mp_units::one];
+        area_fluxes[cell] =
+          ordered_fluxes[position] *
+          channel_area_flux[mp_units::si::metre * mp_units::si::metre];
+      }
     }
   }
 
   TerrainCellDomain::TerrainCellDomain (TerrainDomain domain)
-      : m_domain (std::move (domain)) {}
+      : m_domain (std::move (domain)), m_compass (m_domain) {}
 
   std::size_t TerrainCellDomain::offset (CellIndex index) const {
     if (index.value >= size ())
@@ -414,15 +445,115 @@ namespace moppe::terrain {
     TerrainCellDomain lattice,
     std::vector<FractionalFlowRoute> routes,
     std::vector<CellIndex> topological_order)
-      : m_lattice (std::move (lattice)), m_routes (std::move (routes)),
-        m_topological_order (std::move (topological_order)) {
+      : FractionalFlowDomain (
+          std::move (lattice),
+          Columns { .routes = std::move (routes),
+                    .topological_order = std::move (topological_order) }) {}
+
+  FractionalFlowDomain::FractionalFlowDomain (TerrainCellDomain lattice,
+                                              Columns columns)
+      : m_lattice (std::move (lattice)),
+        m_routes (std::move (columns.routes)),
+        m_topological_order (std::move (columns.topological_order)),
+        m_positions (std::move (columns.positions)),
+        m_topological_routes (std::move (columns.topological_routes)) {
     if (m_routes.size () != size () || m_topological_order.size () != size ())
       throw std::invalid_argument (
         "fractional flow domain data does not match terrain lattice");
+
+    constexpr std::uint32_t unvisited = ~std::uint32_t (0);
+    m_positions.assign (size (), unvisited);
+    for (std::size_t position = 0; position < size (); ++position) {
+      const CellIndex cell = m_topological_order[position];
+      if (cell.value >= size () || m_positions[cell.value] != unvisited)
+        throw std::invalid_argument (
+          "fractional flow order does not visit every cell once");
+      m_positions[cell.value] = static_cast<std::uint32_t> (position);
+    }
+
+    m_topological_routes.assign (size (), TopologicalFlowRoute {});
+    for (std::size_t position = 0; position < size (); ++position) {
+      const FractionalFlowRoute& route =
+        m_routes[m_topological_order[position].value];
+      TopologicalFlowRoute& ordered = m_topological_routes[position];
+      if (route.arc_count > route.arcs.size ())
+        throw std::invalid_argument ("fractional flow route has too many arcs");
+      ordered.arc_count = route.arc_count;
+      for (std::uint8_t arc = 0; arc < route.arc_count; ++arc) {
+        const CellIndex receiver = route.arcs[arc].receiver;
+        if (receiver.value >= size () ||
+            m_positions[receiver.value] <= position)
+          throw std::invalid_argument (
+            "fractional flow route does not lead downstream");
+        ordered.arcs[arc] = { .receiver = m_positions[receiver.value],
+                              .fraction = route.arcs[arc].fraction };
+      }
+    }
   }
 
+  // What a solve in a FractionalDrainageWorkspace works in besides its
+  // result.
+  struct detail::FractionalDrainageScratch {
+    explicit FractionalDrainageScratch (const TerrainDomain& domain)
+        : surface (TerrainCellDomain (domain)), wet (domain) {
+      const std::size_t count = domain.size ();
+      level_values.reserve (count);
+      donors.reserve (count);
+      ready.reserve (count);
+      ordered.directions.reserve (count);
+      ordered.areas.reserve (count);
+      ordered.tangents.reserve (count);
+      ordered.fluxes.reserve (count);
+      ordered.incoming_area_flux.reserve (count);
+    }
+
+    RoutingSurface surface;
+    std::vector<float> level_values;
+    WetDrainageWorkspace wet;
+    std::vector<std::uint32_t> donors;
+    std::vector<std::uint32_t> ready;
+    OrderedColumns ordered;
+  };
+
   namespace {
-    FractionalDrainage analyze_fractional_drainage_impl (
+    // The storage a solve builds its drainage in: what an earlier result was
+    // built in, or nothing.
+    struct DrainageColumns {
+      FractionalFlowDomain::Columns flow;
+      std::vector<DrainageDirection> directions;
+      std::vector<slope_t> slopes;
+      std::vector<FractionalContributingArea> areas;
+      std::vector<ChannelTangent> tangents;
+      std::vector<ChannelAreaFlux> area_fluxes;
+    };
+
+    DrainageColumns released_columns (FractionalDrainage&& drainage) {
+      auto [flow, directions, slopes, areas, tangents, area_fluxes] =
+        std::move (drainage).release ();
+      return { .flow = std::move (flow).release (),
+               .directions = std::move (directions),
+               .slopes = std::move (slopes),
+               .areas = std::move (areas),
+               .tangents = std::move (tangents),
+               .area_fluxes = std::move (area_fluxes) };
+    }
+
+    // A lattice with no routes yet, every column sized for it.
+    FractionalDrainage unrouted_drainage (const TerrainDomain& grid) {
+      std::vector<CellIndex> order (grid.size ());
+      for (std::size_t offset = 0; offset < order.size (); ++offset)
+        order[offset] = CellIndex { static_cast<std::uint32_t> (offset) };
+      return FractionalDrainage (
+        FractionalFlowDomain (TerrainCellDomain (grid),
+                              std::vector<FractionalFlowRoute> (grid.size ()),
+                              std::move (order)));
+    }
+
+    // Builds the drainage in the columns of `recycled` when there is one,
+    // once the inputs have been checked.
+    FractionalDrainage solve_fractional_drainage (
+      detail::FractionalDrainageScratch& scratch,
+      FractionalDrainage* recycled,
       const FloodField& flood,
       const LakeCensus& census,
       std::span<const ChannelTangent> previous_tangent,
@@ -442,11 +573,15 @@ namespace moppe::terrain {
         throw std::invalid_argument (
           "fractional drainage channel memory is invalid");
 
+      DrainageColumns columns;
+      if (recycled)
+        columns = released_columns (std::move (*recycled));
+
       TerrainCellDomain lattice (grid);
-      RoutingSurface surface (lattice);
+      RoutingSurface& surface = scratch.surface;
       const std::span<const SurfaceElevation> levels = flood.water_levels ();
-      std::vector<float> level_values;
-      level_values.reserve (levels.size ());
+      std::vector<float>& level_values = scratch.level_values;
+      level_values.clear ();
       for (SurfaceElevation level : levels)
         level_values.push_back (surface_elevation_value (level));
       auto& elevations = spatial::get<routing_surface_elevation> (surface);
@@ -458,12 +593,15 @@ namespace moppe::terrain {
       // The wet receiver tree supplies flat lake routes and proven depression
       // spills, where continuous downhill direction is undefined. All strict
       // dry-land descent uses D-infinity.
-      const WetDrainageRouting wet = route_wet_drainage (flood, census);
-      std::vector<FractionalFlowRoute> routes (lattice.size ());
-      std::vector<DrainageDirection> directions (
-        lattice.size (), 0.0f * drainage_direction[mp_units::angular::radian]);
-      std::vector<slope_t> slopes (lattice.size (),
-                                   0.0f * terrain_slope[mp_units::one]);
+      const WetDrainageRouting& wet =
+        route_wet_drainage (scratch.wet, flood, census);
+      std::vector<FractionalFlowRoute>& routes = columns.flow.routes;
+      std::vector<DrainageDirection>& directions = columns.directions;
+      std::vector<slope_t>& slopes = columns.slopes;
+      routes.assign (lattice.size (), FractionalFlowRoute {});
+      directions.assign (lattice.size (),
+                         0.0f * drainage_direction[mp_units::angular::radian]);
+      slopes.assign (lattice.size (), 0.0f * terrain_slope[mp_units::one]);
 
       if (backend) {
         backend->select_dry_routes (grid,
@@ -515,37 +653,58 @@ namespace moppe::terrain {
         slopes[offset] = reading.slope;
       }
 
+      order_routes (lattice,
+                    routes,
+                    scratch.donors,
+                    scratch.ready,
+                    columns.flow.topological_order);
+      const std::size_t count = lattice.size ();
+      FractionalFlowDomain flow (std::move (lattice), std::move (columns.flow));
+
       const float cell_area_m2 =
         (grid.cell_area ()).numerical_value_in (moppe::u::m * moppe::u::m);
-      std::vector<FractionalContributingArea> areas (
-        lattice.size (),
-        cell_area_m2 * fractional_contributing_area[mp_units::si::metre *
-                                                    mp_units::si::metre]);
-      std::vector<ChannelTangent> tangents (
-        lattice.size (), Vec3 () * channel_tangent[mp_units::one]);
-      std::vector<ChannelAreaFlux> area_fluxes (
-        lattice.size (),
+      std::vector<FractionalContributingArea>& areas = columns.areas;
+      std::vector<ChannelTangent>& tangents = columns.tangents;
+      std::vector<ChannelAreaFlux>& area_fluxes = columns.area_fluxes;
+      areas.assign (count,
+                    0.0f * fractional_contributing_area[mp_units::si::metre *
+                                                        mp_units::si::metre]);
+      tangents.assign (count, Vec3 () * channel_tangent[mp_units::one]);
+      area_fluxes.assign (
+        count,
         Vec3 () * channel_area_flux[mp_units::si::metre * mp_units::si::metre]);
-      std::vector<CellIndex> order =
-        accumulate (lattice, routes, directions, areas, tangents, area_fluxes);
-      FractionalDrainage result (FractionalFlowDomain (
-        std::move (lattice), std::move (routes), std::move (order)));
-      spatial::get<drainage_direction> (result) = std::move (directions);
-      spatial::get<terrain_slope> (result) = std::move (slopes);
-      spatial::get<fractional_contributing_area> (result) = std::move (areas);
-      spatial::get<channel_tangent> (result) = std::move (tangents);
-      spatial::get<channel_area_flux> (result) = std::move (area_fluxes);
-      return result;
+      accumulate (flow,
+                  directions,
+                  cell_area_m2,
+                  scratch.ordered,
+                  areas,
+                  tangents,
+                  area_fluxes);
+      return FractionalDrainage (std::move (flow),
+                                 std::move (directions),
+                                 std::move (slopes),
+                                 std::move (areas),
+                                 std::move (tangents),
+                                 std::move (area_fluxes));
     }
   }
 
+  FractionalDrainageWorkspace::FractionalDrainageWorkspace (
+    const TerrainDomain& domain)
+      : drainage (unrouted_drainage (domain)),
+        scratch (
+          std::make_unique<detail::FractionalDrainageScratch> (domain)) {}
+
+  FractionalDrainageWorkspace::~FractionalDrainageWorkspace () = default;
+
   FractionalDrainage
   analyze_fractional_drainage (const FloodField& flood,
                                const LakeCensus& census,
                                std::span<const ChannelTangent> previous_tangent,
                                ChannelPersistence persistence) {
-    return analyze_fractional_drainage_impl (
-      flood, census, previous_tangent, persistence, nullptr);
+    detail::FractionalDrainageScratch scratch (flood.domain ());
+    return solve_fractional_drainage (
+      scratch, nullptr, flood, census, previous_tangent, persistence, nullptr);
   }
 
   FractionalDrainage
@@ -554,7 +713,27 @@ namespace moppe::terrain {
                                std::span<const ChannelTangent> previous_tangent,
                                ChannelPersistence persistence,
                                const FractionalRouteBackend& backend) {
-    return analyze_fractional_drainage_impl (
-      flood, census, previous_tangent, persistence, &backend);
+    detail::FractionalDrainageScratch scratch (flood.domain ());
+    return solve_fractional_drainage (
+      scratch, nullptr, flood, census, previous_tangent, persistence, &backend);
+  }
+
+  const FractionalDrainage& analyze_fractional_drainage (
+    FractionalDrainageWorkspace& workspace,
+    const FloodField& flood,
+    const LakeCensus& census,
+    std::span<const ChannelTangent> previous_tangent,
+    ChannelPersistence persistence) {
+    if (workspace.drainage.domain ().terrain_domain () != flood.domain ())
+      throw std::invalid_argument (
+        "fractional drainage workspace was sized for another lattice");
+    workspace.drainage = solve_fractional_drainage (*workspace.scratch,
+                                                    &workspace.drainage,
+                                                    flood,
+                                                    census,
+                                                    previous_tangent,
+                                                    persistence,
+                                                    nullptr);
+    return workspace.drainage;
   }
 }
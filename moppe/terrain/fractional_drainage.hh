@@ -10,14 +10,37 @@
 #include <array>
 #include <cstddef>
 #include <cstdint>
+#include <memory>
 #include <optional>
+#include <ranges>
 #include <span>
+#include <stdexcept>
+#include <utility>
 #include <vector>
 
 namespace moppe::terrain {
   struct FloodField;
   class LakeCensus;
 
+  // The eight neighbours counter-clockwise from east on the map, each
+  // cardinal followed by the diagonal after it.
+  inline constexpr std::array<CellOffset, 8> compass_neighbours {
+    { { 1, 0 }, { 1, -1 }, { 0, -1 }, { -1, -1 },
+      { -1, 0 }, { -1, 1 }, { 0, 1 }, { 1, 1 } }
+  };
+
+  // D-infinity's triangular facets: the center, one cardinal neighbour and
+  // an adjacent diagonal, named by their slots in compass_neighbours.
+  struct CompassFacet {
+    std::uint8_t cardinal;
+    std::uint8_t diagonal;
+  };
+
+  inline constexpr std::array<CompassFacet, 8> compass_facets {
+    { { 0, 1 }, { 2, 1 }, { 2, 3 }, { 4, 3 },
+      { 4, 5 }, { 6, 5 }, { 6, 7 }, { 0, 7 } }
+  };
+
   // A CellIndex view of TerrainDomain for topology algorithms. It does not
   // describe a second lattice: it retains the same dimensions and spacing
   // while exposing dense cell identifiers and their wrapped neighbourhood.
@@ -45,55 +68,43 @@ namespace moppe::terrain {
     std::optional<CellIndex>
     neighbour (CellIndex index, int columns, int rows) const;
 
+    // All eight neighbours at once, in compass_neighbours order. Kernels
+    // that read the whole ring ask for it here rather than one neighbour
+    // at a time.
+    std::array<std::uint32_t, 8> compass (CellIndex index) const {
+      return m_compass.around (static_cast<std::uint32_t> (offset (index)));
+    }
+
     // A purely topological neighbourhood: every neighbour counts the same,
     // so the influence is a plain weight rather than a metric reading.
     using influence_type = float;
 
     template <typename Visitor>
     void visit_neighbourhood (CellIndex center, Visitor&& visitor) const {
-      constexpr std::array offsets {
-        std::array { 1, 0 },   std::array { 1, -1 }, std::array { 0, -1 },
-        std::array { -1, -1 }, std::array { -1, 0 }, std::array { -1, 1 },
-        std::array { 0, 1 },   std::array { 1, 1 }
-      };
-      for (const auto offset : offsets)
-        if (const auto adjacent = neighbour (center, offset[0], offset[1]))
-          visitor (*adjacent, 1.0f);
+      for (const std::uint32_t adjacent : compass (center))
+        visitor (CellIndex { adjacent }, 1.0f);
     }
 
     // D-infinity evaluates eight triangular facets. Each facet is formed by
     // the center, one cardinal neighbour, and an adjacent diagonal neighbour.
     template <typename Visitor>
     void visit_triangular_facets (CellIndex center, Visitor&& visitor) const {
-      struct FacetOffsets {
-        int cardinal_x;
-        int cardinal_y;
-        int diagonal_x;
-        int diagonal_y;
-      };
-      constexpr std::array facets {
-        FacetOffsets { 1, 0, 1, -1 },   FacetOffsets { 0, -1, 1, -1 },
-        FacetOffsets { 0, -1, -1, -1 }, FacetOffsets { -1, 0, -1, -1 },
-        FacetOffsets { -1, 0, -1, 1 },  FacetOffsets { 0, 1, -1, 1 },
-        FacetOffsets { 0, 1, 1, 1 },    FacetOffsets { 1, 0, 1, 1 }
-      };
-      for (const FacetOffsets facet : facets) {
-        const auto cardinal =
-          neighbour (center, facet.cardinal_x, facet.cardinal_y);
-        const auto diagonal =
-          neighbour (center, facet.diagonal_x, facet.diagonal_y);
-        if (cardinal && diagonal)
-          visitor (*cardinal,
-                   *diagonal,
-                   facet.cardinal_x,
-                   facet.cardinal_y,
-                   facet.diagonal_x,
-                   facet.diagonal_y);
+      const std::array<std::uint32_t, 8> ring = compass (center);
+      for (const CompassFacet facet : compass_facets) {
+        const CellOffset cardinal = compass_neighbours[facet.cardinal];
+        const CellOffset diagonal = compass_neighbours[facet.diagonal];
+        visitor (CellIndex { ring[facet.cardinal] },
+                 CellIndex { ring[facet.diagonal] },
+                 cardinal.columns,
+                 cardinal.rows,
+                 diagonal.columns,
+                 diagonal.rows);
       }
     }
 
   private:
     TerrainDomain m_domain;
+    CellStencil<compass_neighbours> m_compass;
   };
 
   using FlowFraction = mp_units::quantity<flow_fraction[mp_units::one], float>;
@@ -132,15 +143,59 @@ namespace moppe::terrain {
     }
   };
 
+  // A route renumbered into topological positions: its receivers name
+  // positions in the same order, always later ones, rather than cells.
+  struct TopologicalFlowArc {
+    std::uint32_t receiver = 0;
+    FlowFraction fraction = 0.0f * flow_fraction[mp_units::one];
+  };
+
+  struct TopologicalFlowRoute {
+    std::array<TopologicalFlowArc, 2> arcs;
+    std::uint8_t arc_count = 0;
+
+    bool empty () const noexcept {
+      return arc_count == 0;
+    }
+  };
+
   // The directed topology induced by one routing analysis. The stored order
   // runs from donor-free sources toward outlets and is deterministic.
+  //
+  // The domain also keeps its routes renumbered by that order. A pass that
+  // carries something downstream over lattice cells jumps across the whole
+  // grid at every step; over topological positions it reads its inputs in
+  // sequence and only its receiver postings jump, mostly a short way ahead.
+  // gather and scatter move per-cell values between the two numberings.
   class FractionalFlowDomain {
   public:
     using index_type = CellIndex;
 
+    // What a domain keeps, handed back by release so that the next routing
+    // of the lattice can build its domain in the same storage. Positions
+    // and topological routes are derived, so any contents they hold are
+    // overwritten.
+    struct Columns {
+      std::vector<FractionalFlowRoute> routes;
+      std::vector<CellIndex> topological_order;
+      std::vector<std::uint32_t> positions;
+      std::vector<TopologicalFlowRoute> topological_routes;
+    };
+
+    // Throws std::invalid_argument unless the order visits every cell once
+    // and each route leads to cells later in it.
     FractionalFlowDomain (TerrainCellDomain lattice,
                           std::vector<FractionalFlowRoute> routes,
                           std::vector<CellIndex> topological_order);
+    FractionalFlowDomain (TerrainCellDomain lattice, Columns columns);
+
+    // Leaves the domain without routes.
+    Columns release () && noexcept {
+      return { .routes = std::exchange (m_routes, {}),
+               .topological_order = std::exchange (m_topological_order, {}),
+               .positions = std::exchange (m_positions, {}),
+               .topological_routes = std::exchange (m_topological_routes, {}) };
+    }
 
     const TerrainCellDomain& lattice () const noexcept {
       return m_lattice;
@@ -164,6 +219,37 @@ namespace moppe::terrain {
       return m_topological_order;
     }
 
+    // Where a cell falls in the topological order.
+    std::uint32_t position (CellIndex index) const {
+      return m_positions[m_lattice.offset (index)];
+    }
+    // The route of the cell at each position, in positions.
+    std::span<const TopologicalFlowRoute> topological_routes () const noexcept {
+      return m_topological_routes;
+    }
+
+    // ordered[position] = cells[cell at position]
+    template <typename Cells, typename Ordered>
+    void gather (const Cells& cells, Ordered&& ordered) const {
+      if (std::ranges::size (cells) != size () ||
+          std::ranges::size (ordered) != size ())
+        throw std::invalid_argument (
+          "gathered values do not match the flow domain");
+      for (std::size_t position = 0; position < size (); ++position)
+        ordered[position] = cells[m_topological_order[position].value];
+    }
+
+    // cells[cell at position] = ordered[position]
+    template <typename Ordered, typename Cells>
+    void scatter (const Ordered& ordered, Cells&& cells) const {
+      if (std::ranges::size (ordered) != size () ||
+          std::ranges::size (cells) != size ())
+        throw std::invalid_argument (
+          "scattered values do not match the flow domain");
+      for (std::size_t position = 0; position < size (); ++position)
+        cells[m_topological_order[position].value] = ordered[position];
+    }
+
     template <typename Visitor>
     void visit_receivers (CellIndex index, Visitor&& visitor) const {
       const FractionalFlowRoute& flow = route (index);
@@ -175,6 +261,8 @@ namespace moppe::terrain {
     TerrainCellDomain m_lattice;
     std::vector<FractionalFlowRoute> m_routes;
     std::vector<CellIndex> m_topological_order;
+    std::vector<std::uint32_t> m_positions;
+    std::vector<TopologicalFlowRoute> m_topological_routes;
   };
 
   using FractionalDrainage = spatial::Bundle<FractionalFlowDomain,
@@ -215,6 +303,34 @@ namespace moppe::terrain {
                                ChannelPersistence persistence,
                                const FractionalRouteBackend& backend);
 
+  namespace detail {
+    struct FractionalDrainageScratch;
+  }
+
+  // Where the fractional drainage solve keeps its result and scratch between
+  // calls, sized once for one lattice. Each solve builds its flow domain and
+  // columns in the storage the last one left, and routes lake interiors,
+  // orders the routes and carries area downstream in scratch kept here, so
+  // solving the same lattice again allocates nothing. The scratch belongs to
+  // the routing pass and stays out of sight. The returned drainage refers
+  // into the workspace and holds until the next solve in it.
+  struct FractionalDrainageWorkspace {
+    explicit FractionalDrainageWorkspace (const TerrainDomain& domain);
+    ~FractionalDrainageWorkspace ();
+
+    FractionalDrainage drainage;
+    std::unique_ptr<detail::FractionalDrainageScratch> scratch;
+  };
+
+  // Throws std::invalid_argument when the workspace was sized for another
+  // lattice.
+  const FractionalDrainage& analyze_fractional_drainage (
+    FractionalDrainageWorkspace& workspace,
+    const FloodField& flood,
+    const LakeCensus& census,
+    std::span<const ChannelTangent> previous_tangent = {},
+    ChannelPersistence persistence = 0.0f * channel_persistence[mp_units::one]);
+
   // River extraction refined by a D-infinity reading of the same terrain.
   // The single-receiver water graph keeps topological authority over reaches
   // and waterfalls; the fractional columns contribute smoothly varying
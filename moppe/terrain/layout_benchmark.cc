@@ -0,0 +1,171 @@
+#include <moppe/map/surface.hh>
+#include <moppe/terrain/tiled_domain.hh>
+
+#include <bit>
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+
+// Times the same neighbourhood rule over one orogeny surface stored in both
+// terrain orders. Arguments follow terrain-orogeny-benchmark, so a row here
+// lines up with a row of its matrix: the surface is the one that benchmark
+// evolves, and only the storage order of the sweep differs between rows.
+
+namespace {
+  using moppe::terrain::SurfaceElevation;
+
+  // Hillslope relaxation sweeps before a timing is taken: enough that the
+  // neighbourhood rule rather than the conversion dominates a tiled row.
+  constexpr int relaxation_sweeps = 16;
+
+  int parse_positive_int (std::string_view text, const char* name) {
+    std::size_t consumed = 0;
+    const int value = std::stoi (std::string (text), &consumed);
+    if (consumed != text.size () || value <= 0)
+      throw std::invalid_argument (std::string (name) +
+                                   " must be a positive integer");
+    return value;
+  }
+
+  int parse_non_negative_int (std::string_view text, const char* name) {
+    std::size_t consumed = 0;
+    const int value = std::stoi (std::string (text), &consumed);
+    if (consumed != text.size () || value < 0)
+      throw std::invalid_argument (std::string (name) +
+                                   " must be a non-negative integer");
+    return value;
+  }
+
+  // One explicit diffusion sweep. Every site visits its neighbours in the
+  // lattice's own order whatever the storage order, so both layouts produce
+  // the same floats and only their memory traffic differs.
+  template <typename Elevations>
+  void relax (const Elevations& from, Elevations& to) {
+    const auto& domain = from.domain ();
+    const auto& source = moppe::spatial::get<0> (from);
+    auto& target = moppe::spatial::get<0> (to);
+    for (std::size_t offset = 0; offset < domain.size (); ++offset) {
+      const moppe::terrain::TerrainIndex site = domain.index (offset);
+      const float centre = moppe::terrain::surface_elevation_value (
+        source[offset]);
+      float weighted = 0.0f;
+      float weights = 0.0f;
+      domain.visit_neighbourhood (site, [&] (auto neighbour, auto influence) {
+        const float weight = influence.numerical_value_in (
+          mp_units::one / (moppe::u::m * moppe::u::m));
+        weighted += weight * (moppe::terrain::surface_elevation_value (
+                                source[domain.offset (neighbour)]) -
+                              centre);
+        weights += weight;
+      });
+      target[offset] = SurfaceElevation (
+        (centre + 0.25f * weighted / weights) *
+        moppe::terrain::surface_elevation[moppe::u::m]);
+    }
+  }
+
+  template <typename Elevations>
+  double relax_repeatedly (Elevations& elevations) {
+    Elevations scratch (elevations.domain ());
+    const auto start = std::chrono::steady_clock::now ();
+    for (int sweep = 0; sweep < relaxation_sweeps; ++sweep) {
+      relax (elevations, scratch);
+      std::swap (elevations, scratch);
+    }
+    const auto stop = std::chrono::steady_clock::now ();
+    return std::chrono::duration<double, std::milli> (stop - start).count ();
+  }
+
+  template <typename Elevations>
+  std::uint64_t height_hash (const Elevations& elevations) {
+    // FNV-1a in lattice position order, so the two layouts hash alike when
+    // and only when they hold the same heights at the same places.
+    std::uint64_t hash = 14695981039346656037ull;
+    const auto& domain = elevations.domain ();
+    const auto& heights = moppe::spatial::get<0> (elevations);
+    for (std::size_t row = 0; row < domain.height (); ++row)
+      for (std::size_t column = 0; column < domain.width (); ++column) {
+        const float height = moppe::terrain::surface_elevation_value (
+          heights[domain.offset ({ .column = column, .row = row })]);
+        std::uint32_t bits = std::bit_cast<std::uint32_t> (height);
+        for (int byte = 0; byte < 4; ++byte) {
+          hash ^= bits & 0xffu;
+          hash *= 1099511628211ull;
+          bits >>= 8;
+        }
+      }
+    return hash;
+  }
+}
+
+int main (int argc, char** argv) {
+  using namespace moppe;
+  using namespace moppe::terrain;
+  using Elevations = spatial::Bundle<TerrainDomain, SurfaceElevation>;
+
+  try {
+    if (argc < 4 || argc > 6)
+      throw std::invalid_argument ("usage: terrain-layout-benchmark SIZE SEED "
+                                   "STEPS [REPEATS] [TILE]");
+    const int resolution = parse_positive_int (argv[1], "size");
+    const int seed = parse_non_negative_int (argv[2], "seed");
+    const int steps = parse_positive_int (argv[3], "steps");
+    const int repeats = argc >= 5 ? parse_positive_int (argv[4], "repeats") : 1;
+    const int tile = argc >= 6 ? parse_positive_int (argv[5], "tile") : 16;
+    if (resolution < 3)
+      throw std::invalid_argument ("size must be at least three");
+
+    StreamPowerEvolution evolution;
+    evolution.diffusivity = 0.0001f * mp_units::si::metre *
+                            mp_units::si::metre /
+                            mp_units::astronomy::Julian_year;
+    evolution.duration = static_cast<float> (steps) * evolution.time_step;
+    map::SurfaceGeometry surface (TerrainDomain (
+      static_cast<std::size_t> (resolution),
+      static_cast<std::size_t> (resolution),
+      spatial_extent_in_metres (Vec3 (11000.0f, 650.0f, 11000.0f))));
+    const auto uplift = map::initialize_terrain (
+      surface, Seed { static_cast<std::uint32_t> (seed) }, 50.0f * u::m);
+    map::evolve_terrain (surface, uplift, evolution);
+    const Elevations evolved (
+      surface.domain (), spatial::get<surface_elevation> (surface));
+
+    std::cout << "resolution,cells,seed,steps,layout,tile,repeat,"
+                 "convert_ms,elapsed_ms,height_hash\n";
+    const auto report = [&] (const char* layout, int tile_side, int repeat,
+                             double convert_ms, double elapsed_ms,
+                             std::uint64_t hash) {
+      std::cout << resolution << ','
+                << static_cast<std::size_t> (resolution) *
+                     static_cast<std::size_t> (resolution)
+                << ',' << seed << ',' << steps << ',' << layout << ','
+                << tile_side << ',' << repeat << ',' << std::fixed
+                << std::setprecision (3) << convert_ms << ',' << elapsed_ms
+                << ',' << std::hex << hash << std::dec << '\n';
+    };
+    for (int repeat = 0; repeat < repeats; ++repeat) {
+      Elevations row_major = evolved;
+      const double row_major_ms = relax_repeatedly (row_major);
+      report ("row_major", 1, repeat, 0.0, row_major_ms,
+              height_hash (row_major));
+
+      const auto convert_start = std::chrono::steady_clock::now ();
+      auto tiled = retile (evolved, static_cast<std::size_t> (tile));
+      const auto convert_stop = std::chrono::steady_clock::now ();
+      const double tiled_ms = relax_repeatedly (tiled);
+      report ("tiled", tile, repeat,
+              std::chrono::duration<double, std::milli> (convert_stop -
+                                                         convert_start)
+                .count (),
+              tiled_ms, height_hash (tiled));
+    }
+  } catch (const std::exception& error) {
+    std::cerr << "terrain layout benchmark: " << error.what () << '\n';
+    return -1;
+  }
+}
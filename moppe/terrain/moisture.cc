@@ -1,11 +1,11 @@
 #include <moppe/terrain/moisture.hh>
 
 #include <moppe/profile.hh>
+#include <moppe/terrain/distance_transform.hh>
 
 #include <algorithm>
 #include <cmath>
 #include <cstdint>
-#include <queue>
 #include <vector>
 
 namespace moppe::terrain {
@@ -15,50 +15,22 @@ namespace moppe::terrain {
                                 const MoistureParameters& parameters) {
     MOPPE_PROFILE_ZONE ("analyze_moisture");
     const TerrainDomain& grid = flood.domain ();
-    const int width = static_cast<int> (grid.width ());
-    const int height = static_cast<int> (grid.height ());
     const std::size_t count = grid.width () * grid.height ();
-    const float spacing =
-      0.5f * ((grid.spacing_x ()).numerical_value_in (moppe::u::m) +
-              (grid.spacing_z ()).numerical_value_in (moppe::u::m));
 
-    // Multi-source BFS distance (in grid steps) from every standing-water
-    // cell. Grid distance is close enough to metric distance here: the
-    // moisture curve is an exponential falloff, not a measurement.
-    constexpr std::uint16_t far_away = 0xffff;
-    std::vector<std::uint16_t> steps (count, far_away);
-    std::queue<std::uint32_t> frontier;
+    // Exact distance from every standing-water cell, out to the point where
+    // the moisture falloff has long since gone flat; beyond it every site
+    // reads the same.
+    const float far_away_m = 4.0f * parameters.water_reach_m;
+    std::vector<meters_t> distance_from_water;
     {
       MOPPE_PROFILE_ZONE ("moisture.distance_from_water");
+      std::vector<std::uint8_t> standing_water (count);
       for (std::uint32_t cell = 0; cell < count; ++cell)
-        if (water_bodies.body_at (CellIndex { cell }) !=
-              WaterBodyMembership::dry ||
-            flood.ocean[cell]) {
-          steps[cell] = 0;
-          frontier.push (cell);
-        }
-      while (!frontier.empty ()) {
-        const std::uint32_t cell = frontier.front ();
-        frontier.pop ();
-        const int x = static_cast<int> (cell) % width;
-        const int y = static_cast<int> (cell) / width;
-        const std::uint16_t next = steps[cell] + 1;
-        if (next * spacing > 4.0f * parameters.water_reach_m)
-          continue;
-        for (int dy = -1; dy <= 1; ++dy)
-          for (int dx = -1; dx <= 1; ++dx) {
-            if (dx == 0 && dy == 0)
-              continue;
-            const int nx = wrap_index (x + dx, width);
-            const int ny = wrap_index (y + dy, height);
-            const std::uint32_t neighbor =
-              static_cast<std::uint32_t> (ny) * width + nx;
-            if (steps[neighbor] <= next)
-              continue;
-            steps[neighbor] = next;
-            frontier.push (neighbor);
-          }
-      }
+        standing_water[cell] = water_bodies.body_at (CellIndex { cell }) !=
+                                   WaterBodyMembership::dry ||
+                                 flood.ocean[cell];
+      distance_from_water =
+        distance_to_sources (grid, standing_water, far_away_m * u::m);
     }
 
     const float cell_area =
@@ -68,9 +40,8 @@ namespace moppe::terrain {
     {
       MOPPE_PROFILE_ZONE ("moisture.combine_water_and_drainage");
       for (std::size_t cell = 0; cell < count; ++cell) {
-        const float distance = steps[cell] == far_away
-                                 ? 4.0f * parameters.water_reach_m
-                                 : steps[cell] * spacing;
+        const float distance = std::min (
+          distance_from_water[cell].numerical_value_in (u::m), far_away_m);
         const float near_water =
           std::exp (-distance / parameters.water_reach_m);
         const float area =
@@ -2,7 +2,21 @@
 
 #include <algorithm>
 #include <array>
+#include <bit>
+#include <cmath>
 #include <random>
+#include <stdexcept>
+
+// Row evaluation is written once over a lane count and instantiated for the
+// widths this build can dispatch to. On x86-64 the same template is compiled
+// a second time for AVX2 and chosen when the processor has it; everywhere
+// else the baseline vector unit is the only width. Neither build enables
+// FMA, so the wider lanes contract nothing the narrow ones do not.
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define MOPPE_NOISE_AVX2 1
+#else
+#define MOPPE_NOISE_AVX2 0
+#endif
 
 namespace moppe::terrain {
   namespace {
@@ -42,4 +56,331 @@ namespace moppe::terrain {
         shuffled[static_cast<std::size_t> (i & 255)];
     return result;
   }
+
+  namespace {
+    // The noise below is written so that each lane-wise pass compiles to
+    // straight vector code on a compiler that keeps floating-point traps
+    // precise: such a compiler will not widen std::floor, a floating-point
+    // comparison, or a select that depends on one. Floors, clamps and signs
+    // are worked on integers and bit patterns instead. Every lattice
+    // coordinate a sum reaches is far inside int.
+
+    // std::floor of a place, as a lattice cell. A negative zero must have
+    // been made positive first, which adding zero does.
+    int perlin_cell (float place) {
+      const std::int32_t whole = static_cast<std::int32_t> (place);
+      const std::int32_t bits = std::bit_cast<std::int32_t> (place);
+      const std::int32_t truncated =
+        std::bit_cast<std::int32_t> (static_cast<float> (whole));
+      // Truncation rounded a negative fraction up: step back one cell.
+      const std::int32_t rounded_up = (bits >> 31) & (truncated != bits);
+      return whole - rounded_up;
+    }
+
+    // value mod period, in [0, period), without an integer division. The
+    // truncated double quotient is within one of the floored one for every
+    // int, so one correction either way leaves the exact remainder.
+    int wrap_perlin_cell (int value, int period, double inverse_period) {
+      int wrapped = value - period * static_cast<int> (
+                                       static_cast<double> (value) *
+                                       inverse_period);
+      wrapped += wrapped < 0 ? period : 0;
+      wrapped -= wrapped >= period ? period : 0;
+      return wrapped;
+    }
+
+    float perlin_fade (float value) {
+      return value * value * value * (value * (value * 6.0f - 15.0f) + 10.0f);
+    }
+
+    float perlin_lerp (float a, float b, float amount) {
+      return a + amount * (b - a);
+    }
+
+    float flip_sign (float value, int flip) {
+      return std::bit_cast<float> (std::bit_cast<std::uint32_t> (value) ^
+                                   (static_cast<std::uint32_t> (flip) << 31));
+    }
+
+    float choose (int which, float first, float second) {
+      const std::uint32_t mask = 0u - static_cast<std::uint32_t> (which);
+      return std::bit_cast<float> (
+        (std::bit_cast<std::uint32_t> (second) & mask) |
+        (std::bit_cast<std::uint32_t> (first) & ~mask));
+    }
+
+    // The eight Perlin gradients as sign flips and selects rather than a
+    // switch, so a lane of them compiles to blends. Each case is the same
+    // single addition or negation it always was: x + (-y) rounds exactly as
+    // x - y does.
+    float perlin_gradient (int hash, float x, float y) {
+      const int negate_first = (hash >> 1) & 1;
+      const int negate_second = hash & 1;
+      const float single =
+        flip_sign (choose (negate_first, x, y), negate_second);
+      const float pair =
+        flip_sign (x, negate_first) + flip_sign (y, negate_second);
+      return choose ((hash >> 2) & 1, pair, single);
+    }
+
+    // The next octave's weight, clamped to [0, 1]. A ridge is never
+    // negative, not even a negative zero, and non-negative floats order as
+    // their bit patterns do.
+    float ridge_weight (float ridge) {
+      const float doubled = ridge * 2.0f;
+      return std::bit_cast<std::int32_t> (doubled) <
+                 std::bit_cast<std::int32_t> (1.0f)
+               ? doubled
+               : 1.0f;
+    }
+
+    // One octave at Lanes positions. Everything but the permutation lookups
+    // is plain lane-wise arithmetic the compiler widens; the lookups are a
+    // pass of their own, gathers where the vector unit has them.
+    template <std::size_t Lanes>
+    void gradient_noise (const PerlinPermutation& permutation,
+                         const float* x,
+                         const float* y,
+                         int period,
+                         float* out) {
+      std::array<int, Lanes> cell_x, cell_y;
+      std::array<float, Lanes> xf, yf, u, v;
+      for (std::size_t lane = 0; lane < Lanes; ++lane) {
+        const float place_x = x[lane] + 0.0f;
+        const float place_y = y[lane] + 0.0f;
+        cell_x[lane] = perlin_cell (place_x);
+        cell_y[lane] = perlin_cell (place_y);
+        xf[lane] = place_x - static_cast<float> (cell_x[lane]);
+        yf[lane] = place_y - static_cast<float> (cell_y[lane]);
+        u[lane] = perlin_fade (xf[lane]);
+        v[lane] = perlin_fade (yf[lane]);
+      }
+
+      // The lattice wraps on the octave's period and then on the table's 256
+      // entries; the cell after the last in a period is the first again.
+      const double inverse_period = 1.0 / static_cast<double> (period);
+      std::array<int, Lanes> xi, yi, xj, yj;
+      for (std::size_t lane = 0; lane < Lanes; ++lane) {
+        const int column =
+          wrap_perlin_cell (cell_x[lane], period, inverse_period);
+        const int row = wrap_perlin_cell (cell_y[lane], period, inverse_period);
+        const int next_column = column + 1 == period ? 0 : column + 1;
+        const int next_row = row + 1 == period ? 0 : row + 1;
+        xi[lane] = column & 255;
+        yi[lane] = row & 255;
+        xj[lane] = next_column & 255;
+        yj[lane] = next_row & 255;
+      }
+
+      std::array<int, Lanes> aa, ab, ba, bb;
+      for (std::size_t lane = 0; lane < Lanes; ++lane) {
+        const int left = permutation[xi[lane]];
+        const int right = permutation[xj[lane]];
+        aa[lane] = permutation[left + yi[lane]];
+        ab[lane] = permutation[left + yj[lane]];
+        ba[lane] = permutation[right + yi[lane]];
+        bb[lane] = permutation[right + yj[lane]];
+      }
+
+      for (std::size_t lane = 0; lane < Lanes; ++lane) {
+        const float x0 = xf[lane];
+        const float y0 = yf[lane];
+        out[lane] = perlin_lerp (
+          perlin_lerp (perlin_gradient (aa[lane], x0, y0),
+                       perlin_gradient (ba[lane], x0 - 1.0f, y0),
+                       u[lane]),
+          perlin_lerp (perlin_gradient (ab[lane], x0, y0 - 1.0f),
+                       perlin_gradient (bb[lane], x0 - 1.0f, y0 - 1.0f),
+                       u[lane]),
+          v[lane]);
+      }
+    }
+
+    template <std::size_t Lanes>
+    void fbm_block (const PerlinPermutation& permutation,
+                    const float* x,
+                    const float* y,
+                    const NoiseShape& shape,
+                    float* out) {
+      std::array<float, Lanes> sum {}, octave_x, octave_y, value;
+      float amplitude = 1.0f;
+      float norm = 0.0f;
+      float frequency = 1.0f;
+      int period = shape.cycles;
+      for (int octave = 0; octave < shape.octaves; ++octave) {
+        for (std::size_t lane = 0; lane < Lanes; ++lane) {
+          octave_x[lane] = x[lane] * frequency;
+          octave_y[lane] = y[lane] * frequency;
+        }
+        gradient_noise<Lanes> (permutation,
+                               octave_x.data (),
+                               octave_y.data (),
+                               period,
+                               value.data ());
+        for (std::size_t lane = 0; lane < Lanes; ++lane)
+          sum[lane] += amplitude * value[lane];
+        norm += amplitude;
+        amplitude *= shape.gain;
+        frequency *= static_cast<float> (shape.lacunarity);
+        period *= shape.lacunarity;
+      }
+      for (std::size_t lane = 0; lane < Lanes; ++lane)
+        out[lane] = sum[lane] / norm;
+    }
+
+    template <std::size_t Lanes>
+    void ridged_block (const PerlinPermutation& permutation,
+                       const float* x,
+                       const float* y,
+                       const NoiseShape& shape,
+                       float* out) {
+      std::array<float, Lanes> sum {}, octave_x, octave_y, value;
+      std::array<float, Lanes> weight;
+      weight.fill (1.0f);
+      float amplitude = 0.5f;
+      float frequency = 1.0f;
+      float norm = 0.0f;
+      int period = shape.cycles;
+      for (int octave = 0; octave < shape.octaves; ++octave) {
+        for (std::size_t lane = 0; lane < Lanes; ++lane) {
+          octave_x[lane] = x[lane] * frequency;
+          octave_y[lane] = y[lane] * frequency;
+        }
+        gradient_noise<Lanes> (permutation,
+                               octave_x.data (),
+                               octave_y.data (),
+                               period,
+                               value.data ());
+        for (std::size_t lane = 0; lane < Lanes; ++lane) {
+          float ridge = 1.0f - std::fabs (value[lane]);
+          ridge *= ridge;
+          ridge *= weight[lane];
+          weight[lane] = ridge_weight (ridge);
+          sum[lane] += ridge * amplitude;
+        }
+        norm += amplitude;
+        amplitude *= shape.gain;
+        frequency *= static_cast<float> (shape.lacunarity);
+        period *= shape.lacunarity;
+      }
+      for (std::size_t lane = 0; lane < Lanes; ++lane)
+        out[lane] = sum[lane] / norm;
+    }
+
+    enum class FractalSum { Fbm, Ridged };
+
+    // Whole blocks at the dispatched width, then any remainder one position
+    // at a time through the same arithmetic.
+    template <std::size_t Lanes>
+    void evaluate_row (const PerlinPermutation& permutation,
+                       FractalSum sum,
+                       const float* x,
+                       const float* y,
+                       const NoiseShape& shape,
+                       float* out,
+                       std::size_t count) {
+      std::size_t first = 0;
+      if (sum == FractalSum::Fbm) {
+        for (; first + Lanes <= count; first += Lanes)
+          fbm_block<Lanes> (
+            permutation, x + first, y + first, shape, out + first);
+        for (; first < count; ++first)
+          fbm_block<1> (permutation, x + first, y + first, shape, out + first);
+      } else {
+        for (; first + Lanes <= count; first += Lanes)
+          ridged_block<Lanes> (
+            permutation, x + first, y + first, shape, out + first);
+        for (; first < count; ++first)
+          ridged_block<1> (
+            permutation, x + first, y + first, shape, out + first);
+      }
+    }
+
+    constexpr std::size_t baseline_lanes = 8;
+
+#if MOPPE_NOISE_AVX2
+    constexpr std::size_t avx2_lanes = 16;
+
+    [[gnu::target ("avx2"), gnu::flatten]] void
+    evaluate_row_avx2 (const PerlinPermutation& permutation,
+                       FractalSum sum,
+                       const float* x,
+                       const float* y,
+                       const NoiseShape& shape,
+                       float* out,
+                       std::size_t count) {
+      evaluate_row<avx2_lanes> (permutation, sum, x, y, shape, out, count);
+    }
+
+    bool has_avx2 () {
+      static const bool available = __builtin_cpu_supports ("avx2");
+      return available;
+    }
+#endif
+
+    void dispatch_row (const PerlinPermutation& permutation,
+                       FractalSum sum,
+                       std::span<const float> x,
+                       std::span<const float> y,
+                       const NoiseShape& shape,
+                       std::span<float> out) {
+      if (x.size () != out.size () || y.size () != out.size ())
+        throw std::invalid_argument ("noise row spans differ in length");
+#if MOPPE_NOISE_AVX2
+      if (has_avx2 ())
+        return evaluate_row_avx2 (permutation,
+                                  sum,
+                                  x.data (),
+                                  y.data (),
+                                  shape,
+                                  out.data (),
+                                  out.size ());
+#endif
+      evaluate_row<baseline_lanes> (permutation,
+                                    sum,
+                                    x.data (),
+                                    y.data (),
+                                    shape,
+                                    out.data (),
+                                    out.size ());
+    }
+  }
+
+  PeriodicNoise::PeriodicNoise (std::uint32_t seed)
+      : m_permutation (make_perlin_permutation (seed)) {}
+
+  float PeriodicNoise::fbm (float x, float y, const NoiseShape& shape) const {
+    float value;
+    fbm_block<1> (m_permutation, &x, &y, shape, &value);
+    return value;
+  }
+
+  float
+  PeriodicNoise::ridged (float x, float y, const NoiseShape& shape) const {
+    float value;
+    ridged_block<1> (m_permutation, &x, &y, shape, &value);
+    return value;
+  }
+
+  void PeriodicNoise::fbm (std::span<const float> x,
+                           std::span<const float> y,
+                           const NoiseShape& shape,
+                           std::span<float> out) const {
+    dispatch_row (m_permutation, FractalSum::Fbm, x, y, shape, out);
+  }
+
+  void PeriodicNoise::ridged (std::span<const float> x,
+                              std::span<const float> y,
+                              const NoiseShape& shape,
+                              std::span<float> out) const {
+    dispatch_row (m_permutation, FractalSum::Ridged, x, y, shape, out);
+  }
+
+  std::size_t periodic_noise_lanes () {
+#if MOPPE_NOISE_AVX2
+    if (has_avx2 ())
+      return avx2_lanes;
+#endif
+    return baseline_lanes;
+  }
 }
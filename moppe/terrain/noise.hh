@@ -2,7 +2,9 @@
 #define MOPPE_TERRAIN_NOISE_HH
 
 #include <array>
+#include <cstddef>
 #include <cstdint>
+#include <span>
 
 namespace moppe::terrain {
   using PerlinPermutation = std::array<std::int32_t, 512>;
@@ -11,6 +13,48 @@ namespace moppe::terrain {
   // Keeping this host-side step common makes CPU and GPU noise differ only
   // in floating-point evaluation, not in their seeded lattice.
   PerlinPermutation make_perlin_permutation (std::uint32_t seed);
+
+  // A fractal sum: `cycles` lattice cells per lap at the first octave, each
+  // octave `lacunarity` times finer and `gain` times quieter than the last.
+  struct NoiseShape {
+    int cycles;
+    int octaves;
+    int lacunarity;
+    float gain;
+  };
+
+  // Perlin gradient noise over one seeded permutation, wrapping on the
+  // shape's period so a sum meets itself at the seam of the torus.
+  //
+  // A row call evaluates many positions a vector register at a time and
+  // answers exactly the bits its positions would one by one: both run the
+  // same arithmetic in the same order, lane by lane. Only the batching
+  // differs between machines, never the result, so a world generated on
+  // one processor is the world any other generates.
+  class PeriodicNoise {
+  public:
+    explicit PeriodicNoise (std::uint32_t seed);
+
+    float fbm (float x, float y, const NoiseShape& shape) const;
+    float ridged (float x, float y, const NoiseShape& shape) const;
+
+    // out[i] is the point answer at (x[i], y[i]); all three spans have the
+    // same length.
+    void fbm (std::span<const float> x,
+              std::span<const float> y,
+              const NoiseShape& shape,
+              std::span<float> out) const;
+    void ridged (std::span<const float> x,
+                 std::span<const float> y,
+                 const NoiseShape& shape,
+                 std::span<float> out) const;
+
+  private:
+    PerlinPermutation m_permutation;
+  };
+
+  // How many positions a row call evaluates together on this processor.
+  std::size_t periodic_noise_lanes ();
 }
 
 #endif
@@ -1,13 +1,19 @@
+#include <moppe/game/world_batch.hh>
 #include <moppe/map/surface.hh>
+#include <moppe/memory.hh>
 
-#include <bit>
+#include <algorithm>
 #include <chrono>
+#include <cmath>
 #include <cstdint>
 #include <iomanip>
 #include <iostream>
+#include <optional>
 #include <stdexcept>
 #include <string>
 #include <string_view>
+#include <utility>
+#include <vector>
 
 namespace {
   int parse_positive_int (std::string_view text, const char* name) {
@@ -28,23 +34,30 @@ namespace {
     return value;
   }
 
-  std::uint64_t height_hash (const moppe::map::SurfaceGeometry& surface) {
-    // FNV-1a over the exact float representation makes benchmark output a
-    // cheap numerical-regression ledger as well as a timing record.
-    std::uint64_t hash = 14695981039346656037ull;
-    const std::size_t count = surface.domain ().size ();
-    const auto& elevations =
+  // How far a coarse-to-fine world ends from the same world evolved wholly
+  // at full resolution: root-mean-square and largest height difference.
+  std::pair<double, double>
+  height_drift (const moppe::map::SurfaceGeometry& surface,
+                const moppe::map::SurfaceGeometry& reference) {
+    const auto& heights =
       moppe::spatial::get<moppe::terrain::surface_elevation> (surface);
+    const auto& expected =
+      moppe::spatial::get<moppe::terrain::surface_elevation> (reference);
+    const std::size_t count = surface.domain ().size ();
+    double squares = 0.0;
+    double largest = 0.0;
     for (std::size_t cell = 0; cell < count; ++cell) {
-      std::uint32_t bits = std::bit_cast<std::uint32_t> (
-        moppe::terrain::surface_elevation_value (elevations[cell]));
-      for (int byte = 0; byte < 4; ++byte) {
-        hash ^= bits & 0xffu;
-        hash *= 1099511628211ull;
-        bits >>= 8;
-      }
+      const double difference =
+        moppe::terrain::surface_elevation_value (heights[cell]) -
+        moppe::terrain::surface_elevation_value (expected[cell]);
+      squares += difference * difference;
+      largest = std::max (largest, std::abs (difference));
     }
-    return hash;
+    return { std::sqrt (squares / static_cast<double> (count)), largest };
+  }
+
+  double megabytes (std::size_t bytes) {
+    return static_cast<double> (bytes) / double (1 << 20);
   }
 }
 
@@ -53,13 +66,20 @@ int main (int argc, char** argv) {
   using namespace moppe::terrain;
 
   try {
-    if (argc < 4 || argc > 5)
+    if (argc < 4 || argc > 7)
       throw std::invalid_argument (
-        "usage: terrain-orogeny-benchmark SIZE SEED STEPS [REPEATS]");
+        "usage: terrain-orogeny-benchmark SIZE SEED STEPS [REPEATS] "
+        "[COARSE_LEVELS] [FINE_STEPS]");
     const int resolution = parse_positive_int (argv[1], "size");
     const int seed = parse_non_negative_int (argv[2], "seed");
     const int steps = parse_positive_int (argv[3], "steps");
     const int repeats = argc >= 5 ? parse_positive_int (argv[4], "repeats") : 1;
+    CoarseToFineEvolution coarse_to_fine;
+    if (argc >= 6)
+      coarse_to_fine.coarse_levels =
+        parse_non_negative_int (argv[5], "coarse levels");
+    if (argc >= 7)
+      coarse_to_fine.fine_steps = parse_positive_int (argv[6], "fine steps");
     if (resolution < 3)
       throw std::invalid_argument ("size must be at least three");
 
@@ -70,33 +90,55 @@ int main (int argc, char** argv) {
     evolution.duration = static_cast<float> (steps) * evolution.time_step;
     const Seed terrain_seed { static_cast<std::uint32_t> (seed) };
 
-    std::cout << "resolution,cells,seed,steps,repeat,"
+    // A coarse-to-fine run is measured against the full-resolution run of
+    // the same world, which is timed and printed first.
+    std::vector<CoarseToFineEvolution> schedules { CoarseToFineEvolution {} };
+    if (coarse_to_fine.enabled ())
+      schedules.push_back (coarse_to_fine);
+
+    std::cout << "resolution,cells,seed,steps,coarse_levels,fine_steps,repeat,"
                  "elapsed_ms,height_hash,final_mean_change_m,"
-                 "final_max_change_m\n";
+                 "final_max_change_m,rms_drift_m,max_drift_m,"
+                 "transient_peak_mb,resident_peak_mb\n";
     for (int repeat = 0; repeat < repeats; ++repeat) {
-      map::SurfaceGeometry surface (TerrainDomain (
-        static_cast<std::size_t> (resolution),
-        static_cast<std::size_t> (resolution),
-        spatial_extent_in_metres (Vec3 (11000.0f, 650.0f, 11000.0f))));
-      const auto uplift =
-        map::initialize_terrain (surface, terrain_seed, 50.0f * u::m);
-      const auto start = std::chrono::steady_clock::now ();
-      const StreamPowerEvolutionReport report =
-        map::evolve_terrain (surface, uplift, evolution);
-      const auto stop = std::chrono::steady_clock::now ();
-      const double elapsed_ms =
-        std::chrono::duration<double, std::milli> (stop - start).count ();
+      std::optional<map::SurfaceGeometry> reference;
+      for (const CoarseToFineEvolution& schedule : schedules) {
+        map::SurfaceGeometry surface (TerrainDomain (
+          static_cast<std::size_t> (resolution),
+          static_cast<std::size_t> (resolution),
+          spatial_extent_in_metres (Vec3 (11000.0f, 650.0f, 11000.0f))));
+        const auto uplift =
+          map::initialize_terrain (surface, terrain_seed, 50.0f * u::m);
+        evolution.coarse_to_fine = schedule;
+        memory::reset_transient_peak ();
+        const auto start = std::chrono::steady_clock::now ();
+        const StreamPowerEvolutionReport report =
+          map::evolve_terrain (surface, uplift, evolution);
+        const auto stop = std::chrono::steady_clock::now ();
+        const double elapsed_ms =
+          std::chrono::duration<double, std::milli> (stop - start).count ();
+        const auto [rms_drift, max_drift] =
+          reference ? height_drift (surface, *reference)
+                    : std::pair<double, double> {};
 
-      std::cout << resolution << ','
-                << static_cast<std::size_t> (resolution) *
-                     static_cast<std::size_t> (resolution)
-                << ',' << seed << ',' << steps << ',' << repeat << ','
-                << std::fixed << std::setprecision (3) << elapsed_ms << ","
-                << std::hex << height_hash (surface) << std::dec << ','
-                << report.final_step_mean_change.numerical_value_in (u::m)
-                << ','
-                << report.final_step_maximum_change.numerical_value_in (u::m)
-                << '\n';
+        std::cout << resolution << ','
+                  << static_cast<std::size_t> (resolution) *
+                       static_cast<std::size_t> (resolution)
+                  << ',' << seed << ',' << steps << ','
+                  << schedule.coarse_levels << ',' << schedule.fine_steps
+                  << ',' << repeat << ',' << std::fixed
+                  << std::setprecision (3) << elapsed_ms << "," << std::hex
+                  << game::elevation_hash (surface) << std::dec << ','
+                  << report.final_step_mean_change.numerical_value_in (u::m)
+                  << ','
+                  << report.final_step_maximum_change.numerical_value_in (u::m)
+                  << ',' << rms_drift << ',' << max_drift << ','
+                  << megabytes (memory::transient_peak_bytes ()) << ','
+                  << megabytes (memory::resident_memory ().peak_bytes)
+                  << '\n';
+        if (!reference)
+          reference = std::move (surface);
+      }
     }
   } catch (const std::exception& error) {
     std::cerr << "terrain orogeny benchmark: " << error.what () << '\n';
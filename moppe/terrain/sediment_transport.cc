@@ -6,6 +6,7 @@
 #include <limits>
 #include <numeric>
 #include <stdexcept>
+#include <utility>
 #include <vector>
 
 #include <mp-units/math.h>
@@ -175,18 +176,6 @@ namespace moppe::terrain {
             "water-body storage must be finite and non-negative");
       }
 
-      std::vector<std::size_t> position (count);
-      std::vector<std::uint8_t> seen (count);
-      const auto order = flow.topological_order ();
-      for (std::size_t i = 0; i < order.size (); ++i) {
-        const std::size_t cell = order[i].value;
-        if (cell >= count || seen[cell])
-          throw std::invalid_argument (
-            "sediment routing requires a complete topological order");
-        seen[cell] = 1;
-        position[cell] = i;
-      }
-
       for (std::size_t cell = 0; cell < count; ++cell) {
         const double potential =
           sediment_volume_value (potential_detachment[cell]);
@@ -214,21 +203,17 @@ namespace moppe::terrain {
           throw std::invalid_argument (
             "sediment water-body identifier is outside storage domain");
 
+        // The flow domain has already checked that every route leads
+        // downstream through its topological order.
         const FractionalFlowRoute& route =
           flow.route (CellIndex { static_cast<std::uint32_t> (cell) });
-        if (route.arc_count > route.arcs.size ())
-          throw std::invalid_argument (
-            "sediment route has too many receiver arcs");
-
         double fraction_total = 0.0;
         for (std::uint8_t arc = 0; arc < route.arc_count; ++arc) {
-          const std::size_t receiver = route.arcs[arc].receiver.value;
           const double fraction =
             route.arcs[arc].fraction.numerical_value_in (mp_units::one);
-          if (receiver >= count || position[receiver] <= position[cell] ||
-              !std::isfinite (fraction) || fraction < 0.0)
+          if (!std::isfinite (fraction) || fraction < 0.0)
             throw std::invalid_argument (
-              "sediment route is not a valid drainage DAG");
+              "sediment receiver fractions must be finite and non-negative");
           fraction_total += fraction;
         }
         if (route.arc_count != 0 && std::abs (fraction_total - 1.0) > 1e-5)
@@ -280,7 +265,50 @@ namespace moppe::terrain {
            mp_units::si::metre;
   }
 
+  void SedimentWorkspace::reserve (const TerrainDomain& domain) {
+    const std::size_t count = domain.size ();
+    for (std::vector<SedimentVolume>* column :
+         { &storage.ocean_mouth_capacity,
+           &routing.detached,
+           &routing.entrained_cover,
+           &routing.bedrock_detached,
+           &routing.deposited,
+           &routing.outgoing,
+           &standing.dry_centerline,
+           &standing.deposited,
+           &lateral.deposited })
+      column->reserve (count);
+    for (std::vector<SedimentThickness>* column :
+         { &hillslope.sediment_thickness,
+           &hillslope.eroded_thickness,
+           &hillslope.deposited_thickness })
+      column->reserve (count);
+    hillslope.heights.reserve (count);
+    routing_cells.reserve (count);
+    for (std::vector<double>& column : scratch)
+      column.reserve (count);
+    body_cells.reserve (count);
+    footprint_position.reserve (count);
+  }
+
   StandingWaterStorage standing_water_storage_capacity (
+    const FloodField& flood,
+    const LakeCensus& census,
+    std::span<const FractionalContributingArea> contributing_areas,
+    std::span<const SedimentVolume> maximum_deposition,
+    const ValleyDeposition& parameters) {
+    SedimentWorkspace workspace;
+    standing_water_storage_capacity (workspace,
+                                     flood,
+                                     census,
+                                     contributing_areas,
+                                     maximum_deposition,
+                                     parameters);
+    return std::move (workspace.storage);
+  }
+
+  const StandingWaterStorage& standing_water_storage_capacity (
+    SedimentWorkspace& workspace,
     const FloodField& flood,
     const LakeCensus& census,
     std::span<const FractionalContributingArea> contributing_areas,
@@ -292,8 +320,10 @@ namespace moppe::terrain {
       throw std::invalid_argument (
         "standing-water capacity inputs do not share a domain");
 
-    std::vector<double> body_capacity_m3 (census.domain ().size ());
-    std::vector<double> ocean_capacity_m3 (count);
+    std::vector<double>& body_capacity_m3 = workspace.body_scratch[0];
+    std::vector<double>& ocean_capacity_m3 = workspace.scratch[0];
+    body_capacity_m3.assign (census.domain ().size (), 0.0);
+    ocean_capacity_m3.assign (count, 0.0);
     const double cell_area_m2 =
       flood.domain ().cell_area ().numerical_value_in (mp_units::si::metre *
                                                        mp_units::si::metre);
@@ -325,10 +355,12 @@ namespace moppe::terrain {
       }
     }
 
-    StandingWaterStorage result;
+    StandingWaterStorage& result = workspace.storage;
+    result.body_capacity.clear ();
     result.body_capacity.reserve (body_capacity_m3.size ());
     for (const double capacity_m3 : body_capacity_m3)
       result.body_capacity.push_back (sediment_volume_from (capacity_m3));
+    result.ocean_mouth_capacity.clear ();
     result.ocean_mouth_capacity.reserve (count);
     for (const double capacity_m3 : ocean_capacity_m3)
       result.ocean_mouth_capacity.push_back (
@@ -346,6 +378,31 @@ namespace moppe::terrain {
                   std::span<const WaterBodyId> water_body,
                   std::span<const SedimentVolume> body_storage_capacity,
                   std::span<const SedimentVolume> ocean_mouth_capacity) {
+    SedimentWorkspace workspace;
+    route_sediment (workspace,
+                    flow,
+                    potential_detachment,
+                    transport_capacity,
+                    maximum_deposition,
+                    ocean,
+                    available_cover,
+                    water_body,
+                    body_storage_capacity,
+                    ocean_mouth_capacity);
+    return std::move (workspace.routing);
+  }
+
+  const SedimentRoutingResult&
+  route_sediment (SedimentWorkspace& workspace,
+                  const FractionalFlowDomain& flow,
+                  std::span<const SedimentVolume> potential_detachment,
+                  std::span<const SedimentVolume> transport_capacity,
+                  std::span<const SedimentVolume> maximum_deposition,
+                  std::span<const std::uint8_t> ocean,
+                  std::span<const SedimentVolume> available_cover,
+                  std::span<const WaterBodyId> water_body,
+                  std::span<const SedimentVolume> body_storage_capacity,
+                  std::span<const SedimentVolume> ocean_mouth_capacity) {
     validate_sediment_routing (flow,
                                potential_detachment,
                                transport_capacity,
@@ -357,87 +414,112 @@ namespace moppe::terrain {
                                ocean_mouth_capacity);
 
     const std::size_t count = flow.size ();
-    std::vector<double> incoming (count);
-    SedimentRoutingResult result {
-      .detached = std::vector<SedimentVolume> (count, SedimentVolume::zero ()),
-      .entrained_cover =
-        std::vector<SedimentVolume> (count, SedimentVolume::zero ()),
-      .bedrock_detached =
-        std::vector<SedimentVolume> (count, SedimentVolume::zero ()),
-      .deposited = std::vector<SedimentVolume> (count, SedimentVolume::zero ()),
-      .outgoing = std::vector<SedimentVolume> (count, SedimentVolume::zero ())
-    };
+    SedimentRoutingResult& result = workspace.routing;
+    result.detached.assign (count, SedimentVolume::zero ());
+    result.entrained_cover.assign (count, SedimentVolume::zero ());
+    result.bedrock_detached.assign (count, SedimentVolume::zero ());
+    result.deposited.assign (count, SedimentVolume::zero ());
+    result.outgoing.assign (count, SedimentVolume::zero ());
+
+    // Everything the downstream pass reads, gathered once into topological
+    // order so that the pass itself streams through it; incoming sediment
+    // is posted by position too.
+    const std::span<const CellIndex> order = flow.topological_order ();
+    const std::span<const TopologicalFlowRoute> routes =
+      flow.topological_routes ();
+    std::vector<detail::SedimentRoutingCell>& cells = workspace.routing_cells;
+    cells.resize (count);
+    for (std::size_t position = 0; position < count; ++position) {
+      const std::size_t cell = order[position].value;
+      cells[position] = {
+        .potential_detachment =
+          sediment_volume_value (potential_detachment[cell]),
+        .transport_capacity = sediment_volume_value (transport_capacity[cell]),
+        .maximum_deposition = sediment_volume_value (maximum_deposition[cell]),
+        .cover = available_cover.empty ()
+                   ? 0.0
+                   : sediment_volume_value (available_cover[cell]),
+        .ocean_mouth_capacity =
+          ocean_mouth_capacity.empty ()
+            ? 0.0
+            : sediment_volume_value (ocean_mouth_capacity[cell]),
+        .body = water_body.empty () ? no_water_body : water_body[cell],
+        .ocean = ocean[cell] != 0,
+      };
+    }
+    std::vector<double>& incoming = workspace.scratch[0];
+    incoming.assign (count, 0.0);
 
     double detached_total = 0.0;
     double entrained_cover_total = 0.0;
     double bedrock_detached_total = 0.0;
     double deposited_total = 0.0;
     double exported_total = 0.0;
-    std::vector<double> remaining_body_storage;
+    std::vector<double>& remaining_body_storage = workspace.body_scratch[0];
+    remaining_body_storage.clear ();
     remaining_body_storage.reserve (body_storage_capacity.size ());
     for (const SedimentVolume capacity : body_storage_capacity)
       remaining_body_storage.push_back (sediment_volume_value (capacity));
 
-    for (const CellIndex index : flow.topological_order ()) {
-      const std::size_t cell = index.value;
-      const FractionalFlowRoute& route = flow.route (index);
+    const auto post_downstream = [&] (const TopologicalFlowRoute& route,
+                                      double outgoing) {
+      double posted = 0.0;
+      for (std::uint8_t arc = 0; arc < route.arc_count; ++arc) {
+        // Make the final posting the exact remainder. Independently rounding
+        // every arc would slowly manufacture or destroy sediment at splits.
+        const double share =
+          arc + 1 == route.arc_count
+            ? outgoing - posted
+            : outgoing *
+                route.arcs[arc].fraction.numerical_value_in (mp_units::one);
+        incoming[route.arcs[arc].receiver] += share;
+        posted += share;
+      }
+    };
+
+    for (std::size_t position = 0; position < count; ++position) {
+      const std::size_t cell = order[position].value;
+      const detail::SedimentRoutingCell& reading = cells[position];
+      const TopologicalFlowRoute& route = routes[position];
+      const double arriving = incoming[position];
 
-      if (ocean[cell]) {
+      if (reading.ocean) {
         const double deposited =
-          ocean_mouth_capacity.empty ()
-            ? 0.0
-            : std::min (incoming[cell],
-                        sediment_volume_value (ocean_mouth_capacity[cell]));
+          std::min (arriving, reading.ocean_mouth_capacity);
         result.deposited[cell] = sediment_volume_from (deposited);
         deposited_total += deposited;
-        exported_total += incoming[cell] - deposited;
+        exported_total += arriving - deposited;
         continue;
       }
 
-      const WaterBodyId body =
-        water_body.empty () ? no_water_body : water_body[cell];
-      if (body != no_water_body && !route.empty ()) {
+      if (reading.body != no_water_body && !route.empty ()) {
         const double deposited =
-          std::min (incoming[cell], remaining_body_storage[body.value]);
-        remaining_body_storage[body.value] -= deposited;
-        const double outgoing = incoming[cell] - deposited;
+          std::min (arriving, remaining_body_storage[reading.body.value]);
+        remaining_body_storage[reading.body.value] -= deposited;
+        const double outgoing = arriving - deposited;
         result.deposited[cell] = sediment_volume_from (deposited);
         result.outgoing[cell] = sediment_volume_from (outgoing);
         deposited_total += deposited;
-
-        double posted = 0.0;
-        for (std::uint8_t arc = 0; arc < route.arc_count; ++arc) {
-          const double share =
-            arc + 1 == route.arc_count
-              ? outgoing - posted
-              : outgoing *
-                  route.arcs[arc].fraction.numerical_value_in (mp_units::one);
-          incoming[route.arcs[arc].receiver.value] += share;
-          posted += share;
-        }
+        post_downstream (route, outgoing);
         continue;
       }
 
       if (route.empty ()) {
-        result.deposited[cell] = sediment_volume_from (incoming[cell]);
-        deposited_total += incoming[cell];
+        result.deposited[cell] = sediment_volume_from (arriving);
+        deposited_total += arriving;
         continue;
       }
 
-      const double capacity = sediment_volume_value (transport_capacity[cell]);
-      double spare_capacity = std::max (0.0, capacity - incoming[cell]);
-      const double cover = available_cover.empty ()
-                             ? 0.0
-                             : sediment_volume_value (available_cover[cell]);
-      const double entrained_cover = std::min (cover, spare_capacity);
+      const double capacity = reading.transport_capacity;
+      double spare_capacity = std::max (0.0, capacity - arriving);
+      const double entrained_cover = std::min (reading.cover, spare_capacity);
       spare_capacity -= entrained_cover;
-      const double bedrock_detachment = std::min (
-        sediment_volume_value (potential_detachment[cell]), spare_capacity);
+      const double bedrock_detachment =
+        std::min (reading.potential_detachment, spare_capacity);
       const double local_detachment = entrained_cover + bedrock_detachment;
-      const double available = incoming[cell] + local_detachment;
-      const double deposited =
-        std::min (std::max (0.0, available - capacity),
-                  sediment_volume_value (maximum_deposition[cell]));
+      const double available = arriving + local_detachment;
+      const double deposited = std::min (std::max (0.0, available - capacity),
+                                         reading.maximum_deposition);
       const double outgoing = available - deposited;
 
       result.detached[cell] = sediment_volume_from (local_detachment);
@@ -449,19 +531,7 @@ namespace moppe::terrain {
       entrained_cover_total += entrained_cover;
       bedrock_detached_total += bedrock_detachment;
       deposited_total += deposited;
-
-      double posted = 0.0;
-      for (std::uint8_t arc = 0; arc < route.arc_count; ++arc) {
-        // Make the final posting the exact remainder. Independently rounding
-        // every arc would slowly manufacture or destroy sediment at splits.
-        const double share =
-          arc + 1 == route.arc_count
-            ? outgoing - posted
-            : outgoing *
-                route.arcs[arc].fraction.numerical_value_in (mp_units::one);
-        incoming[route.arcs[arc].receiver.value] += share;
-        posted += share;
-      }
+      post_downstream (route, outgoing);
     }
 
     result.detached_total = sediment_volume_from (detached_total);
@@ -476,6 +546,27 @@ namespace moppe::terrain {
   }
 
   LateralDepositionResult spread_valley_deposition (
+    const FractionalFlowDomain& flow,
+    std::span<const SurfaceElevation> elevations,
+    std::span<const FractionalContributingArea> contributing_areas,
+    std::span<const ChannelTangent> channel_tangents,
+    std::span<const SedimentVolume> centerline_deposition,
+    std::span<const std::uint8_t> ocean,
+    const ValleyDeposition& parameters) {
+    SedimentWorkspace workspace;
+    spread_valley_deposition (workspace,
+                              flow,
+                              elevations,
+                              contributing_areas,
+                              channel_tangents,
+                              centerline_deposition,
+                              ocean,
+                              parameters);
+    return std::move (workspace.lateral);
+  }
+
+  const LateralDepositionResult& spread_valley_deposition (
+    SedimentWorkspace& workspace,
     const FractionalFlowDomain& flow,
     std::span<const SurfaceElevation> elevations,
     std::span<const FractionalContributingArea> contributing_areas,
@@ -505,10 +596,12 @@ namespace moppe::terrain {
       0.0f,
       parameters.wall_relief_per_width.numerical_value_in (mp_units::one));
 
-    LateralDepositionResult result { .deposited = std::vector<SedimentVolume> (
-                                       count, SedimentVolume::zero ()) };
-    std::vector<double> distributed_m3 (count);
-    std::vector<double> working_height_m (count);
+    LateralDepositionResult& result = workspace.lateral;
+    result.deposited.assign (count, SedimentVolume::zero ());
+    std::vector<double>& distributed_m3 = workspace.scratch[0];
+    std::vector<double>& working_height_m = workspace.scratch[1];
+    distributed_m3.assign (count, 0.0);
+    working_height_m.assign (count, 0.0);
     for (std::size_t cell = 0; cell < count; ++cell) {
       if (!mp_units::isfinite (elevations[cell].quantity_from_zero ()) ||
           !mp_units::isfinite (contributing_areas[cell]) ||
@@ -524,10 +617,8 @@ namespace moppe::terrain {
       working_height_m[cell] = surface_elevation_value (elevations[cell]);
     }
 
-    struct Candidate {
-      std::size_t cell;
-      double height_m;
-    };
+    std::vector<std::size_t>& footprint = workspace.footprint;
+    std::vector<detail::DepositionCandidate>& candidates = workspace.candidates;
     double input_total_m3 = 0.0;
     double output_total_m3 = 0.0;
     for (std::size_t source = 0; source < count; ++source) {
@@ -581,7 +672,7 @@ namespace moppe::terrain {
       const TerrainIndex center = domain.index (source);
       const double ceiling_m = working_height_m[source] + wall_relief_m;
 
-      std::vector<std::size_t> footprint;
+      footprint.clear ();
       for (int dz = -radius_z; dz <= radius_z; ++dz)
         for (int dx = -radius_x; dx <= radius_x; ++dx) {
           const float offset_x_m = static_cast<float> (dx) * spacing_x_m;
@@ -603,17 +694,16 @@ namespace moppe::terrain {
       if (footprint.empty ())
         footprint.push_back (source);
 
-      std::vector<Candidate> candidates;
-      candidates.reserve (footprint.size ());
+      candidates.clear ();
       for (const std::size_t cell : footprint)
         candidates.push_back ({ cell, working_height_m[cell] });
-      std::ranges::sort (candidates, {}, &Candidate::height_m);
+      std::ranges::sort (candidates, {}, &detail::DepositionCandidate::rank);
 
       double remaining_m3 = source_volume_m3;
       std::size_t active = 1;
-      double floor_level_m = candidates.front ().height_m;
+      double floor_level_m = candidates.front ().rank;
       while (active < candidates.size ()) {
-        const double next_level_m = candidates[active].height_m;
+        const double next_level_m = candidates[active].rank;
         const double needed_m3 = (next_level_m - floor_level_m) * cell_area_m2 *
                                  static_cast<double> (active);
         if (remaining_m3 < needed_m3)
@@ -631,7 +721,7 @@ namespace moppe::terrain {
         const double share_m3 =
           position + 1 == active
             ? source_volume_m3 - posted_m3
-            : (floor_level_m - candidates[position].height_m) * cell_area_m2;
+            : (floor_level_m - candidates[position].rank) * cell_area_m2;
         distributed_m3[cell] += share_m3;
         working_height_m[cell] += share_m3 / cell_area_m2;
         posted_m3 += share_m3;
@@ -646,6 +736,29 @@ namespace moppe::terrain {
   }
 
   StandingWaterDepositionResult spread_standing_water_deposition (
+    const FloodField& flood,
+    const LakeCensus& census,
+    const FractionalFlowDomain& flow,
+    std::span<const FractionalContributingArea> contributing_areas,
+    std::span<const ChannelTangent> channel_tangents,
+    std::span<const SedimentVolume> centerline_deposition,
+    std::span<const SedimentVolume> maximum_deposition,
+    const ValleyDeposition& parameters) {
+    SedimentWorkspace workspace;
+    spread_standing_water_deposition (workspace,
+                                      flood,
+                                      census,
+                                      flow,
+                                      contributing_areas,
+                                      channel_tangents,
+                                      centerline_deposition,
+                                      maximum_deposition,
+                                      parameters);
+    return std::move (workspace.standing);
+  }
+
+  const StandingWaterDepositionResult& spread_standing_water_deposition (
+    SedimentWorkspace& workspace,
     const FloodField& flood,
     const LakeCensus& census,
     const FractionalFlowDomain& flow,
@@ -664,16 +777,23 @@ namespace moppe::terrain {
       throw std::invalid_argument (
         "standing-water deposition inputs do not share a domain");
 
-    StandingWaterDepositionResult result {
-      .dry_centerline =
-        std::vector<SedimentVolume> (count, SedimentVolume::zero ()),
-      .deposited = std::vector<SedimentVolume> (count, SedimentVolume::zero ())
-    };
-    std::vector<double> deposited_m3 (count);
-    std::vector<double> remaining_capacity_m3 (count);
-    std::vector<double> body_load_m3 (census.domain ().size ());
-    std::vector<double> body_capacity_m3 (census.domain ().size ());
-    std::vector<std::vector<std::size_t>> body_cells (census.domain ().size ());
+    StandingWaterDepositionResult& result = workspace.standing;
+    result.dry_centerline.assign (count, SedimentVolume::zero ());
+    result.deposited.assign (count, SedimentVolume::zero ());
+    const std::size_t bodies = census.domain ().size ();
+    std::vector<double>& deposited_m3 = workspace.scratch[0];
+    std::vector<double>& remaining_capacity_m3 = workspace.scratch[1];
+    std::vector<double>& body_load_m3 = workspace.body_scratch[0];
+    std::vector<double>& body_capacity_m3 = workspace.body_scratch[1];
+    deposited_m3.assign (count, 0.0);
+    remaining_capacity_m3.assign (count, 0.0);
+    body_load_m3.assign (bodies, 0.0);
+    body_capacity_m3.assign (bodies, 0.0);
+    // Each lake's cells, in cell order: body b holds body_cells from
+    // body_cell_offsets[b] up to body_cell_offsets[b + 1].
+    std::vector<std::size_t>& body_cell_offsets = workspace.body_cell_offsets;
+    std::vector<std::size_t>& body_cells = workspace.body_cells;
+    body_cell_offsets.assign (bodies + 1, 0);
     const double cell_area_m2 = domain.cell_area ().numerical_value_in (
       mp_units::si::metre * mp_units::si::metre);
     const float spacing_x_m =
@@ -683,7 +803,11 @@ namespace moppe::terrain {
     const float cell_diagonal_m = std::hypot (spacing_x_m, spacing_z_m);
     const std::size_t no_footprint_position =
       std::numeric_limits<std::size_t>::max ();
-    std::vector<std::size_t> footprint_position (count, no_footprint_position);
+    std::vector<std::size_t>& footprint_position =
+      workspace.footprint_position;
+    footprint_position.assign (count, no_footprint_position);
+    std::vector<detail::DepositionCandidate>& footprint = workspace.candidates;
+    std::vector<detail::DepositionCandidate>& still_open = workspace.still_open;
 
     double input_m3 = 0.0;
     double dry_m3 = 0.0;
@@ -715,7 +839,7 @@ namespace moppe::terrain {
       if (!flood.ocean[cell]) {
         body_load_m3[body.value] += load_m3;
         body_capacity_m3[body.value] += remaining_capacity_m3[cell];
-        body_cells[body.value].push_back (cell);
+        ++body_cell_offsets[body.value + 1];
         continue;
       }
       if (load_m3 == 0.0)
@@ -734,11 +858,7 @@ namespace moppe::terrain {
       const int radius_z =
         static_cast<int> (std::ceil (search_m / spacing_z_m));
       const TerrainIndex center = domain.index (cell);
-      struct MouthCell {
-        std::size_t cell;
-        double weight;
-      };
-      std::vector<MouthCell> footprint;
+      footprint.clear ();
       for (int dz = -radius_z; dz <= radius_z; ++dz)
         for (int dx = -radius_x; dx <= radius_x; ++dx) {
           const float offset_x_m = static_cast<float> (dx) * spacing_x_m;
@@ -769,11 +889,11 @@ namespace moppe::terrain {
             position = footprint.size ();
             footprint.push_back ({ destination, weight });
           } else {
-            footprint[position].weight =
-              std::max (footprint[position].weight, weight);
+            footprint[position].rank =
+              std::max (footprint[position].rank, weight);
           }
         }
-      for (const MouthCell& destination : footprint)
+      for (const detail::DepositionCandidate& destination : footprint)
         footprint_position[destination.cell] = no_footprint_position;
 
       double remaining_m3 = load_m3;
@@ -782,17 +902,18 @@ namespace moppe::terrain {
           std::accumulate (footprint.begin (),
                            footprint.end (),
                            0.0,
-                           [] (double sum, const MouthCell& destination) {
-                             return sum + destination.weight;
+                           [] (double sum,
+                               const detail::DepositionCandidate& destination) {
+                             return sum + destination.rank;
                            });
         if (weight_total <= 0.0)
           break;
         const double pass_load_m3 = remaining_m3;
         double posted_m3 = 0.0;
-        std::vector<MouthCell> still_open;
-        for (const MouthCell& destination : footprint) {
+        still_open.clear ();
+        for (const detail::DepositionCandidate& destination : footprint) {
           const double requested_m3 =
-            pass_load_m3 * destination.weight / weight_total;
+            pass_load_m3 * destination.rank / weight_total;
           const double share_m3 =
             std::min (requested_m3, remaining_capacity_m3[destination.cell]);
           deposited_m3[destination.cell] += share_m3;
@@ -804,13 +925,29 @@ namespace moppe::terrain {
         if (posted_m3 <= 1e-12)
           break;
         remaining_m3 -= posted_m3;
-        footprint = std::move (still_open);
+        std::swap (footprint, still_open);
       }
       ocean_m3 += load_m3 - remaining_m3;
       exported_m3 += remaining_m3;
     }
 
-    for (std::size_t body = 0; body < body_cells.size (); ++body) {
+    // With every lake's cells counted, lay them out. Placing a body's cells
+    // walks its offset to the next body's start; shifting the offsets back
+    // one body restores the starts.
+    std::partial_sum (body_cell_offsets.begin (),
+                      body_cell_offsets.end (),
+                      body_cell_offsets.begin ());
+    body_cells.resize (body_cell_offsets.back ());
+    for (std::size_t cell = 0; cell < count; ++cell) {
+      const WaterBodyId body =
+        census.body_at (CellIndex { static_cast<std::uint32_t> (cell) });
+      if (body != LakeCensus::dry && !flood.ocean[cell])
+        body_cells[body_cell_offsets[body.value]++] = cell;
+    }
+    std::shift_right (body_cell_offsets.begin (), body_cell_offsets.end (), 1);
+    body_cell_offsets.front () = 0;
+
+    for (std::size_t body = 0; body < bodies; ++body) {
       const double load_m3 = body_load_m3[body];
       if (load_m3 == 0.0)
         continue;
@@ -821,11 +958,12 @@ namespace moppe::terrain {
       }
       const double stored_m3 = std::min (load_m3, capacity_m3);
       double posted_m3 = 0.0;
-      for (std::size_t position = 0; position < body_cells[body].size ();
+      const std::size_t last = body_cell_offsets[body + 1];
+      for (std::size_t position = body_cell_offsets[body]; position < last;
            ++position) {
-        const std::size_t cell = body_cells[body][position];
+        const std::size_t cell = body_cells[position];
         const double local_capacity_m3 = remaining_capacity_m3[cell];
-        const double share_m3 = position + 1 == body_cells[body].size ()
+        const double share_m3 = position + 1 == last
                                   ? stored_m3 - posted_m3
                                   : stored_m3 * local_capacity_m3 / capacity_m3;
         deposited_m3[cell] += share_m3;
@@ -858,6 +996,29 @@ namespace moppe::terrain {
                             square_meters_per_julian_year_t diffusivity,
                             proportion_t critical_gradient,
                             proportion_t maximum_diffusivity_multiplier) {
+    SedimentWorkspace workspace;
+    route_hillslope_sediment (workspace,
+                              domain,
+                              elevations,
+                              sediment,
+                              fixed,
+                              duration,
+                              diffusivity,
+                              critical_gradient,
+                              maximum_diffusivity_multiplier);
+    return std::move (workspace.hillslope);
+  }
+
+  const HillslopeTransportResult&
+  route_hillslope_sediment (SedimentWorkspace& workspace,
+                            const TerrainDomain& domain,
+                            std::span<const SurfaceElevation> elevations,
+                            std::span<const SedimentThickness> sediment,
+                            std::span<const std::uint8_t> fixed,
+                            julian_years_f64_t duration,
+                            square_meters_per_julian_year_t diffusivity,
+                            proportion_t critical_gradient,
+                            proportion_t maximum_diffusivity_multiplier) {
     validate_hillslope_transport (domain,
                                   elevations,
                                   sediment,
@@ -868,20 +1029,24 @@ namespace moppe::terrain {
                                   maximum_diffusivity_multiplier);
 
     const std::size_t count = domain.size ();
-    HillslopeTransportResult result {
-      .heights = { elevations.begin (), elevations.end () },
-      .sediment_thickness = { sediment.begin (), sediment.end () },
-      .eroded_thickness =
-        std::vector<SedimentThickness> (count, SedimentThickness::zero ()),
-      .deposited_thickness =
-        std::vector<SedimentThickness> (count, SedimentThickness::zero ()),
-    };
+    HillslopeTransportResult& result = workspace.hillslope;
+    result.heights.assign (elevations.begin (), elevations.end ());
+    result.sediment_thickness.assign (sediment.begin (), sediment.end ());
+    result.eroded_thickness.assign (count, SedimentThickness::zero ());
+    result.deposited_thickness.assign (count, SedimentThickness::zero ());
+    result.transferred = SedimentVolume::zero ();
+    result.bedrock_detached = SedimentVolume::zero ();
+    result.balance_residual = 0.0 * cubic_metre;
     const double cell_area_m2 = domain.cell_area ().numerical_value_in (
       mp_units::si::metre * mp_units::si::metre);
-    std::vector<double> height_m (count);
-    std::vector<double> sediment_m3 (count);
-    std::vector<double> gradient_x (count);
-    std::vector<double> gradient_z (count);
+    std::vector<double>& height_m = workspace.scratch[0];
+    std::vector<double>& sediment_m3 = workspace.scratch[1];
+    std::vector<double>& gradient_x = workspace.scratch[2];
+    std::vector<double>& gradient_z = workspace.scratch[3];
+    height_m.assign (count, 0.0);
+    sediment_m3.assign (count, 0.0);
+    gradient_x.assign (count, 0.0);
+    gradient_z.assign (count, 0.0);
     for (std::size_t cell = 0; cell < count; ++cell) {
       height_m[cell] = surface_elevation_value (elevations[cell]);
       sediment_m3[cell] =
@@ -927,9 +1092,12 @@ namespace moppe::terrain {
       return result;
 
     const julian_years_f64_t sweep_duration = duration / sweep_count;
-    std::vector<double> net_m3 (count);
-    std::vector<double> outgoing_m3 (count);
-    std::vector<double> incoming_m3 (count);
+    std::vector<double>& net_m3 = workspace.scratch[4];
+    std::vector<double>& outgoing_m3 = workspace.scratch[5];
+    std::vector<double>& incoming_m3 = workspace.scratch[6];
+    net_m3.resize (count);
+    outgoing_m3.resize (count);
+    incoming_m3.resize (count);
 
     double transferred_m3 = 0.0;
     double bedrock_detached_m3 = 0.0;
@@ -4,6 +4,7 @@
 #include <moppe/terrain/flood.hh>
 #include <moppe/terrain/fractional_drainage.hh>
 
+#include <array>
 #include <cstdint>
 #include <span>
 #include <vector>
@@ -165,6 +166,111 @@ namespace moppe::terrain {
     proportion_t critical_gradient = 1.0f * proportion[mp_units::one],
     proportion_t maximum_diffusivity_multiplier = 1.0f *
                                                   proportion[mp_units::one]);
+
+  namespace detail {
+    // One cell's routing inputs, as route_sediment reads them.
+    struct SedimentRoutingCell {
+      double potential_detachment = 0.0;
+      double transport_capacity = 0.0;
+      double maximum_deposition = 0.0;
+      double cover = 0.0;
+      double ocean_mouth_capacity = 0.0;
+      WaterBodyId body = no_water_body;
+      bool ocean = false;
+    };
+
+    // A cell a deposit may settle into, ranked by its height across a
+    // valley floor or by its weight in a river-mouth fan.
+    struct DepositionCandidate {
+      std::size_t cell;
+      double rank;
+    };
+  }
+
+  // Where the sediment stages keep their results and scratch between calls.
+  // A stage handed a workspace sizes the columns it needs with assign, which
+  // keeps their capacity, so once every column has grown to the lattice a
+  // geological step allocates nothing here. Columns indexed by water body
+  // grow to the most bodies any step has seen. A returned result refers into
+  // the workspace and holds until that stage runs on it again.
+  struct SedimentWorkspace {
+    StandingWaterStorage storage;
+    SedimentRoutingResult routing;
+    StandingWaterDepositionResult standing;
+    LateralDepositionResult lateral;
+    HillslopeTransportResult hillslope;
+
+    std::vector<detail::SedimentRoutingCell> routing_cells;
+    // Per-cell volumes that no stage keeps past its own call.
+    std::array<std::vector<double>, 7> scratch;
+    // Per-body volumes, and each body's cells as offsets into one list.
+    std::array<std::vector<double>, 3> body_scratch;
+    std::vector<std::size_t> body_cell_offsets;
+    std::vector<std::size_t> body_cells;
+    std::vector<std::size_t> footprint_position;
+    std::vector<std::size_t> footprint;
+    std::vector<detail::DepositionCandidate> candidates;
+    std::vector<detail::DepositionCandidate> still_open;
+
+    // Grows every per-cell column to the lattice up front, so that not even
+    // the first step allocates them.
+    void reserve (const TerrainDomain& domain);
+  };
+
+  // The same stages, each writing into a workspace; see SedimentWorkspace.
+  const StandingWaterStorage&
+  standing_water_storage_capacity (
+    SedimentWorkspace& workspace,
+    const FloodField& flood,
+    const LakeCensus& census,
+    std::span<const FractionalContributingArea> contributing_areas,
+    std::span<const SedimentVolume> maximum_deposition,
+    const ValleyDeposition& parameters = {});
+
+  const SedimentRoutingResult&
+  route_sediment (SedimentWorkspace& workspace,
+                  const FractionalFlowDomain& flow,
+                  std::span<const SedimentVolume> potential_detachment,
+                  std::span<const SedimentVolume> transport_capacity,
+                  std::span<const SedimentVolume> maximum_deposition,
+                  std::span<const std::uint8_t> ocean,
+                  std::span<const SedimentVolume> available_cover = {},
+                  std::span<const WaterBodyId> water_body = {},
+                  std::span<const SedimentVolume> body_storage_capacity = {},
+                  std::span<const SedimentVolume> ocean_mouth_capacity = {});
+
+  const LateralDepositionResult& spread_valley_deposition (
+    SedimentWorkspace& workspace,
+    const FractionalFlowDomain& flow,
+    std::span<const SurfaceElevation> elevations,
+    std::span<const FractionalContributingArea> contributing_areas,
+    std::span<const ChannelTangent> channel_tangents,
+    std::span<const SedimentVolume> centerline_deposition,
+    std::span<const std::uint8_t> ocean,
+    const ValleyDeposition& parameters = {});
+
+  const StandingWaterDepositionResult& spread_standing_water_deposition (
+    SedimentWorkspace& workspace,
+    const FloodField& flood,
+    const LakeCensus& census,
+    const FractionalFlowDomain& flow,
+    std::span<const FractionalContributingArea> contributing_areas,
+    std::span<const ChannelTangent> channel_tangents,
+    std::span<const SedimentVolume> centerline_deposition,
+    std::span<const SedimentVolume> maximum_deposition,
+    const ValleyDeposition& parameters = {});
+
+  const HillslopeTransportResult& route_hillslope_sediment (
+    SedimentWorkspace& workspace,
+    const TerrainDomain& domain,
+    std::span<const SurfaceElevation> elevations,
+    std::span<const SedimentThickness> sediment,
+    std::span<const std::uint8_t> fixed,
+    julian_years_f64_t duration,
+    square_meters_per_julian_year_t diffusivity,
+    proportion_t critical_gradient = 1.0f * proportion[mp_units::one],
+    proportion_t maximum_diffusivity_multiplier = 1.0f *
+                                                  proportion[mp_units::one]);
 }
 
 #endif
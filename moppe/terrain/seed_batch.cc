@@ -0,0 +1,142 @@
+#include <moppe/game/world_batch.hh>
+#include <moppe/terrain/world_recipe.hh>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <iostream>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Generates a suite of seeds in one process and streams one CSV row per
+// world to standard output, in the order the seeds were named. Progress and
+// failures go to standard error.
+
+namespace {
+  constexpr std::string_view usage =
+    "usage: terrain-seed-batch [--jobs N] [--memory-mb MB] RESOLUTION "
+    "PROFILE SEED...\n"
+    "  SEED is an integer or an inclusive range FIRST..LAST";
+
+  int parse_positive_int (std::string_view text, const char* name) {
+    std::size_t consumed = 0;
+    const int value = std::stoi (std::string (text), &consumed);
+    if (consumed != text.size () || value <= 0)
+      throw std::invalid_argument (std::string (name) +
+                                   " must be a positive integer");
+    return value;
+  }
+
+  std::uint32_t parse_seed (std::string_view text) {
+    std::size_t consumed = 0;
+    const unsigned long value = std::stoul (std::string (text), &consumed);
+    if (consumed != text.size () ||
+        value > std::numeric_limits<std::uint32_t>::max ())
+      throw std::invalid_argument ("seed must be a 32-bit unsigned integer");
+    return static_cast<std::uint32_t> (value);
+  }
+
+  void append_seeds (std::string_view text,
+                     std::vector<std::uint32_t>& seeds) {
+    const std::size_t range = text.find ("..");
+    if (range == std::string_view::npos) {
+      seeds.push_back (parse_seed (text));
+      return;
+    }
+    const std::uint32_t first = parse_seed (text.substr (0, range));
+    const std::uint32_t last = parse_seed (text.substr (range + 2));
+    if (last < first)
+      throw std::invalid_argument ("seed range must not run backwards");
+    for (std::uint64_t seed = first; seed <= last; ++seed)
+      seeds.push_back (static_cast<std::uint32_t> (seed));
+  }
+
+  moppe::terrain::TerrainGenerationProfile
+  parse_profile (std::string_view text) {
+    using Profile = moppe::terrain::TerrainGenerationProfile;
+    if (text == "smoke")
+      return Profile::Smoke;
+    if (text == "fast")
+      return Profile::Fast;
+    if (text == "play")
+      return Profile::Play;
+    if (text == "research")
+      return Profile::Research;
+    throw std::invalid_argument (
+      "profile must be smoke, fast, play, or research");
+  }
+}
+
+int main (int argc, char** argv) {
+  using namespace moppe;
+  using namespace moppe::terrain;
+
+  try {
+    game::WorldBatchConfig config;
+    int argument = 1;
+    for (; argument + 1 < argc; argument += 2) {
+      const std::string_view option = argv[argument];
+      if (option == "--jobs")
+        config.workers = static_cast<std::size_t> (
+          parse_positive_int (argv[argument + 1], "jobs"));
+      else if (option == "--memory-mb")
+        config.memory_budget_bytes =
+          static_cast<std::size_t> (
+            parse_positive_int (argv[argument + 1], "memory"))
+          << 20;
+      else
+        break;
+    }
+    if (argc - argument < 3)
+      throw std::invalid_argument (std::string (usage));
+    const int resolution = parse_positive_int (argv[argument], "resolution");
+    const TerrainGenerationProfile profile = parse_profile (argv[argument + 1]);
+    std::vector<std::uint32_t> seeds;
+    for (int seed = argument + 2; seed < argc; ++seed)
+      append_seeds (argv[seed], seeds);
+
+    std::vector<WorldRecipe> recipes;
+    recipes.reserve (seeds.size ());
+    for (const std::uint32_t seed : seeds)
+      recipes.push_back (make_world_recipe (
+        spatial_extent_in_metres (Vec3 (5000.0f, 320.0f, 5000.0f)),
+        resolution,
+        Seed { seed },
+        50.0f * u::m,
+        profile));
+
+    std::cerr << "Generating " << recipes.size () << " " << resolution << "x"
+              << resolution << " " << profile_id (profile) << " worlds, "
+              << config.workers << " at a time within "
+              << (config.memory_budget_bytes >> 20) << " MB" << std::endl;
+    const auto start = std::chrono::steady_clock::now ();
+    std::size_t failures = 0;
+    game::write_world_batch_csv_header (std::cout);
+    game::generate_world_batch (
+      recipes, config, [&] (const game::WorldBatchResult& result) {
+        game::write_world_batch_csv_row (std::cout, result);
+        std::cout.flush ();
+        const std::uint32_t seed = seeds[result.index];
+        if (!result.error.empty ()) {
+          ++failures;
+          std::cerr << "seed " << seed << " failed: " << result.error
+                    << std::endl;
+        } else {
+          std::cerr << "seed " << seed << " in " << result.elapsed_seconds
+                    << " s" << std::endl;
+        }
+      });
+    const std::chrono::duration<double> elapsed =
+      std::chrono::steady_clock::now () - start;
+    std::cerr << recipes.size () << " worlds in " << elapsed.count () << " s"
+              << std::endl;
+    return failures == 0 ? 0 : 1;
+  } catch (const std::exception& error) {
+    std::cerr << "terrain-seed-batch: " << error.what () << '\n';
+    return -1;
+  }
+}
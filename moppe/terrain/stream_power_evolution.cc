@@ -1,6 +1,7 @@
 #include <moppe/terrain/stream_power_evolution.hh>
 
 #include <moppe/gfx/signal.hh>
+#include <moppe/memory.hh>
 #include <moppe/profile.hh>
 #include <moppe/quantities.hh>
 #include <moppe/terrain/domain.hh>
@@ -23,22 +24,12 @@
 namespace moppe::terrain {
   namespace {
     using mp_units::abs;
-    using mp_units::default_point_origin;
     using mp_units::isfinite;
     using mp_units::one;
-    using mp_units::quantity_point;
     using mp_units::astronomy::Julian_year;
     using mp_units::si::metre;
     using spatial::get;
 
-    // The backward-Euler solve mixes heights of the whole world with small
-    // per-step changes, so it carries its points at double precision and
-    // narrows once when a solved cell is stored.
-    using ElevationF64 =
-      quantity_point<surface_elevation[u::m],
-                     default_point_origin (surface_elevation[u::m]),
-                     double>;
-
     constexpr auto stream_cubic_metre = u::m * u::m * u::m;
 
     SedimentVolume stream_sediment_volume_from (double cubic_metres) {
@@ -95,7 +86,9 @@ namespace moppe::terrain {
           !isfinite (p.valley_deposition.wall_relief_per_width) ||
           p.valley_deposition.wall_relief_per_width < 0 ||
           !isfinite (p.channel_persistence) || p.channel_persistence < 0 ||
-          p.channel_persistence >= 1 * one)
+          p.channel_persistence >= 1 * one ||
+          p.coarse_to_fine.coarse_levels < 0 ||
+          p.coarse_to_fine.fine_steps < 1)
         throw std::invalid_argument (
           "invalid stream-power evolution parameters");
     }
@@ -176,9 +169,363 @@ namespace moppe::terrain {
       return { tangents.begin (), tangents.end () };
     }
 
+    // The whole evolution's ledger against the surface it started from.
+    void record_total_change (const TerrainDomain& grid,
+                              std::span<const SurfaceElevation> initial,
+                              std::span<const SurfaceElevation> evolved,
+                              StreamPowerEvolutionReport& report) {
+      const square_meters_t cell_area = grid.cell_area ();
+      cubic_meters_f64_t lowered_volume = 0.0 * u::m * u::m * u::m;
+      cubic_meters_f64_t raised_volume = 0.0 * u::m * u::m * u::m;
+      meters_f64_t total_absolute_change = 0.0 * u::m;
+      meters_f64_t maximum_absolute_change = 0.0 * u::m;
+
+      for (std::size_t cell = 0; cell < initial.size (); ++cell) {
+        const meters_f64_t change =
+          mp_units::isq::height (evolved[cell] - initial[cell]);
+
+        if (change < meters_f64_t::zero ())
+          lowered_volume -= change * cell_area;
+        else
+          raised_volume += change * cell_area;
+
+        total_absolute_change += mp_units::abs (change);
+        maximum_absolute_change =
+          std::max (maximum_absolute_change, mp_units::abs (change));
+      }
+
+      report.lowered_volume = lowered_volume;
+      report.raised_volume = raised_volume;
+      report.mean_absolute_change =
+        total_absolute_change / static_cast<double> (initial.size ());
+      report.maximum_absolute_change = maximum_absolute_change;
+    }
+
+    // ---- Coarse-to-fine ----
+
+    // The full lattice first, then each halving the schedule asks for and
+    // the lattice allows. A coarse sample covers a 2x2 block of the finer
+    // lattice, so both periods are unchanged.
+    std::vector<TerrainDomain>
+    coarse_to_fine_lattices (const TerrainDomain& grid, int levels) {
+      std::vector<TerrainDomain> lattices { grid };
+      while (static_cast<int> (lattices.size ()) <= levels) {
+        const TerrainDomain& finer = lattices.back ();
+        if (finer.width () % 2 != 0 || finer.height () % 2 != 0 ||
+            finer.width () < 16 || finer.height () < 16)
+          break;
+        TerrainDomain coarser (finer.width () / 2,
+                               finer.height () / 2,
+                               finer.spacing_x () * 2.0f,
+                               finer.spacing_z () * 2.0f);
+        lattices.push_back (coarser);
+      }
+      return lattices;
+    }
+
+    // Each coarse sample is the mean of the block it covers.
+    template <typename Value>
+    std::vector<Value> halved_samples (const TerrainDomain& finer,
+                                       std::span<const Value> values) {
+      const std::size_t width = finer.width () / 2;
+      const std::size_t height = finer.height () / 2;
+      std::vector<Value> coarser (width * height);
+      for (std::size_t row = 0; row < height; ++row)
+        for (std::size_t column = 0; column < width; ++column) {
+          const std::size_t corner = 2 * row * finer.width () + 2 * column;
+          const std::size_t below = corner + finer.width ();
+          coarser[row * width + column] =
+            (values[corner] + values[corner + 1] + values[below] +
+             values[below + 1]) *
+            0.25f;
+        }
+      return coarser;
+    }
+
+    // Bilinear reconstruction on the finer lattice. A fine sample lies a
+    // quarter of a coarse spacing from the nearest coarse centre, so along
+    // each axis it takes three quarters of that sample and one quarter of
+    // the next one over: the previous for an even index, the following for
+    // an odd one, wrapping at the seams.
+    template <typename Value>
+    std::vector<Value> doubled_samples (const TerrainDomain& coarser,
+                                        std::span<const Value> values) {
+      const std::size_t width = coarser.width ();
+      const std::size_t height = coarser.height ();
+      const auto beside = [] (std::size_t fine, std::size_t extent) {
+        const std::size_t nearest = fine / 2;
+        return fine % 2 == 0 ? (nearest + extent - 1) % extent
+                             : (nearest + 1) % extent;
+      };
+      std::vector<Value> finer (4 * width * height);
+      for (std::size_t row = 0; row < 2 * height; ++row) {
+        const std::size_t near_row = (row / 2) * width;
+        const std::size_t far_row = beside (row, height) * width;
+        for (std::size_t column = 0; column < 2 * width; ++column) {
+          const std::size_t near_column = column / 2;
+          const std::size_t far_column = beside (column, width);
+          const Value along_near_row = values[near_row + near_column] * 0.75f +
+                                       values[near_row + far_column] * 0.25f;
+          const Value along_far_row = values[far_row + near_column] * 0.75f +
+                                      values[far_row + far_column] * 0.25f;
+          finer[row * 2 * width + column] =
+            along_near_row * 0.75f + along_far_row * 0.25f;
+        }
+      }
+      return finer;
+    }
+
+    template <typename Value>
+    std::vector<Value>
+    coarsest_samples (std::span<const TerrainDomain> lattices,
+                      std::vector<Value> values) {
+      for (std::size_t level = 0; level + 1 < lattices.size (); ++level)
+        values = halved_samples<Value> (lattices[level], values);
+      return values;
+    }
+
+    template <typename Value>
+    std::vector<Value>
+    finest_samples (std::span<const TerrainDomain> lattices,
+                    std::vector<Value> values) {
+      for (std::size_t level = lattices.size () - 1; level > 0; --level)
+        values = doubled_samples<Value> (lattices[level], values);
+      return values;
+    }
+
+    // Averaging and blending shorten channel directions where neighbours
+    // disagreed. What still points somewhere becomes a unit direction again;
+    // what cancelled out starts from rest.
+    std::vector<ChannelTangent>
+    channel_directions (std::span<const Vec3> blended) {
+      std::vector<ChannelTangent> tangents;
+      tangents.reserve (blended.size ());
+      for (const Vec3& value : blended) {
+        const float magnitude = value.magnitude ();
+        tangents.push_back (
+          (magnitude > 1e-3f ? value / magnitude : Vec3 ()) *
+          channel_tangent[one]);
+      }
+      return tangents;
+    }
+
+    // The early steps run on the coarsest lattice. Their change in height
+    // is carried up rather than their heights, so the fine relief the
+    // geology drew survives beneath the coarse evolution; cover, material
+    // history and channel memory are carried up as they are. The full
+    // lattice then runs the remaining steps from there.
+    StreamPowerEvolutionResult evolve_coarse_to_fine (
+      StreamPowerWorkspace& workspace,
+      std::span<const TerrainDomain> lattices,
+      std::span<const SurfaceElevation> elevations,
+      std::span<const meters_per_julian_year_t> uplift_rate,
+      const StreamPowerEvolution& parameters,
+      IterationCount coarse_steps,
+      IterationCount steps,
+      const StreamPowerProgress& progress,
+      std::span<const ChannelTangent> initial_channel_tangents,
+      std::span<const SedimentThickness> initial_sediment) {
+
+      MOPPE_PROFILE_ZONE ("orogeny.coarse_to_fine");
+      const TerrainDomain& grid = lattices.front ();
+      const TerrainDomain& coarse_grid = lattices.back ();
+      const auto per_year = u::m / Julian_year;
+
+      const std::span<const float> fine_heights =
+        surface_elevation_values (elevations);
+      const std::vector<float> coarse_heights = coarsest_samples (
+        lattices,
+        std::vector<float> (fine_heights.begin (), fine_heights.end ()));
+      std::vector<SurfaceElevation> coarse_elevations;
+      coarse_elevations.reserve (coarse_heights.size ());
+      for (const float height : coarse_heights)
+        coarse_elevations.push_back (surface_elevation_point (height * u::m));
+
+      std::vector<float> uplift_values;
+      uplift_values.reserve (uplift_rate.size ());
+      for (const meters_per_julian_year_t rate : uplift_rate)
+        uplift_values.push_back (rate.numerical_value_in (per_year));
+      std::vector<meters_per_julian_year_t> coarse_uplift;
+      for (const float rate :
+           coarsest_samples (lattices, std::move (uplift_values)))
+        coarse_uplift.push_back (rate * per_year);
+
+      std::vector<SedimentThickness> coarse_sediment;
+      if (!initial_sediment.empty ()) {
+        std::vector<float> cover;
+        cover.reserve (initial_sediment.size ());
+        for (const SedimentThickness thickness :
+             validated_sediment (initial_sediment, grid.size ()))
+          cover.push_back (thickness.numerical_value_in (u::m));
+        for (const float thickness :
+             coarsest_samples (lattices, std::move (cover)))
+          coarse_sediment.push_back (thickness * sediment_thickness[u::m]);
+      }
+
+      std::vector<ChannelTangent> coarse_tangents;
+      if (!initial_channel_tangents.empty ()) {
+        std::vector<Vec3> directions;
+        directions.reserve (initial_channel_tangents.size ());
+        for (const ChannelTangent tangent :
+             validated_channel_memory (initial_channel_tangents, grid.size ()))
+          directions.push_back (tangent.numerical_value_in (one));
+        coarse_tangents = channel_directions (
+          coarsest_samples (lattices, std::move (directions)));
+      }
+
+      // Both stages keep the whole evolution's clock: the coarse stage ends
+      // on a step boundary, and the fine stage begins the tectonic and
+      // geological time that remain from there.
+      const julian_years_t coarse_duration =
+        static_cast<float> (count_value (coarse_steps)) * parameters.time_step;
+      StreamPowerEvolution coarse_parameters = parameters;
+      coarse_parameters.coarse_to_fine.coarse_levels = 0;
+      coarse_parameters.duration = coarse_duration;
+      StreamPowerEvolution fine_parameters = coarse_parameters;
+      fine_parameters.duration = parameters.duration - coarse_duration;
+      fine_parameters.uplift_duration =
+        std::max (parameters.uplift_duration - coarse_duration,
+                  julian_years_t::zero ());
+
+      StreamPowerProgress coarse_progress;
+      StreamPowerProgress fine_progress;
+      if (progress) {
+        coarse_progress = [&] (IterationCount completed,
+                               IterationCount,
+                               std::span<const SurfaceElevation> heights) {
+          progress (completed, steps, heights);
+        };
+        fine_progress = [&] (IterationCount completed,
+                             IterationCount,
+                             std::span<const SurfaceElevation> heights) {
+          progress (coarse_steps + completed, steps, heights);
+        };
+      }
+
+      StreamPowerEvolutionResult coarse =
+        detail::evolve_stream_power (coarse_grid,
+                                     coarse_elevations,
+                                     coarse_uplift,
+                                     coarse_parameters,
+                                     coarse_progress,
+                                     coarse_tangents,
+                                     coarse_sediment);
+
+      std::vector<float> coarse_change (coarse_heights.size ());
+      for (std::size_t cell = 0; cell < coarse_change.size (); ++cell)
+        coarse_change[cell] =
+          surface_elevation_value (coarse.heights[cell]) - coarse_heights[cell];
+      const std::vector<float> change =
+        finest_samples (lattices, std::move (coarse_change));
+      std::vector<SurfaceElevation> refined_elevations;
+      refined_elevations.reserve (grid.size ());
+      for (std::size_t cell = 0; cell < grid.size (); ++cell)
+        refined_elevations.push_back (
+          surface_elevation_point ((fine_heights[cell] + change[cell]) * u::m));
+
+      const auto refined_thickness =
+        [&] (std::span<const SedimentThickness> coarse_thickness) {
+          std::vector<float> values;
+          values.reserve (coarse_thickness.size ());
+          for (const SedimentThickness thickness : coarse_thickness)
+            values.push_back (thickness.numerical_value_in (u::m));
+          std::vector<SedimentThickness> refined;
+          refined.reserve (grid.size ());
+          for (const float thickness :
+               finest_samples (lattices, std::move (values)))
+            refined.push_back (std::max (thickness, 0.0f) *
+                               sediment_thickness[u::m]);
+          return refined;
+        };
+      const std::vector<SedimentThickness> refined_sediment =
+        refined_thickness (coarse.sediment_thickness);
+
+      std::vector<Vec3> coarse_directions;
+      coarse_directions.reserve (coarse.channel_tangents.size ());
+      for (const ChannelTangent tangent : coarse.channel_tangents)
+        coarse_directions.push_back (tangent.numerical_value_in (one));
+      const std::vector<ChannelTangent> refined_tangents = channel_directions (
+        finest_samples (lattices, std::move (coarse_directions)));
+
+      StreamPowerEvolutionResult result =
+        detail::evolve_stream_power (workspace,
+                                     grid,
+                                     refined_elevations,
+                                     uplift_rate,
+                                     fine_parameters,
+                                     fine_progress,
+                                     refined_tangents,
+                                     refined_sediment);
+
+      const std::vector<SedimentThickness> coarse_eroded =
+        refined_thickness (coarse.eroded_thickness);
+      const std::vector<SedimentThickness> coarse_deposited =
+        refined_thickness (coarse.deposited_thickness);
+      for (std::size_t cell = 0; cell < grid.size (); ++cell) {
+        result.eroded_thickness[cell] += coarse_eroded[cell];
+        result.deposited_thickness[cell] += coarse_deposited[cell];
+      }
+
+      // Volumes are physical, so the two stages' ledgers simply add. The
+      // final-step readings and the boundary count are the full lattice's.
+      StreamPowerEvolutionReport& report = result.report;
+      const StreamPowerEvolutionReport& early = coarse.report;
+      report.steps = steps;
+      report.hillslope_sweeps += early.hillslope_sweeps;
+      report.tectonic_uplift_volume += early.tectonic_uplift_volume;
+      report.eroded_volume += early.eroded_volume;
+      report.deposited_volume += early.deposited_volume;
+      report.exported_sediment_volume += early.exported_sediment_volume;
+      report.fluvial_entrained_cover_volume +=
+        early.fluvial_entrained_cover_volume;
+      report.fluvial_bedrock_detached_volume +=
+        early.fluvial_bedrock_detached_volume;
+      report.lake_sediment_storage_volume += early.lake_sediment_storage_volume;
+      report.ocean_mouth_deposition_volume +=
+        early.ocean_mouth_deposition_volume;
+      report.sediment_balance_residual += early.sediment_balance_residual;
+      report.hillslope_transferred_volume += early.hillslope_transferred_volume;
+      report.hillslope_bedrock_detached_volume +=
+        early.hillslope_bedrock_detached_volume;
+      record_total_change (grid, elevations, result.heights, report);
+      return result;
+    }
+  }
+
+  StreamPowerWorkspace::StreamPowerWorkspace (const TerrainDomain& domain)
+      : domain (domain),
+        next (domain),
+        boundary (domain.size ()),
+        uplifted_heights (domain.size ()),
+        potential_detachment (domain.size (), SedimentVolume::zero ()),
+        transport_capacity (domain.size (), SedimentVolume::zero ()),
+        maximum_deposition (domain.size (), SedimentVolume::zero ()),
+        available_cover (domain.size (), SedimentVolume::zero ()),
+        water (domain), drainage (domain) {
+    sediment.reserve (domain);
+  }
+
+  StreamPowerEvolutionResult detail::evolve_stream_power (
+    const TerrainDomain& grid,
+    std::span<const SurfaceElevation> elevations,
+    std::span<const meters_per_julian_year_t> uplift_rate,
+    const StreamPowerEvolution& parameters,
+    const StreamPowerProgress& progress,
+    std::span<const ChannelTangent> initial_channel_tangents,
+    std::span<const SedimentThickness> initial_sediment) {
+    StreamPowerWorkspace workspace (grid);
+    return evolve_stream_power (workspace,
+                                grid,
+                                elevations,
+                                uplift_rate,
+                                parameters,
+                                progress,
+                                initial_channel_tangents,
+                                initial_sediment);
   }
 
   StreamPowerEvolutionResult detail::evolve_stream_power (
+    StreamPowerWorkspace& workspace,
     const TerrainDomain& grid,
     std::span<const SurfaceElevation> elevations,
     std::span<const meters_per_julian_year_t> uplift_rate,
@@ -189,6 +536,31 @@ namespace moppe::terrain {
 
     MOPPE_PROFILE_ZONE ("evolve_stream_power");
     validate_stream_power_evolution (grid, elevations, uplift_rate, parameters);
+    if (workspace.domain != grid)
+      throw std::invalid_argument (
+        "stream-power workspace was sized for another lattice");
+
+    if (parameters.coarse_to_fine.enabled () && parameters.duration > 0) {
+      const IterationCount steps = whole_step_count (
+        parameters.duration,
+        julian_years_f64_t (parameters.time_step) / one_iteration,
+        "stream-power evolution requests too many steps");
+      const IterationCount fine_steps =
+        parameters.coarse_to_fine.fine_steps * one_iteration;
+      const std::vector<TerrainDomain> lattices = coarse_to_fine_lattices (
+        grid, parameters.coarse_to_fine.coarse_levels);
+      if (lattices.size () > 1 && steps > fine_steps)
+        return evolve_coarse_to_fine (workspace,
+                                      lattices,
+                                      elevations,
+                                      uplift_rate,
+                                      parameters,
+                                      steps - fine_steps,
+                                      steps,
+                                      progress,
+                                      initial_channel_tangents,
+                                      initial_sediment);
+    }
 
     const std::size_t count = grid.width () * grid.height ();
     const square_meters_t cell_area = grid.cell_area ();
@@ -248,19 +620,20 @@ namespace moppe::terrain {
     cubic_meters_f64_t hillslope_bedrock_detached_volume =
       0.0 * stream_cubic_metre;
 
-    ElevationMap next (grid);
-
-    auto& next_heights = get<surface_elevation> (next);
-    std::vector<std::uint8_t> boundary (count);
-    std::vector<ElevationF64> uplifted_heights (count);
-    std::vector<SedimentVolume> potential_detachment (count,
-                                                      SedimentVolume::zero ());
-    std::vector<SedimentVolume> transport_capacity (count,
-                                                    SedimentVolume::zero ());
-    std::vector<SedimentVolume> maximum_deposition (count,
-                                                    SedimentVolume::zero ());
-    std::vector<SedimentVolume> available_cover (count,
-                                                 SedimentVolume::zero ());
+    // Every step overwrites each of these columns before reading it.
+    auto& next_heights = get<surface_elevation> (workspace.next);
+    memory::tracked_vector<std::uint8_t>& boundary = workspace.boundary;
+    memory::tracked_vector<ElevationF64>& uplifted_heights =
+      workspace.uplifted_heights;
+    memory::tracked_vector<SedimentVolume>& potential_detachment =
+      workspace.potential_detachment;
+    memory::tracked_vector<SedimentVolume>& transport_capacity =
+      workspace.transport_capacity;
+    memory::tracked_vector<SedimentVolume>& maximum_deposition =
+      workspace.maximum_deposition;
+    memory::tracked_vector<SedimentVolume>& available_cover =
+      workspace.available_cover;
+    SedimentWorkspace& sediment = workspace.sediment;
 
     for (IterationCount step = 0 * one; step < steps; step += one_iteration) {
       MOPPE_PROFILE_NAMED_ZONE (geological_step, "orogeny.geological_step");
@@ -272,10 +645,10 @@ namespace moppe::terrain {
       const julian_years_f64_t uplift_dt =
         std::clamp (uplift_remaining, julian_years_f64_t::zero (), dt);
 
-      const FloodField flood =
-        analyze_standing_water (current, parameters.sea_level);
+      const FloodField& flood =
+        analyze_standing_water (workspace.water, current, parameters.sea_level);
 
-      const LakeCensus census = census_lakes (flood);
+      const LakeCensus& census = census_lakes (workspace.water, flood);
 
       std::copy (current_heights.begin (),
                  current_heights.end (),
@@ -295,8 +668,12 @@ namespace moppe::terrain {
                  stream_sediment_volume_from (maximum_deposition_m3));
       std::size_t fixed_boundaries = 0;
 
-      const FractionalDrainage drainage = analyze_fractional_drainage (
-        flood, census, channel_memory, parameters.channel_persistence);
+      const FractionalDrainage& drainage =
+        analyze_fractional_drainage (workspace.drainage,
+                                     flood,
+                                     census,
+                                     channel_memory,
+                                     parameters.channel_persistence);
       channel_memory = spatial::get<channel_tangent> (drainage);
 
       {
@@ -425,15 +802,17 @@ namespace moppe::terrain {
             mobile_sediment[cell].numerical_value_in (u::m) * cell_area_m2;
           available_cover[cell] = stream_sediment_volume_from (cover_m3);
         }
-        const StandingWaterStorage standing_storage =
+        const StandingWaterStorage& standing_storage =
           standing_water_storage_capacity (
+            sediment,
             flood,
             census,
             spatial::get<fractional_contributing_area> (drainage),
             maximum_deposition,
             parameters.valley_deposition);
-        const SedimentRoutingResult routed =
-          route_sediment (drainage.domain (),
+        const SedimentRoutingResult& routed =
+          route_sediment (sediment,
+                          drainage.domain (),
                           potential_detachment,
                           transport_capacity,
                           maximum_deposition,
@@ -462,8 +841,9 @@ namespace moppe::terrain {
             static_cast<float> (detached_m) * sediment_thickness[u::m];
         }
 
-        const StandingWaterDepositionResult standing =
+        const StandingWaterDepositionResult& standing =
           spread_standing_water_deposition (
+            sediment,
             flood,
             census,
             drainage.domain (),
@@ -482,7 +862,8 @@ namespace moppe::terrain {
         const double storage_overflow_m3 =
           stream_sediment_volume_value (standing.exported);
 
-        const LateralDepositionResult lateral = spread_valley_deposition (
+        const LateralDepositionResult& lateral = spread_valley_deposition (
+          sediment,
           drainage.domain (),
           next_heights,
           spatial::get<fractional_contributing_area> (drainage),
@@ -527,7 +908,8 @@ namespace moppe::terrain {
       IterationCount step_sweeps = 0 * one;
       {
         MOPPE_PROFILE_ZONE ("orogeny.route_hillslope_sediment");
-        HillslopeTransportResult hillslope = route_hillslope_sediment (
+        const HillslopeTransportResult& hillslope = route_hillslope_sediment (
+          sediment,
           grid,
           next_heights,
           mobile_sediment,
@@ -537,8 +919,9 @@ namespace moppe::terrain {
           parameters.critical_hillslope_gradient,
           parameters.maximum_hillslope_diffusivity_multiplier);
         step_sweeps = hillslope.sweeps;
-        next_heights = std::move (hillslope.heights);
-        mobile_sediment = std::move (hillslope.sediment_thickness);
+        std::ranges::copy (hillslope.heights, next_heights.begin ());
+        std::ranges::copy (hillslope.sediment_thickness,
+                           mobile_sediment.begin ());
         for (std::size_t cell = 0; cell < count; ++cell) {
           eroded_thickness[cell] += hillslope.eroded_thickness[cell];
           deposited_thickness[cell] += hillslope.deposited_thickness[cell];
@@ -598,30 +981,7 @@ namespace moppe::terrain {
     report.hillslope_bedrock_detached_volume =
       hillslope_bedrock_detached_volume;
 
-    cubic_meters_f64_t lowered_volume = 0.0 * u::m * u::m * u::m;
-    cubic_meters_f64_t raised_volume = 0.0 * u::m * u::m * u::m;
-    meters_f64_t total_absolute_change = 0.0 * u::m;
-    meters_f64_t maximum_absolute_change = 0.0 * u::m;
-
-    for (std::size_t cell = 0; cell < count; ++cell) {
-      const meters_f64_t change =
-        mp_units::isq::height (current_heights[cell] - initial[cell]);
-
-      if (change < meters_f64_t::zero ())
-        lowered_volume -= change * cell_area;
-      else
-        raised_volume += change * cell_area;
-
-      total_absolute_change += mp_units::abs (change);
-      maximum_absolute_change =
-        std::max (maximum_absolute_change, mp_units::abs (change));
-    }
-
-    report.lowered_volume = lowered_volume;
-    report.raised_volume = raised_volume;
-    report.mean_absolute_change =
-      total_absolute_change / static_cast<double> (count);
-    report.maximum_absolute_change = maximum_absolute_change;
+    record_total_change (grid, initial, current_heights, report);
 
     return { .heights = std::move (current_heights),
              .sediment_thickness = std::move (mobile_sediment),
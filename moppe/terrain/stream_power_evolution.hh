@@ -1,15 +1,42 @@
 #ifndef MOPPE_TERRAIN_STREAM_POWER_EVOLUTION_HH
 #define MOPPE_TERRAIN_STREAM_POWER_EVOLUTION_HH
 
+#include <moppe/memory.hh>
 #include <moppe/terrain/domain.hh>
+#include <moppe/terrain/flood.hh>
 #include <moppe/terrain/fractional_drainage.hh>
 #include <moppe/terrain/sediment_transport.hh>
 
+#include <cstdint>
 #include <functional>
 #include <span>
 #include <vector>
 
 namespace moppe::terrain {
+  // Coarse-to-fine scheduling of the geological steps. The early steps raise
+  // the broad relief and settle the trunk drainage, which a lattice a few
+  // times coarser resolves nearly as well at a small fraction of the cost.
+  // Those steps run on the coarse lattice; the change they made, the cover
+  // they left and the channel directions they remember are carried back up
+  // to the full lattice, which runs the last steps itself and so still cuts
+  // the fine channel network.
+  struct CoarseToFineEvolution {
+    // How many times the lattice is halved for the early steps. Zero runs
+    // every step at full resolution. A lattice that cannot be halved that
+    // often, or that would fall below eight samples a side, halves as often
+    // as it can.
+    int coarse_levels = 0;
+    // Geological steps that always run on the full lattice; at least one.
+    int fine_steps = 4;
+
+    bool enabled () const noexcept {
+      return coarse_levels > 0;
+    }
+
+    friend bool operator== (const CoarseToFineEvolution&,
+                            const CoarseToFineEvolution&) = default;
+  };
+
   // Backward-Euler landscape evolution for the n=1 stream-power equation.
   // Incision velocity is calibrated at a reference drainage area, keeping
   // every parameter dimensionally stable while the area exponent remains an
@@ -62,6 +89,7 @@ namespace moppe::terrain {
     // routing; values must remain below one.
     ChannelPersistence channel_persistence =
       0.35f * moppe::terrain::channel_persistence[mp_units::one];
+    CoarseToFineEvolution coarse_to_fine;
   };
 
   struct StreamPowerEvolutionReport {
@@ -113,10 +141,45 @@ namespace moppe::terrain {
 
   // Called after each geological step. The elevation span contains the
   // current lattice samples and remains valid only for the duration of the
-  // callback.
+  // callback. During the coarse stage of a coarse-to-fine evolution those are
+  // the coarse lattice's samples; the step counts always cover the whole
+  // evolution.
   using StreamPowerProgress = std::function<void (
     IterationCount, IterationCount, std::span<const SurfaceElevation>)>;
 
+  // The backward-Euler solve mixes heights of the whole world with small
+  // per-step changes, so it carries its points at double precision and
+  // narrows once when a solved cell is stored.
+  using ElevationF64 =
+    quantity_point<surface_elevation[u::m],
+                   default_point_origin (surface_elevation[u::m]),
+                   double>;
+
+  // What a geological step works in, sized once for one lattice and kept by
+  // the caller. An evolution handed a workspace analyses standing water,
+  // counts lakes, solves drainage and runs every sediment stage in it, so
+  // past its first step a geological step allocates nothing, and a baker
+  // evolving many worlds of one resolution sizes one workspace for all of
+  // them. The lake census's row workers live here too, so a workspace is
+  // built in place and never moved.
+  struct StreamPowerWorkspace {
+    explicit StreamPowerWorkspace (const TerrainDomain& domain);
+
+    TerrainDomain domain;
+    ElevationMap next;
+    // The step's scratch columns are its largest transient holding, so they
+    // count toward the tracked peak for as long as the workspace lives.
+    memory::tracked_vector<std::uint8_t> boundary;
+    memory::tracked_vector<ElevationF64> uplifted_heights;
+    memory::tracked_vector<SedimentVolume> potential_detachment;
+    memory::tracked_vector<SedimentVolume> transport_capacity;
+    memory::tracked_vector<SedimentVolume> maximum_deposition;
+    memory::tracked_vector<SedimentVolume> available_cover;
+    FloodWorkspace water;
+    FractionalDrainageWorkspace drainage;
+    SedimentWorkspace sediment;
+  };
+
   namespace detail {
     StreamPowerEvolutionResult evolve_stream_power (
       const TerrainDomain& domain,
@@ -126,6 +189,18 @@ namespace moppe::terrain {
       const StreamPowerProgress& progress,
       std::span<const ChannelTangent> initial_channel_tangents,
       std::span<const SedimentThickness> initial_sediment);
+
+    // Throws std::invalid_argument when the workspace was sized for another
+    // lattice. A coarse-to-fine evolution runs only its fine steps in it.
+    StreamPowerEvolutionResult evolve_stream_power (
+      StreamPowerWorkspace& workspace,
+      const TerrainDomain& domain,
+      std::span<const SurfaceElevation> elevations,
+      std::span<const meters_per_julian_year_t> uplift_rate,
+      const StreamPowerEvolution& parameters,
+      const StreamPowerProgress& progress,
+      std::span<const ChannelTangent> initial_channel_tangents,
+      std::span<const SedimentThickness> initial_sediment);
   }
 
   template <TerrainElevations Terrain>
@@ -144,6 +219,25 @@ namespace moppe::terrain {
                                         initial_channel_tangents,
                                         initial_sediment);
   }
+
+  template <TerrainElevations Terrain>
+  StreamPowerEvolutionResult evolve_stream_power (
+    StreamPowerWorkspace& workspace,
+    const Terrain& terrain,
+    std::span<const meters_per_julian_year_t> uplift_rate,
+    const StreamPowerEvolution& parameters,
+    const StreamPowerProgress& progress = {},
+    std::span<const ChannelTangent> initial_channel_tangents = {},
+    std::span<const SedimentThickness> initial_sediment = {}) {
+    return detail::evolve_stream_power (workspace,
+                                        terrain.domain (),
+                                        elevations (terrain),
+                                        uplift_rate,
+                                        parameters,
+                                        progress,
+                                        initial_channel_tangents,
+                                        initial_sediment);
+  }
 }
 
 #endif
@@ -0,0 +1,175 @@
+#ifndef MOPPE_TERRAIN_TILED_DOMAIN_HH
+#define MOPPE_TERRAIN_TILED_DOMAIN_HH
+
+#include <moppe/spatial/bundle.hh>
+#include <moppe/terrain/domain.hh>
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <stdexcept>
+#include <utility>
+
+// The terrain lattice in a second storage order. A row-major column puts a
+// site's north and south neighbours a whole row away, so on a world larger
+// than the cache every neighbourhood rule touches three distant lines per
+// site. Stored tile by tile instead -- square blocks of sites, each block
+// row-major, the blocks themselves row-major -- nearly every neighbour of a
+// site lies in the same few lines.
+//
+// Positions are the same TerrainIndex values over the same torus; only the
+// offsets differ. A bundle over this domain is a different bundle type, so a
+// column in one order can never be read as if it were in the other. The
+// row-major TerrainDomain stays the exchange format: textures, caches and
+// every existing rule read it, and retile / untile move between the two.
+
+namespace moppe::terrain {
+  class TiledTerrainDomain {
+  public:
+    using index_type = TerrainIndex;
+    using influence_type = TerrainDomain::influence_type;
+
+    // The tile side is a power of two that divides both lattice extents.
+    TiledTerrainDomain (TerrainDomain lattice, std::size_t tile = 16)
+        : m_lattice (std::move (lattice)), m_tile (tile),
+          m_tile_shift (std::has_single_bit (tile)
+                          ? static_cast<std::size_t> (std::countr_zero (tile))
+                          : 0),
+          m_tiles_across (m_lattice.width () >> m_tile_shift) {
+      if (!std::has_single_bit (tile) || m_lattice.width () % tile != 0 ||
+          m_lattice.height () % tile != 0)
+        throw std::invalid_argument ("terrain tile does not divide domain");
+    }
+
+    friend bool operator== (const TiledTerrainDomain& left,
+                            const TiledTerrainDomain& right) {
+      return left.m_lattice == right.m_lattice && left.m_tile == right.m_tile;
+    }
+
+    const TerrainDomain& lattice () const noexcept {
+      return m_lattice;
+    }
+    std::size_t tile () const noexcept {
+      return m_tile;
+    }
+    std::size_t size () const noexcept {
+      return m_lattice.size ();
+    }
+    std::size_t width () const noexcept {
+      return m_lattice.width ();
+    }
+    std::size_t height () const noexcept {
+      return m_lattice.height ();
+    }
+
+    std::size_t offset (TerrainIndex index) const {
+      if (index.column >= width () || index.row >= height ())
+        throw std::out_of_range ("terrain index outside domain");
+      const std::size_t mask = m_tile - 1;
+      const std::size_t tile = (index.row >> m_tile_shift) * m_tiles_across +
+                               (index.column >> m_tile_shift);
+      return (tile << (2 * m_tile_shift)) +
+             ((index.row & mask) << m_tile_shift) + (index.column & mask);
+    }
+
+    TerrainIndex index (std::size_t offset) const {
+      if (offset >= size ())
+        throw std::out_of_range ("terrain offset outside domain");
+      const std::size_t mask = m_tile - 1;
+      const std::size_t tile = offset >> (2 * m_tile_shift);
+      const std::size_t within = offset & ((m_tile << m_tile_shift) - 1);
+      return { .column = ((tile % m_tiles_across) << m_tile_shift) +
+                         (within & mask),
+               .row = ((tile / m_tiles_across) << m_tile_shift) +
+                      (within >> m_tile_shift) };
+    }
+
+    // Topology and reconstruction are the lattice's own: they speak in
+    // positions, never in offsets.
+    TerrainIndex shifted (TerrainIndex index, int columns, int rows) const {
+      return m_lattice.shifted (index, columns, rows);
+    }
+
+    template <typename Visitor>
+    void visit_neighbourhood (TerrainIndex centre, Visitor&& visitor) const {
+      m_lattice.visit_neighbourhood (centre, std::forward<Visitor> (visitor));
+    }
+
+    template <typename Visitor>
+    void visit_interpolation_stencil (const position_t& position,
+                                      Visitor&& visitor) const {
+      m_lattice.visit_interpolation_stencil (position,
+                                             std::forward<Visitor> (visitor));
+    }
+
+  private:
+    TerrainDomain m_lattice;
+    std::size_t m_tile;
+    std::size_t m_tile_shift;
+    std::size_t m_tiles_across;
+  };
+
+  static_assert (spatial::FiniteDomain<TiledTerrainDomain>);
+  static_assert (
+    spatial::InterpolationDomain<TiledTerrainDomain, position_t>);
+
+  namespace detail {
+    // Each tile row is one contiguous run in both orders, so moving a column
+    // between them is a copy per tile row rather than per site.
+    template <typename Copy>
+    void for_each_tile_row (const TiledTerrainDomain& tiled, Copy&& copy) {
+      const std::size_t tile = tiled.tile ();
+      const std::size_t width = tiled.width ();
+      std::size_t tiled_offset = 0;
+      for (std::size_t tile_row = 0; tile_row < tiled.height ();
+           tile_row += tile)
+        for (std::size_t tile_column = 0; tile_column < width;
+             tile_column += tile)
+          for (std::size_t row = tile_row; row < tile_row + tile; ++row) {
+            copy (row * width + tile_column, tiled_offset, tile);
+            tiled_offset += tile;
+          }
+    }
+  }
+
+  // The same columns in tile order. Values are copied unchanged.
+  template <typename... Quantities>
+  spatial::Bundle<TiledTerrainDomain, Quantities...>
+  retile (const spatial::Bundle<TerrainDomain, Quantities...>& source,
+          std::size_t tile = 16) {
+    TiledTerrainDomain domain (source.domain (), tile);
+    spatial::Bundle<TiledTerrainDomain, Quantities...> result (domain);
+    [&]<std::size_t... Column> (std::index_sequence<Column...>) {
+      (detail::for_each_tile_row (
+         domain,
+         [&] (std::size_t row_major, std::size_t tiled, std::size_t count) {
+           std::copy_n (spatial::get<Column> (source).begin () + row_major,
+                        count,
+                        spatial::get<Column> (result).begin () + tiled);
+         }),
+       ...);
+    }(std::index_sequence_for<Quantities...> {});
+    return result;
+  }
+
+  // Back to the row-major exchange order.
+  template <typename... Quantities>
+  spatial::Bundle<TerrainDomain, Quantities...>
+  untile (const spatial::Bundle<TiledTerrainDomain, Quantities...>& source) {
+    spatial::Bundle<TerrainDomain, Quantities...> result (
+      source.domain ().lattice ());
+    [&]<std::size_t... Column> (std::index_sequence<Column...>) {
+      (detail::for_each_tile_row (
+         source.domain (),
+         [&] (std::size_t row_major, std::size_t tiled, std::size_t count) {
+           std::copy_n (spatial::get<Column> (source).begin () + tiled,
+                        count,
+                        spatial::get<Column> (result).begin () + row_major);
+         }),
+       ...);
+    }(std::index_sequence_for<Quantities...> {});
+    return result;
+  }
+}
+
+#endif
@@ -1,6 +1,7 @@
 #include <moppe/terrain/watercourse.hh>
 
 #include <moppe/gfx/signal.hh>
+#include <moppe/parallel.hh>
 #include <moppe/profile.hh>
 #include <moppe/terrain/river.hh>
 
@@ -46,7 +47,8 @@ namespace moppe::terrain {
                               const LakeCensus& census,
                               const DrainageGraph& drainage,
                               const RiverNetwork& rivers,
-                              const WatercoursePaint& parameters) {
+                              const WatercoursePaint& parameters,
+                              std::size_t band_rows) {
     MOPPE_PROFILE_ZONE ("paint_watercourses");
     const TerrainDomain& grid = flood.domain ();
     if (terrain_domain != grid)
@@ -58,6 +60,8 @@ namespace moppe::terrain {
     if (census.cell_count () != count || drainage.receiver.size () != count)
       throw std::invalid_argument (
         "watercourse painting inputs do not share a grid");
+    if (band_rows == 0)
+      throw std::invalid_argument ("watercourse bands need at least one row");
 
     // Standing bodies establish the first surface. Running alignments are
     // painted into this same field below; the renderer's exact cell clipper
@@ -120,7 +124,13 @@ namespace moppe::terrain {
       rivers.reaches.size ());
     {
       MOPPE_PROFILE_ZONE ("watercourse.prepare_running_surface");
-      for (const RiverReach& reach : rivers.reaches) {
+      // Reaches are prepared independently; each writes only its own points.
+      const std::size_t reach_count = rivers.reaches.size ();
+      std::size_t alignment_points = 0;
+      for (const RiverReach& reach : rivers.reaches)
+        alignment_points += reach.alignment.points.size ();
+      parallel_rows (reach_count, alignment_points, [&] (std::size_t index) {
+        const RiverReach& reach = rivers.reaches[index];
         const auto& points = reach.alignment.points;
         auto& prepared = reach_points[reach.id];
         prepared.reserve (points.size ());
@@ -183,7 +193,7 @@ namespace moppe::terrain {
         for (std::size_t point = prepared.size (); point > 1; --point)
           prepared[point - 2].level_m =
             std::max (prepared[point - 2].level_m, prepared[point - 1].level_m);
-      }
+      });
     }
 
     // A confluence owns one level. Tributaries and the trunk meet at the
@@ -204,14 +214,34 @@ namespace moppe::terrain {
           reach_points[upstream].back ().level_m = junction_level;
     }
 
+    // Each segment between two running points is a brush swept over the
+    // lattice cells within its radius. The segments are binned by the bands
+    // of rows their brush reaches, in reach and point order, and every band
+    // is painted by one worker. A cell therefore receives exactly the
+    // contributions, in exactly the order, a single sweep over all reaches
+    // would give it: currents sum and the lowest-score level wins the same
+    // way, whatever the band height or the schedule.
+    struct RunningSegment {
+      const RunningPoint* start;
+      const RunningPoint* end;
+      int minimum_x;
+      int maximum_x;
+      int minimum_z;
+      int maximum_z;
+    };
+
     std::vector<float> running_score (count,
                                       std::numeric_limits<float>::infinity ());
     std::vector<float> running_level (count, 0.0f);
+    const float margin = parameters.bank_margin.numerical_value_in (u::m);
+    const float depth_limit = parameters.depth_limit.numerical_value_in (u::m);
+    const std::size_t band_count =
+      (static_cast<std::size_t> (height) + band_rows - 1) / band_rows;
+    std::vector<RunningSegment> segments;
+    std::vector<std::size_t> band_segment_start (band_count + 1, 0);
+    std::vector<std::size_t> band_segments;
     {
-      MOPPE_PROFILE_ZONE ("watercourse.paint_running_surface");
-      const float margin = parameters.bank_margin.numerical_value_in (u::m);
-      const float depth_limit =
-        parameters.depth_limit.numerical_value_in (u::m);
+      MOPPE_PROFILE_ZONE ("watercourse.bin_running_segments");
       for (const RiverReach& reach : rivers.reaches) {
         const auto& points = reach_points[reach.id];
         for (std::size_t point = 0; point + 1 < points.size (); ++point) {
@@ -219,29 +249,86 @@ namespace moppe::terrain {
           const RunningPoint& end = points[point + 1];
           const float run_x = end.x_m - start.x_m;
           const float run_z = end.z_m - start.z_m;
-          const float run2 = run_x * run_x + run_z * run_z;
-          if (run2 < 1e-6f)
+          if (run_x * run_x + run_z * run_z < 1e-6f)
             continue;
-          const float run = std::sqrt (run2);
-          const float direction_x = run_x / run;
-          const float direction_z = run_z / run;
-          const bool falling = std::max (start.waterfall, end.waterfall) > 0.5f;
           const float radius =
             std::max (start.half_width_m + margin * start.source_profile,
                       end.half_width_m + margin * end.source_profile);
           if (radius <= 0.01f)
             continue;
-          const int minimum_x = static_cast<int> (
-            std::floor ((std::min (start.x_m, end.x_m) - radius) / spacing_x));
-          const int maximum_x = static_cast<int> (
-            std::ceil ((std::max (start.x_m, end.x_m) + radius) / spacing_x));
-          const int minimum_z = static_cast<int> (
-            std::floor ((std::min (start.z_m, end.z_m) - radius) / spacing_z));
-          const int maximum_z = static_cast<int> (
-            std::ceil ((std::max (start.z_m, end.z_m) + radius) / spacing_z));
-          for (int unwrapped_z = minimum_z; unwrapped_z <= maximum_z;
-               ++unwrapped_z)
-            for (int unwrapped_x = minimum_x; unwrapped_x <= maximum_x;
+          segments.push_back ({
+            .start = &start,
+            .end = &end,
+            .minimum_x = static_cast<int> (std::floor (
+              (std::min (start.x_m, end.x_m) - radius) / spacing_x)),
+            .maximum_x = static_cast<int> (std::ceil (
+              (std::max (start.x_m, end.x_m) + radius) / spacing_x)),
+            .minimum_z = static_cast<int> (std::floor (
+              (std::min (start.z_m, end.z_m) - radius) / spacing_z)),
+            .maximum_z = static_cast<int> (std::ceil (
+              (std::max (start.z_m, end.z_m) + radius) / spacing_z)),
+          });
+        }
+      }
+
+      // Counted, then filled. A brush taller than a band, or wrapping
+      // across the seam, lands in every band it touches, once.
+      std::vector<std::size_t> last_segment (band_count, segments.size ());
+      const auto visit_bands = [&] (auto&& visit) {
+        std::ranges::fill (last_segment, segments.size ());
+        for (std::size_t index = 0; index < segments.size (); ++index)
+          for (int unwrapped_z = segments[index].minimum_z;
+               unwrapped_z <= segments[index].maximum_z;
+               ++unwrapped_z) {
+            const std::size_t band =
+              static_cast<std::size_t> (wrap_index (unwrapped_z, height)) /
+              band_rows;
+            if (last_segment[band] == index)
+              continue;
+            last_segment[band] = index;
+            visit (band, index);
+          }
+      };
+      visit_bands ([&] (std::size_t band, std::size_t) {
+        ++band_segment_start[band + 1];
+      });
+      for (std::size_t band = 0; band < band_count; ++band)
+        band_segment_start[band + 1] += band_segment_start[band];
+      band_segments.resize (band_segment_start[band_count]);
+      std::vector<std::size_t> band_fill (band_segment_start.begin (),
+                                          band_segment_start.end () - 1);
+      visit_bands ([&] (std::size_t band, std::size_t index) {
+        band_segments[band_fill[band]++] = index;
+      });
+    }
+
+    {
+      MOPPE_PROFILE_ZONE ("watercourse.paint_running_surface");
+      parallel_rows (band_count, count, [&] (std::size_t band) {
+        const int first_row = static_cast<int> (band * band_rows);
+        const int last_row = static_cast<int> (
+          std::min ((band + 1) * band_rows, static_cast<std::size_t> (height)));
+        for (std::size_t slot = band_segment_start[band];
+             slot < band_segment_start[band + 1];
+             ++slot) {
+          const RunningSegment& segment = segments[band_segments[slot]];
+          const RunningPoint& start = *segment.start;
+          const RunningPoint& end = *segment.end;
+          const float run_x = end.x_m - start.x_m;
+          const float run_z = end.z_m - start.z_m;
+          const float run2 = run_x * run_x + run_z * run_z;
+          const float run = std::sqrt (run2);
+          const float direction_x = run_x / run;
+          const float direction_z = run_z / run;
+          const bool falling = std::max (start.waterfall, end.waterfall) > 0.5f;
+          for (int unwrapped_z = segment.minimum_z;
+               unwrapped_z <= segment.maximum_z;
+               ++unwrapped_z) {
+            const int z = wrap_index (unwrapped_z, height);
+            if (z < first_row || z >= last_row)
+              continue;
+            for (int unwrapped_x = segment.minimum_x;
+                 unwrapped_x <= segment.maximum_x;
                  ++unwrapped_x) {
               const float world_x = unwrapped_x * spacing_x;
               const float world_z = unwrapped_z * spacing_z;
@@ -262,7 +349,6 @@ namespace moppe::terrain {
               if (distance >= local_radius || local_radius <= 1e-4f)
                 continue;
               const int x = wrap_index (unwrapped_x, width);
-              const int z = wrap_index (unwrapped_z, height);
               const std::size_t cell = static_cast<std::size_t> (z) * width + x;
               const float weight =
                 std::pow (1.0f - distance / local_radius, 2.0f);
@@ -294,8 +380,9 @@ namespace moppe::terrain {
                 running_level[cell] = candidate;
               }
             }
+          }
         }
-      }
+      });
     }
 
     for (std::size_t cell = 0; cell < count; ++cell) {
@@ -323,7 +410,8 @@ namespace moppe::terrain {
     {
       constexpr float dry_margin = 1e-6f;
       std::vector<float> signed_surface = surface;
-      for (int y = 0; y < height; ++y)
+      parallel_rows (height, count, [&] (std::size_t row) {
+        const int y = static_cast<int> (row);
         for (int x = 0; x < width; ++x) {
           const std::size_t cell = static_cast<std::size_t> (y) * width + x;
           const float ground = elevation_at (grid, elevations, x, y);
@@ -345,6 +433,7 @@ namespace moppe::terrain {
           if (std::isfinite (lowest_wet))
             signed_surface[cell] = std::min (lowest_wet, ground - dry_margin);
         }
+      });
       surface = std::move (signed_surface);
     }
 
@@ -4,6 +4,7 @@
 #include <moppe/terrain/drainage.hh>
 #include <moppe/terrain/flood.hh>
 
+#include <cstddef>
 #include <vector>
 
 namespace moppe::terrain {
@@ -39,6 +40,10 @@ namespace moppe::terrain {
     Bundle<TerrainDomain, SurfaceElevation, WaveAmplitude, WaterVelocity>;
 
   namespace detail {
+    // Running water is painted in bands of lattice rows, one worker to a
+    // band. The sheet is the same for any band height; tests vary it.
+    inline constexpr std::size_t watercourse_band_rows = 16;
+
     WaterSheets
     paint_watercourses (const TerrainDomain& domain,
                         std::span<const SurfaceElevation> elevations,
@@ -46,7 +51,8 @@ namespace moppe::terrain {
                         const LakeCensus& census,
                         const DrainageGraph& drainage,
                         const RiverNetwork& rivers,
-                        const WatercoursePaint& parameters);
+                        const WatercoursePaint& parameters,
+                        std::size_t band_rows = watercourse_band_rows);
   }
 
   template <TerrainElevations Terrain>
@@ -4,6 +4,7 @@
 #include <cmath>
 #include <cstdint>
 #include <limits>
+#include <span>
 #include <stdexcept>
 #include <unordered_map>
 
@@ -291,16 +292,19 @@ namespace moppe::terrain {
 
     // Bucket segments by lattice cell so each node only inspects its
     // neighborhood; a marching-squares segment spans at most two cells.
+    // The buckets are one flat table over the lattice: a count per cell,
+    // then every cell's segments stored contiguously after the counts'
+    // running sum.
     struct ShoreSegment {
       float ax, ay, bx, by;
     };
     std::vector<ShoreSegment> shore;
-    std::unordered_map<std::uint64_t, std::vector<std::uint32_t>> buckets;
-    const auto bucket_key = [&] (int x, int y) -> std::uint64_t {
+    std::vector<std::uint32_t> home_cell;
+    const auto bucket_key = [&] (int x, int y) -> std::uint32_t {
       x = wrap_index (x, static_cast<int> (width));
       y = wrap_index (y, static_cast<int> (height));
-      return static_cast<std::uint64_t> (y) * width +
-             static_cast<std::uint64_t> (x);
+      return static_cast<std::uint32_t> (static_cast<std::size_t> (y) * width +
+                                         static_cast<std::size_t> (x));
     };
     for (const WaterlineContour& contour : waterline.contours) {
       const std::size_t points = contour.size ();
@@ -321,13 +325,12 @@ namespace moppe::terrain {
           segment.by -= world_y;
         if (segment.ay - segment.by > 0.5f * world_y)
           segment.by += world_y;
-        const std::uint32_t index = static_cast<std::uint32_t> (shore.size ());
         shore.push_back (segment);
-        buckets[bucket_key (static_cast<int> (std::floor (
-                              0.5f * (segment.ax + segment.bx) / spacing_x)),
-                            static_cast<int> (std::floor (
-                              0.5f * (segment.ay + segment.by) / spacing_y)))]
-          .push_back (index);
+        home_cell.push_back (
+          bucket_key (static_cast<int> (std::floor (
+                        0.5f * (segment.ax + segment.bx) / spacing_x)),
+                      static_cast<int> (std::floor (
+                        0.5f * (segment.ay + segment.by) / spacing_y))));
       }
     }
     if (shore.empty ())
@@ -361,9 +364,27 @@ namespace moppe::terrain {
       return std::sqrt (cx * cx + cy * cy);
     };
 
+    std::vector<std::uint32_t> bucket_start (count + 1, 0);
+    for (const std::uint32_t cell : home_cell)
+      ++bucket_start[cell + 1];
+    for (std::size_t cell = 0; cell < count; ++cell)
+      bucket_start[cell + 1] += bucket_start[cell];
+    std::vector<std::uint32_t> bucketed (shore.size ());
+    {
+      std::vector<std::uint32_t> filled (bucket_start.begin (),
+                                         bucket_start.end () - 1);
+      for (std::uint32_t segment = 0; segment < shore.size (); ++segment)
+        bucketed[filled[home_cell[segment]]++] = segment;
+    }
+
     // Exact distances for every node within the band of a bucketed
     // cell; everything farther keeps the clamp.
-    for (const auto& [key, segment_indices] : buckets) {
+    for (std::size_t key = 0; key < count; ++key) {
+      const std::span<const std::uint32_t> segment_indices (
+        bucketed.data () + bucket_start[key],
+        bucketed.data () + bucket_start[key + 1]);
+      if (segment_indices.empty ())
+        continue;
       const int bx = static_cast<int> (key % width);
       const int by = static_cast<int> (key / width);
       for (int dy = -reach_y; dy <= reach_y; ++dy)
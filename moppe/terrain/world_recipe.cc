@@ -25,7 +25,8 @@ namespace moppe::terrain {
     std::optional<square_meters_t> channel_initiation_area,
     std::optional<SedimentConcentration> sediment_concentration,
     std::optional<proportion_t> critical_hillslope_gradient,
-    std::optional<proportion_t> maximum_hillslope_multiplier)
+    std::optional<proportion_t> maximum_hillslope_multiplier,
+    std::optional<CoarseToFineEvolution> coarse_to_fine)
       : m_extent (extent), m_resolution (resolution), m_seed (seed),
         m_water_datum (water_datum), m_generation_profile (generation_profile) {
     // Evolution age and tectonic forcing are separate clocks. The initial
@@ -56,6 +57,8 @@ namespace moppe::terrain {
     if (maximum_hillslope_multiplier)
       m_evolution.maximum_hillslope_diffusivity_multiplier =
         *maximum_hillslope_multiplier;
+    if (coarse_to_fine)
+      m_evolution.coarse_to_fine = *coarse_to_fine;
     m_evolution.diffusivity = 0.0001f * mp_units::si::metre *
                               mp_units::si::metre /
                               mp_units::astronomy::Julian_year;
@@ -74,7 +77,8 @@ namespace moppe::terrain {
     std::optional<square_meters_t> channel_initiation_area,
     std::optional<SedimentConcentration> sediment_concentration,
     std::optional<proportion_t> critical_hillslope_gradient,
-    std::optional<proportion_t> maximum_hillslope_multiplier) {
+    std::optional<proportion_t> maximum_hillslope_multiplier,
+    std::optional<CoarseToFineEvolution> coarse_to_fine) {
     return { extent,
              resolution,
              seed,
@@ -84,6 +88,7 @@ namespace moppe::terrain {
              channel_initiation_area,
              sediment_concentration,
              critical_hillslope_gradient,
-             maximum_hillslope_multiplier };
+             maximum_hillslope_multiplier,
+             coarse_to_fine };
   }
 }
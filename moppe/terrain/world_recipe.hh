@@ -45,6 +45,14 @@ namespace moppe::terrain {
       return m_trail_formation;
     }
 
+    // The same world drawn on another lattice. Every other input, and with
+    // it every physical scale, is unchanged.
+    WorldRecipe with_resolution (int resolution) const {
+      WorldRecipe resampled = *this;
+      resampled.m_resolution = resolution;
+      return resampled;
+    }
+
   private:
     friend WorldRecipe make_world_recipe (
       spatial_extent_t extent,
@@ -56,7 +64,8 @@ namespace moppe::terrain {
       std::optional<square_meters_t> channel_initiation_area,
       std::optional<SedimentConcentration> sediment_concentration,
       std::optional<proportion_t> critical_hillslope_gradient,
-      std::optional<proportion_t> maximum_hillslope_multiplier);
+      std::optional<proportion_t> maximum_hillslope_multiplier,
+      std::optional<CoarseToFineEvolution> coarse_to_fine);
     WorldRecipe (spatial_extent_t extent,
                  int resolution,
                  Seed seed,
@@ -66,7 +75,8 @@ namespace moppe::terrain {
                  std::optional<square_meters_t> channel_initiation_area,
                  std::optional<SedimentConcentration> sediment_concentration,
                  std::optional<proportion_t> critical_hillslope_gradient,
-                 std::optional<proportion_t> maximum_hillslope_multiplier);
+                 std::optional<proportion_t> maximum_hillslope_multiplier,
+                 std::optional<CoarseToFineEvolution> coarse_to_fine);
 
     spatial_extent_t m_extent;
     int m_resolution;
@@ -87,7 +97,8 @@ namespace moppe::terrain {
     std::optional<square_meters_t> channel_initiation_area = std::nullopt,
     std::optional<SedimentConcentration> sediment_concentration = std::nullopt,
     std::optional<proportion_t> critical_hillslope_gradient = std::nullopt,
-    std::optional<proportion_t> maximum_hillslope_multiplier = std::nullopt);
+    std::optional<proportion_t> maximum_hillslope_multiplier = std::nullopt,
+    std::optional<CoarseToFineEvolution> coarse_to_fine = std::nullopt);
 }
 
 #endif
@@ -1,4 +1,5 @@
 #include <moppe/game/forest.hh>
+#include <moppe/gfx/signal.hh>
 #include <moppe/map/surface.hh>
 
 #include <tests/recording_renderer.hh>
@@ -7,24 +8,153 @@
 
 #include <algorithm>
 #include <array>
+#include <cmath>
 #include <concepts>
 #include <cstddef>
+#include <cstdint>
 #include <filesystem>
 #include <fstream>
 #include <vector>
 
-static_assert (std::same_as<decltype (moppe::game::ForestSite {}.position),
+namespace {
+  template <mp_units::QuantitySpec auto QS>
+  using ForestColumn = moppe::game::ForestPlan::value_type<
+    moppe::game::ForestPlan::spec_index<QS>>;
+
+  // A site the single-threaded planner kept, in the order it kept them.
+  struct GreedySite {
+    float x;
+    float z;
+    std::uint32_t identity;
+  };
+
+  // The planner as it was before tiling: one pass over the proposal
+  // stream, a global priority sort, and each candidate kept unless a site
+  // already kept lies within the exclusion radius, found through bins of
+  // accepted sites. Tiled plans must keep exactly these sites.
+  std::vector<GreedySite>
+  greedy_forest_sites (const moppe::map::SurfaceReadings& readings,
+                       std::uint32_t seed,
+                       float spacing) {
+    using namespace moppe;
+    struct Candidate {
+      float x;
+      float z;
+      float priority;
+      std::uint32_t identity;
+    };
+    const terrain::TerrainDomain& domain = readings.domain ();
+    const float width = domain.period_x ().numerical_value_in (u::m);
+    const float depth = domain.period_z ().numerical_value_in (u::m);
+    const float proposal_spacing = spacing / std::sqrt (2.0f);
+    const std::uint64_t proposal_count = std::max<std::uint64_t> (
+      1,
+      static_cast<std::uint64_t> (std::ceil ((width / proposal_spacing) *
+                                             (depth / proposal_spacing))));
+    std::vector<Candidate> candidates;
+    for (std::uint64_t proposal = 0; proposal < proposal_count; ++proposal) {
+      const std::uint32_t identity =
+        lattice_hash (static_cast<std::uint32_t> (proposal),
+                      static_cast<std::uint32_t> (proposal >> 32),
+                      seed);
+      const meters_t x = hash_lane (identity, 0) * (width * u::m);
+      const meters_t z = hash_lane (identity, 1) * (depth * u::m);
+      const map::ForestCover cover = spatial::sample<map::forest_cover> (
+        readings,
+        position (Vec3 (
+          x.numerical_value_in (u::m), 0, z.numerical_value_in (u::m))));
+      const float population =
+        band (0.08f * map::forest_cover[mp_units::one],
+              0.62f * map::forest_cover[mp_units::one],
+              cover)
+          .numerical_value_in (mp_units::one);
+      const float proposal_scale = std::lerp (0.55f, 0.95f, population);
+      if (cover < 0.06f * map::forest_cover[mp_units::one] ||
+          hash_lane (identity, 2) > population * proposal_scale)
+        continue;
+      candidates.push_back ({ .x = x.numerical_value_in (u::m),
+                              .z = z.numerical_value_in (u::m),
+                              .priority = hash_lane (identity, 3),
+                              .identity = identity });
+    }
+    std::ranges::sort (candidates,
+                       [] (const Candidate& a, const Candidate& b) {
+                         return a.priority < b.priority ||
+                                (a.priority == b.priority &&
+                                 a.identity < b.identity);
+                       });
+
+    const float exclusion = spacing * 0.40f;
+    const std::uint32_t bins_x =
+      std::max (1U, static_cast<std::uint32_t> (std::ceil (width / exclusion)));
+    const std::uint32_t bins_z =
+      std::max (1U, static_cast<std::uint32_t> (std::ceil (depth / exclusion)));
+    const float bin_x = width / static_cast<float> (bins_x);
+    const float bin_z = depth / static_cast<float> (bins_z);
+    const int reach_x = static_cast<int> (std::ceil (exclusion / bin_x));
+    const int reach_z = static_cast<int> (std::ceil (exclusion / bin_z));
+    const auto wrap = [] (int value, std::uint32_t period) {
+      const int extent = static_cast<int> (period);
+      value %= extent;
+      return static_cast<std::uint32_t> (value < 0 ? value + extent : value);
+    };
+    const auto periodic_delta = [] (float value, float period) {
+      return value - std::round (value / period) * period;
+    };
+    std::vector<std::vector<std::size_t>> bins (
+      static_cast<std::size_t> (bins_x) * bins_z);
+    std::vector<GreedySite> accepted;
+    for (const Candidate& candidate : candidates) {
+      const std::uint32_t bx =
+        std::min (static_cast<std::uint32_t> (candidate.x / bin_x), bins_x - 1);
+      const std::uint32_t bz =
+        std::min (static_cast<std::uint32_t> (candidate.z / bin_z), bins_z - 1);
+      bool separated = true;
+      for (int dz = -reach_z; separated && dz <= reach_z; ++dz)
+        for (int dx = -reach_x; separated && dx <= reach_x; ++dx) {
+          const std::size_t bin =
+            static_cast<std::size_t> (
+              wrap (static_cast<int> (bz) + dz, bins_z)) *
+              bins_x +
+            wrap (static_cast<int> (bx) + dx, bins_x);
+          for (const std::size_t kept : bins[bin]) {
+            const float delta_x =
+              periodic_delta (candidate.x - accepted[kept].x, width);
+            const float delta_z =
+              periodic_delta (candidate.z - accepted[kept].z, depth);
+            if (delta_x * delta_x + delta_z * delta_z <
+                exclusion * exclusion) {
+              separated = false;
+              break;
+            }
+          }
+        }
+      if (!separated)
+        continue;
+      bins[static_cast<std::size_t> (bz) * bins_x + bx].push_back (
+        accepted.size ());
+      accepted.push_back (
+        { .x = candidate.x, .z = candidate.z, .identity = candidate.identity });
+    }
+    return accepted;
+  }
+}
+
+static_assert (std::same_as<ForestColumn<mp_units::isq::position_vector>,
                             moppe::position_t>);
-static_assert (std::same_as<decltype (moppe::game::ForestSite {}.normal),
+static_assert (std::same_as<ForestColumn<moppe::terrain::terrain_normal>,
                             moppe::terrain::TerrainNormal>);
-static_assert (std::same_as<decltype (moppe::game::ForestSite {}.cover),
+static_assert (std::same_as<ForestColumn<moppe::map::forest_cover>,
                             moppe::map::ForestCover>);
-static_assert (std::same_as<decltype (moppe::game::ForestSite {}.moisture),
+static_assert (std::same_as<ForestColumn<moppe::map::surface_moisture>,
                             moppe::map::SurfaceMoisture>);
-static_assert (std::same_as<decltype (moppe::game::ForestSite {}.size),
+static_assert (std::same_as<ForestColumn<moppe::game::tree_size_factor>,
                             moppe::game::TreeSizeFactor>);
-static_assert (std::same_as<decltype (moppe::game::ForestPlan {}.period),
-                            moppe::spatial_extent_t>);
+static_assert (std::same_as<ForestColumn<moppe::game::tree_seed>,
+                            moppe::game::TreeSeed>);
+static_assert (
+  std::same_as<decltype (moppe::game::ForestPopulation {}.period ()),
+               const moppe::spatial_extent_t&>);
 static_assert (std::same_as<decltype (moppe::render::ForestInstance {}.height),
                             moppe::meters_t>);
 static_assert (
@@ -48,19 +178,23 @@ MOPPE_TEST (global_forest_sites_are_stable_and_follow_canopy_cover) {
     game::plan_global_forest (surface, readings, 0xa511e9b3U);
   const game::ForestPlan second =
     game::plan_global_forest (surface, readings, 0xa511e9b3U);
-  MOPPE_CHECK (first.sites.size () > 100);
-  MOPPE_CHECK (first.sites.size () == second.sites.size ());
-  for (std::size_t index = 0; index < first.sites.size (); ++index) {
-    const game::ForestSite& site = first.sites[index];
-    MOPPE_CHECK (site.seed == second.sites[index].seed);
-    MOPPE_CHECK_NEAR (position_value (site.position)[0],
-                      position_value (second.sites[index].position)[0],
+  MOPPE_CHECK (first.size () > 100);
+  MOPPE_CHECK (first.domain () == second.domain ());
+  MOPPE_CHECK (spatial::get<game::tree_seed> (first) ==
+               spatial::get<game::tree_seed> (second));
+  const auto& positions = spatial::get<mp_units::isq::position_vector> (first);
+  const auto& repeated = spatial::get<mp_units::isq::position_vector> (second);
+  for (std::size_t index = 0; index < first.size (); ++index) {
+    MOPPE_CHECK_NEAR (position_value (positions[index])[0],
+                      position_value (repeated[index])[0],
                       1e-6f);
-    MOPPE_CHECK_NEAR (position_value (site.position)[2],
-                      position_value (second.sites[index].position)[2],
+    MOPPE_CHECK_NEAR (position_value (positions[index])[2],
+                      position_value (repeated[index])[2],
                       1e-6f);
-    MOPPE_CHECK (site.cover >= 0.06f * map::forest_cover[mp_units::one]);
-    MOPPE_CHECK (site.normal.numerical_value_in (mp_units::one)[1] > 0.99f);
+    MOPPE_CHECK (spatial::get<map::forest_cover> (first)[index] >=
+                 0.06f * map::forest_cover[mp_units::one]);
+    MOPPE_CHECK (spatial::get<terrain::terrain_normal> (first)[index]
+                   .numerical_value_in (mp_units::one)[1] > 0.99f);
   }
 }
 
@@ -79,7 +213,7 @@ MOPPE_TEST (global_forest_sites_leave_materialized_clearings_empty) {
       .seed = 0xfeed1234U });
 
   MOPPE_CHECK (
-    game::plan_global_forest (surface, readings, 0x31415926U).sites.empty ());
+    game::plan_global_forest (surface, readings, 0x31415926U).size () == 0);
 }
 
 MOPPE_TEST (global_forest_population_has_a_periodic_hard_core) {
@@ -97,11 +231,12 @@ MOPPE_TEST (global_forest_population_has_a_periodic_hard_core) {
 
   const game::ForestPlan plan =
     game::plan_global_forest (surface, readings, 0x96c41d2bU);
-  MOPPE_CHECK (plan.sites.size () > 700);
-  for (std::size_t i = 0; i < plan.sites.size (); ++i)
-    for (std::size_t j = i + 1; j < plan.sites.size (); ++j) {
-      const Vec3 a = position_value (plan.sites[i].position);
-      const Vec3 b = position_value (plan.sites[j].position);
+  const auto& positions = spatial::get<mp_units::isq::position_vector> (plan);
+  MOPPE_CHECK (plan.size () > 700);
+  for (std::size_t i = 0; i < plan.size (); ++i)
+    for (std::size_t j = i + 1; j < plan.size (); ++j) {
+      const Vec3 a = position_value (positions[i]);
+      const Vec3 b = position_value (positions[j]);
       const float dx = std::abs (a[0] - b[0]);
       const float dz = std::abs (a[2] - b[2]);
       const float periodic_x = std::min (dx, period - dx);
@@ -111,34 +246,90 @@ MOPPE_TEST (global_forest_population_has_a_periodic_hard_core) {
     }
 }
 
+MOPPE_TEST (tiled_forest_thinning_keeps_the_serial_plan) {
+  using namespace moppe;
+  map::SurfaceGeometry surface = map::SurfaceGeometry (terrain::TerrainDomain (
+    129, 129, spatial_extent_in_metres (Vec3 (640, 0, 640))));
+  std::ranges::fill (
+    spatial::get<terrain::surface_elevation> (surface),
+    terrain::surface_elevation_point (0.42f * 180.0f * mp_units::si::metre));
+  map::rebuild_geometry (surface);
+  const map::SurfaceReadings readings = test::complete_readings (
+    surface,
+    { .moisture = test::uniform_moisture (surface.domain (), 0.48f),
+      .seed = 0x5eed0043U });
+
+  const std::vector<GreedySite> serial =
+    greedy_forest_sites (readings, 0x7a11e5edU, 5.0f);
+  MOPPE_CHECK (serial.size () > 100);
+  const auto keeps_the_serial_plan = [&] (const game::ForestPlan& tiled) {
+    if (tiled.size () != serial.size ())
+      return false;
+    const auto& positions =
+      spatial::get<mp_units::isq::position_vector> (tiled);
+    const auto& seeds = spatial::get<game::tree_seed> (tiled);
+    for (std::size_t site = 0; site < serial.size (); ++site) {
+      const Vec3& at = position_value (positions[site]);
+      if (at[0] != serial[site].x || at[2] != serial[site].z ||
+          seeds[site] != serial[site].identity * game::tree_seed[mp_units::one])
+        return false;
+    }
+    return true;
+  };
+  for (const std::uint32_t tile_bins : { 1U, 4U, 64U, 1U << 20 })
+    MOPPE_CHECK (keeps_the_serial_plan (game::detail::plan_global_forest (
+      surface, readings, 0x7a11e5edU, 5.0f * u::m, tile_bins)));
+  MOPPE_CHECK (keeps_the_serial_plan (
+    game::plan_global_forest (surface, readings, 0x7a11e5edU)));
+}
+
 MOPPE_TEST (baked_forest_plan_round_trips_and_rejects_bad_identity) {
   using namespace moppe;
   const std::filesystem::path path =
-    std::filesystem::temp_directory_path () / "moppe-forest-plan-test.bin";
+    std::filesystem::temp_directory_path () / "moppe-forest-plan-test.arrows";
   const spatial_extent_t period = spatial_extent_in_metres (Vec3 (640, 0, 480));
-  game::ForestPlan plan;
-  plan.period = period;
-  plan.sites.push_back (
-    { .position = position (Vec3 (12, 34, 56)),
-      .normal = Vec3 (0, 1, 0) * terrain::terrain_normal[mp_units::one],
-      .cover = 0.7f * map::forest_cover[mp_units::one],
-      .moisture = 0.4f * map::surface_moisture[mp_units::one],
-      .size = 1.2f * game::tree_size_factor[mp_units::one],
-      .seed = 1234,
-      .form = game::ForestForm::conifer,
-      .age = game::ForestAge::ancient });
-
-  game::save_forest_plan (plan, 99, path.string ());
+  game::ForestPlan plan (game::ForestPopulation (1, 99, period));
+  spatial::get<mp_units::isq::position_vector> (plan)[0] =
+    position (Vec3 (12, 34, 56));
+  spatial::get<terrain::terrain_normal> (plan)[0] =
+    Vec3 (0, 1, 0) * terrain::terrain_normal[mp_units::one];
+  spatial::get<map::forest_cover> (plan)[0] =
+    0.7f * map::forest_cover[mp_units::one];
+  spatial::get<map::surface_moisture> (plan)[0] =
+    0.4f * map::surface_moisture[mp_units::one];
+  spatial::get<game::tree_size_factor> (plan)[0] =
+    1.2f * game::tree_size_factor[mp_units::one];
+  spatial::get<game::tree_seed> (plan)[0] =
+    1234U * game::tree_seed[mp_units::one];
+  spatial::get<game::tree_form> (plan)[0] =
+    game::forest_form_code (game::ForestForm::conifer);
+  spatial::get<game::tree_age_class> (plan)[0] =
+    game::forest_age_code (game::ForestAge::ancient);
+
+  game::save_forest_plan (plan, path.string ());
   const std::optional<game::ForestPlan> restored =
     game::try_load_forest_plan (path.string (), 99, period);
   MOPPE_CHECK (restored.has_value ());
-  MOPPE_CHECK (restored->sites.size () == 1);
-  MOPPE_CHECK (restored->sites[0].seed == 1234);
-  MOPPE_CHECK (restored->sites[0].form == game::ForestForm::conifer);
-  MOPPE_CHECK (restored->sites[0].age == game::ForestAge::ancient);
+  MOPPE_CHECK (restored->size () == 1);
+  MOPPE_CHECK (spatial::get<game::tree_seed> (*restored)[0] ==
+               1234U * game::tree_seed[mp_units::one]);
+  MOPPE_CHECK (game::forest_form (spatial::get<game::tree_form> (
+                 *restored)[0]) == game::ForestForm::conifer);
+  MOPPE_CHECK (game::forest_age (spatial::get<game::tree_age_class> (
+                 *restored)[0]) == game::ForestAge::ancient);
   MOPPE_CHECK_NEAR (
-    position_value (restored->sites[0].position)[1], 34.0f, 0.0f);
+    position_value (
+      spatial::get<mp_units::isq::position_vector> (*restored)[0])[1],
+    34.0f,
+    0.0f);
   MOPPE_CHECK (!game::try_load_forest_plan (path.string (), 100, period));
+  MOPPE_CHECK (!game::try_load_forest_plan (
+    path.string (), 99, spatial_extent_in_metres (Vec3 (480, 0, 640))));
+
+  spatial::get<game::tree_form> (plan)[0] =
+    std::uint8_t { 7 } * game::tree_form[mp_units::one];
+  game::save_forest_plan (plan, path.string ());
+  MOPPE_CHECK (!game::try_load_forest_plan (path.string (), 99, period));
 
   std::ofstream (path, std::ios::binary | std::ios::trunc).put ('x');
   MOPPE_CHECK (!game::try_load_forest_plan (path.string (), 99, period));
@@ -0,0 +1,210 @@
+#include <moppe/game/game_session_history.hh>
+#include <moppe/game/input_frame_adapter.hh>
+#include <moppe/map/surface.hh>
+
+#include <tests/test.hh>
+
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
+
+using namespace moppe;
+
+namespace {
+  struct Ride {
+    map::SurfaceGeometry surface = map::SurfaceGeometry (
+      terrain::TerrainDomain (17,
+                              17,
+                              spatial_extent_in_metres (Vec3 (200, 0, 200))));
+    game::WorldParams world;
+    std::vector<mov::Box> obstacles;
+    game::InputFrame input;
+    // A binary fraction, so the session clock counts whole steps exactly.
+    seconds_t step = seconds (1.0f / 64.0f);
+
+    Ride () {
+      std::ranges::fill (spatial::get<terrain::surface_elevation> (surface),
+                         terrain::surface_elevation_point (
+                           10.0f * mp_units::si::metre));
+      map::rebuild_geometry (surface);
+      world.map_size = spatial_extent_in_metres (Vec3 (200, 20, 200));
+      world.resolution = static_cast<int> (surface.domain ().width ());
+      world.water_level = 0 * u::m;
+
+      game::InputFrameAdapter keys;
+      keys.key (platform::Key::D, true);
+      keys.key (platform::Key::W, true);
+      input = keys.take_frame ();
+    }
+
+    void prepare (game::GameSession& session) const {
+      session.stars ().generate (surface, world, 12);
+    }
+
+    // As MoppeGame::tick does: the clock, then one fixed step.
+    void advance (game::GameSession& session) const {
+      session.logic ().m_total_time += seconds_value (step);
+      game::advance_game_session (
+        world, surface, obstacles, session, input, step);
+    }
+  };
+
+  void check_same (const game::GameState& actual,
+                   const game::GameState& expected) {
+    MOPPE_CHECK (actual.logic.m_total_time == expected.logic.m_total_time);
+    MOPPE_CHECK (actual.logic.m_odometer == expected.logic.m_odometer);
+    MOPPE_CHECK (position_value (actual.vehicle.position) ==
+                 position_value (expected.vehicle.position));
+    MOPPE_CHECK (position_value (actual.camera.position) ==
+                 position_value (expected.camera.position));
+    MOPPE_CHECK (actual.stars.count == expected.stars.count);
+    MOPPE_CHECK (actual.stars.collected == expected.stars.collected);
+    for (std::size_t star = 0; star < expected.stars.count; ++star) {
+      MOPPE_CHECK (actual.stars.stars[star].position ==
+                   expected.stars.stars[star].position);
+      MOPPE_CHECK (actual.stars.stars[star].respawn_at ==
+                   expected.stars.stars[star].respawn_at);
+    }
+    MOPPE_CHECK (actual.stars.clock == expected.stars.clock);
+    MOPPE_CHECK (actual.dust.next_id == expected.dust.next_id);
+    MOPPE_CHECK (actual.dust.emissions.size () ==
+                 expected.dust.emissions.size ());
+    for (std::size_t emission = 0;
+         emission < std::min (actual.dust.emissions.size (),
+                              expected.dust.emissions.size ());
+         ++emission)
+      MOPPE_CHECK (actual.dust.emissions[emission].id ==
+                   expected.dust.emissions[emission].id);
+  }
+}
+
+MOPPE_TEST (a_session_history_restores_any_recent_step) {
+  const Ride ride;
+  game::GameSession session (ride.world, ride.surface);
+  ride.prepare (session);
+  game::GameSessionHistory history (120, 16);
+  const std::size_t held_bytes = history.owned_bytes ();
+
+  std::vector<game::GameState> live;
+  for (int step = 0; step < 300; ++step) {
+    ride.advance (session);
+    // Collecting a star changes it, so later snapshots carry star changes
+    // as well as keyframes.
+    if (step == 150)
+      session.stars ().update (
+        session.stars ().state ().stars[3].position, 0.0f, 1.0f / 64.0f);
+    history.record (session);
+    live.push_back (session.state ());
+  }
+
+  MOPPE_CHECK (history.size () >= 120);
+  MOPPE_CHECK (history.size () <= 136);
+  MOPPE_CHECK (history.owned_bytes () == held_bytes);
+  MOPPE_CHECK (live.back ().stars.collected >= 1);
+
+  for (const std::size_t back : { std::size_t (0),
+                                  std::size_t (1),
+                                  std::size_t (17),
+                                  std::size_t (119),
+                                  history.size () - 1 }) {
+    history.restore (session, back);
+    check_same (session.state (), live[live.size () - 1 - back]);
+  }
+  MOPPE_CHECK (history.steps_back_for (seconds (0.5f)) == 32);
+  MOPPE_CHECK (history.steps_back_for (seconds (1000.0f)) ==
+               history.size () - 1);
+
+  bool refused = false;
+  try {
+    history.restore (session, history.size ());
+  } catch (const std::out_of_range&) {
+    refused = true;
+  }
+  MOPPE_CHECK (refused);
+}
+
+MOPPE_TEST (rewinding_a_session_history_continues_from_the_restored_step) {
+  const Ride ride;
+  game::GameSession session (ride.world, ride.surface);
+  ride.prepare (session);
+  game::GameSessionHistory history (60, 8);
+  for (int step = 0; step < 90; ++step) {
+    ride.advance (session);
+    history.record (session);
+  }
+  const game::GameState finished = session.state ();
+
+  // Back 40 steps and through them again: the same inputs ride the same
+  // line, and the history reads as if nothing had been undone.
+  history.rewind (session, 40);
+  MOPPE_CHECK (history.total_time (0) < finished.logic.m_total_time);
+  for (int step = 0; step < 40; ++step) {
+    ride.advance (session);
+    history.record (session);
+  }
+  check_same (session.state (), finished);
+
+  history.restore (session, 0);
+  check_same (session.state (), finished);
+  history.clear ();
+  MOPPE_CHECK (history.empty ());
+}
+
+MOPPE_TEST (collecting_every_star_keeps_the_whole_history) {
+  const Ride ride;
+  game::GameSession session (ride.world, ride.surface);
+  session.stars ().generate (ride.surface, ride.world, 200);
+  game::GameSessionHistory history (120, 16);
+
+  // Every star is collected early on and then waits out its respawn
+  // through the rest of the ride. Each is a change once, when collected,
+  // rather than at every step it waits.
+  std::vector<game::GameState> live;
+  for (int step = 0; step < 400; ++step) {
+    ride.advance (session);
+    if (step >= 10 && step < 210)
+      session.stars ().update (
+        session.stars ().state ().stars[step - 10].position,
+        0.0f,
+        1.0f / 64.0f);
+    history.record (session);
+    live.push_back (session.state ());
+  }
+  MOPPE_CHECK (live.back ().stars.collected >= 200);
+  MOPPE_CHECK (history.size () >= 120);
+
+  const std::size_t oldest = history.size () - 1;
+  history.restore (session, 60);
+  check_same (session.state (), live[live.size () - 1 - 60]);
+  history.rewind (session, oldest);
+  check_same (session.state (), live[live.size () - 1 - oldest]);
+  MOPPE_CHECK (history.size () == 1);
+}
+
+MOPPE_TEST (drifting_at_full_throttle_keeps_ten_seconds_of_history) {
+  const Ride ride;
+  game::GameSession session (ride.world, ride.surface);
+  ride.prepare (session);
+  // Ten seconds of 64 Hz steps, from the newest snapshot to the oldest.
+  constexpr std::size_t span = 640;
+  game::GameSessionHistory history (span + 1);
+
+  // Turning at full throttle throws roost, drift dirt and exhaust at
+  // nearly every step, each puff alive for most of a second.
+  std::vector<game::GameState> live;
+  std::size_t most_dust = 0;
+  for (std::size_t step = 0; step < 2 * span; ++step) {
+    ride.advance (session);
+    history.record (session);
+    live.push_back (session.state ());
+    most_dust = std::max (most_dust, live.back ().dust.emissions.size ());
+  }
+  MOPPE_CHECK (most_dust > 16);
+  MOPPE_CHECK (history.size () > span);
+  MOPPE_CHECK (history.total_time (0) - history.total_time (span) == 10.0);
+
+  history.restore (session, span);
+  check_same (session.state (), live[live.size () - 1 - span]);
+  history.restore (session, span / 3);
+  check_same (session.state (), live[live.size () - 1 - span / 3]);
+}
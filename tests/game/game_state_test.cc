@@ -3,6 +3,7 @@
 #include <moppe/game/input_frame_adapter.hh>
 #include <moppe/map/surface.hh>
 
+#include <tests/recording_renderer.hh>
 #include <tests/test.hh>
 
 #include <algorithm>
@@ -486,7 +487,37 @@ MOPPE_TEST (star_state_restores_attraction_and_respawn_state) {
   MOPPE_CHECK (restored.collected == 0);
   check_vector (restored.stars[0].position, initial.stars[0].position);
   MOPPE_CHECK_NEAR (restored.stars[0].phase, initial.stars[0].phase, 1e-6f);
-  MOPPE_CHECK_NEAR (restored.stars[0].respawn, initial.stars[0].respawn, 1e-6f);
+  MOPPE_CHECK (restored.stars[0].respawn_at == initial.stars[0].respawn_at);
+  MOPPE_CHECK (restored.clock == initial.clock);
+}
+
+MOPPE_TEST (visible_stars_draw_as_one_instance_batch_per_mesh) {
+  using namespace moppe;
+  map::SurfaceGeometry surface = map::SurfaceGeometry (terrain::TerrainDomain (
+    17, 17, spatial_extent_in_metres (Vec3 (100, 0, 100))));
+  std::ranges::fill (spatial::get<terrain::surface_elevation> (surface),
+                     moppe::terrain::surface_elevation_point (
+                       (0.5f) * 20.0f * mp_units::si::metre));
+  map::rebuild_geometry (surface);
+  game::WorldParams world;
+  world.map_size = spatial_extent_in_metres (Vec3 (100, 20, 100));
+  world.water_level = 0 * u::m;
+  game::Stars stars;
+  stars.generate (surface, world, 8);
+  const game::Stars::State initial = stars.state ();
+  MOPPE_CHECK (stars.update (initial.stars[0].position, 0.0f, 1.0f / 60.0f) ==
+               1);
+
+  test::RecordingRenderer renderer;
+  game::FrameEnv env {};
+  env.camera_pos = position (Vec3 (50, 10, 50));
+  env.time = seconds (2.0f);
+  stars.render (renderer, env);
+
+  // The collected star waits to respawn; the other seven share two draws.
+  MOPPE_CHECK (renderer.meshes_drawn == 0);
+  MOPPE_CHECK (
+    (renderer.instance_batches == std::vector<std::size_t> { 7, 7 }));
 }
 
 MOPPE_TEST (dust_state_is_a_bounded_deterministic_emission_log) {
@@ -690,3 +721,61 @@ MOPPE_TEST (game_session_advance_replays_an_input_tape_on_the_same_world) {
                     seconds_value (live_state.dust.logical_time),
                     1e-6f);
 }
+
+MOPPE_TEST (game_state_reprojects_onto_a_finer_surface_of_the_same_extent) {
+  using namespace moppe;
+  // A coarse flat preview and a finer sloping world over the same square.
+  const auto planar = [] (std::size_t resolution, float base, float slope) {
+    map::SurfaceGeometry surface =
+      map::SurfaceGeometry (terrain::TerrainDomain (
+        resolution,
+        resolution,
+        spatial_extent_in_metres (Vec3 (100, 0, 100))));
+    const float spacing = 100.0f / static_cast<float> (resolution);
+    for (std::size_t y = 0; y < resolution; ++y)
+      for (std::size_t x = 0; x < resolution; ++x)
+        spatial::get<terrain::surface_elevation> (
+          surface[terrain::TerrainIndex { x, y }]) =
+          terrain::surface_elevation_point (
+            (base + slope * spacing * static_cast<float> (x)) *
+            mp_units::si::metre);
+    map::rebuild_geometry (surface);
+    return surface;
+  };
+  const map::SurfaceGeometry preview = planar (8, 10.0f, 0.0f);
+  const map::SurfaceGeometry full = planar (16, 25.0f, 0.1f);
+
+  game::GameState state;
+  state.vehicle.position = position (Vec3 (20, 12, 30));
+  state.vehicle.fall_top = 14 * u::m;
+  state.car.position = position (Vec3 (40, 10, 40));
+  state.walker.position = position (Vec3 (30, 11, 10));
+  state.camera.position = position (Vec3 (10, 18, 30));
+  state.camera.target = position (Vec3 (20, 12, 30));
+  state.logic.m_fp_eye = Vec3 (20, 13, 30);
+  state.stars.count = 1;
+  state.stars.stars[0].position = Vec3 (50, 15, 60);
+  state.stars.stars[1].position = Vec3 (50, 15, 60);
+
+  const game::GameState moved =
+    game::reproject_game_state (state, preview, full);
+  // Clearance above the ground is kept; the full world's ground at x is
+  // 25 m plus a tenth of x.
+  check_position (moved.vehicle.position, position (Vec3 (20, 29, 30)));
+  MOPPE_CHECK_NEAR (
+    moved.vehicle.fall_top.numerical_value_in (u::m), 31.0f, 1e-4f);
+  check_position (moved.car.position, position (Vec3 (40, 29, 40)));
+  check_position (moved.walker.position, position (Vec3 (30, 29, 10)));
+  check_position (moved.camera.position, position (Vec3 (10, 34, 30)));
+  check_position (moved.camera.target, moved.vehicle.position);
+  check_vector (moved.logic.m_fp_eye, Vec3 (20, 30, 30));
+  check_vector (moved.stars.stars[0].position, Vec3 (50, 35, 60));
+  // Slots past the live count are left alone.
+  check_vector (moved.stars.stars[1].position, Vec3 (50, 15, 60));
+
+  // Back again restores the original heights.
+  const game::GameState returned =
+    game::reproject_game_state (moved, full, preview);
+  check_position (returned.vehicle.position, state.vehicle.position);
+  check_position (returned.camera.position, state.camera.position);
+}
@@ -7,6 +7,7 @@
 #include <filesystem>
 #include <memory>
 #include <sstream>
+#include <string_view>
 #include <type_traits>
 #include <vector>
 
@@ -96,10 +97,42 @@ MOPPE_TEST (generated_world_owns_a_complete_named_world) {
   MOPPE_CHECK (world->water_surface ().size () == 17 * 17);
   MOPPE_CHECK (world->readings ().size () == 17 * 17);
   MOPPE_CHECK (world->trails ().domain == world->surface ().domain ());
-  MOPPE_CHECK (world->forest ().period ==
+  MOPPE_CHECK (world->forest ().domain ().period () ==
                spatial_extent_in_metres (Vec3 (640, 0, 640)));
 }
 
+MOPPE_TEST (generated_world_accounts_for_every_part_it_owns) {
+  using namespace moppe;
+  using namespace moppe::terrain;
+
+  const spatial_extent_t extent =
+    spatial_extent_in_metres (Vec3 (640, 650, 640));
+  game::WorldParams params;
+  params.map_size = extent;
+  params.resolution = 17;
+  const std::unique_ptr<game::GeneratedWorld> world =
+    build_test_world (test_world_recipe (extent, 17, Seed { 42 }), params);
+
+  const memory::Ledger ledger = game::account_memory (*world);
+  const auto entry = [&ledger] (std::string_view name) {
+    for (const memory::LedgerEntry& candidate : ledger.entries ())
+      if (candidate.name == name)
+        return candidate.bytes;
+    return std::size_t (0);
+  };
+  MOPPE_CHECK (entry ("surface.surface_elevation") >= 17 * 17 * sizeof (float));
+  MOPPE_CHECK (entry ("drainage.receiver") >= 17 * 17 * sizeof (CellIndex));
+  MOPPE_CHECK (entry ("census.membership") == 17 * 17 * sizeof (WaterBodyId));
+  MOPPE_CHECK (entry ("trails.earthwork_delta") >= 17 * 17 * sizeof (float));
+
+  std::size_t surface = 0;
+  for (const memory::LedgerEntry& candidate : ledger.entries ())
+    if (candidate.name.starts_with ("surface."))
+      surface += candidate.bytes;
+  MOPPE_CHECK (surface > 0);
+  MOPPE_CHECK (ledger.total_bytes () > surface);
+}
+
 MOPPE_TEST (generated_world_handoffs_move_the_owner_not_the_world) {
   using namespace moppe;
   using namespace moppe::terrain;
@@ -216,10 +249,8 @@ MOPPE_TEST (finished_world_cache_round_trips_every_owned_artifact) {
   MOPPE_CHECK (restored->readings ().size () == written->readings ().size ());
   MOPPE_CHECK (restored->water_surface ().size () ==
                written->water_surface ().size ());
-  MOPPE_CHECK (restored->forest ().period == written->forest ().period);
-  MOPPE_CHECK (restored->forest ().sites.size () ==
-               written->forest ().sites.size ());
-  MOPPE_CHECK (std::filesystem::is_regular_file (cache / "forest-plan.bin"));
+  MOPPE_CHECK (restored->forest ().domain () == written->forest ().domain ());
+  MOPPE_CHECK (std::filesystem::is_regular_file (cache / "forest.arrows"));
 
   const WorldRecipe other_seed = test_world_recipe (extent, 17, Seed { 92 });
   MOPPE_CHECK (!game::try_load_world_cache (
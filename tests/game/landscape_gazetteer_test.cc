@@ -2,15 +2,18 @@
 
 #include <tests/test.hh>
 
+#include <algorithm>
+#include <cmath>
 #include <sstream>
+#include <string>
 #include <vector>
 
 using namespace moppe;
 
 namespace {
   struct GazetteerFixture {
-    static constexpr int side = 17;
-    static constexpr std::size_t count = side * side;
+    int side;
+    std::size_t count = static_cast<std::size_t> (side) * side;
 
     terrain::TerrainDomain domain = terrain::TerrainDomain (
       side, side, spatial_extent_in_metres (Vec3 (1600, 0, 1600)));
@@ -22,8 +25,9 @@ namespace {
     terrain::RiverNetwork rivers;
     terrain::TrailNetwork trail;
 
-    GazetteerFixture ()
-        : flood { .surface = terrain::make_flood_surface (
+    explicit GazetteerFixture (int lattice_side = 17)
+        : side (lattice_side),
+          flood { .surface = terrain::make_flood_surface (
                     domain,
                     std::vector<float> (count, 0.0f),
                     std::vector<float> (count, 0.0f)),
@@ -44,7 +48,7 @@ namespace {
           spatial::get<terrain::surface_elevation> (surface[{
             static_cast<std::size_t> (x), static_cast<std::size_t> (z) }]) =
             terrain::surface_elevation_point (hill * u::m);
-          const std::size_t cell = z * side + x;
+          const std::size_t cell = static_cast<std::size_t> (z) * side + x;
           const auto cell_index = static_cast<std::uint32_t> (cell);
           flood.spill_receiver[cell] = terrain::CellIndex { cell_index };
           drainage.receiver[cell] = terrain::CellIndex { cell_index };
@@ -94,6 +98,55 @@ MOPPE_TEST (landscape_gazetteer_is_a_deterministic_typed_landscape_reading) {
   }
 }
 
+MOPPE_TEST (landscape_gazetteer_land_sites_keep_clear_of_earlier_shots) {
+  // Fine enough that the best samples of one objective crowd together, so
+  // choosing has to look past its leaders.
+  GazetteerFixture fixture (65);
+  const game::LandscapeGazetteer gazetteer =
+    game::plan_landscape_gazetteer (fixture.surface,
+                                    fixture.readings,
+                                    fixture.flood,
+                                    fixture.census,
+                                    fixture.drainage,
+                                    fixture.rivers,
+                                    fixture.trail,
+                                    position (Vec3 (400, 70, 400)),
+                                    normalized (Vec3 (0.42f, 0.37f, 0.83f)));
+  const auto distance = [&] (terrain::CellIndex a, terrain::CellIndex b) {
+    const int side = fixture.side;
+    const auto image = [side] (int delta) {
+      delta = std::abs (delta) % side;
+      return std::min (delta, side - delta);
+    };
+    const int dx = image (static_cast<int> (a.value % side) -
+                          static_cast<int> (b.value % side));
+    const int dz = image (static_cast<int> (a.value / side) -
+                          static_cast<int> (b.value / side));
+    return std::hypot (
+      dx * fixture.domain.spacing_x ().numerical_value_in (u::m),
+      dz * fixture.domain.spacing_z ().numerical_value_in (u::m));
+  };
+
+  // The other grass-gradient views and the aerial reuse a site chosen for
+  // an earlier shot; water shots follow their own features.
+  const std::vector<std::string> chosen_on_land {
+    "forest-floor",           "forest-sunward", "forest-shadowplay",
+    "forest-interior",        "open-meadow",    "grass-gradient-sunward",
+    "wetland-edge",           "eroded-slope",   "highland-vista",
+  };
+  std::size_t land_sites = 0;
+  for (std::size_t index = 0; index < gazetteer.shots.size (); ++index) {
+    if (std::ranges::find (chosen_on_land, gazetteer.shots[index].name) ==
+        chosen_on_land.end ())
+      continue;
+    ++land_sites;
+    for (std::size_t earlier = 0; earlier < index; ++earlier)
+      MOPPE_CHECK (distance (gazetteer.shots[index].site,
+                             gazetteer.shots[earlier].site) >= 90.0f);
+  }
+  MOPPE_CHECK (land_sites == chosen_on_land.size ());
+}
+
 MOPPE_TEST (landscape_gazetteer_csv_names_units_and_exact_images) {
   game::LandscapeGazetteer gazetteer;
   gazetteer.shots.push_back ({
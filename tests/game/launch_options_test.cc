@@ -86,9 +86,13 @@ MOPPE_TEST (launch_help_lists_every_supported_option_and_short_alias) {
          "--sediment-concentration",
          "--hillslope-critical-gradient",
          "--hillslope-max-multiplier",
+         "--coarse-orogeny",
          "--world-cache-key",
          "--refresh-world-cache",
          "--no-world-cache",
+         "--no-world-preview",
+         "--trace",
+         "--record-input",
          "--screenshot",
          "--water-screenshot",
          "--window-size",
@@ -188,6 +192,8 @@ MOPPE_TEST (launch_rejects_malformed_command_lines) {
   MOPPE_CHECK (rejects ({ "--sediment-concentration", "1.1" }));
   MOPPE_CHECK (rejects ({ "--hillslope-critical-gradient", "0" }));
   MOPPE_CHECK (rejects ({ "--hillslope-max-multiplier", "0.9" }));
+  MOPPE_CHECK (rejects ({ "--coarse-orogeny", "0" }));
+  MOPPE_CHECK (rejects ({ "--coarse-orogeny", "4" }));
   MOPPE_CHECK (rejects ({ "--world-cache-key" }));
   MOPPE_CHECK (rejects ({ "--world-cache-key", "../shared" }));
   MOPPE_CHECK (rejects ({ "--world-cache-key", "spaces are unsafe" }));
@@ -213,6 +219,15 @@ MOPPE_TEST (launch_selects_stable_whole_world_cache_policy) {
                game::WorldCacheMode::Refresh);
   MOPPE_CHECK (parsed ({ "--no-world-cache" }).world_cache.mode ==
                game::WorldCacheMode::Disabled);
+  MOPPE_CHECK (options.world_preview);
+  MOPPE_CHECK (!parsed ({ "--no-world-preview" }).world_preview);
+  MOPPE_CHECK (options.trace_path.empty ());
+  MOPPE_CHECK (parsed ({ "--trace", "/tmp/moppe-trace.json" }).trace_path ==
+               "/tmp/moppe-trace.json");
+  MOPPE_CHECK (options.input_tape_path.empty ());
+  MOPPE_CHECK (
+    parsed ({ "--record-input", "/tmp/ride.tape" }).input_tape_path ==
+    "/tmp/ride.tape");
 }
 
 MOPPE_TEST (launch_captures_pin_a_seed_and_stay_out_of_the_way) {
@@ -222,6 +237,7 @@ MOPPE_TEST (launch_captures_pin_a_seed_and_stay_out_of_the_way) {
   MOPPE_CHECK (shot.config.capture_frames);
   MOPPE_CHECK (!shot.config.activate);
   MOPPE_CHECK (shot.seed == 123);
+  MOPPE_CHECK (!shot.world_preview);
 
   // An explicit seed still wins over the capture default.
   MOPPE_CHECK (
@@ -297,7 +313,9 @@ MOPPE_TEST (launch_recipe_carries_the_resolved_seed_and_profile) {
                                           "--hillslope-critical-gradient",
                                           "0.8",
                                           "--hillslope-max-multiplier",
-                                          "4" });
+                                          "4",
+                                          "--coarse-orogeny",
+                                          "2" });
   options.seed = 4321;
   const terrain::WorldRecipe recipe = game::make_launch_recipe (options);
   MOPPE_CHECK (recipe.seed ().value == 4321u);
@@ -315,6 +333,7 @@ MOPPE_TEST (launch_recipe_carries_the_resolved_seed_and_profile) {
                0.8f * proportion[mp_units::one]);
   MOPPE_CHECK (recipe.evolution ().maximum_hillslope_diffusivity_multiplier ==
                4.0f * proportion[mp_units::one]);
+  MOPPE_CHECK (recipe.evolution ().coarse_to_fine.coarse_levels == 2);
 }
 
 MOPPE_TEST (launch_benchmark_environment_reaches_the_backend) {
@@ -0,0 +1,135 @@
+#include <moppe/game/rider_water.hh>
+#include <moppe/parallel.hh>
+
+#include <tests/test.hh>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+using namespace moppe;
+
+namespace {
+  // A lake a metre and a half deep over flat ground, with a shore five
+  // metres high across the far rows.
+  struct LakeShore {
+    terrain::TerrainDomain domain { 32, 32, 2.0f * u::m, 2.0f * u::m };
+    map::SurfaceGeometry surface { domain };
+    terrain::WaterSheets water { domain };
+
+    LakeShore () {
+      for (std::size_t z = 0; z < domain.height (); ++z)
+        for (std::size_t x = 0; x < domain.width (); ++x) {
+          const terrain::TerrainIndex site { x, z };
+          spatial::get<terrain::surface_elevation> (surface[site]) =
+            terrain::surface_elevation_point ((z >= 13 ? 5.0f : 0.0f) * u::m);
+          spatial::get<terrain::surface_elevation> (water[site]) =
+            terrain::surface_elevation_point (1.5f * u::m);
+        }
+      map::rebuild_geometry (surface);
+    }
+
+    // A vehicle crossing the lake at ten metres a second, one step at a
+    // time.
+    mov::Vehicle::State crossing (int step) const {
+      mov::Vehicle::State vehicle;
+      const float x = 10.0f + static_cast<float> (step) / 12.0f;
+      vehicle.position = position (Vec3 (x, 1.5f, 14.0f));
+      vehicle.velocity = velocity (Vec3 (10.0f, 0.0f, 0.0f));
+      return vehicle;
+    }
+  };
+
+  // A window over a lake two metres deep with a strip of dry land, so the
+  // bands cross both water and shore.
+  lavoir::water_window banded_pool () {
+    return lavoir::water_window (
+      96,
+      0.5f * u::m / lavoir::unit,
+      2.5f * u::m,
+      (1.0 / 120.0) * mp_units::si::second / lavoir::step,
+      0,
+      0,
+      [] (std::int64_t column, std::int64_t) {
+        return (column >= 60 && column < 70 ? -1.0f : 2.0f) * u::m;
+      });
+  }
+
+  game::RiderWaterParams small_window () {
+    game::RiderWaterParams params;
+    params.side = 64;
+    return params;
+  }
+}
+
+MOPPE_TEST (rider_water_leaves_a_wake_on_the_lake_and_none_on_the_shore) {
+  const LakeShore lake;
+  game::RiderWater water (lake.water,
+                          lake.surface,
+                          lake.crossing (0).position,
+                          seconds (1.0f / 120.0f),
+                          small_window ());
+  for (int step = 0; step < 120; ++step)
+    water.advance (lake.crossing (step));
+
+  // The window has followed the rider, ten metres downstream.
+  MOPPE_CHECK (water.window ().origin_column () == 40 - 32);
+  float deepest = 0.0f;
+  for (float x = 8.0f; x <= 20.0f; x += 0.5f)
+    deepest = std::min (
+      deepest,
+      water.displacement (position (Vec3 (x, 0.0f, 14.0f)))
+        .numerical_value_in (u::m));
+  MOPPE_CHECK (deepest < 0.0f);
+  MOPPE_CHECK (deepest > -0.1f);
+  MOPPE_CHECK (water.displacement (position (Vec3 (20.0f, 0.0f, 29.0f))) ==
+               0.0f * u::m);
+}
+
+MOPPE_TEST (rider_water_follows_from_the_ride_alone) {
+  const LakeShore lake;
+  game::RiderWater first (lake.water,
+                          lake.surface,
+                          lake.crossing (0).position,
+                          seconds (1.0f / 120.0f),
+                          small_window ());
+  game::RiderWater second (lake.water,
+                           lake.surface,
+                           lake.crossing (0).position,
+                           seconds (1.0f / 120.0f),
+                           small_window ());
+  for (int step = 0; step < 90; ++step) {
+    first.advance (lake.crossing (step));
+    second.advance (lake.crossing (step));
+  }
+  const auto one = first.window ().surface ().values ();
+  const auto other = second.window ().surface ().values ();
+  MOPPE_CHECK (std::ranges::equal (one, other));
+}
+
+MOPPE_TEST (rider_water_bands_on_several_threads_step_like_one) {
+  RowWorkers workers (3);
+  MOPPE_CHECK (workers.size () > 1);
+  lavoir::water_window shared = banded_pool ();
+  lavoir::water_window serial = banded_pool ();
+  const auto pooled = [&] (std::size_t bands,
+                           std::size_t,
+                           const auto& band) {
+    workers.run (bands, band);
+  };
+  for (int step = 0; step < 60; ++step) {
+    if (step % 20 == 0) {
+      const double at = 20.0 + static_cast<double> (step);
+      shared.disturb (at, 48.0, -0.05f * u::m, 3.0f);
+      serial.disturb (at, 48.0, -0.05f * u::m, 3.0f);
+    }
+    shared.tick (pooled);
+    serial.tick (lavoir::serial_bands {});
+  }
+  const auto one = shared.surface ().values ();
+  const auto other = serial.surface ().values ();
+  MOPPE_CHECK (std::ranges::equal (one, other));
+  MOPPE_CHECK (std::ranges::any_of (one, [] (const auto height) {
+    return height != height.zero ();
+  }));
+}
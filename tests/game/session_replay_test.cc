@@ -0,0 +1,125 @@
+#include <moppe/game/game_session.hh>
+#include <moppe/game/session_replay.hh>
+#include <moppe/map/surface.hh>
+
+#include <tests/test.hh>
+
+#include <algorithm>
+#include <cstdint>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+using namespace moppe;
+
+namespace {
+  struct ReplayedRide {
+    map::SurfaceGeometry surface = map::SurfaceGeometry (
+      terrain::TerrainDomain (17,
+                              17,
+                              spatial_extent_in_metres (Vec3 (200, 0, 200))));
+    game::WorldParams world;
+    std::vector<mov::Box> obstacles;
+    // A metre of still water over all of the ground.
+    terrain::WaterSheets water { surface.domain () };
+
+    ReplayedRide () {
+      std::ranges::fill (spatial::get<terrain::surface_elevation> (surface),
+                         terrain::surface_elevation_point (
+                           10.0f * mp_units::si::metre));
+      map::rebuild_geometry (surface);
+      std::ranges::fill (spatial::get<terrain::surface_elevation> (water),
+                         terrain::surface_elevation_point (
+                           11.0f * mp_units::si::metre));
+      world.map_size = spatial_extent_in_metres (Vec3 (200, 20, 200));
+      world.resolution = static_cast<int> (surface.domain ().width ());
+      world.water_level = 0 * u::m;
+    }
+
+    // A fresh session through the whole tape, as game-session-benchmark
+    // rides it, with or without water around the rider.
+    std::uint64_t ride (const std::vector<game::InputFrame>& tape,
+                        bool wading = false) const {
+      game::GameSession session (world, surface);
+      if (wading)
+        session.follow_water (surface, water);
+      session.stars ().generate (surface, world, 12);
+      const seconds_t step = seconds (1.0f / 120.0f);
+      for (const game::InputFrame& input : tape) {
+        session.logic ().m_total_time += seconds_value (step);
+        game::advance_game_session (
+          world, surface, obstacles, session, input, step);
+      }
+      return game::game_state_digest (session);
+    }
+  };
+
+  std::vector<game::InputFrame> autopilot_tape (int steps) {
+    std::vector<game::InputFrame> tape;
+    for (int step = 1; step <= steps; ++step)
+      tape.push_back (game::demo_autopilot_input (step / 120.0));
+    return tape;
+  }
+}
+
+MOPPE_TEST (an_input_tape_reads_back_exactly_what_was_written) {
+  std::vector<game::InputFrame> tape = autopilot_tape (240);
+  tape[17].turn = 1.0f / 3.0f;
+  tape[17].deploy_glider = true;
+  tape[18].deploy_glider_held = true;
+  tape[19].toggle_mount = true;
+  tape[20].cycle_camera = true;
+  tape[21].leave_cinematic = true;
+
+  std::stringstream stream;
+  game::write_input_tape (stream, tape);
+  const std::vector<game::InputFrame> read = game::read_input_tape (stream);
+  MOPPE_CHECK (read.size () == tape.size ());
+  for (std::size_t step = 0; step < tape.size (); ++step) {
+    MOPPE_CHECK (read[step].turn == tape[step].turn);
+    MOPPE_CHECK (read[step].drive == tape[step].drive);
+    MOPPE_CHECK (read[step].boost == tape[step].boost);
+    MOPPE_CHECK (read[step].deploy_glider == tape[step].deploy_glider);
+    MOPPE_CHECK (read[step].deploy_glider_held ==
+                 tape[step].deploy_glider_held);
+    MOPPE_CHECK (read[step].toggle_mount == tape[step].toggle_mount);
+    MOPPE_CHECK (read[step].cycle_camera == tape[step].cycle_camera);
+    MOPPE_CHECK (read[step].leave_cinematic == tape[step].leave_cinematic);
+  }
+
+  for (const char* broken :
+       { "", "not a tape\n", "moppe-input-tape 1\n0.5 1 0 0 0\n" }) {
+    std::istringstream input (broken);
+    bool refused = false;
+    try {
+      game::read_input_tape (input);
+    } catch (const std::runtime_error&) {
+      refused = true;
+    }
+    MOPPE_CHECK (refused);
+  }
+}
+
+MOPPE_TEST (a_replayed_ride_always_arrives_at_the_same_digest) {
+  const ReplayedRide replay;
+  std::vector<game::InputFrame> tape = autopilot_tape (360);
+  const std::uint64_t digest = replay.ride (tape);
+  MOPPE_CHECK (replay.ride (tape) == digest);
+
+  std::stringstream stream;
+  game::write_input_tape (stream, tape);
+  MOPPE_CHECK (replay.ride (game::read_input_tape (stream)) == digest);
+
+  tape[200].turn = -1.0f;
+  MOPPE_CHECK (replay.ride (tape) != digest);
+}
+
+MOPPE_TEST (a_session_digest_folds_in_the_water_around_the_rider) {
+  const ReplayedRide ride;
+  const std::vector<game::InputFrame> tape = autopilot_tape (240);
+  const std::uint64_t wading = ride.ride (tape, true);
+  MOPPE_CHECK (wading == ride.ride (tape, true));
+  // The water does not push back on the ride, so only the digest of the
+  // waves tells the two apart.
+  MOPPE_CHECK (wading != ride.ride (tape));
+}
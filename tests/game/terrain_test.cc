@@ -30,3 +30,54 @@ MOPPE_TEST (terrain_local_shadow_keeps_a_typed_bounded_focus) {
   for (int element = 0; element < 16; ++element)
     MOPPE_CHECK (std::isfinite (shadow.light_view_proj.element (element)));
 }
+
+MOPPE_TEST (terrain_update_region_uploads_only_the_changed_rectangle) {
+  // Narrower than one chunk, so the terrain has no chunk bounds to refresh
+  // and needs no setup (nor its textures) to follow the edit.
+  terrain::TerrainDomain domain (32, 32, 2.0f * u::m, 2.0f * u::m);
+  map::SurfaceGeometry surface { domain };
+  map::rebuild_geometry (surface);
+  game::Terrain terrain;
+  test::RecordingRenderer renderer;
+
+  // A bump across the seam, so the reach of the edit wraps.
+  spatial::get<terrain::surface_elevation> (
+    surface[terrain::TerrainIndex { 31, 4 }]) =
+    terrain::surface_elevation_point (3.0f * u::m);
+  const map::GeometryChange change = map::rebuild_geometry (
+    surface,
+    terrain::TerrainRect { .origin = { 31, 4 }, .columns = 1, .rows = 1 });
+  terrain.update_region (renderer, surface, change.normals);
+
+  MOPPE_CHECK (renderer.terrain_regions.size () == 1);
+  MOPPE_CHECK (renderer.terrain_regions.front () == change.normals);
+  MOPPE_CHECK (change.normals.columns < domain.width ());
+  MOPPE_CHECK (change.normals.rows < domain.height ());
+
+  // Nothing changed, nothing is uploaded.
+  terrain.update_region (renderer, surface, terrain::TerrainRect {});
+  MOPPE_CHECK (renderer.terrain_regions.size () == 1);
+}
+
+MOPPE_TEST (terrain_update_region_across_a_chunk_seam_uploads_the_rectangle) {
+  // Two chunks a side, never set up, with an edit on the last column so
+  // the changed normals wrap onto the first.
+  terrain::TerrainDomain domain (256, 256, 2.0f * u::m, 2.0f * u::m);
+  map::SurfaceGeometry surface { domain };
+  map::rebuild_geometry (surface);
+  game::Terrain terrain;
+  test::RecordingRenderer renderer;
+
+  spatial::get<terrain::surface_elevation> (
+    surface[terrain::TerrainIndex { 255, 128 }]) =
+    terrain::surface_elevation_point (3.0f * u::m);
+  const map::GeometryChange change = map::rebuild_geometry (
+    surface,
+    terrain::TerrainRect { .origin = { 255, 128 }, .columns = 1, .rows = 1 });
+  MOPPE_CHECK (change.normals.origin.column + change.normals.columns >
+               domain.width ());
+  terrain.update_region (renderer, surface, change.normals);
+
+  MOPPE_CHECK (renderer.terrain_regions.size () == 1);
+  MOPPE_CHECK (renderer.terrain_regions.front () == change.normals);
+}
@@ -0,0 +1,88 @@
+#include <moppe/game/world_batch.hh>
+
+#include <tests/test.hh>
+
+#include <algorithm>
+#include <cstdint>
+#include <initializer_list>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+  std::vector<moppe::terrain::WorldRecipe>
+  batch_recipes (std::initializer_list<std::uint32_t> seeds) {
+    using namespace moppe;
+    using namespace moppe::terrain;
+    std::vector<WorldRecipe> recipes;
+    for (const std::uint32_t seed : seeds)
+      recipes.push_back (make_world_recipe (
+        spatial_extent_in_metres (Vec3 (640, 650, 640)),
+        17,
+        Seed { seed },
+        50.0f * u::m,
+        TerrainGenerationProfile::Fast,
+        750000.0f * mp_units::astronomy::Julian_year));
+    return recipes;
+  }
+
+  std::vector<moppe::game::WorldBatchResult>
+  run_batch (const std::vector<moppe::terrain::WorldRecipe>& recipes,
+             moppe::game::WorldBatchConfig config) {
+    std::vector<moppe::game::WorldBatchResult> results;
+    moppe::game::generate_world_batch (
+      recipes, config, [&] (const moppe::game::WorldBatchResult& result) {
+        results.push_back (result);
+      });
+    return results;
+  }
+}
+
+MOPPE_TEST (world_batch_streams_results_in_recipe_order) {
+  using namespace moppe;
+  const std::vector<terrain::WorldRecipe> recipes =
+    batch_recipes ({ 42, 43, 42 });
+  // A budget smaller than any one world admits them one at a time.
+  const std::vector<game::WorldBatchResult> results =
+    run_batch (recipes, { .workers = 3, .memory_budget_bytes = 1 });
+
+  MOPPE_CHECK (results.size () == 3);
+  for (std::size_t index = 0; index < results.size (); ++index) {
+    MOPPE_CHECK (results[index].index == index);
+    MOPPE_CHECK (results[index].error.empty ());
+  }
+  MOPPE_CHECK (results[0].summary.seed == 42u);
+  MOPPE_CHECK (results[1].summary.seed == 43u);
+  MOPPE_CHECK (results[0].summary.resolution == 17);
+  MOPPE_CHECK (results[0].elevation_hash == results[2].elevation_hash);
+  MOPPE_CHECK (results[0].elevation_hash != results[1].elevation_hash);
+  MOPPE_CHECK (terrain::count_value (results[0].evolution.steps) > 0);
+}
+
+MOPPE_TEST (world_batch_reuses_a_workspace_without_changing_a_world) {
+  using namespace moppe;
+  // One worker draws every world into the same surface; three workers each
+  // start fresh. Both must agree on every world.
+  const std::vector<terrain::WorldRecipe> recipes =
+    batch_recipes ({ 7, 8, 9 });
+  const std::vector<game::WorldBatchResult> serial =
+    run_batch (recipes, { .workers = 1 });
+  const std::vector<game::WorldBatchResult> concurrent =
+    run_batch (recipes, { .workers = 3 });
+
+  MOPPE_CHECK (serial.size () == concurrent.size ());
+  for (std::size_t index = 0; index < serial.size (); ++index) {
+    MOPPE_CHECK (serial[index].elevation_hash ==
+                 concurrent[index].elevation_hash);
+    MOPPE_CHECK (serial[index].summary.river_reaches ==
+                 concurrent[index].summary.river_reaches);
+  }
+
+  std::ostringstream csv;
+  game::write_world_batch_csv_header (csv);
+  for (const game::WorldBatchResult& result : serial)
+    game::write_world_batch_csv_row (csv, result);
+  const std::string table = csv.str ();
+  MOPPE_CHECK (table.starts_with ("index,failed,elevation_hash,"));
+  MOPPE_CHECK (std::count (table.begin (), table.end (), '\n') == 4);
+}
@@ -0,0 +1,140 @@
+#include <lavoir/shallow_water.hh>
+
+#include <tests/test.hh>
+
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+namespace lv = lavoir;
+
+namespace {
+  constexpr std::size_t pool_side = 96;
+
+  /// Two metres of still water everywhere but an island of dry land
+  /// around the world's origin.
+  lv::metres_q island_depth (std::int64_t column, std::int64_t row) {
+    const bool land = column * column + row * row < 12 * 12;
+    return (land ? -1.0f : 2.0f) * mp_units::si::metre;
+  }
+
+  lv::water_window island_pool (std::int64_t origin_column,
+                                std::int64_t origin_row) {
+    return lv::water_window (pool_side,
+                             0.5f * mp_units::si::metre / lv::unit,
+                             2.5f * mp_units::si::metre,
+                             (1.0 / 120.0) * mp_units::si::second / lv::step,
+                             origin_column,
+                             origin_row,
+                             island_depth);
+  }
+
+  /// Bands in reverse order: any order must write the same step.
+  struct reversed_bands {
+    template <typename Body>
+    void operator() (std::size_t bands, std::size_t, Body&& body) const {
+      for (std::size_t band = bands; band-- > 0;)
+        body (band);
+    }
+  };
+}
+
+MOPPE_TEST (lavoir_water_window_rejects_unstable_construction) {
+  bool rejected = false;
+  try {
+    lv::water_window too_deep (pool_side,
+                               0.05f * mp_units::si::metre / lv::unit,
+                               50.0f * mp_units::si::metre,
+                               (1.0 / 60.0) * mp_units::si::second / lv::step,
+                               0,
+                               0,
+                               island_depth);
+  } catch (const std::invalid_argument&) {
+    rejected = true;
+  }
+  MOPPE_CHECK (rejected);
+}
+
+MOPPE_TEST (lavoir_water_window_spreads_a_splash_and_keeps_the_land_dry) {
+  lv::water_window pool = island_pool (-48, -48);
+  MOPPE_CHECK (pool.site_updates () == (pool_side - 2) * (pool_side - 2));
+  pool.disturb (24.0, 0.0, 0.1f * mp_units::si::metre, 2.0f);
+
+  for (int i = 0; i < 600; ++i)
+    pool.tick ();
+  MOPPE_CHECK (pool.age () == 600 * lv::step);
+
+  const auto surface = pool.surface ();
+  const auto depth = pool.still_depth ();
+  bool finite = true;
+  bool land_dry = true;
+  lv::metres_q highest = lv::metres_q::zero ();
+  for (std::size_t site = 0; site < surface.domain ().size (); ++site) {
+    const lv::metres_q height = surface.values ()[site];
+    finite =
+      finite && std::isfinite (height.numerical_value_in (mp_units::si::metre));
+    if (depth.values ()[site] == lv::metres_q::zero ())
+      land_dry = land_dry && height == lv::metres_q::zero ();
+    highest = std::max (highest, abs (height));
+  }
+  MOPPE_CHECK (finite);
+  MOPPE_CHECK (land_dry);
+  // The splash has spread out rather than standing or growing.
+  MOPPE_CHECK (highest > lv::metres_q::zero ());
+  MOPPE_CHECK (highest < 0.1f * mp_units::si::metre);
+  MOPPE_CHECK (pool.displacement_at (0.0, 0.0) == lv::metres_q::zero ());
+}
+
+MOPPE_TEST (lavoir_water_window_bands_write_one_step_in_any_order) {
+  lv::water_window first = island_pool (-48, -48);
+  lv::water_window second = island_pool (-48, -48);
+  for (int i = 0; i < 240; ++i) {
+    if (i % 40 == 0) {
+      const double column = 20.0 - 0.1 * i;
+      first.disturb (column, 16.0, -0.05f * mp_units::si::metre, 1.5f);
+      second.disturb (column, 16.0, -0.05f * mp_units::si::metre, 1.5f);
+    }
+    first.tick ();
+    second.tick (reversed_bands {});
+  }
+
+  const auto one = first.surface ();
+  const auto other = second.surface ();
+  bool identical = true;
+  for (std::size_t site = 0; site < one.domain ().size (); ++site)
+    identical = identical && one.values ()[site] == other.values ()[site];
+  MOPPE_CHECK (identical);
+}
+
+MOPPE_TEST (lavoir_water_window_carries_its_waves_as_it_follows) {
+  lv::water_window pool = island_pool (-48, -48);
+  pool.disturb (-20.0, 20.0, 0.1f * mp_units::si::metre, 2.0f);
+  for (int i = 0; i < 120; ++i)
+    pool.tick ();
+
+  std::vector<lv::metres_q> before;
+  for (std::int64_t row = -48; row < 48; ++row)
+    for (std::int64_t column = -48; column < 48; ++column)
+      before.push_back (pool.displacement_at (column, row));
+
+  pool.follow (-43, -51, island_depth);
+  MOPPE_CHECK (pool.origin_column () == -43);
+  MOPPE_CHECK (pool.origin_row () == -51);
+  bool kept = true;
+  std::size_t index = 0;
+  for (std::int64_t row = -48; row < 48; ++row)
+    for (std::int64_t column = -48; column < 48; ++column, ++index) {
+      const bool inside =
+        column > -43 && row > -51 && column < -43 + 95 && row < -51 + 95;
+      if (inside)
+        kept = kept && pool.displacement_at (column, row) == before[index];
+    }
+  MOPPE_CHECK (kept);
+
+  // Uncovered water arrives still, and the window keeps stepping.
+  MOPPE_CHECK (pool.displacement_at (50.0, 0.0) == lv::metres_q::zero ());
+  for (int i = 0; i < 120; ++i)
+    pool.tick ();
+  MOPPE_CHECK (std::isfinite (pool.displacement_at (-20.0, 20.0)
+                                .numerical_value_in (mp_units::si::metre)));
+}
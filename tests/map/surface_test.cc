@@ -9,10 +9,14 @@
 
 #include <algorithm>
 #include <array>
+#include <bit>
 #include <cmath>
 #include <concepts>
+#include <cstdint>
+#include <cstring>
 #include <stdexcept>
 #include <type_traits>
+#include <vector>
 
 namespace {
   // The 0..1 readings derive from moppe::proportion, so each widens to a
@@ -423,6 +427,54 @@ MOPPE_TEST (surface_presentation_is_the_numeric_bridge_for_typed_sections) {
   MOPPE_CHECK (render::TexturePixels ().empty ());
 }
 
+MOPPE_TEST (texture_lanes_held_as_codes_are_copied_as_they_are) {
+  using namespace moppe;
+  const std::array<std::uint8_t, 20> codes {
+    0, 1, 2, 127, 128, 200, 254, 255, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 250
+  };
+  const auto zero = [] (std::size_t) { return 0.0f; };
+  const auto decoded = [&] (std::size_t pixel) {
+    return static_cast<float> (codes[pixel]) / 255.0f;
+  };
+  const render::LaneCodes<std::uint8_t> stored { codes };
+
+  // Twenty pixels span a full packing block and a partial one.
+  std::array<std::byte, 4 * 20> copied {};
+  std::array<std::byte, 4 * 20> packed {};
+  render::pack_rows (render::PixelFormat::rgba8unorm,
+                     copied.data (),
+                     20,
+                     0,
+                     1,
+                     zero,
+                     stored,
+                     zero,
+                     stored);
+  render::pack_rows (render::PixelFormat::rgba8unorm,
+                     packed.data (),
+                     20,
+                     0,
+                     1,
+                     zero,
+                     decoded,
+                     zero,
+                     decoded);
+  MOPPE_CHECK (copied == packed);
+  for (std::size_t pixel = 0; pixel < codes.size (); ++pixel)
+    MOPPE_CHECK (std::to_integer<std::uint8_t> (copied[4 * pixel + 1]) ==
+                 codes[pixel]);
+
+  // A format with other lanes cannot take these codes.
+  bool rejected = false;
+  try {
+    render::pack_rows (
+      render::PixelFormat::rg8snorm, copied.data (), 20, 0, 1, stored, zero);
+  } catch (const std::invalid_argument&) {
+    rejected = true;
+  }
+  MOPPE_CHECK (rejected);
+}
+
 MOPPE_TEST (surface_material_sections_keep_meaning_until_the_numeric_bridge) {
   using namespace moppe;
   map::SurfaceGeometry surface = map::SurfaceGeometry (
@@ -468,14 +520,15 @@ MOPPE_TEST (surface_material_sections_keep_meaning_until_the_numeric_bridge) {
                1.0f * map::surface_moisture[one]);
   MOPPE_CHECK (spatial::sample<map::waterline_distance> (values, center) ==
                2.5f * map::waterline_distance[u::m]);
+  // Exposure and cover keep eight bits, so a half lands on the nearest code.
   MOPPE_CHECK_NEAR (
     spatial::get<map::erosion_exposure> (values)[4].numerical_value_in (one),
     0.5f,
-    1e-6f);
+    0.5f / 255.0f);
   MOPPE_CHECK_NEAR (
     spatial::get<map::deposition_cover> (values)[4].numerical_value_in (one),
     0.5f,
-    1e-6f);
+    0.5f / 255.0f);
 
   const auto wetness_pixels =
     render::decode_channels (render::texture_pixels<map::surface_moisture> (
@@ -492,6 +545,128 @@ MOPPE_TEST (surface_material_sections_keep_meaning_until_the_numeric_bridge) {
   const auto geology = render::decode_channels (
     render::texture_pixels<map::erosion_exposure, map::deposition_cover> (
       values, render::PixelFormat::rg16f));
-  MOPPE_CHECK_NEAR (geology[0][4], 0.5f, 1e-3f);
-  MOPPE_CHECK_NEAR (geology[1][4], 0.5f, 1e-3f);
+  MOPPE_CHECK_NEAR (geology[0][4], 0.5f, 1.0f / 255.0f);
+  MOPPE_CHECK_NEAR (geology[1][4], 0.5f, 1.0f / 255.0f);
+}
+
+MOPPE_TEST (vector_half_packing_matches_the_scalar_definition_bit_for_bit) {
+  using namespace moppe;
+  // A stride coprime with every field boundary visits signs, subnormals,
+  // overflow, and NaNs without walking all four billion patterns.
+  for (std::uint64_t bits = 0; bits < (std::uint64_t (1) << 32);
+       bits += 65521) {
+    const float value = std::bit_cast<float> (std::uint32_t (bits));
+    MOPPE_CHECK (render::detail::float_to_half_lane (value) ==
+                 render::float_to_half (value));
+  }
+  for (const float value : { 0.0f, -0.0f, 1.0f, 65504.0f, 70000.0f, 6.0e-8f,
+                             -3.0e-5f, 1.0e-12f })
+    MOPPE_CHECK (render::detail::float_to_half_lane (value) ==
+                 render::float_to_half (value));
+}
+
+MOPPE_TEST (packed_rows_agree_however_the_rows_are_split) {
+  using namespace moppe;
+  // Wide enough that the whole-image write shares its rows among workers.
+  map::SurfaceGeometry surface = map::SurfaceGeometry (terrain::TerrainDomain (
+    384, 256, spatial_extent_in_metres (Vec3 (384, 0, 256))));
+  map::rebuild_geometry (surface);
+  std::vector<float> moisture (surface.domain ().size ());
+  std::vector<float> distance (surface.domain ().size ());
+  for (std::size_t cell = 0; cell < moisture.size (); ++cell) {
+    moisture[cell] = static_cast<float> (cell % 257) / 256.0f;
+    distance[cell] = static_cast<float> (cell % 61) * 0.25f;
+  }
+  const map::SurfaceReadings readings = test::complete_readings (
+    surface,
+    { .moisture = test::moisture_map (surface.domain (), moisture),
+      .waterline = test::waterline_map (surface.domain (), distance) });
+
+  for (const auto format : { render::PixelFormat::rg32f,
+                             render::PixelFormat::rg16f,
+                             render::PixelFormat::rg16snorm,
+                             render::PixelFormat::rg8snorm }) {
+    const auto pixels =
+      render::texture_pixels<map::surface_moisture, map::waterline_distance> (
+        readings, format);
+    std::vector<std::byte> whole (pixels.byte_size ());
+    std::vector<std::byte> banded (pixels.byte_size ());
+    pixels.write_into (whole.data ());
+    for (std::size_t row = 0; row < pixels.height (); row += 7)
+      pixels.write_rows (
+        banded.data (), row, std::min (row + 7, pixels.height ()));
+    MOPPE_CHECK (whole == banded);
+
+    // Each texel is exactly what the per-channel definition would write.
+    const std::size_t lane = render::channel_bytes (format);
+    for (const std::size_t pixel : { std::size_t (0),
+                                     std::size_t (17),
+                                     moisture.size () / 2,
+                                     moisture.size () - 1 }) {
+      const std::byte* at =
+        whole.data () + pixel * render::bytes_per_pixel (format);
+      if (format == render::PixelFormat::rg16f) {
+        std::uint16_t packed = 0;
+        std::memcpy (&packed, at + lane, sizeof packed);
+        MOPPE_CHECK (packed == render::float_to_half (distance[pixel]));
+      } else if (format == render::PixelFormat::rg32f) {
+        float packed = 0.0f;
+        std::memcpy (&packed, at, sizeof packed);
+        const auto stored =
+          spatial::get<map::surface_moisture> (readings)[pixel];
+        MOPPE_CHECK (packed == stored.numerical_value_in (one));
+      }
+    }
+  }
+}
+
+MOPPE_TEST (a_region_rebuild_matches_a_whole_rebuild_across_the_seam) {
+  using namespace moppe;
+  const auto height_at = [] (std::size_t column, std::size_t row, float bump) {
+    return terrain::surface_elevation_point (
+      (std::sin (0.21f * static_cast<float> (column)) * 30.0f +
+       std::cos (0.17f * static_cast<float> (row)) * 20.0f + bump) *
+      mp_units::si::metre);
+  };
+  map::SurfaceGeometry edited = map::SurfaceGeometry (terrain::TerrainDomain (
+    48, 40, spatial_extent_in_metres (Vec3 (96, 0, 80))));
+  for (const terrain::TerrainIndex site : spatial::sites (edited.domain ()))
+    spatial::get<terrain::surface_elevation> (edited[site]) =
+      height_at (site.column, site.row, 0.0f);
+  map::rebuild_geometry (edited);
+
+  // A crater straddling the corner where both seams meet.
+  const terrain::TerrainRect crater {
+    .origin = { 45, 37 }, .columns = 6, .rows = 5
+  };
+  map::SurfaceGeometry expected = edited;
+  edited.domain ().visit_unwrapped (
+    crater, [&] (const terrain::TerrainRect& piece) {
+      for (std::size_t row = 0; row < piece.rows; ++row)
+        for (std::size_t column = 0; column < piece.columns; ++column) {
+          const terrain::TerrainIndex site { piece.origin.column + column,
+                                             piece.origin.row + row };
+          const auto bump = height_at (site.column, site.row, -12.0f);
+          spatial::get<terrain::surface_elevation> (edited[site]) = bump;
+          spatial::get<terrain::surface_elevation> (expected[site]) = bump;
+        }
+    });
+  const map::GeometryChange change = map::rebuild_geometry (edited, crater);
+  map::rebuild_geometry (expected);
+
+  MOPPE_CHECK ((change.normals == terrain::TerrainRect {
+                                    .origin = { 44, 36 },
+                                    .columns = 8,
+                                    .rows = 7 }));
+  MOPPE_CHECK (change.snow_support.columns >= change.normals.columns);
+  for (const terrain::TerrainIndex site : spatial::sites (edited.domain ())) {
+    const Vec3 normal = normal_value (
+      spatial::get<terrain::terrain_normal> (edited[site]));
+    const Vec3 whole = normal_value (
+      spatial::get<terrain::terrain_normal> (expected[site]));
+    for (int axis = 0; axis < 3; ++axis)
+      MOPPE_CHECK (normal[axis] == whole[axis]);
+    MOPPE_CHECK (spatial::get<map::snow_support> (edited[site]) ==
+                 spatial::get<map::snow_support> (expected[site]));
+  }
 }
@@ -0,0 +1,94 @@
+#include <moppe/memory.hh>
+#include <moppe/terrain/domain.hh>
+#include <moppe/terrain/sediment_transport.hh>
+
+#include <tests/test.hh>
+
+#include <cstdint>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace moppe;
+
+MOPPE_TEST (owned_bytes_counts_capacity_and_what_elements_own) {
+  std::vector<std::uint32_t> flat;
+  flat.reserve (10);
+  flat.push_back (1);
+  MOPPE_CHECK (memory::owned_bytes (flat) == 10 * sizeof (std::uint32_t));
+
+  std::vector<std::vector<float>> nested (2);
+  nested[0].reserve (4);
+  nested[1].reserve (6);
+  MOPPE_CHECK (memory::owned_bytes (nested) ==
+               nested.capacity () * sizeof (std::vector<float>) +
+                 10 * sizeof (float));
+}
+
+MOPPE_TEST (ledger_names_each_bundle_column_and_sorts_largest_first) {
+  using Columns = spatial::Bundle<terrain::TerrainDomain,
+                                  terrain::SurfaceElevation,
+                                  terrain::SedimentThickness>;
+  const Columns columns (terrain::TerrainDomain (
+    4, 4, spatial_extent_in_metres (Vec3 (40, 10, 40))));
+
+  memory::Ledger ledger;
+  ledger.add ("small", 3);
+  memory::account_bundle (ledger, "surface", columns);
+  ledger.add ("large", 1 << 20);
+
+  MOPPE_CHECK (ledger.entries ().size () == 4);
+  MOPPE_CHECK (ledger.entries ()[1].name == "surface.surface_elevation");
+  MOPPE_CHECK (ledger.entries ()[2].name == "surface.sediment_thickness");
+  MOPPE_CHECK (ledger.entries ()[1].bytes >= 16 * sizeof (float));
+  MOPPE_CHECK (ledger.total_bytes () == 3 + (1 << 20) +
+                                          ledger.entries ()[1].bytes +
+                                          ledger.entries ()[2].bytes);
+
+  ledger.sort_by_size ();
+  MOPPE_CHECK (ledger.entries ().front ().name == "large");
+  MOPPE_CHECK (ledger.entries ().back ().name == "small");
+
+  std::ostringstream csv;
+  memory::write_ledger_csv (csv, ledger);
+  MOPPE_CHECK (csv.str ().starts_with ("entry,bytes\nlarge,1048576\n"));
+}
+
+MOPPE_TEST (tracked_buffers_raise_the_transient_peak_and_give_it_back) {
+  const std::size_t before = memory::transient_bytes ();
+  memory::reset_transient_peak ();
+  {
+    memory::tracked_vector<double> first (1000);
+    {
+      memory::tracked_vector<double> second (500);
+      MOPPE_CHECK (memory::transient_bytes () ==
+                   before + 1500 * sizeof (double));
+    }
+    MOPPE_CHECK (memory::transient_bytes () == before + 1000 * sizeof (double));
+  }
+  MOPPE_CHECK (memory::transient_bytes () == before);
+  MOPPE_CHECK (memory::transient_peak_bytes () >=
+               before + 1500 * sizeof (double));
+
+  memory::reset_transient_peak ();
+  MOPPE_CHECK (memory::transient_peak_bytes () == before);
+}
+
+MOPPE_TEST (stage_report_keeps_each_stage_transient_peak_apart) {
+  memory::StageMemoryReport report;
+  {
+    memory::tracked_vector<std::uint8_t> scratch (4096);
+  }
+  report.mark ("large");
+  {
+    memory::tracked_vector<std::uint8_t> scratch (16);
+  }
+  report.mark ("small");
+
+  MOPPE_CHECK (report.stages ().size () == 2);
+  MOPPE_CHECK (report.stages ()[0].stage == "large");
+  MOPPE_CHECK (report.stages ()[0].transient_peak_bytes >= 4096);
+  MOPPE_CHECK (report.stages ()[1].transient_peak_bytes < 4096);
+  MOPPE_CHECK (report.largest_transient_peak_bytes () ==
+               report.stages ()[0].transient_peak_bytes);
+}
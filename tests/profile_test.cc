@@ -0,0 +1,80 @@
+#include <moppe/profile.hh>
+
+#include <tests/test.hh>
+
+#include <sstream>
+#include <string>
+#include <thread>
+
+using namespace moppe;
+
+namespace {
+  std::size_t occurrences (const std::string& text, const std::string& part) {
+    std::size_t count = 0;
+    for (std::size_t at = text.find (part); at != std::string::npos;
+         at = text.find (part, at + part.size ()))
+      ++count;
+    return count;
+  }
+}
+
+#if !defined(TRACY_ENABLE)
+MOPPE_TEST (the_recorder_writes_zones_plots_and_threads_as_a_chrome_trace) {
+  profile::start_recording ();
+  {
+    MOPPE_PROFILE_ZONE ("test.outer");
+    MOPPE_PROFILE_NAMED_ZONE (inner, "test.inner");
+    MOPPE_PROFILE_PLOT ("test.plot", 42);
+  }
+  std::jthread ([] {
+    MOPPE_PROFILE_THREAD ("Test worker");
+    MOPPE_PROFILE_ZONE ("test.worker");
+  }).join ();
+  MOPPE_PROFILE_FRAME ();
+  profile::stop_recording ();
+  {
+    MOPPE_PROFILE_ZONE ("test.unrecorded");
+  }
+
+  std::ostringstream output;
+  profile::write_trace (output);
+  const std::string trace = output.str ();
+  MOPPE_CHECK (trace.starts_with ("{\"displayTimeUnit\":\"ms\""));
+  MOPPE_CHECK (trace.ends_with ("]}\n"));
+  MOPPE_CHECK (occurrences (trace, "\"name\":\"test.outer\",\"ph\":\"X\"") ==
+               1);
+  MOPPE_CHECK (occurrences (trace, "\"name\":\"test.inner\",\"ph\":\"X\"") ==
+               1);
+  MOPPE_CHECK (occurrences (trace, "\"name\":\"test.worker\",\"ph\":\"X\"") ==
+               1);
+  MOPPE_CHECK (occurrences (trace, "\"args\":{\"value\":42}") == 1);
+  MOPPE_CHECK (occurrences (trace, "\"args\":{\"name\":\"Test worker\"}") ==
+               1);
+  MOPPE_CHECK (occurrences (trace, "\"name\":\"frame\",\"ph\":\"i\"") == 1);
+  MOPPE_CHECK (occurrences (trace, "test.unrecorded") == 0);
+}
+
+MOPPE_TEST (a_new_recording_keeps_only_the_newest_events_of_its_own) {
+  profile::start_recording ();
+  {
+    MOPPE_PROFILE_ZONE ("test.earlier");
+  }
+  profile::stop_recording ();
+
+  // A thread's ring is sized by the recording it first records in.
+  profile::start_recording (4);
+  std::jthread ([] {
+    for (int step = 0; step < 10; ++step)
+      MOPPE_PROFILE_PLOT ("test.step", step);
+  }).join ();
+  profile::stop_recording ();
+
+  std::ostringstream output;
+  profile::write_trace (output);
+  const std::string trace = output.str ();
+  MOPPE_CHECK (occurrences (trace, "test.earlier") == 0);
+  MOPPE_CHECK (occurrences (trace, "\"name\":\"test.step\"") == 4);
+  MOPPE_CHECK (occurrences (trace, "\"args\":{\"value\":5}") == 0);
+  MOPPE_CHECK (occurrences (trace, "\"args\":{\"value\":9}") == 1);
+}
+#endif
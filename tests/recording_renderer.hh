@@ -47,6 +47,14 @@ namespace moppe::test {
     void set_terrain (const render::TerrainParams&,
                       std::span<const terrain::SurfaceElevation>,
                       std::span<const terrain::TerrainNormal>) override {}
+    std::vector<terrain::TerrainRect> terrain_regions;
+
+    void
+    update_terrain_region (const terrain::TerrainRect& region,
+                           std::span<const terrain::SurfaceElevation>,
+                           std::span<const terrain::TerrainNormal>) override {
+      terrain_regions.push_back (region);
+    }
     void set_terrain_topology_overlay (bool) override {}
     void set_terrain_textures (render::TexturePtr,
                                render::TexturePtr,
@@ -123,6 +131,13 @@ namespace moppe::test {
     void draw_mesh (const render::Mesh&, const Mat4&, uint64_t) override {
       ++meshes_drawn;
     }
+    std::vector<std::size_t> instance_batches;
+
+    void draw_mesh_instances (
+      const render::Mesh&,
+      std::span<const render::InstanceTransform> instances) override {
+      instance_batches.push_back (instances.size ());
+    }
     void draw_list (const render::DrawList&, uint64_t) override {}
     void apply_underwater (float) override {}
     void apply_motion_blur (float) override {}
@@ -2,6 +2,7 @@
 
 #include <tests/test.hh>
 
+#include <cmath>
 #include <vector>
 
 using namespace moppe;
@@ -78,3 +79,65 @@ MOPPE_TEST (reflection_proxy_wraps_authoritative_samples_across_the_seam) {
   MOPPE_CHECK_NEAR (first.z, -2.0f, 0.0f);
   MOPPE_CHECK_NEAR (first.y, 22.0f, 0.0f);
 }
+
+MOPPE_TEST (adaptive_reflection_proxy_spends_two_triangles_on_a_plane) {
+  const render::TerrainParams params = terrain_params (8, 8);
+  std::vector<terrain::SurfaceElevation> heights (64, elevation (7.0f));
+  const render::ReflectionTerrainProxy proxy =
+    render::build_adaptive_reflection_terrain_proxy (params,
+                                                     heights,
+                                                     Vec3 (4.0f, 8.0f, 4.0f),
+                                                     Mat4::identity (),
+                                                     640,
+                                                     400,
+                                                     {},
+                                                     4.0f);
+  MOPPE_CHECK (proxy.metrics.triangle_count == 2);
+  MOPPE_CHECK (proxy.metrics.source_sample_count == 81);
+  MOPPE_CHECK_NEAR (proxy.metrics.height_max_m, 0.0f, 0.0f);
+  for (const render::ReflectionProxyVertex& vertex : proxy.triangles)
+    MOPPE_CHECK_NEAR (vertex.y, 7.0f, 0.0f);
+}
+
+MOPPE_TEST (adaptive_reflection_proxy_refines_only_where_pixels_need_it) {
+  // One hill on flat ground, the whole window on screen at 12.5 pixels per
+  // metre of height.
+  const render::TerrainParams params = terrain_params (32, 32);
+  std::vector<terrain::SurfaceElevation> heights;
+  for (int z = 0; z < 32; ++z)
+    for (int x = 0; x < 32; ++x) {
+      const float distance_squared =
+        static_cast<float> ((x - 8) * (x - 8) + (z - 9) * (z - 9));
+      heights.push_back (
+        elevation (10.0f * std::exp (-distance_squared / 8.0f)));
+    }
+  const Mat4 view_projection =
+    Mat4::scaling (Vec3 (1.0f / 16.0f, 1.0f / 16.0f, 1.0f)) *
+    Mat4::translation (Vec3 (-16.0f, 0.0f, 0.0f));
+  const render::ReflectionProxyTolerance tolerance { .projected_px = 2.0f };
+  const render::ReflectionTerrainProxy proxy =
+    render::build_adaptive_reflection_terrain_proxy (params,
+                                                     heights,
+                                                     Vec3 (16.0f, 8.0f, 16.0f),
+                                                     view_projection,
+                                                     640,
+                                                     400,
+                                                     tolerance,
+                                                     16.0f);
+  const render::ReflectionTerrainProxy grid =
+    render::build_reflection_terrain_proxy (params,
+                                            heights,
+                                            Vec3 (16.0f, 8.0f, 16.0f),
+                                            view_projection,
+                                            640,
+                                            400,
+                                            1,
+                                            16.0f);
+  MOPPE_CHECK (proxy.metrics.projected_sample_count ==
+               proxy.metrics.source_sample_count);
+  MOPPE_CHECK (proxy.metrics.projected_max_px <= tolerance.projected_px);
+  MOPPE_CHECK (proxy.metrics.projected_max_px > 0.0f);
+  MOPPE_CHECK (proxy.metrics.triangle_count > 2);
+  MOPPE_CHECK (proxy.metrics.triangle_count * 4 <
+               grid.metrics.triangle_count);
+}
@@ -0,0 +1,113 @@
+#ifndef MOPPE_TESTS_SEDIMENT_FIXTURE_HH
+#define MOPPE_TESTS_SEDIMENT_FIXTURE_HH
+
+#include <moppe/terrain/stream_power_evolution.hh>
+
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+// One small lattice on which every sediment stage of a geological step has
+// real work, shared by the tests that run those stages in a workspace.
+
+namespace moppe::test {
+  // A coast, a slope rising inland and a walled pond on it: every sediment
+  // stage has real work.
+  struct SedimentStages {
+    terrain::TerrainDomain domain { 16, 16, 10.0f * u::m, 10.0f * u::m };
+    terrain::ElevationMap ground;
+    terrain::FloodField flood;
+    terrain::LakeCensus census;
+    terrain::FractionalDrainage drainage;
+    std::vector<terrain::SedimentVolume> potential_detachment;
+    std::vector<terrain::SedimentVolume> transport_capacity;
+    std::vector<terrain::SedimentVolume> maximum_deposition;
+    std::vector<terrain::SedimentVolume> cover;
+    std::vector<terrain::SedimentThickness> thickness;
+    std::vector<std::uint8_t> fixed;
+
+    SedimentStages ()
+        : ground (terrain::make_elevation_map (domain, pond_slope (domain))),
+          flood (terrain::analyze_standing_water (ground, 0.0f)),
+          census (terrain::census_lakes (flood)),
+          drainage (terrain::analyze_fractional_drainage (flood, census)) {
+      const auto volume = [] (double cubic_metres) {
+        return cubic_metres * terrain::sediment_volume[u::m * u::m * u::m];
+      };
+      for (std::size_t cell = 0; cell < domain.size (); ++cell) {
+        const double wave = std::sin (0.7 * static_cast<double> (cell));
+        potential_detachment.push_back (volume (2.0 + wave));
+        transport_capacity.push_back (volume (4.0 + 3.0 * wave));
+        maximum_deposition.push_back (volume (0.5));
+        cover.push_back (volume (1.0 - 0.5 * wave));
+        thickness.push_back (0.1f * terrain::sediment_thickness[u::m]);
+        fixed.push_back (flood.ocean[cell]);
+      }
+    }
+
+    static std::vector<float>
+    pond_slope (const terrain::TerrainDomain& domain) {
+      std::vector<float> heights (domain.size ());
+      for (std::size_t row = 0; row < domain.height (); ++row)
+        for (std::size_t column = 0; column < domain.width (); ++column) {
+          const bool pond = row >= 5 && row <= 10 && column >= 7 &&
+                            column <= 12;
+          const bool wall =
+            row == 5 || row == 10 || column == 7 || column == 12;
+          float height = 2.0f * static_cast<float> (column) - 6.0f +
+                         0.3f * static_cast<float> (row % 3);
+          if (pond)
+            height = wall ? 24.0f : 5.0f;
+          heights[domain.offset ({ column, row })] = height;
+        }
+      return heights;
+    }
+
+    void run (terrain::SedimentWorkspace& workspace) const {
+      const auto& areas =
+        spatial::get<terrain::fractional_contributing_area> (drainage);
+      const auto& tangents = spatial::get<terrain::channel_tangent> (drainage);
+      const terrain::StandingWaterStorage& storage =
+        terrain::standing_water_storage_capacity (
+          workspace, flood, census, areas, maximum_deposition);
+      const terrain::SedimentRoutingResult& routed =
+        terrain::route_sediment (workspace,
+                                 drainage.domain (),
+                                 potential_detachment,
+                                 transport_capacity,
+                                 maximum_deposition,
+                                 flood.ocean,
+                                 cover,
+                                 census.membership ().values (),
+                                 storage.body_capacity,
+                                 storage.ocean_mouth_capacity);
+      const terrain::StandingWaterDepositionResult& standing =
+        terrain::spread_standing_water_deposition (workspace,
+                                                   flood,
+                                                   census,
+                                                   drainage.domain (),
+                                                   areas,
+                                                   tangents,
+                                                   routed.deposited,
+                                                   maximum_deposition);
+      terrain::spread_valley_deposition (
+        workspace,
+        drainage.domain (),
+        spatial::get<terrain::surface_elevation> (ground),
+        areas,
+        tangents,
+        standing.dry_centerline,
+        flood.ocean);
+      terrain::route_hillslope_sediment (
+        workspace,
+        domain,
+        spatial::get<terrain::surface_elevation> (ground),
+        thickness,
+        fixed,
+        50000.0 * mp_units::astronomy::Julian_year,
+        0.01f * u::m * u::m / mp_units::astronomy::Julian_year);
+    }
+  };
+}
+
+#endif
@@ -41,6 +41,10 @@ namespace {
   using StoredDensity = quantity<stored_density[one], float>;
   using StoredRingBundle =
     spatial::Bundle<StoredRing, StoredDisplacement, StoredDensity>;
+  using StoredQuantizedBundle = spatial::Bundle<
+    StoredRing,
+    spatial::Quantized<StoredDisplacement, spatial::Half>,
+    spatial::Quantized<StoredDensity, spatial::Unorm8<>>>;
   using StoredNarrowBundle = spatial::Bundle<StoredRing, StoredDisplacement>;
 
   QUANTITY_SPEC (stored_direction,
@@ -159,6 +163,42 @@ MOPPE_TEST (a_vector_quantity_is_an_arrow_fixed_size_list) {
   MOPPE_CHECK_NEAR (value[2], 3.0f, 1e-6f);
 }
 
+MOPPE_TEST (a_quantized_column_is_stored_as_its_codes) {
+  const StoredQuantizedBundle bundle =
+    spatial::store_as<StoredQuantizedBundle> (written_ring ());
+  std::stringstream file (std::ios::in | std::ios::out | std::ios::binary);
+  spatial::write_bundle (file, bundle);
+
+  const std::optional loaded =
+    spatial::read_bundle<StoredQuantizedBundle> (file);
+  MOPPE_CHECK (loaded.has_value ());
+  MOPPE_CHECK (spatial::get<0> (*loaded) == spatial::get<0> (bundle));
+  MOPPE_CHECK (spatial::get<1> (*loaded) == spatial::get<1> (bundle));
+  MOPPE_CHECK (spatial::get<stored_displacement> (*loaded)[2] ==
+               5.0f * stored_displacement[u::m]);
+
+  file.clear ();
+  file.seekg (0);
+  spatial::detail::UniqueArrayStream stream;
+  MOPPE_CHECK (spatial::detail::read_ipc_stream (file, stream));
+  ArrowError error;
+  ArrowErrorInit (&error);
+  spatial::detail::UniqueSchema schema;
+  MOPPE_CHECK (ArrowArrayStreamGetSchema (
+                 stream.get (), schema.get (), &error) == NANOARROW_OK);
+  MOPPE_CHECK (std::string_view (schema->children[0]->format) == "e");
+  MOPPE_CHECK (std::string_view (schema->children[1]->format) == "C");
+  MOPPE_CHECK (spatial::detail::metadata_value (*schema->children[1],
+                                                spatial::detail::storage_key) ==
+               "unorm8[0,1]");
+
+  // The same quantities at full precision are another file.
+  StoredRingBundle full (StoredRing { 3 });
+  file.clear ();
+  file.seekg (0);
+  MOPPE_CHECK (!spatial::load_bundle (file, full));
+}
+
 MOPPE_TEST (loading_keeps_the_callers_bundle_when_the_domain_differs) {
   std::stringstream file (std::ios::in | std::ios::out | std::ios::binary);
   spatial::write_bundle (file, written_ring ());
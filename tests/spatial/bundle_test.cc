@@ -4,6 +4,7 @@
 
 #include <tests/test.hh>
 
+#include <algorithm>
 #include <concepts>
 #include <cstddef>
 #include <stdexcept>
@@ -175,3 +176,42 @@ MOPPE_TEST (for_each_site_rewrites_one_bundle_in_place) {
   MOPPE_CHECK_NEAR (density[1].numerical_value_in (one), 4.0f, 1e-6f);
   MOPPE_CHECK_NEAR (density[2].numerical_value_in (one), 6.0f, 1e-6f);
 }
+
+MOPPE_TEST (a_quantized_column_reads_decoded_values_and_writes_codes) {
+  using Density8 = spatial::Quantized<TestDensity, spatial::Unorm8<>>;
+  using Displacement16 = spatial::Quantized<TestDisplacement, spatial::Half>;
+  using FullBundle =
+    spatial::Bundle<SizedRing, TestDensity, TestDisplacement>;
+  using PackedBundle = spatial::Bundle<SizedRing, Density8, Displacement16>;
+  static_assert (std::same_as<PackedBundle::value_type<0>, TestDensity>);
+
+  FullBundle full (SizedRing {});
+  auto& [density, displacement] = full;
+  density[0] = 1.0f * test_density[one];
+  density[1] = 0.5f * test_density[one];
+  density[2] = 2.0f * test_density[one];
+  displacement[1] = 2.5f * test_displacement[u::m];
+
+  PackedBundle packed = spatial::store_as<PackedBundle> (std::move (full));
+  const auto& codes = spatial::get<test_density> (packed).codes ();
+  MOPPE_CHECK (codes[0] == 255 && codes[1] == 128 && codes[2] == 255);
+
+  // Both ends of a unorm range decode exactly; the rest to within a code.
+  const PackedBundle& reading = packed;
+  MOPPE_CHECK (spatial::get<test_density> (reading)[0] ==
+               1.0f * test_density[one]);
+  MOPPE_CHECK_NEAR (
+    spatial::get<test_density> (reading[1]).numerical_value_in (one),
+    0.5f,
+    0.5f / 255.0f);
+  MOPPE_CHECK (spatial::get<test_displacement> (reading)[1] ==
+               2.5f * test_displacement[u::m]);
+
+  // Writes go through the row as they would into a vector.
+  spatial::get<test_density> (packed[2]) = 0.0f * test_density[one];
+  std::ranges::fill (spatial::get<test_displacement> (packed),
+                     1.0f * test_displacement[u::m]);
+  MOPPE_CHECK (spatial::get<test_density> (packed).codes ()[2] == 0);
+  MOPPE_CHECK (spatial::get<test_displacement> (reading)[0] ==
+               1.0f * test_displacement[u::m]);
+}
@@ -100,14 +100,14 @@ namespace moppe::test {
     map::ForestCoverMap cover =
       map::analyze_forest_cover (habitat, use, recipe.seed);
 
-    return spatial::join (std::move (moisture),
-                          recipe.waterline
-                            ? std::move (*recipe.waterline)
-                            : terrain::WaterlineProximity (domain),
-                          map::analyze_geology_materials (surface),
-                          std::move (habitat),
-                          std::move (cover),
-                          std::move (use));
+    return spatial::store_as<map::SurfaceReadings> (
+      spatial::join (std::move (moisture),
+                     recipe.waterline ? std::move (*recipe.waterline)
+                                      : terrain::WaterlineProximity (domain),
+                     map::analyze_geology_materials (surface),
+                     std::move (habitat),
+                     std::move (cover),
+                     std::move (use)));
   }
 }
 
@@ -0,0 +1,84 @@
+#include <moppe/terrain/distance_transform.hh>
+
+#include <moppe/spatial/bundle_operations.hh>
+
+#include <tests/test.hh>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+using namespace moppe;
+using namespace moppe::terrain;
+
+namespace {
+  // Every pair of sites, every source, the nearest image across both seams.
+  float brute_force_distance (const TerrainDomain& domain,
+                              const std::vector<std::uint8_t>& sources,
+                              TerrainIndex site) {
+    const float spacing_x = domain.spacing_x ().numerical_value_in (u::m);
+    const float spacing_z = domain.spacing_z ().numerical_value_in (u::m);
+    float nearest = std::numeric_limits<float>::infinity ();
+    for (const TerrainIndex source : spatial::sites (domain)) {
+      if (sources[domain.offset (source)] == 0)
+        continue;
+      const auto lap_gap = [] (std::size_t a, std::size_t b, std::size_t lap) {
+        const std::size_t gap = a > b ? a - b : b - a;
+        return static_cast<float> (std::min (gap, lap - gap));
+      };
+      const float across =
+        lap_gap (site.column, source.column, domain.width ()) * spacing_x;
+      const float along =
+        lap_gap (site.row, source.row, domain.height ()) * spacing_z;
+      nearest = std::min (nearest, std::sqrt (across * across + along * along));
+    }
+    return nearest;
+  }
+}
+
+MOPPE_TEST (distance_to_sources_is_exact_across_the_seams) {
+  const TerrainDomain domain (11, 7, 2.0f * u::m, 3.0f * u::m);
+  std::vector<std::uint8_t> sources (domain.size (), 0);
+  sources[domain.offset ({ 1, 1 })] = 1;
+  sources[domain.offset ({ 9, 5 })] = 1;
+  sources[domain.offset ({ 5, 0 })] = 1;
+
+  const std::vector<meters_t> distance = distance_to_sources (domain, sources);
+  for (const TerrainIndex site : spatial::sites (domain))
+    MOPPE_CHECK_NEAR (
+      distance[domain.offset (site)].numerical_value_in (u::m),
+      brute_force_distance (domain, sources, site),
+      1e-4f);
+  // Two cells down and two across is the diagonal, not the larger step.
+  MOPPE_CHECK_NEAR (
+    distance[domain.offset ({ 3, 3 })].numerical_value_in (u::m),
+    std::sqrt (4.0f * 4.0f + 6.0f * 6.0f),
+    1e-4f);
+}
+
+MOPPE_TEST (distance_beyond_the_reach_reads_as_infinitely_far) {
+  const TerrainDomain domain (16, 16, 1.0f * u::m, 1.0f * u::m);
+  std::vector<std::uint8_t> sources (domain.size (), 0);
+  sources[domain.offset ({ 0, 0 })] = 1;
+
+  const std::vector<meters_t> distance =
+    distance_to_sources (domain, sources, 3.0f * u::m);
+  for (const TerrainIndex site : spatial::sites (domain)) {
+    const float expected = brute_force_distance (domain, sources, site);
+    const float measured =
+      distance[domain.offset (site)].numerical_value_in (u::m);
+    if (expected > 3.0f)
+      MOPPE_CHECK (std::isinf (measured));
+    else
+      MOPPE_CHECK_NEAR (measured, expected, 1e-4f);
+  }
+
+  const std::vector<meters_t> nowhere = distance_to_sources (
+    domain, std::vector<std::uint8_t> (domain.size (), 0));
+  MOPPE_CHECK (std::ranges::all_of (nowhere, [] (meters_t value) {
+    return std::isinf (value.numerical_value_in (u::m));
+  }));
+}
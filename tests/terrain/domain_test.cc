@@ -36,6 +36,26 @@ MOPPE_TEST (a_step_off_the_lattice_edge_wraps_around_the_torus) {
   MOPPE_CHECK (domain.shifted (origin, -4, -3) == origin);
 }
 
+MOPPE_TEST (a_cell_stencil_finds_the_same_neighbours_as_a_wrapped_step) {
+  // One lattice with an interior, and one so thin that every cell borders
+  // itself across the seam.
+  for (const auto [width, height] :
+       { std::pair<std::size_t, std::size_t> { 4, 3 },
+         std::pair<std::size_t, std::size_t> { 1, 2 } }) {
+    const terrain::TerrainDomain domain (width, height);
+    const terrain::CellStencil<terrain::scan_neighbours> neighbours (domain);
+    for (const terrain::TerrainIndex site : spatial::sites (domain)) {
+      const auto ring = neighbours.around (site.column, site.row);
+      for (std::size_t slot = 0; slot < ring.size (); ++slot) {
+        const terrain::CellOffset step = terrain::scan_neighbours[slot];
+        MOPPE_CHECK (ring[slot] ==
+                     domain.offset (
+                       domain.shifted (site, step.columns, step.rows)));
+      }
+    }
+  }
+}
+
 MOPPE_TEST (every_site_shifted_by_nothing_is_itself) {
   const terrain::TerrainDomain domain (5, 4);
   for (const terrain::TerrainIndex site : spatial::sites (domain))
@@ -45,3 +65,43 @@ MOPPE_TEST (every_site_shifted_by_nothing_is_itself) {
 MOPPE_TEST (continuous_coordinates_rounding_to_a_full_lap_wrap_to_zero) {
   MOPPE_CHECK_NEAR (terrain::wrap_coordinate (-0.00001f, 2048.0f), 0.0f, 0.0f);
 }
+
+MOPPE_TEST (a_rectangle_across_the_seams_unwraps_into_plain_pieces) {
+  const terrain::TerrainDomain domain (8, 6);
+  const terrain::TerrainRect rect {
+    .origin = { 6, 4 }, .columns = 4, .rows = 3
+  };
+  std::multiset<std::pair<std::size_t, std::size_t>> covered;
+  std::size_t pieces = 0;
+  domain.visit_unwrapped (rect, [&] (const terrain::TerrainRect& piece) {
+    MOPPE_CHECK (piece.origin.column + piece.columns <= domain.width ());
+    MOPPE_CHECK (piece.origin.row + piece.rows <= domain.height ());
+    for (std::size_t row = 0; row < piece.rows; ++row)
+      for (std::size_t column = 0; column < piece.columns; ++column)
+        covered.insert (
+          { piece.origin.column + column, piece.origin.row + row });
+    ++pieces;
+  });
+  MOPPE_CHECK (pieces == 4);
+  MOPPE_CHECK (covered.size () == 12);
+  for (std::size_t row = 0; row < rect.rows; ++row)
+    for (std::size_t column = 0; column < rect.columns; ++column) {
+      const terrain::TerrainIndex site = domain.shifted (
+        rect.origin, static_cast<int> (column), static_cast<int> (row));
+      MOPPE_CHECK (covered.count ({ site.column, site.row }) == 1);
+    }
+}
+
+MOPPE_TEST (growing_a_rectangle_wraps_its_origin_and_saturates_at_a_lap) {
+  const terrain::TerrainDomain domain (8, 6);
+  const terrain::TerrainRect site {
+    .origin = { 0, 5 }, .columns = 1, .rows = 1
+  };
+  MOPPE_CHECK ((domain.grown (site, 1, 1) ==
+                terrain::TerrainRect {
+                  .origin = { 7, 4 }, .columns = 3, .rows = 3 }));
+  MOPPE_CHECK ((domain.grown (site, 4, 1) ==
+                terrain::TerrainRect {
+                  .origin = { 0, 4 }, .columns = 8, .rows = 3 }));
+  MOPPE_CHECK (domain.grown (domain.whole (), 2, 2) == domain.whole ());
+}
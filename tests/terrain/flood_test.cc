@@ -2,7 +2,9 @@
 
 #include <tests/test.hh>
 
+#include <algorithm>
 #include <array>
+#include <cstdint>
 #include <vector>
 
 using namespace moppe::terrain;
@@ -207,6 +209,78 @@ MOPPE_TEST (census_shape_separates_channel_water_from_lakes) {
   MOPPE_CHECK (!lake.channel_like);
 }
 
+MOPPE_TEST (lake_census_numbers_bodies_as_a_scan_order_flood_fill) {
+  // Scattered wet cells near the percolation threshold: bodies of every size
+  // crossing label bands and both torus seams, on a lattice large enough to
+  // label in parallel.
+  constexpr std::size_t width = 320;
+  constexpr std::size_t height = 250;
+  constexpr std::size_t count = width * height;
+  const TerrainDomain grid (width, height);
+  std::vector<float> depth (count, 0.0f);
+  for (std::uint32_t cell = 0; cell < count; ++cell) {
+    std::uint32_t mixed = cell * 0x9e3779b9U;
+    mixed ^= mixed >> 16;
+    mixed *= 0x85ebca6bU;
+    mixed ^= mixed >> 13;
+    if ((mixed & 0xffU) < 112)
+      depth[cell] = 2.0f;
+  }
+  const std::vector<float> level (count, 5.0f);
+  const FloodField flood { .surface = make_flood_surface (grid, level, depth),
+                           .sea_level = 0.0f,
+                           .has_ocean = false,
+                           .ocean = std::vector<std::uint8_t> (count, 0),
+                           .spill_receiver = std::vector<CellIndex> (
+                             count, CellIndex { 0 }) };
+  const LakeCensus census = census_lakes (flood);
+
+  std::vector<WaterBodyId> expected (count, LakeCensus::dry);
+  std::vector<std::size_t> sizes;
+  std::vector<std::size_t> frontier;
+  for (std::size_t origin = 0; origin < count; ++origin) {
+    if (depth[origin] == 0.0f || expected[origin] != LakeCensus::dry)
+      continue;
+    const WaterBodyId id { static_cast<std::uint32_t> (sizes.size ()) };
+    sizes.push_back (0);
+    expected[origin] = id;
+    frontier.push_back (origin);
+    while (!frontier.empty ()) {
+      const std::size_t cell = frontier.back ();
+      frontier.pop_back ();
+      ++sizes.back ();
+      for (std::size_t dy = 0; dy < 3; ++dy)
+        for (std::size_t dx = 0; dx < 3; ++dx) {
+          const std::size_t next =
+            (cell / width + height + dy - 1) % height * width +
+            (cell % width + width + dx - 1) % width;
+          if (depth[next] > 0.0f && expected[next] == LakeCensus::dry) {
+            expected[next] = id;
+            frontier.push_back (next);
+          }
+        }
+    }
+  }
+
+  MOPPE_CHECK (sizes.size () > 100);
+  MOPPE_CHECK (census.domain ().size () == sizes.size ());
+  const auto labels = census.membership ().values ();
+  MOPPE_CHECK (std::ranges::equal (labels, expected));
+  if (census.domain ().size () != sizes.size ())
+    return;
+  const float cell_area_m2 =
+    grid.cell_area ().numerical_value_in (moppe::u::m * moppe::u::m);
+  for (std::size_t body = 0; body < sizes.size (); ++body) {
+    const WaterBody& measured = census.water_bodies ()[body];
+    MOPPE_CHECK (measured.cells == cell_count (sizes[body]));
+    MOPPE_CHECK_NEAR (
+      measured.volume.numerical_value_in (moppe::u::m * moppe::u::m *
+                                          moppe::u::m),
+      2.0f * static_cast<float> (sizes[body]) * cell_area_m2,
+      1e-3f * static_cast<float> (sizes[body]));
+  }
+}
+
 MOPPE_TEST (permanence_removes_small_ponds_but_never_the_sea) {
   const std::array heights { -2.f, -1.f, 1.f, 2.f };
   const ElevationMap terrain =
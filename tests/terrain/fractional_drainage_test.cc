@@ -9,6 +9,7 @@
 #include <cstdint>
 #include <numbers>
 #include <span>
+#include <stdexcept>
 #include <vector>
 
 using namespace moppe;
@@ -141,6 +142,53 @@ MOPPE_TEST (fractional_accumulation_is_conservative_acyclic_and_deterministic) {
                     1e-3f);
 }
 
+MOPPE_TEST (a_flow_domain_renumbers_its_routes_in_topological_order) {
+  const std::vector<float> heights = descending_plane (0.37f);
+  const FractionalDrainage drainage = analyze_plane (heights);
+  const FractionalFlowDomain& flow = drainage.domain ();
+  const auto order = flow.topological_order ();
+  const auto routes = flow.topological_routes ();
+
+  MOPPE_CHECK (routes.size () == width * height);
+  for (std::size_t position = 0; position < order.size (); ++position) {
+    MOPPE_CHECK (flow.position (order[position]) == position);
+    const FractionalFlowRoute& route = flow.route (order[position]);
+    MOPPE_CHECK (routes[position].arc_count == route.arc_count);
+    for (std::uint8_t arc = 0; arc < route.arc_count; ++arc) {
+      MOPPE_CHECK (routes[position].arcs[arc].receiver > position);
+      MOPPE_CHECK (routes[position].arcs[arc].receiver ==
+                   flow.position (route.arcs[arc].receiver));
+      MOPPE_CHECK (routes[position].arcs[arc].fraction ==
+                   route.arcs[arc].fraction);
+    }
+  }
+
+  std::vector<std::uint32_t> cells (width * height);
+  for (std::size_t cell = 0; cell < cells.size (); ++cell)
+    cells[cell] = static_cast<std::uint32_t> (cell * 7);
+  std::vector<std::uint32_t> ordered (cells.size ());
+  flow.gather (cells, ordered);
+  MOPPE_CHECK (ordered[5] == order[5].value * 7);
+  std::vector<std::uint32_t> returned (cells.size ());
+  flow.scatter (ordered, returned);
+  MOPPE_CHECK (returned == cells);
+
+  // A route that leads back up the order is refused.
+  std::vector<FractionalFlowRoute> upstream (2);
+  upstream[1].arcs[0] = { .receiver = CellIndex { 0 },
+                          .fraction = 1.0f * flow_fraction[mp_units::one] };
+  upstream[1].arc_count = 1;
+  bool refused = false;
+  try {
+    FractionalFlowDomain (TerrainCellDomain (TerrainDomain (2, 1)),
+                          upstream,
+                          { CellIndex { 0 }, CellIndex { 1 } });
+  } catch (const std::invalid_argument&) {
+    refused = true;
+  }
+  MOPPE_CHECK (refused);
+}
+
 MOPPE_TEST (fractional_accumulation_materializes_an_area_weighted_tangent) {
   const std::vector<float> heights = descending_plane (0.37f);
   const FractionalDrainage drainage = analyze_plane (heights);
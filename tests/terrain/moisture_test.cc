@@ -44,3 +44,42 @@ MOPPE_TEST (moisture_decays_away_from_standing_water) {
     MOPPE_CHECK (values[i] <= 1.0f * surface_moisture[mp_units::one]);
   }
 }
+
+MOPPE_TEST (moisture_falls_off_alike_in_every_direction) {
+  // A 13x13 plain with one pond cell in the center. Three cells east and
+  // three cells diagonally are the same number of steps away, but not the
+  // same distance.
+  const std::size_t count = 169;
+  const TerrainDomain grid (
+    13, 13, 10.0f * mp_units::si::metre, 10.0f * mp_units::si::metre);
+  const std::vector<float> levels (count, 0.0f);
+  const std::vector<float> depths (count, 0.0f);
+  const std::vector<float> slopes (count, 0.01f);
+  const std::vector<float> areas (count, 100.0f);
+  const std::size_t pond = grid.offset ({ 6, 6 });
+  std::vector<WaterBodyId> body_at_cell (count, WaterBodyMembership::dry);
+  body_at_cell[pond] = 0;
+  const CellIndex receiver { static_cast<std::uint32_t> (pond) };
+  const FloodField flood { .surface = make_flood_surface (grid, levels, depths),
+                           .sea_level = -1.0f,
+                           .has_ocean = false,
+                           .ocean = std::vector<std::uint8_t> (count, 0),
+                           .spill_receiver =
+                             std::vector<CellIndex> (count, receiver) };
+  const WaterBodyMembership water_bodies (std::move (body_at_cell),
+                                          WaterBodyDomain (1));
+  const DrainageGraph drainage { .readings =
+                                   make_drainage_readings (grid, slopes, areas),
+                                 .receiver =
+                                   std::vector<CellIndex> (count, receiver) };
+
+  const MoistureMap moisture = analyze_moisture (flood, water_bodies, drainage);
+  const auto& values = spatial::get<surface_moisture> (moisture);
+  const auto at = [&] (std::size_t x, std::size_t y) {
+    return values[grid.offset ({ x, y })].numerical_value_in (mp_units::one);
+  };
+
+  MOPPE_CHECK (at (9, 6) > at (9, 9));
+  MOPPE_CHECK_NEAR (at (9, 6), at (6, 3), 1e-6f);
+  MOPPE_CHECK_NEAR (at (9, 9), at (3, 3), 1e-6f);
+}
@@ -0,0 +1,100 @@
+#include <moppe/terrain/noise.hh>
+
+#include <moppe/gfx/signal.hh>
+
+#include <tests/test.hh>
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+using namespace moppe;
+using namespace moppe::terrain;
+
+namespace {
+  // Places spread over several laps on both sides of the origin, including
+  // exact lattice corners and a negative zero, in a count that leaves a
+  // remainder after any lane width.
+  std::vector<float> noise_places (std::size_t count, float phase) {
+    std::vector<float> places (count);
+    for (std::size_t index = 0; index < count; ++index)
+      places[index] =
+        -7.0f + phase + 0.37f * static_cast<float> (index % 53) +
+        0.011f * static_cast<float> (index / 53);
+    places[0] = -0.0f;
+    places[1] = 3.0f;
+    places[2] = -2.0f;
+    return places;
+  }
+
+  bool same_bits (float left, float right) {
+    return std::bit_cast<std::uint32_t> (left) ==
+           std::bit_cast<std::uint32_t> (right);
+  }
+}
+
+MOPPE_TEST (a_noise_row_answers_exactly_what_its_points_do) {
+  const PeriodicNoise noise (0x5eedU);
+  const NoiseShape shape { 3, 5, 2, 0.55f };
+  const std::size_t count = 8 * 16 + 5;
+  const std::vector<float> x = noise_places (count, 0.0f);
+  const std::vector<float> y = noise_places (count, 0.29f);
+  std::vector<float> fbm (count);
+  std::vector<float> ridged (count);
+  noise.fbm (x, y, shape, fbm);
+  noise.ridged (x, y, shape, ridged);
+
+  bool identical = true;
+  for (std::size_t index = 0; index < count; ++index)
+    identical = identical &&
+                same_bits (fbm[index], noise.fbm (x[index], y[index], shape)) &&
+                same_bits (ridged[index],
+                           noise.ridged (x[index], y[index], shape));
+  MOPPE_CHECK (identical);
+  MOPPE_CHECK (periodic_noise_lanes () >= 8);
+}
+
+MOPPE_TEST (noise_rows_of_different_lengths_are_refused) {
+  const PeriodicNoise noise (1);
+  const std::vector<float> x (9, 0.5f);
+  const std::vector<float> y (8, 0.5f);
+  std::vector<float> out (9);
+  bool refused = false;
+  try {
+    noise.fbm (x, y, NoiseShape { 3, 4, 2, 0.5f }, out);
+  } catch (const std::invalid_argument&) {
+    refused = true;
+  }
+  MOPPE_CHECK (refused);
+}
+
+MOPPE_TEST (a_value_noise_row_answers_exactly_what_its_places_do) {
+  constexpr std::uint32_t patches = 23;
+  constexpr std::uint32_t seed = 0x91e10da5U;
+  const std::size_t width = 37;
+  std::vector<PeriodicNoiseAxis> across (width);
+  for (std::size_t column = 0; column < width; ++column)
+    across[column] = periodic_noise_axis (
+      static_cast<float> (column) / static_cast<float> (width) *
+        proportion[one],
+      patches);
+  const proportion_t along_z = 0.61f * proportion[one];
+  std::vector<noise_signal_t> row (width);
+  periodic_noise_row (
+    across, periodic_noise_axis (along_z, patches), seed, row);
+
+  bool identical = true;
+  for (std::size_t column = 0; column < width; ++column) {
+    const noise_signal_t point = periodic_noise (
+      static_cast<float> (column) / static_cast<float> (width) *
+        proportion[one],
+      along_z,
+      patches,
+      seed);
+    identical = identical && same_bits (row[column].numerical_value_in (one),
+                                        point.numerical_value_in (one));
+  }
+  MOPPE_CHECK (identical);
+}
@@ -0,0 +1,125 @@
+#include <moppe/terrain/stream_power_evolution.hh>
+
+#include <tests/sediment_fixture.hh>
+#include <tests/test.hh>
+
+#include <array>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <span>
+#include <vector>
+
+using namespace moppe;
+using namespace moppe::terrain;
+
+// Every plain allocation in this binary passes through here, so a test can
+// say how many a stretch of code made. Replacing global allocation changes it
+// for the whole program, which is why these tests are a binary of their own
+// rather than part of moppe-tests.
+namespace {
+  std::atomic<std::size_t> counted_allocations = 0;
+}
+
+void* operator new (std::size_t size) {
+  counted_allocations.fetch_add (1, std::memory_order_relaxed);
+  if (void* memory = std::malloc (size == 0 ? 1 : size))
+    return memory;
+  throw std::bad_alloc ();
+}
+
+void operator delete (void* memory) noexcept {
+  std::free (memory);
+}
+
+void operator delete (void* memory, std::size_t) noexcept {
+  std::free (memory);
+}
+
+MOPPE_TEST (a_warm_sediment_workspace_runs_every_stage_without_allocating) {
+  const test::SedimentStages stages;
+  SedimentWorkspace workspace;
+  stages.run (workspace);
+
+  const std::size_t before = counted_allocations.load ();
+  stages.run (workspace);
+  MOPPE_CHECK (counted_allocations.load () == before);
+
+  // The workspace holds what the allocating stages return.
+  const auto& areas =
+    spatial::get<fractional_contributing_area> (stages.drainage);
+  const StandingWaterStorage storage = standing_water_storage_capacity (
+    stages.flood, stages.census, areas, stages.maximum_deposition);
+  MOPPE_CHECK (storage.body_capacity == workspace.storage.body_capacity);
+  const SedimentRoutingResult routed =
+    route_sediment (stages.drainage.domain (),
+                    stages.potential_detachment,
+                    stages.transport_capacity,
+                    stages.maximum_deposition,
+                    stages.flood.ocean,
+                    stages.cover,
+                    stages.census.membership ().values (),
+                    storage.body_capacity,
+                    storage.ocean_mouth_capacity);
+  MOPPE_CHECK (routed.deposited == workspace.routing.deposited);
+  MOPPE_CHECK (routed.outgoing == workspace.routing.outgoing);
+  const StandingWaterDepositionResult standing =
+    spread_standing_water_deposition (
+      stages.flood,
+      stages.census,
+      stages.drainage.domain (),
+      areas,
+      spatial::get<channel_tangent> (stages.drainage),
+      routed.deposited,
+      stages.maximum_deposition);
+  MOPPE_CHECK (standing.deposited == workspace.standing.deposited);
+  MOPPE_CHECK (standing.lake_storage == workspace.standing.lake_storage);
+  const LateralDepositionResult lateral = spread_valley_deposition (
+    stages.drainage.domain (),
+    spatial::get<surface_elevation> (stages.ground),
+    areas,
+    spatial::get<channel_tangent> (stages.drainage),
+    standing.dry_centerline,
+    stages.flood.ocean);
+  MOPPE_CHECK (lateral.deposited == workspace.lateral.deposited);
+  const HillslopeTransportResult hillslope = route_hillslope_sediment (
+    stages.domain,
+    spatial::get<surface_elevation> (stages.ground),
+    stages.thickness,
+    stages.fixed,
+    50000.0 * mp_units::astronomy::Julian_year,
+    0.01f * u::m * u::m / mp_units::astronomy::Julian_year);
+  MOPPE_CHECK (hillslope.sweeps > iteration_count (0));
+  MOPPE_CHECK (hillslope.heights == workspace.hillslope.heights);
+  MOPPE_CHECK (hillslope.transferred == workspace.hillslope.transferred);
+}
+
+MOPPE_TEST (a_warm_stream_power_workspace_steps_without_allocating) {
+  const test::SedimentStages stages;
+  const auto uplift = std::vector<meters_per_julian_year_t> (
+    stages.domain.size (),
+    1e-4f * mp_units::si::metre / mp_units::astronomy::Julian_year);
+  const StreamPowerEvolution parameters {
+    .duration = 200000.0f * mp_units::astronomy::Julian_year,
+    .sea_level = 0.0f,
+  };
+  StreamPowerWorkspace workspace (stages.domain);
+  evolve_stream_power (workspace, stages.ground, uplift, parameters);
+
+  // An evolution sets itself up before its first step ends and builds what
+  // it returns after its last, so every allocation between those two is one
+  // a geological step made: flood analysis, the lake census, the drainage
+  // solve, the incision solve and the sediment stages alike.
+  std::array<std::size_t, 4> after_step {};
+  const StreamPowerProgress progress = [&] (IterationCount done,
+                                           IterationCount,
+                                           std::span<const SurfaceElevation>) {
+    after_step[static_cast<std::size_t> (count_value (done) - 1)] =
+      counted_allocations.load ();
+  };
+  const StreamPowerEvolutionResult result = evolve_stream_power (
+    workspace, stages.ground, uplift, parameters, progress);
+  MOPPE_CHECK (result.report.steps == iteration_count (4));
+  MOPPE_CHECK (after_step.front () != 0);
+  MOPPE_CHECK (after_step.back () == after_step.front ());
+}
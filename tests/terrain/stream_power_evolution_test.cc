@@ -1,10 +1,13 @@
 #include <moppe/terrain/stream_power_evolution.hh>
 
+#include <moppe/spatial/bundle_operations.hh>
+
 #include <tests/test.hh>
 
 #include <algorithm>
 #include <array>
 #include <cmath>
+#include <span>
 #include <vector>
 
 using namespace moppe;
@@ -409,3 +412,73 @@ MOPPE_TEST (hillslope_catchments_are_left_to_creep) {
   MOPPE_CHECK_NEAR (
     surface_elevation_value (evolve (100000.0f).heights[1]), 100.0f, 1e-6f);
 }
+
+MOPPE_TEST (coarse_to_fine_finishes_on_the_full_lattice) {
+  // A 32x32 dome on a 16 m lattice. One halving, one full-resolution step:
+  // three steps run on the 16x16 lattice, the last on this one.
+  const TerrainDomain grid (
+    32, 32, 16.0f * mp_units::si::metre, 16.0f * mp_units::si::metre);
+  std::vector<float> heights (grid.size ());
+  for (const TerrainIndex site : spatial::sites (grid)) {
+    const float x = static_cast<float> (site.column) - 15.5f;
+    const float z = static_cast<float> (site.row) - 15.5f;
+    heights[grid.offset (site)] =
+      std::max (0.0f, 60.0f - 0.2f * (x * x + z * z)) +
+      0.5f * static_cast<float> ((site.column * 7 + site.row * 3) % 5);
+  }
+  const ElevationMap terrain = make_elevation_map (grid, heights);
+  const auto uplift = uniform_uplift (grid.size (), 0.0002f);
+  StreamPowerEvolution parameters {
+    .duration = 200000.0f * mp_units::astronomy::Julian_year,
+    .time_step = 50000.0f * mp_units::astronomy::Julian_year,
+    .uplift_duration = 100000.0f * mp_units::astronomy::Julian_year,
+    .sea_level = 1.0f
+  };
+  parameters.coarse_to_fine = { .coarse_levels = 1, .fine_steps = 1 };
+
+  std::vector<int> completed;
+  const StreamPowerEvolutionResult result = evolve_stream_power (
+    terrain,
+    uplift,
+    parameters,
+    [&] (IterationCount step,
+         IterationCount total,
+         std::span<const SurfaceElevation>) {
+      MOPPE_CHECK (total == iteration_count (4));
+      completed.push_back (count_value (step));
+    });
+
+  MOPPE_CHECK ((completed == std::vector<int> { 1, 2, 3, 4 }));
+  MOPPE_CHECK (result.report.steps == iteration_count (4));
+  MOPPE_CHECK (result.report.cells == cell_count (grid.size ()));
+  MOPPE_CHECK (result.heights.size () == grid.size ());
+  MOPPE_CHECK (result.sediment_thickness.size () == grid.size ());
+  MOPPE_CHECK (result.report.tectonic_uplift_volume >
+               cubic_meters_f64_t::zero ());
+  for (const SurfaceElevation height : result.heights)
+    MOPPE_CHECK (std::isfinite (surface_elevation_value (height)));
+  for (const ChannelTangent tangent : result.channel_tangents) {
+    const Vec3 direction = tangent.numerical_value_in (mp_units::one);
+    MOPPE_CHECK (direction.magnitude () <= 1.0001f);
+    MOPPE_CHECK (direction[1] == 0.0f);
+  }
+}
+
+MOPPE_TEST (coarse_to_fine_falls_back_where_the_lattice_cannot_halve) {
+  const ElevationMap terrain =
+    make_elevation_map (profile_grid (), profile_heights);
+  const auto uplift = uniform_uplift (profile_heights.size (), 0.0005f);
+  StreamPowerEvolution parameters {
+    .duration = 50000.0f * mp_units::astronomy::Julian_year,
+    .time_step = 5000.0f * mp_units::astronomy::Julian_year,
+    .sea_level = 0.0f
+  };
+  const StreamPowerEvolutionResult exact =
+    evolve_stream_power (terrain, uplift, parameters);
+  parameters.coarse_to_fine.coarse_levels = 2;
+  const StreamPowerEvolutionResult scheduled =
+    evolve_stream_power (terrain, uplift, parameters);
+
+  MOPPE_CHECK (scheduled.heights == exact.heights);
+  MOPPE_CHECK (scheduled.channel_tangents == exact.channel_tangents);
+}
@@ -0,0 +1,42 @@
+#include <moppe/terrain/stream_power_evolution.hh>
+
+#include <tests/sediment_fixture.hh>
+#include <tests/test.hh>
+
+#include <stdexcept>
+#include <vector>
+
+using namespace moppe;
+using namespace moppe::terrain;
+
+MOPPE_TEST (an_evolution_in_a_reused_workspace_matches_a_fresh_one) {
+  const test::SedimentStages stages;
+  const auto uplift = std::vector<meters_per_julian_year_t> (
+    stages.domain.size (),
+    1e-4f * mp_units::si::metre / mp_units::astronomy::Julian_year);
+  const StreamPowerEvolution parameters {
+    .duration = 200000.0f * mp_units::astronomy::Julian_year,
+    .sea_level = 0.0f,
+  };
+  const StreamPowerEvolutionResult fresh =
+    evolve_stream_power (stages.ground, uplift, parameters);
+
+  StreamPowerWorkspace workspace (stages.domain);
+  for (int world = 0; world < 2; ++world) {
+    const StreamPowerEvolutionResult reused =
+      evolve_stream_power (workspace, stages.ground, uplift, parameters);
+    MOPPE_CHECK (reused.heights == fresh.heights);
+    MOPPE_CHECK (reused.sediment_thickness == fresh.sediment_thickness);
+    MOPPE_CHECK (reused.report.steps == fresh.report.steps);
+  }
+
+  StreamPowerWorkspace elsewhere (
+    TerrainDomain (8, 8, 10.0f * u::m, 10.0f * u::m));
+  bool refused = false;
+  try {
+    evolve_stream_power (elsewhere, stages.ground, uplift, parameters);
+  } catch (const std::invalid_argument&) {
+    refused = true;
+  }
+  MOPPE_CHECK (refused);
+}
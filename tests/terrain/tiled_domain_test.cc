@@ -0,0 +1,64 @@
+#include <moppe/terrain/tiled_domain.hh>
+
+#include <tests/test.hh>
+
+#include <cstddef>
+#include <stdexcept>
+
+using namespace moppe;
+
+MOPPE_TEST (tile_order_numbers_every_lattice_position_exactly_once) {
+  const terrain::TiledTerrainDomain domain (terrain::TerrainDomain (8, 4), 4);
+  for (std::size_t offset = 0; offset < domain.size (); ++offset)
+    MOPPE_CHECK (domain.offset (domain.index (offset)) == offset);
+  // The first tile's second row follows its first row directly, and the
+  // second tile begins only once the first is complete.
+  MOPPE_CHECK (domain.offset ({ .column = 0, .row = 1 }) == 4);
+  MOPPE_CHECK (domain.offset ({ .column = 4, .row = 0 }) == 16);
+  MOPPE_CHECK (domain.offset ({ .column = 7, .row = 3 }) == 31);
+}
+
+MOPPE_TEST (a_column_survives_the_trip_through_tile_order) {
+  using Elevations =
+    spatial::Bundle<terrain::TerrainDomain, terrain::SurfaceElevation>;
+  const terrain::TerrainDomain lattice (8, 4);
+  Elevations elevations (lattice);
+  auto& column = spatial::get<terrain::surface_elevation> (elevations);
+  for (std::size_t cell = 0; cell < column.size (); ++cell)
+    column[cell] = terrain::surface_elevation_point (
+      static_cast<float> (cell) * u::m);
+
+  const auto tiled = terrain::retile (elevations, 2);
+  const auto& tiled_column = spatial::get<terrain::surface_elevation> (tiled);
+  for (const terrain::TerrainIndex site : spatial::sites (lattice))
+    MOPPE_CHECK (terrain::surface_elevation_value (
+                   tiled_column[tiled.domain ().offset (site)]) ==
+                 terrain::surface_elevation_value (
+                   column[lattice.offset (site)]));
+
+  const Elevations untiled = terrain::untile (tiled);
+  MOPPE_CHECK (untiled.domain () == lattice);
+  for (std::size_t cell = 0; cell < column.size (); ++cell)
+    MOPPE_CHECK (terrain::surface_elevation_value (
+                   spatial::get<terrain::surface_elevation> (untiled)[cell]) ==
+                 terrain::surface_elevation_value (column[cell]));
+}
+
+MOPPE_TEST (a_tile_that_does_not_divide_the_lattice_is_refused) {
+  bool refused = false;
+  try {
+    static_cast<void> (
+      terrain::TiledTerrainDomain (terrain::TerrainDomain (12, 8), 8));
+  } catch (const std::invalid_argument&) {
+    refused = true;
+  }
+  MOPPE_CHECK (refused);
+  refused = false;
+  try {
+    static_cast<void> (
+      terrain::TiledTerrainDomain (terrain::TerrainDomain (12, 12), 3));
+  } catch (const std::invalid_argument&) {
+    refused = true;
+  }
+  MOPPE_CHECK (refused);
+}
@@ -243,3 +243,53 @@ MOPPE_TEST (dry_ridges_remain_still) {
   MOPPE_CHECK_NEAR (velocity[0], 0.0f, 0.0f);
   MOPPE_CHECK_NEAR (velocity[2], 0.0f, 0.0f);
 }
+
+MOPPE_TEST (banded_running_water_paints_the_same_sheet_as_one_sweep) {
+  // Wide enough for the bands to run on workers: ridged slopes shedding
+  // many reaches into the sea along the bottom rows.
+  constexpr std::size_t side = 256;
+  std::vector<float> heights (side * side);
+  for (std::size_t y = 0; y < side; ++y)
+    for (std::size_t x = 0; x < side; ++x)
+      heights[y * side + x] =
+        y >= side - 6
+          ? -5.0f
+          : 60.0f - 0.2f * static_cast<float> (y) +
+              6.0f * std::abs (std::sin (0.07f * static_cast<float> (x)));
+  const TerrainDomain grid (
+    side, side, 5.0f * mp_units::si::metre, 5.0f * mp_units::si::metre);
+  const ElevationMap terrain = make_elevation_map (grid, heights);
+  const FloodField flood = analyze_standing_water (terrain, 0.0f);
+  const LakeCensus census = census_lakes (flood);
+  const DrainageGraph drainage = analyze_wet_drainage (flood, census);
+  const RiverNetwork rivers =
+    extract_river_network (flood,
+                           census,
+                           drainage,
+                           400.0f * mp_units::si::metre * mp_units::si::metre);
+  MOPPE_CHECK (rivers.reaches.size () > 8);
+
+  const auto paint = [&] (std::size_t band_rows) {
+    return detail::paint_watercourses (grid,
+                                       elevations (terrain),
+                                       flood,
+                                       census,
+                                       drainage,
+                                       rivers,
+                                       {},
+                                       band_rows);
+  };
+  const WaterSheets single = paint (side);
+  for (const std::size_t band_rows : { std::size_t { 1 }, std::size_t { 7 } }) {
+    const WaterSheets banded = paint (band_rows);
+    bool same = true;
+    for (std::size_t cell = 0; cell < grid.size (); ++cell)
+      same = same &&
+             spatial::get<surface_elevation> (banded)[cell] ==
+               spatial::get<surface_elevation> (single)[cell] &&
+             spatial::get<wave_amplitude> (banded)[cell] ==
+               spatial::get<wave_amplitude> (single)[cell] &&
+             sheet_velocity (banded, cell) == sheet_velocity (single, cell);
+    MOPPE_CHECK (same);
+  }
+}